@@ -0,0 +1,289 @@
+/**
+  ******************************************************************************
+  * @file           : at24cs0x_cache.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Write-back page cache of the AT24CS0x EEPROM
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+#include "at24cs0x_cache.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "freertos/task.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define WRITE_TIMEOUT_US	(CONFIG_AT24CS0X_CACHE_WRITE_TIMEOUT_MS * 1000)
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static const char *TAG = "at24cs0x_cache";
+
+/* Private function prototypes -----------------------------------------------*/
+static esp_err_t line_get(at24cs0x_cache_t * const me, uint8_t page, bool load, at24cs0x_cache_line_t **line);
+static esp_err_t line_write_back(at24cs0x_cache_t * const me, at24cs0x_cache_line_t *line);
+static esp_err_t ack_poll(at24cs0x_cache_t * const me, uint8_t addr);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief Function to initialize an EEPROM cache
+  */
+esp_err_t at24cs0x_cache_init(at24cs0x_cache_t * const me, at24cs0x_t *eeprom, uint16_t size) {
+	ESP_LOGI(TAG, "Initializing AT24CS0x cache instance...");
+
+	if (size == 0 || size > AT24CS02_SIZE || size % AT24CS0X_CACHE_PAGE_SIZE) {
+		return ESP_ERR_INVALID_ARG;
+	}
+
+	me->eeprom = eeprom;
+	me->size = size;
+	me->clock = 0;
+	me->reads = 0;
+	me->writes = 0;
+	me->polls = 0;
+
+	for (uint8_t i = 0; i < AT24CS0X_CACHE_PAGES; i++) {
+		me->lines[i].valid = false;
+		me->lines[i].dirty = false;
+	}
+
+	me->mutex = xSemaphoreCreateMutexStatic(&me->mutex_buffer);
+
+	if (me->mutex == NULL) {
+		ESP_LOGE(TAG, "Failed to create the cache mutex");
+		return ESP_FAIL;
+	}
+
+	return ESP_OK;
+}
+
+/**
+  * @brief Function to read from the EEPROM through the cache
+  */
+esp_err_t at24cs0x_cache_read(at24cs0x_cache_t * const me, uint16_t addr, uint8_t *data, uint16_t len) {
+	if ((uint32_t)addr + len > me->size) {
+		return ESP_ERR_INVALID_SIZE;
+	}
+
+	esp_err_t ret = ESP_OK;
+
+	xSemaphoreTake(me->mutex, portMAX_DELAY);
+
+	while (len) {
+		uint8_t offset = addr % AT24CS0X_CACHE_PAGE_SIZE;
+		uint8_t chunk = AT24CS0X_CACHE_PAGE_SIZE - offset;
+		at24cs0x_cache_line_t *line;
+
+		if (chunk > len) {
+			chunk = len;
+		}
+
+		ret = line_get(me, addr / AT24CS0X_CACHE_PAGE_SIZE, true, &line);
+
+		if (ret != ESP_OK) {
+			break;
+		}
+
+		memcpy(data, &line->data[offset], chunk);
+
+		addr += chunk;
+		data += chunk;
+		len -= chunk;
+	}
+
+	xSemaphoreGive(me->mutex);
+
+	return ret;
+}
+
+/**
+  * @brief Function to write to the EEPROM through the cache
+  */
+esp_err_t at24cs0x_cache_write(at24cs0x_cache_t * const me, uint16_t addr, const uint8_t *data, uint16_t len) {
+	if ((uint32_t)addr + len > me->size) {
+		return ESP_ERR_INVALID_SIZE;
+	}
+
+	esp_err_t ret = ESP_OK;
+
+	xSemaphoreTake(me->mutex, portMAX_DELAY);
+
+	while (len) {
+		uint8_t offset = addr % AT24CS0X_CACHE_PAGE_SIZE;
+		uint8_t chunk = AT24CS0X_CACHE_PAGE_SIZE - offset;
+		at24cs0x_cache_line_t *line;
+
+		if (chunk > len) {
+			chunk = len;
+		}
+
+		/* A whole page is overwritten, its old content isn't needed */
+		ret = line_get(me, addr / AT24CS0X_CACHE_PAGE_SIZE, chunk < AT24CS0X_CACHE_PAGE_SIZE, &line);
+
+		if (ret != ESP_OK) {
+			break;
+		}
+
+		if (memcmp(&line->data[offset], data, chunk)) {
+			memcpy(&line->data[offset], data, chunk);
+			line->dirty = true;
+		}
+
+		addr += chunk;
+		data += chunk;
+		len -= chunk;
+	}
+
+	xSemaphoreGive(me->mutex);
+
+	return ret;
+}
+
+/**
+  * @brief Function to write every modified page back to the EEPROM
+  */
+esp_err_t at24cs0x_cache_flush(at24cs0x_cache_t * const me) {
+	esp_err_t ret = ESP_OK;
+
+	xSemaphoreTake(me->mutex, portMAX_DELAY);
+
+	for (uint8_t i = 0; i < AT24CS0X_CACHE_PAGES && ret == ESP_OK; i++) {
+		ret = line_write_back(me, &me->lines[i]);
+	}
+
+	xSemaphoreGive(me->mutex);
+
+	return ret;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static esp_err_t line_get(at24cs0x_cache_t * const me, uint8_t page, bool load, at24cs0x_cache_line_t **line) {
+	at24cs0x_cache_line_t *victim = &me->lines[0];
+
+	for (uint8_t i = 0; i < AT24CS0X_CACHE_PAGES; i++) {
+		at24cs0x_cache_line_t *l = &me->lines[i];
+
+		if (l->valid && l->page == page) {
+			l->used = ++me->clock;
+			*line = l;
+
+			return ESP_OK;
+		}
+
+		/* Prefer a free line, otherwise the least recently used one */
+		if (victim->valid && (!l->valid || l->used < victim->used)) {
+			victim = l;
+		}
+	}
+
+	esp_err_t ret = line_write_back(me, victim);
+
+	if (ret != ESP_OK) {
+		return ret;
+	}
+
+	victim->valid = false;
+
+	if (load) {
+		i2c_bus_dev_t *dev = me->eeprom->i2c_dev;
+		uint8_t addr = page * AT24CS0X_CACHE_PAGE_SIZE;
+
+		/* Sequential read of the whole page */
+		me->reads++;
+
+		if (dev->read(&addr, 1, victim->data, AT24CS0X_CACHE_PAGE_SIZE, dev) != 0) {
+			ESP_LOGE(TAG, "Failed to read page %d", page);
+			return ESP_FAIL;
+		}
+	}
+
+	victim->page = page;
+	victim->valid = true;
+
+	/* Not loaded, the data is still the one of the evicted page and the caller
+	 * overwrites all of it, so it has to be written back whatever it writes */
+	victim->dirty = !load;
+	victim->used = ++me->clock;
+	*line = victim;
+
+	return ESP_OK;
+}
+
+static esp_err_t line_write_back(at24cs0x_cache_t * const me, at24cs0x_cache_line_t *line) {
+	if (!line->valid || !line->dirty) {
+		return ESP_OK;
+	}
+
+	i2c_bus_dev_t *dev = me->eeprom->i2c_dev;
+	uint8_t addr = line->page * AT24CS0X_CACHE_PAGE_SIZE;
+
+	/* The page is written in one burst, the EEPROM then goes through its
+	 * internal write cycle */
+	me->writes++;
+
+	if (dev->write(&addr, 1, line->data, AT24CS0X_CACHE_PAGE_SIZE, dev) != 0) {
+		ESP_LOGE(TAG, "Failed to write page %d", line->page);
+		return ESP_FAIL;
+	}
+
+	line->dirty = false;
+
+	return ack_poll(me, addr);
+}
+
+static esp_err_t ack_poll(at24cs0x_cache_t * const me, uint8_t addr) {
+	i2c_bus_dev_t *dev = me->eeprom->i2c_dev;
+	int64_t start = esp_timer_get_time();
+	uint8_t dummy;
+
+	/* The EEPROM doesn't acknowledge its address until the write cycle
+	 * ends, a one byte random read returns as soon as it does */
+	do {
+		me->polls++;
+
+		if (dev->read(&addr, 1, &dummy, 1, dev) == 0) {
+			return ESP_OK;
+		}
+
+		taskYIELD();
+	} while (esp_timer_get_time() - start < WRITE_TIMEOUT_US);
+
+	ESP_LOGE(TAG, "Write cycle timeout");
+
+	return ESP_ERR_TIMEOUT;
+}
+
+/***************************** END OF FILE ************************************/
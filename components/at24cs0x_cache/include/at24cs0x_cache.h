@@ -0,0 +1,151 @@
+/**
+  ******************************************************************************
+  * @file           : at24cs0x_cache.h
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Write-back page cache of the AT24CS0x EEPROM
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef AT24CS0X_CACHE_H_
+#define AT24CS0X_CACHE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "esp_err.h"
+#include "sdkconfig.h"
+#include "at24cs0x.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+/* Exported macro ------------------------------------------------------------*/
+#define AT24CS0X_CACHE_PAGE_SIZE	8
+#define AT24CS0X_CACHE_PAGES		CONFIG_AT24CS0X_CACHE_PAGES
+#define AT24CS01_SIZE				128
+#define AT24CS02_SIZE				256
+
+/* Exported typedef ----------------------------------------------------------*/
+typedef struct {
+	uint8_t data[AT24CS0X_CACHE_PAGE_SIZE];
+	uint8_t page;
+	bool valid;
+	bool dirty;					/* Modified and not written back */
+	uint32_t used;				/* Last use, for the LRU eviction */
+} at24cs0x_cache_line_t;
+
+typedef struct {
+	at24cs0x_t *eeprom;
+	uint16_t size;				/* EEPROM array size in bytes */
+	at24cs0x_cache_line_t lines[AT24CS0X_CACHE_PAGES];
+	uint32_t clock;
+	SemaphoreHandle_t mutex;
+	StaticSemaphore_t mutex_buffer;
+
+	/* Bus transactions */
+	uint32_t reads;				/* Page reads */
+	uint32_t writes;			/* Page writes */
+	uint32_t polls;				/* Acknowledge polls */
+} at24cs0x_cache_t;
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions prototypes ---------------------------------------------*/
+/**
+  * @brief Function to initialize an EEPROM cache
+  *
+  * @param me     : Pointer to a at24cs0x_cache_t structure
+  * @param eeprom : Pointer to an initialized at24cs0x_t structure
+  * @param size   : EEPROM array size in bytes, AT24CS01_SIZE or AT24CS02_SIZE
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_INVALID_ARG if the size isn't a multiple of the page size
+  */
+esp_err_t at24cs0x_cache_init(at24cs0x_cache_t * const me, at24cs0x_t *eeprom, uint16_t size);
+
+/**
+  * @brief Function to read from the EEPROM through the cache
+  *
+  * @param me   : Pointer to a at24cs0x_cache_t structure
+  * @param addr : EEPROM address
+  * @param data : Pointer to store the data
+  * @param len  : Number of bytes
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_INVALID_SIZE if the range is out of the array
+  * 	- ESP_FAIL if a bus transaction failed
+  */
+esp_err_t at24cs0x_cache_read(at24cs0x_cache_t * const me, uint16_t addr, uint8_t *data, uint16_t len);
+
+/**
+  * @brief Function to write to the EEPROM through the cache
+  *
+  * @note The data reaches the EEPROM when its page is evicted or on
+  *       at24cs0x_cache_flush()
+  *
+  * @param me   : Pointer to a at24cs0x_cache_t structure
+  * @param addr : EEPROM address
+  * @param data : Pointer to the data
+  * @param len  : Number of bytes
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_INVALID_SIZE if the range is out of the array
+  * 	- ESP_FAIL if a bus transaction failed
+  */
+esp_err_t at24cs0x_cache_write(at24cs0x_cache_t * const me, uint16_t addr, const uint8_t *data, uint16_t len);
+
+/**
+  * @brief Function to write every modified page back to the EEPROM
+  *
+  * @param me : Pointer to a at24cs0x_cache_t structure
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_FAIL if a bus transaction failed
+  * 	- ESP_ERR_TIMEOUT if the EEPROM didn't finish a write cycle in time
+  */
+esp_err_t at24cs0x_cache_flush(at24cs0x_cache_t * const me);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AT24CS0X_CACHE_H_ */
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,381 @@
+/**
+  ******************************************************************************
+  * @file           : test_at24cs0x_cache.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Host test of the AT24CS0x cache against a fake EEPROM
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+#include "host_test.h"
+#include "at24cs0x_cache.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define BUSY_POLLS				3		/* NACKed transactions after a page write */
+#define SEED					1
+
+/* The test_bus_transactions() accesses */
+#define WORKLOAD_READS			10
+#define WORKLOAD_WRITES			100
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+	i2c_bus_dev_t dev;
+	uint8_t mem[AT24CS02_SIZE];
+	uint32_t busy;				/* Transactions left in the write cycle */
+	uint32_t busy_polls;		/* Length of the write cycle in transactions */
+	bool absent;				/* NACKs every transaction */
+	uint32_t reads;
+	uint32_t writes;
+	uint32_t nacks;
+} fake_eeprom_t;
+
+/* Private variables ---------------------------------------------------------*/
+static fake_eeprom_t eeprom;
+static at24cs0x_t at24cs0x = {.i2c_dev = &eeprom.dev};
+static at24cs0x_cache_t cache;
+
+/* Private function prototypes -----------------------------------------------*/
+static int8_t eeprom_read(uint8_t *reg_addr, uint8_t addr_len, uint8_t *reg_data, uint32_t data_len, void *intf);
+static int8_t eeprom_write(uint8_t *reg_addr, uint8_t addr_len, const uint8_t *reg_data, uint32_t data_len, void *intf);
+static bool eeprom_nack(fake_eeprom_t *fake);
+static void setup(void);
+static void test_init_args(void);
+static void test_random_access(void);
+static void test_whole_page_write_after_eviction(void);
+static void workload_cached(void);
+static void workload_uncached(void);
+static void test_bus_transactions(void);
+static void test_uncached_baseline(void);
+static void test_bus_errors(void);
+
+/* Main ----------------------------------------------------------------------*/
+int main(void) {
+	RUN_TEST(test_init_args);
+	RUN_TEST(test_random_access);
+	RUN_TEST(test_whole_page_write_after_eviction);
+	RUN_TEST(test_bus_transactions);
+	RUN_TEST(test_uncached_baseline);
+	RUN_TEST(test_bus_errors);
+
+	return 0;
+}
+
+/* Private functions ---------------------------------------------------------*/
+/* Sequential reads roll over the whole array, page writes within the page */
+static int8_t eeprom_read(uint8_t *reg_addr, uint8_t addr_len, uint8_t *reg_data, uint32_t data_len, void *intf) {
+	fake_eeprom_t *fake = intf;
+
+	TEST_ASSERT_EQUAL(1, addr_len);
+
+	if (eeprom_nack(fake)) {
+		return -1;
+	}
+
+	fake->reads++;
+
+	for (uint32_t i = 0; i < data_len; i++) {
+		reg_data[i] = fake->mem[(reg_addr[0] + i) % AT24CS02_SIZE];
+	}
+
+	return 0;
+}
+
+static int8_t eeprom_write(uint8_t *reg_addr, uint8_t addr_len, const uint8_t *reg_data, uint32_t data_len, void *intf) {
+	fake_eeprom_t *fake = intf;
+	uint8_t page = reg_addr[0] & ~(AT24CS0X_CACHE_PAGE_SIZE - 1);
+
+	TEST_ASSERT_EQUAL(1, addr_len);
+	TEST_ASSERT(data_len <= AT24CS0X_CACHE_PAGE_SIZE);
+
+	if (eeprom_nack(fake)) {
+		return -1;
+	}
+
+	fake->writes++;
+
+	for (uint32_t i = 0; i < data_len; i++) {
+		fake->mem[page + (reg_addr[0] + i) % AT24CS0X_CACHE_PAGE_SIZE] = reg_data[i];
+	}
+
+	fake->busy = fake->busy_polls;
+
+	return 0;
+}
+
+static bool eeprom_nack(fake_eeprom_t *fake) {
+	if (fake->absent || fake->busy) {
+		fake->busy -= fake->busy > 0;
+		fake->nacks++;
+
+		return true;
+	}
+
+	return false;
+}
+
+static void setup(void) {
+	memset(&eeprom, 0, sizeof(eeprom));
+	eeprom.dev.read = eeprom_read;
+	eeprom.dev.write = eeprom_write;
+	eeprom.busy_polls = BUSY_POLLS;
+
+	TEST_ASSERT_EQUAL(ESP_OK, at24cs0x_cache_init(&cache, &at24cs0x, AT24CS02_SIZE));
+}
+
+static void test_init_args(void) {
+	setup();
+
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, at24cs0x_cache_init(&cache, &at24cs0x, 0));
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, at24cs0x_cache_init(&cache, &at24cs0x, AT24CS02_SIZE + AT24CS0X_CACHE_PAGE_SIZE));
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, at24cs0x_cache_init(&cache, &at24cs0x, AT24CS01_SIZE + 1));
+	TEST_ASSERT_EQUAL(ESP_OK, at24cs0x_cache_init(&cache, &at24cs0x, AT24CS01_SIZE));
+
+	uint8_t data[2] = {0};
+
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, at24cs0x_cache_read(&cache, AT24CS01_SIZE - 1, data, 2));
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, at24cs0x_cache_write(&cache, AT24CS01_SIZE, data, 1));
+	TEST_ASSERT_EQUAL(0, eeprom.reads + eeprom.writes);
+}
+
+/* Random reads and writes against a plain copy of the array, the EEPROM has
+ * to match the copy after every flush */
+static void test_random_access(void) {
+	uint8_t model[AT24CS02_SIZE];
+
+	setup();
+	srand(SEED);
+
+	for (uint16_t i = 0; i < AT24CS02_SIZE; i++) {
+		eeprom.mem[i] = model[i] = rand();
+	}
+
+	for (uint32_t i = 0; i < 20000; i++) {
+		uint16_t addr = rand() % AT24CS02_SIZE;
+		uint16_t len = 1 + rand() % 24;
+		uint8_t data[24];
+
+		/* Page aligned whole pages now and then, they are not loaded */
+		if (rand() % 4 == 0) {
+			addr &= ~(AT24CS0X_CACHE_PAGE_SIZE - 1);
+			len = AT24CS0X_CACHE_PAGE_SIZE * (1 + rand() % 3);
+		}
+
+		if (addr + len > AT24CS02_SIZE) {
+			len = AT24CS02_SIZE - addr;
+		}
+
+		if (rand() % 3 == 0) {
+			/* Few values, so that the new data often equals the old one */
+			for (uint16_t j = 0; j < len; j++) {
+				data[j] = rand() % 4;
+			}
+
+			TEST_ASSERT_EQUAL(ESP_OK, at24cs0x_cache_write(&cache, addr, data, len));
+			memcpy(&model[addr], data, len);
+		}
+		else {
+			TEST_ASSERT_EQUAL(ESP_OK, at24cs0x_cache_read(&cache, addr, data, len));
+			TEST_ASSERT(memcmp(data, &model[addr], len) == 0);
+		}
+
+		if (i % 1000 == 999) {
+			TEST_ASSERT_EQUAL(ESP_OK, at24cs0x_cache_flush(&cache));
+			TEST_ASSERT(memcmp(eeprom.mem, model, sizeof(model)) == 0);
+		}
+	}
+}
+
+/* A whole page write takes a line without loading it, the stale data of the
+ * evicted page must not make the new data look unchanged */
+static void test_whole_page_write_after_eviction(void) {
+	uint8_t zeros[AT24CS0X_CACHE_PAGE_SIZE] = {0};
+	uint8_t data[AT24CS0X_CACHE_PAGE_SIZE];
+
+	setup();
+	memset(&eeprom.mem[AT24CS0X_CACHE_PAGES * AT24CS0X_CACHE_PAGE_SIZE], 0xAA, AT24CS0X_CACHE_PAGE_SIZE);
+
+	/* Fill the cache with pages of zeros */
+	for (uint8_t i = 0; i < AT24CS0X_CACHE_PAGES; i++) {
+		TEST_ASSERT_EQUAL(ESP_OK, at24cs0x_cache_read(&cache, i * AT24CS0X_CACHE_PAGE_SIZE, data, sizeof(data)));
+	}
+
+	TEST_ASSERT_EQUAL(ESP_OK, at24cs0x_cache_write(&cache, AT24CS0X_CACHE_PAGES * AT24CS0X_CACHE_PAGE_SIZE, zeros, sizeof(zeros)));
+	TEST_ASSERT_EQUAL(ESP_OK, at24cs0x_cache_flush(&cache));
+	TEST_ASSERT(memcmp(&eeprom.mem[AT24CS0X_CACHE_PAGES * AT24CS0X_CACHE_PAGE_SIZE], zeros, sizeof(zeros)) == 0);
+	TEST_ASSERT_EQUAL(1, eeprom.writes);
+}
+
+static void test_bus_transactions(void) {
+	uint8_t blob[32];
+	uint8_t data[AT24CS0X_CACHE_PAGE_SIZE];
+
+	setup();
+
+	/* A page is read once while it stays cached */
+	for (uint8_t i = 0; i < 10; i++) {
+		TEST_ASSERT_EQUAL(ESP_OK, at24cs0x_cache_read(&cache, 3, data, 4));
+	}
+
+	TEST_ASSERT_EQUAL(1, eeprom.reads);
+	TEST_ASSERT_EQUAL(1, cache.reads);
+
+	/* Rewriting the same value leaves the page clean */
+	TEST_ASSERT_EQUAL(ESP_OK, at24cs0x_cache_write(&cache, 3, data, 4));
+	TEST_ASSERT_EQUAL(ESP_OK, at24cs0x_cache_flush(&cache));
+	TEST_ASSERT_EQUAL(0, eeprom.writes);
+
+	/* A state blob rewritten many times reaches the EEPROM as one burst per
+	 * page on flush, the aligned pages are never read */
+	eeprom.reads = 0;
+	cache.reads = 0;
+
+	for (uint8_t i = 0; i < 100; i++) {
+		memset(blob, i + 1, sizeof(blob));
+		TEST_ASSERT_EQUAL(ESP_OK, at24cs0x_cache_write(&cache, 64, blob, sizeof(blob)));
+	}
+
+	TEST_ASSERT_EQUAL(0, eeprom.writes);
+	TEST_ASSERT_EQUAL(ESP_OK, at24cs0x_cache_flush(&cache));
+
+	TEST_ASSERT_EQUAL(0, cache.reads);
+	TEST_ASSERT_EQUAL(sizeof(blob) / AT24CS0X_CACHE_PAGE_SIZE, eeprom.writes);
+	TEST_ASSERT_EQUAL(eeprom.writes, cache.writes);
+	TEST_ASSERT(memcmp(&eeprom.mem[64], blob, sizeof(blob)) == 0);
+
+	/* Every write cycle is polled until the address is acknowledged, the
+	 * only reads are the last polls */
+	TEST_ASSERT_EQUAL(eeprom.writes, eeprom.reads);
+	TEST_ASSERT_EQUAL(cache.writes * (BUSY_POLLS + 1), cache.polls);
+	TEST_ASSERT_EQUAL(cache.writes * BUSY_POLLS, eeprom.nacks);
+
+	/* A second flush has nothing to write */
+	TEST_ASSERT_EQUAL(ESP_OK, at24cs0x_cache_flush(&cache));
+	TEST_ASSERT_EQUAL(sizeof(blob) / AT24CS0X_CACHE_PAGE_SIZE, eeprom.writes);
+}
+
+/* A page read often and a state blob rewritten often */
+static void workload_cached(void) {
+	uint8_t blob[32];
+	uint8_t data[4];
+
+	for (uint8_t i = 0; i < WORKLOAD_READS; i++) {
+		TEST_ASSERT_EQUAL(ESP_OK, at24cs0x_cache_read(&cache, 3, data, sizeof(data)));
+	}
+
+	for (uint8_t i = 0; i < WORKLOAD_WRITES; i++) {
+		memset(blob, i + 1, sizeof(blob));
+		TEST_ASSERT_EQUAL(ESP_OK, at24cs0x_cache_write(&cache, 64, blob, sizeof(blob)));
+	}
+
+	TEST_ASSERT_EQUAL(ESP_OK, at24cs0x_cache_flush(&cache));
+}
+
+/* The same through the at24cs0x driver, a sequential read per read and a
+ * byte write per byte, each waited for with the fixed write cycle delay */
+static void workload_uncached(void) {
+	uint8_t blob[32];
+	uint8_t data[4];
+	uint8_t addr;
+
+	for (uint8_t i = 0; i < WORKLOAD_READS; i++) {
+		addr = 3;
+		TEST_ASSERT_EQUAL(0, eeprom.dev.read(&addr, 1, data, sizeof(data), &eeprom));
+	}
+
+	for (uint8_t i = 0; i < WORKLOAD_WRITES; i++) {
+		memset(blob, i + 1, sizeof(blob));
+
+		for (uint8_t j = 0; j < sizeof(blob); j++) {
+			addr = 64 + j;
+			TEST_ASSERT_EQUAL(0, eeprom.dev.write(&addr, 1, &blob[j], 1, &eeprom));
+			eeprom.busy = 0;
+		}
+	}
+}
+
+/* Against the driver alone, the cache takes two orders of magnitude fewer
+ * transactions and write cycles, acknowledge polls included */
+static void test_uncached_baseline(void) {
+	setup();
+	workload_uncached();
+
+	uint32_t uncached = eeprom.reads + eeprom.writes;
+	uint32_t uncached_writes = eeprom.writes;
+
+	setup();
+	workload_cached();
+
+	uint32_t cached = eeprom.reads + eeprom.writes + eeprom.nacks;
+	uint8_t blob[32];
+
+	memset(blob, WORKLOAD_WRITES, sizeof(blob));
+	TEST_ASSERT(memcmp(&eeprom.mem[64], blob, sizeof(blob)) == 0);
+
+	printf("bus transactions: %" PRIu32 " uncached, %" PRIu32 " cached\n", uncached, cached);
+	printf("write cycles: %" PRIu32 " uncached, %" PRIu32 " cached\n", uncached_writes, eeprom.writes);
+
+	TEST_ASSERT(cached * 100 < uncached);
+	TEST_ASSERT(eeprom.writes * 100 < uncached_writes);
+}
+
+static void test_bus_errors(void) {
+	uint8_t data = 0x55;
+
+	setup();
+
+	/* A page that can't be read isn't cached */
+	eeprom.absent = true;
+	TEST_ASSERT_EQUAL(ESP_FAIL, at24cs0x_cache_write(&cache, 0, &data, 1));
+	eeprom.absent = false;
+	TEST_ASSERT_EQUAL(ESP_OK, at24cs0x_cache_write(&cache, 0, &data, 1));
+
+	/* A NACKed page write keeps the page dirty until a flush succeeds */
+	eeprom.absent = true;
+	TEST_ASSERT_EQUAL(ESP_FAIL, at24cs0x_cache_flush(&cache));
+	TEST_ASSERT_EQUAL(0, eeprom.writes);
+	eeprom.absent = false;
+	TEST_ASSERT_EQUAL(ESP_OK, at24cs0x_cache_flush(&cache));
+	TEST_ASSERT_EQUAL(1, eeprom.writes);
+	TEST_ASSERT_EQUAL(data, eeprom.mem[0]);
+
+	/* A write cycle that never ends times out */
+	data = 0xAA;
+	eeprom.busy_polls = UINT32_MAX;
+	TEST_ASSERT_EQUAL(ESP_OK, at24cs0x_cache_write(&cache, 0, &data, 1));
+	TEST_ASSERT_EQUAL(ESP_ERR_TIMEOUT, at24cs0x_cache_flush(&cache));
+	TEST_ASSERT_EQUAL(2, eeprom.writes);
+	TEST_ASSERT_EQUAL(data, eeprom.mem[0]);
+}
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,192 @@
+/**
+  ******************************************************************************
+  * @file           : bsec2_state.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Persistence of the BSEC2 calibration state
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <sys/time.h>
+
+#include "bsec2_state.h"
+#include "esp_log.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define NVS_NAMESPACE		"bsec2"
+#define NVS_STATE_KEY		"state"
+#define NVS_META_KEY		"meta"
+
+#define SAVE_PERIOD_S		((int64_t)CONFIG_BSEC2_STATE_SAVE_PERIOD_MIN * 60)
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+/* Stored next to the state blob */
+typedef struct {
+	int64_t time;
+	uint8_t accuracy;
+} state_meta_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const char *TAG = "bsec2_state";
+
+/* Private function prototypes -----------------------------------------------*/
+static int64_t get_rtc_time(void);
+static esp_err_t state_save(bsec2_state_t * const me, bsec2_t *bsec, uint8_t accuracy);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief Function to initialize the state storage
+  */
+esp_err_t bsec2_state_init(bsec2_state_t * const me) {
+	ESP_LOGI(TAG, "Initializing BSEC2 state instance...");
+
+	me->saves = 0;
+
+	esp_err_t ret = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &me->nvs);
+
+	if (ret != ESP_OK) {
+		ESP_LOGE(TAG, "Failed to open NVS namespace");
+		return ret;
+	}
+
+	state_meta_t meta;
+	size_t len = sizeof(meta);
+
+	if (nvs_get_blob(me->nvs, NVS_META_KEY, &meta, &len) == ESP_OK && len == sizeof(meta)) {
+		me->saved_time = meta.time;
+		me->saved_accuracy = meta.accuracy;
+	}
+	else {
+		/* Nothing saved yet, the first save waits a whole period unless the
+		 * accuracy improves */
+		me->saved_time = get_rtc_time();
+		me->saved_accuracy = 0;
+	}
+
+	return ESP_OK;
+}
+
+/**
+  * @brief Function to restore the saved state into BSEC
+  */
+esp_err_t bsec2_state_restore(bsec2_state_t * const me, bsec2_t *bsec) {
+	size_t len = sizeof(me->state);
+	esp_err_t ret = nvs_get_blob(me->nvs, NVS_STATE_KEY, me->state, &len);
+
+	if (ret != ESP_OK) {
+		return ret;
+	}
+
+	if (!bsec2_set_state(bsec, me->state)) {
+		ESP_LOGW(TAG, "Saved state rejected");
+		return ESP_FAIL;
+	}
+
+	ESP_LOGI(TAG, "State restored, IAQ accuracy %d", me->saved_accuracy);
+
+	return ESP_OK;
+}
+
+/**
+  * @brief Function to save the BSEC state if it is due
+  */
+esp_err_t bsec2_state_update(bsec2_state_t * const me, bsec2_t *bsec, uint8_t accuracy) {
+	/* A better calibrated state is worth saving right away */
+	if (accuracy > me->saved_accuracy) {
+		return state_save(me, bsec, accuracy);
+	}
+
+	int64_t now = get_rtc_time();
+
+	/* The RTC time starts over after a power loss */
+	if (now < me->saved_time) {
+		me->saved_time = now;
+	}
+
+	if (now - me->saved_time < SAVE_PERIOD_S) {
+		return ESP_OK;
+	}
+
+	/* Don't replace the saved state with one still learning */
+	if (accuracy < CONFIG_BSEC2_STATE_MIN_ACCURACY || accuracy < me->saved_accuracy) {
+		return ESP_OK;
+	}
+
+	return state_save(me, bsec, accuracy);
+}
+
+/* Private functions ---------------------------------------------------------*/
+static int64_t get_rtc_time(void) {
+	struct timeval tv;
+
+	/* Kept by the RTC timer across deep sleep, unlike esp_timer */
+	gettimeofday(&tv, NULL);
+
+	return tv.tv_sec;
+}
+
+static esp_err_t state_save(bsec2_state_t * const me, bsec2_t *bsec, uint8_t accuracy) {
+	if (!bsec2_get_state(bsec, me->state)) {
+		ESP_LOGE(TAG, "Failed to get the state");
+		return ESP_FAIL;
+	}
+
+	state_meta_t meta = {
+			.time = get_rtc_time(),
+			.accuracy = accuracy,
+	};
+
+	esp_err_t ret = nvs_set_blob(me->nvs, NVS_STATE_KEY, me->state, sizeof(me->state));
+
+	if (ret == ESP_OK) {
+		ret = nvs_set_blob(me->nvs, NVS_META_KEY, &meta, sizeof(meta));
+	}
+
+	if (ret == ESP_OK) {
+		ret = nvs_commit(me->nvs);
+	}
+
+	if (ret != ESP_OK) {
+		ESP_LOGE(TAG, "Failed to save the state");
+		return ret;
+	}
+
+	me->saved_time = meta.time;
+	me->saved_accuracy = accuracy;
+	me->saves++;
+
+	ESP_LOGI(TAG, "State saved, IAQ accuracy %d", accuracy);
+
+	return ESP_OK;
+}
+
+/***************************** END OF FILE ************************************/
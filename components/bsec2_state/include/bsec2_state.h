@@ -0,0 +1,115 @@
+/**
+  ******************************************************************************
+  * @file           : bsec2_state.h
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Persistence of the BSEC2 calibration state
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef BSEC2_STATE_H_
+#define BSEC2_STATE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "sdkconfig.h"
+#include "bsec2.h"
+#include "nvs.h"
+
+/* Exported macro ------------------------------------------------------------*/
+
+/* Exported typedef ----------------------------------------------------------*/
+typedef struct {
+	nvs_handle_t nvs;
+	int64_t saved_time;			/* RTC time in s of the last save */
+	uint8_t saved_accuracy;		/* IAQ accuracy of the saved state */
+	uint32_t saves;				/* Saves since boot */
+	uint8_t state[BSEC_MAX_STATE_BLOB_SIZE];
+} bsec2_state_t;
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions prototypes ---------------------------------------------*/
+/**
+  * @brief Function to initialize the state storage
+  *
+  * @note NVS must be initialized before
+  *
+  * @param me : Pointer to a bsec2_state_t structure
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- An NVS error code otherwise
+  */
+esp_err_t bsec2_state_init(bsec2_state_t * const me);
+
+/**
+  * @brief Function to restore the saved state into BSEC
+  *
+  * @param me   : Pointer to a bsec2_state_t structure
+  * @param bsec : Pointer to an initialized bsec2_t structure
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_NVS_NOT_FOUND if no state was saved
+  * 	- ESP_FAIL if BSEC rejects the state
+  */
+esp_err_t bsec2_state_restore(bsec2_state_t * const me, bsec2_t *bsec);
+
+/**
+  * @brief Function to save the BSEC state if it is due
+  *
+  * @note It can be called after every bsec2_run(), the check alone doesn't
+  *       touch the flash
+  *
+  * @param me       : Pointer to a bsec2_state_t structure
+  * @param bsec     : Pointer to a bsec2_t structure
+  * @param accuracy : Current IAQ accuracy
+  *
+  * @retval
+  * 	- ESP_OK on success, saved or not
+  * 	- ESP_FAIL if BSEC can't serialize its state
+  * 	- An NVS error code otherwise
+  */
+esp_err_t bsec2_state_update(bsec2_state_t * const me, bsec2_t *bsec, uint8_t accuracy);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BSEC2_STATE_H_ */
+
+/***************************** END OF FILE ************************************/
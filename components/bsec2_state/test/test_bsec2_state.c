@@ -0,0 +1,281 @@
+/**
+  ******************************************************************************
+  * @file           : test_bsec2_state.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Host test of the BSEC state storage
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <sys/time.h>
+
+#include "host_test.h"
+#include "bsec2_state.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define RUN_PERIOD_S			3		/* BSEC low power rate */
+#define PERIOD_S				((int64_t)CONFIG_BSEC2_STATE_SAVE_PERIOD_MIN * 60)
+#define DAY_S					(24 * 60 * 60)
+#define WEEK_S					(7 * DAY_S)
+#define ACCURACY_STEP_S			(2 * 60 * 60)	/* Time to reach each accuracy */
+#define WRITES_PER_SAVE			2		/* State and metadata */
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static bsec2_t bsec;
+static uint8_t bsec_state[BSEC_MAX_STATE_BLOB_SIZE];	/* State held by BSEC */
+static bool bsec_reject;
+static bool bsec_get_fail;
+static int64_t rtc_time;
+
+/* Private function prototypes -----------------------------------------------*/
+static void rtc_set(int64_t s);
+static void bsec_learn(void);
+static void setup(void);
+static void test_first_boot(void);
+static void test_round_trip(void);
+static void test_write_budget(void);
+static void test_no_downgrade(void);
+static void test_rtc_reset(void);
+static void test_errors(void);
+
+/* Main ----------------------------------------------------------------------*/
+int main(void) {
+	RUN_TEST(test_first_boot);
+	RUN_TEST(test_round_trip);
+	RUN_TEST(test_write_budget);
+	RUN_TEST(test_no_downgrade);
+	RUN_TEST(test_rtc_reset);
+	RUN_TEST(test_errors);
+
+	return 0;
+}
+
+/* Fake BSEC state functions -------------------------------------------------*/
+bool bsec2_get_state(bsec2_t *me, uint8_t *state) {
+	if (bsec_get_fail) {
+		return false;
+	}
+
+	memcpy(state, bsec_state, sizeof(bsec_state));
+
+	return true;
+}
+
+bool bsec2_set_state(bsec2_t *me, uint8_t *state) {
+	if (bsec_reject) {
+		return false;
+	}
+
+	memcpy(bsec_state, state, sizeof(bsec_state));
+
+	return true;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static void rtc_set(int64_t s) {
+	struct timeval tv = {.tv_sec = s};
+
+	rtc_time = s;
+	settimeofday(&tv, NULL);
+}
+
+/* The state changes on every run */
+static void bsec_learn(void) {
+	for (uint32_t i = 0; i < sizeof(bsec_state); i++) {
+		bsec_state[i] = rand();
+	}
+}
+
+static void setup(void) {
+	host_nvs_erase();
+	bsec_reject = false;
+	bsec_get_fail = false;
+	rtc_set(1000);
+	bsec_learn();
+}
+
+/* Nothing to restore on a blank flash, and nothing saved while the state
+ * doesn't improve within the period */
+static void test_first_boot(void) {
+	bsec2_state_t state;
+
+	setup();
+
+	TEST_ASSERT_EQUAL(ESP_OK, bsec2_state_init(&state));
+	TEST_ASSERT_EQUAL(ESP_ERR_NVS_NOT_FOUND, bsec2_state_restore(&state, &bsec));
+	TEST_ASSERT_EQUAL(0, state.saved_accuracy);
+
+	rtc_set(rtc_time + PERIOD_S - 1);
+	TEST_ASSERT_EQUAL(ESP_OK, bsec2_state_update(&state, &bsec, 0));
+	TEST_ASSERT_EQUAL(0, host_nvs_writes());
+}
+
+/* The saved state, its accuracy and time come back after a reboot */
+static void test_round_trip(void) {
+	bsec2_state_t state;
+	bsec2_state_t rebooted;
+	uint8_t saved[sizeof(bsec_state)];
+
+	setup();
+
+	TEST_ASSERT_EQUAL(ESP_OK, bsec2_state_init(&state));
+	TEST_ASSERT_EQUAL(ESP_OK, bsec2_state_update(&state, &bsec, 2));
+	TEST_ASSERT_EQUAL(1, state.saves);
+	memcpy(saved, bsec_state, sizeof(saved));
+
+	/* BSEC starts over on the reboot */
+	bsec_learn();
+	rtc_set(rtc_time + 60);
+
+	TEST_ASSERT_EQUAL(ESP_OK, bsec2_state_init(&rebooted));
+	TEST_ASSERT_EQUAL(ESP_OK, bsec2_state_restore(&rebooted, &bsec));
+	TEST_ASSERT(memcmp(saved, bsec_state, sizeof(saved)) == 0);
+	TEST_ASSERT_EQUAL(2, rebooted.saved_accuracy);
+	TEST_ASSERT_EQUAL(state.saved_time, rebooted.saved_time);
+	TEST_ASSERT_EQUAL(0, rebooted.saves);
+
+	/* Rejected by a BSEC of another version */
+	bsec_reject = true;
+	TEST_ASSERT_EQUAL(ESP_FAIL, bsec2_state_restore(&rebooted, &bsec));
+}
+
+/* A week at the low power rate, learning for six hours and then wavering
+ * between accuracy 2 and 3, saves once per period plus the improvements */
+static void test_write_budget(void) {
+	bsec2_state_t state;
+	uint8_t last_save[sizeof(bsec_state)];
+	int64_t start;
+
+	setup();
+	start = rtc_time;
+
+	TEST_ASSERT_EQUAL(ESP_OK, bsec2_state_init(&state));
+
+	for (int64_t t = 0; t < WEEK_S; t += RUN_PERIOD_S) {
+		uint8_t accuracy = t < 3 * ACCURACY_STEP_S ? t / ACCURACY_STEP_S : (rand() % 10 ? 3 : 2);
+		uint32_t saves = state.saves;
+
+		rtc_set(start + t);
+		bsec_learn();
+		TEST_ASSERT_EQUAL(ESP_OK, bsec2_state_update(&state, &bsec, accuracy));
+
+		if (state.saves != saves) {
+			memcpy(last_save, bsec_state, sizeof(last_save));
+		}
+	}
+
+	uint32_t periods = (WEEK_S - 3 * ACCURACY_STEP_S) / PERIOD_S;
+
+	printf("%" PRIu32 " saves in a week, %" PRIu32 " periods\n", state.saves, periods);
+
+	TEST_ASSERT(state.saves <= periods + 3);
+	TEST_ASSERT(state.saves >= periods);
+	TEST_ASSERT_EQUAL(state.saves * WRITES_PER_SAVE, host_nvs_writes());
+
+	/* The last save is the one restored */
+	bsec2_state_t rebooted;
+
+	TEST_ASSERT_EQUAL(ESP_OK, bsec2_state_init(&rebooted));
+	TEST_ASSERT_EQUAL(ESP_OK, bsec2_state_restore(&rebooted, &bsec));
+	TEST_ASSERT(memcmp(last_save, bsec_state, sizeof(last_save)) == 0);
+	TEST_ASSERT_EQUAL(3, rebooted.saved_accuracy);
+}
+
+/* A calibrated state isn't replaced by a worse one */
+static void test_no_downgrade(void) {
+	bsec2_state_t state;
+
+	setup();
+
+	TEST_ASSERT_EQUAL(ESP_OK, bsec2_state_init(&state));
+	TEST_ASSERT_EQUAL(ESP_OK, bsec2_state_update(&state, &bsec, 3));
+	TEST_ASSERT_EQUAL(1, state.saves);
+
+	rtc_set(rtc_time + 2 * PERIOD_S);
+	TEST_ASSERT_EQUAL(ESP_OK, bsec2_state_update(&state, &bsec, 2));
+	TEST_ASSERT_EQUAL(1, state.saves);
+	TEST_ASSERT_EQUAL(3, state.saved_accuracy);
+
+	TEST_ASSERT_EQUAL(ESP_OK, bsec2_state_update(&state, &bsec, 3));
+	TEST_ASSERT_EQUAL(2, state.saves);
+}
+
+/* After a power loss the RTC starts over, the next save waits a period
+ * from then instead of never coming */
+static void test_rtc_reset(void) {
+	bsec2_state_t state;
+
+	setup();
+	rtc_set(10 * PERIOD_S);
+
+	TEST_ASSERT_EQUAL(ESP_OK, bsec2_state_init(&state));
+	TEST_ASSERT_EQUAL(ESP_OK, bsec2_state_update(&state, &bsec, 3));
+
+	rtc_set(0);
+	TEST_ASSERT_EQUAL(ESP_OK, bsec2_state_update(&state, &bsec, 3));
+	TEST_ASSERT_EQUAL(1, state.saves);
+
+	rtc_set(PERIOD_S - 1);
+	TEST_ASSERT_EQUAL(ESP_OK, bsec2_state_update(&state, &bsec, 3));
+	TEST_ASSERT_EQUAL(1, state.saves);
+
+	rtc_set(PERIOD_S);
+	TEST_ASSERT_EQUAL(ESP_OK, bsec2_state_update(&state, &bsec, 3));
+	TEST_ASSERT_EQUAL(2, state.saves);
+}
+
+/* A failed save is retried on the next update */
+static void test_errors(void) {
+	bsec2_state_t state;
+
+	setup();
+
+	TEST_ASSERT_EQUAL(ESP_OK, bsec2_state_init(&state));
+
+	host_nvs_write_error(ESP_ERR_NVS_NOT_ENOUGH_SPACE);
+	TEST_ASSERT_EQUAL(ESP_ERR_NVS_NOT_ENOUGH_SPACE, bsec2_state_update(&state, &bsec, 3));
+	TEST_ASSERT_EQUAL(0, state.saves);
+	TEST_ASSERT_EQUAL(0, state.saved_accuracy);
+
+	host_nvs_write_error(ESP_OK);
+	bsec_get_fail = true;
+	TEST_ASSERT_EQUAL(ESP_FAIL, bsec2_state_update(&state, &bsec, 3));
+	TEST_ASSERT_EQUAL(0, state.saves);
+
+	bsec_get_fail = false;
+	TEST_ASSERT_EQUAL(ESP_OK, bsec2_state_update(&state, &bsec, 3));
+	TEST_ASSERT_EQUAL(1, state.saves);
+}
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,181 @@
+/**
+  ******************************************************************************
+  * @file           : cycle_trace.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Cycle count tracing of hot path sections
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <stdatomic.h>
+
+#include "cycle_trace.h"
+#include "esp_attr.h"
+#include "esp_cpu.h"
+#include "esp_timer.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+/* Private macro -------------------------------------------------------------*/
+#ifdef CONFIG_CYCLE_TRACE_ENABLE
+#define RING_SIZE	CONFIG_CYCLE_TRACE_RING_SIZE
+#define RING_MASK	(RING_SIZE - 1)
+
+/* Room for the tasks created while the task list is allocated */
+#define TASKS_MARGIN	4
+#endif
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+#ifdef CONFIG_CYCLE_TRACE_ENABLE
+typedef struct {
+	uint32_t time_us;			/* esp_timer time, it keeps counting in light sleep */
+	uint32_t ccount;			/* CPU cycles, the rate follows the CPU frequency */
+	TaskHandle_t task;			/* NULL in an ISR */
+	const char *name;
+	uint8_t phase;
+} event_t;
+
+typedef struct {
+	atomic_uint head;			/* Next position claimed by a recorder */
+	uint32_t tail;				/* First position not dumped yet */
+	event_t events[RING_SIZE];
+} ring_t;
+#endif
+
+/* Private variables ---------------------------------------------------------*/
+#ifdef CONFIG_CYCLE_TRACE_ENABLE
+_Static_assert((RING_SIZE & RING_MASK) == 0, "CONFIG_CYCLE_TRACE_RING_SIZE must be a power of two");
+
+/* A core only writes to its own ring, the recorders never wait */
+static ring_t rings[portNUM_PROCESSORS];
+static atomic_bool paused;
+#endif
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief Function to record an event in the ring buffer of the current
+  *        core
+  */
+void IRAM_ATTR cycle_trace_record(const char *name, cycle_trace_phase_e phase) {
+#ifdef CONFIG_CYCLE_TRACE_ENABLE
+	/* First, the cost of the recording isn't counted in the section */
+	uint32_t ccount = esp_cpu_get_cycle_count();
+
+	if (atomic_load_explicit(&paused, memory_order_relaxed)) {
+		return;
+	}
+
+	ring_t *ring = &rings[esp_cpu_get_core_id()];
+	uint32_t pos = atomic_fetch_add_explicit(&ring->head, 1, memory_order_relaxed);
+	event_t *event = &ring->events[pos & RING_MASK];
+
+	event->time_us = (uint32_t)esp_timer_get_time();
+	event->ccount = ccount;
+	event->task = xPortInIsrContext() ? NULL : xTaskGetCurrentTaskHandle();
+	event->name = name;
+	event->phase = phase;
+#endif
+}
+
+/**
+  * @brief Function to print the events of every core on the console
+  */
+esp_err_t cycle_trace_dump(void) {
+#ifdef CONFIG_CYCLE_TRACE_ENABLE
+	UBaseType_t tasks_num = uxTaskGetNumberOfTasks() + TASKS_MARGIN;
+	TaskStatus_t *tasks = malloc(tasks_num * sizeof(TaskStatus_t));
+
+	if (tasks == NULL) {
+		return ESP_ERR_NO_MEM;
+	}
+
+	/* The names are only read from the running tasks, the handles of the
+	 * events may belong to deleted ones */
+	tasks_num = uxTaskGetSystemState(tasks, tasks_num, NULL);
+
+	atomic_store(&paused, true);
+
+	uint32_t heads[portNUM_PROCESSORS];
+	uint32_t lost = 0;
+
+	for (uint8_t i = 0; i < portNUM_PROCESSORS; i++) {
+		ring_t *ring = &rings[i];
+
+		heads[i] = atomic_load(&ring->head);
+
+		/* The oldest events were overwritten */
+		if (heads[i] - ring->tail > RING_SIZE) {
+			lost += heads[i] - ring->tail - RING_SIZE;
+			ring->tail = heads[i] - RING_SIZE;
+		}
+	}
+
+	printf("CT:H,%d,%" PRIu32 "\r\n", portNUM_PROCESSORS, lost);
+
+	for (UBaseType_t i = 0; i < tasks_num; i++) {
+		printf("CT:T,%08" PRIx32 ",%s\r\n", (uint32_t)(uintptr_t)tasks[i].xHandle, tasks[i].pcTaskName);
+	}
+
+	free(tasks);
+
+	for (uint8_t i = 0; i < portNUM_PROCESSORS; i++) {
+		ring_t *ring = &rings[i];
+
+		for (uint32_t pos = ring->tail; pos != heads[i]; pos++) {
+			const event_t *event = &ring->events[pos & RING_MASK];
+
+			printf("CT:E,%u,%" PRIu32 ",%" PRIu32 ",%c,%08" PRIx32 ",%s\r\n", i, event->time_us, event->ccount,
+					event->phase == CYCLE_TRACE_BEGIN_PHASE ? 'B' : 'E', (uint32_t)(uintptr_t)event->task, event->name);
+		}
+
+		ring->tail = heads[i];
+	}
+
+	printf("CT:F\r\n");
+
+	atomic_store(&paused, false);
+
+	return ESP_OK;
+#else
+	return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,105 @@
+/**
+  ******************************************************************************
+  * @file           : cycle_trace.h
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Cycle count tracing of hot path sections
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef CYCLE_TRACE_H_
+#define CYCLE_TRACE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+/* Exported macro ------------------------------------------------------------*/
+#ifdef CONFIG_CYCLE_TRACE_ENABLE
+/* The name is recorded as a pointer, it must be a string literal. A section
+ * ends in the task it began in */
+#define CYCLE_TRACE_BEGIN(name)	cycle_trace_record((name), CYCLE_TRACE_BEGIN_PHASE)
+#define CYCLE_TRACE_END(name)	cycle_trace_record((name), CYCLE_TRACE_END_PHASE)
+#else
+#define CYCLE_TRACE_BEGIN(name)	do { } while (0)
+#define CYCLE_TRACE_END(name)	do { } while (0)
+#endif /* CONFIG_CYCLE_TRACE_ENABLE */
+
+/* Exported typedef ----------------------------------------------------------*/
+typedef enum {
+	CYCLE_TRACE_BEGIN_PHASE = 0,
+	CYCLE_TRACE_END_PHASE,
+} cycle_trace_phase_e;
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions prototypes ---------------------------------------------*/
+/**
+  * @brief Function to record an event in the ring buffer of the current
+  *        core, used by the CYCLE_TRACE_x macros
+  *
+  * @note It doesn't block and it is in IRAM, it can be called from an ISR
+  *
+  * @param name  : Section name, not copied
+  * @param phase : Begin or end of the section
+  */
+void cycle_trace_record(const char *name, cycle_trace_phase_e phase);
+
+/**
+  * @brief Function to print the events of every core on the console, oldest
+  *        first, for tools/cycle_trace_json.py:
+  *        - CT:H,<cores>,<events overwritten>
+  *        - CT:T,<task handle>,<task name> per running task
+  *        - CT:E,<core>,<time us>,<cycle count>,<B|E>,<task handle>,<name>
+  *          per event, the handle is 0 in an ISR
+  *        - CT:F at the end
+  *
+  * @note The recording is paused while the events are printed, the ring
+  *       buffers are emptied
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_NOT_SUPPORTED if CONFIG_CYCLE_TRACE_ENABLE is not set
+  * 	- ESP_ERR_NO_MEM if the task list can't be allocated
+  */
+esp_err_t cycle_trace_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CYCLE_TRACE_H_ */
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,302 @@
+/**
+  ******************************************************************************
+  * @file           : test_cycle_trace.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Host test of the cycle trace ring wrap and JSON converter
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "host_test.h"
+#include "cycle_trace.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define RING_SIZE				CONFIG_CYCLE_TRACE_RING_SIZE
+#define CAPTURE_PATH			"cycle_trace_capture.txt"
+#define JSON_PATH				"cycle_trace.json"
+
+/* Section k lasts k + 1 s, the cycle counter wraps every 27 s in between */
+#define WRAP_SECTIONS			20
+#define SECTION_US				1000000
+#define SECTION_SLACK_US		500000
+
+/* Events recorded: the outer section around the others */
+#define WRAP_EVENTS				(2 * WRAP_SECTIONS + 2)
+#define WRAP_LOST				(WRAP_EVENTS - RING_SIZE)
+
+/* The ring keeps the end of the section cut in half, the next ones whole
+ * and the end of the outer one */
+#define WRAP_FIRST_WHOLE		(WRAP_SECTIONS - (RING_SIZE - 2) / 2)
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+	uint32_t lost;
+	uint32_t events;
+	char first[64];				/* Phase and name of the oldest event */
+} capture_t;
+
+typedef struct {
+	uint32_t sections;
+	uint32_t unmatched;
+	uint32_t lost;
+} summary_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const char *names[WRAP_SECTIONS] = {
+		"s0", "s1", "s2", "s3", "s4", "s5", "s6", "s7", "s8", "s9",
+		"s10", "s11", "s12", "s13", "s14", "s15", "s16", "s17", "s18", "s19",
+};
+
+static char json[32768];
+
+/* Private function prototypes -----------------------------------------------*/
+static void section_record(const char *name, int64_t us);
+static void dump_capture(capture_t *capture);
+static void json_convert(summary_t *summary);
+static bool json_section(const char *name, int64_t *dur, int64_t *cycles);
+static void test_wrap(void);
+static void test_after_dump(void);
+
+/* Main ----------------------------------------------------------------------*/
+int main(void) {
+	RUN_TEST(test_wrap);
+	RUN_TEST(test_after_dump);
+
+	return 0;
+}
+
+/* Fake scheduler ------------------------------------------------------------*/
+/* The test thread is the only task with a name in the dump */
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *status_array, UBaseType_t array_size, uint32_t *total_run_time) {
+	status_array[0] = (TaskStatus_t) {
+			.xHandle = xTaskGetCurrentTaskHandle(),
+			.pcTaskName = "main",
+	};
+
+	return 1;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static void section_record(const char *name, int64_t us) {
+	CYCLE_TRACE_BEGIN(name);
+	host_time_advance(us);
+	CYCLE_TRACE_END(name);
+}
+
+/* Runs cycle_trace_dump() with the console in a file, and reads its header
+ * and events back */
+static void dump_capture(capture_t *capture) {
+	fflush(stdout);
+
+	int console = dup(STDOUT_FILENO);
+	int fd = open(CAPTURE_PATH, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+	TEST_ASSERT(console >= 0 && fd >= 0);
+	dup2(fd, STDOUT_FILENO);
+	close(fd);
+
+	esp_err_t ret = cycle_trace_dump();
+
+	fflush(stdout);
+	dup2(console, STDOUT_FILENO);
+	close(console);
+
+	TEST_ASSERT_EQUAL(ESP_OK, ret);
+
+	FILE *file = fopen(CAPTURE_PATH, "r");
+	char line[128];
+	bool done = false;
+
+	TEST_ASSERT(file != NULL);
+	memset(capture, 0, sizeof(*capture));
+
+	while (fgets(line, sizeof(line), file) != NULL) {
+		char phase;
+		char name[32];
+
+		if (sscanf(line, "CT:H,1,%" SCNu32, &capture->lost) == 1) {
+			continue;
+		}
+
+		if (sscanf(line, "CT:E,0,%*u,%*u,%c,%*x,%31[^\r\n]", &phase, name) == 2) {
+			if (capture->events++ == 0) {
+				snprintf(capture->first, sizeof(capture->first), "%c %s", phase, name);
+			}
+
+			continue;
+		}
+
+		done |= strncmp(line, "CT:F", 4) == 0;
+	}
+
+	fclose(file);
+
+	TEST_ASSERT(done);
+}
+
+/* Runs tools/cycle_trace_json.py on the capture, and reads its summary */
+static void json_convert(summary_t *summary) {
+	FILE *pipe = popen(PYTHON3 " " CYCLE_TRACE_JSON " -o " JSON_PATH " " CAPTURE_PATH " 2>&1", "r");
+	char output[256];
+
+	TEST_ASSERT(pipe != NULL);
+
+	/* Read to the end, the converter fails on a closed pipe */
+	size_t len = fread(output, 1, sizeof(output) - 1, pipe);
+
+	output[len] = '\0';
+	TEST_ASSERT_EQUAL(0, pclose(pipe));
+	TEST_ASSERT_EQUAL(3, sscanf(output, "%" SCNu32 " sections converted, %" SCNu32 " unmatched, %" SCNu32,
+			&summary->sections, &summary->unmatched, &summary->lost));
+
+	FILE *file = fopen(JSON_PATH, "r");
+
+	TEST_ASSERT(file != NULL);
+
+	len = fread(json, 1, sizeof(json) - 1, file);
+
+	json[len] = '\0';
+	fclose(file);
+
+	TEST_ASSERT(len < sizeof(json) - 1);
+}
+
+/* Duration and cycles of the complete event of a section */
+static bool json_section(const char *name, int64_t *dur, int64_t *cycles) {
+	char key[64];
+
+	snprintf(key, sizeof(key), "{\"name\": \"%s\", \"ph\": \"X\"", name);
+
+	const char *event = strstr(json, key);
+
+	if (event == NULL) {
+		return false;
+	}
+
+	const char *field = strstr(event, "\"dur\": ");
+
+	TEST_ASSERT(field != NULL && sscanf(field, "\"dur\": %" SCNd64, dur) == 1);
+
+	field = strstr(event, "\"cycles\": ");
+
+	TEST_ASSERT(field != NULL && sscanf(field, "\"cycles\": %" SCNd64, cycles) == 1);
+
+	return true;
+}
+
+/* The ring keeps the newest events, the converter pairs the sections still
+ * whole and counts the ends left without their begin */
+static void test_wrap(void) {
+	capture_t capture;
+	summary_t summary;
+	int64_t dur;
+	int64_t cycles;
+
+	CYCLE_TRACE_BEGIN("outer");
+
+	for (uint32_t k = 0; k < WRAP_SECTIONS; k++) {
+		section_record(names[k], (int64_t)(k + 1) * SECTION_US);
+	}
+
+	CYCLE_TRACE_END("outer");
+
+	dump_capture(&capture);
+
+	TEST_ASSERT_EQUAL(WRAP_LOST, capture.lost);
+	TEST_ASSERT_EQUAL(RING_SIZE, capture.events);
+
+	char first[64];
+
+	snprintf(first, sizeof(first), "E %s", names[WRAP_FIRST_WHOLE - 1]);
+	TEST_ASSERT(strcmp(first, capture.first) == 0);
+
+	json_convert(&summary);
+
+	printf("%" PRIu32 " sections converted, %" PRIu32 " unmatched, %" PRIu32 " events overwritten\n",
+			summary.sections, summary.unmatched, summary.lost);
+
+	TEST_ASSERT_EQUAL(WRAP_SECTIONS - WRAP_FIRST_WHOLE, summary.sections);
+	TEST_ASSERT_EQUAL(2, summary.unmatched);
+	TEST_ASSERT_EQUAL(WRAP_LOST, summary.lost);
+
+	for (uint32_t k = 0; k < WRAP_SECTIONS; k++) {
+		bool whole = json_section(names[k], &dur, &cycles);
+
+		TEST_ASSERT_EQUAL(k >= WRAP_FIRST_WHOLE, whole);
+
+		if (!whole) {
+			continue;
+		}
+
+		/* The counter is read just before the time */
+		int64_t expected = (int64_t)(k + 1) * SECTION_US;
+
+		TEST_ASSERT(dur >= expected && dur < expected + SECTION_SLACK_US);
+		TEST_ASSERT(llabs(cycles - dur * CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ) < SECTION_SLACK_US * CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ);
+	}
+
+	TEST_ASSERT(!json_section("outer", &dur, &cycles));
+	TEST_ASSERT(strstr(json, "\"args\": {\"name\": \"main\"}") != NULL);
+}
+
+/* The dump empties the ring, the next one only has the newer events */
+static void test_after_dump(void) {
+	capture_t capture;
+	summary_t summary;
+	int64_t dur;
+	int64_t cycles;
+
+	section_record(names[0], SECTION_US);
+	section_record(names[1], SECTION_US);
+
+	dump_capture(&capture);
+
+	TEST_ASSERT_EQUAL(0, capture.lost);
+	TEST_ASSERT_EQUAL(4, capture.events);
+	TEST_ASSERT(strcmp("B s0", capture.first) == 0);
+
+	json_convert(&summary);
+
+	TEST_ASSERT_EQUAL(2, summary.sections);
+	TEST_ASSERT_EQUAL(0, summary.unmatched);
+	TEST_ASSERT_EQUAL(0, summary.lost);
+	TEST_ASSERT(json_section(names[0], &dur, &cycles));
+	TEST_ASSERT(json_section(names[1], &dur, &cycles));
+}
+
+/***************************** END OF FILE ************************************/
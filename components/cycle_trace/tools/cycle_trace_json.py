@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+# Convert a cycle_trace_dump() console capture to Chrome trace JSON, for
+# chrome://tracing or ui.perfetto.dev
+#
+# Usage:
+#   cycle_trace_json.py [-o OUTPUT] [INPUT]
+#
+# INPUT is a capture file or a serial port, stdin if omitted. The first
+# complete dump is converted, the other console output is skipped. Every
+# section is a complete event on the thread of its task, with the CPU cycles
+# it took in its arguments. The cycles include the ones of the tasks that
+# preempted it, the time includes light sleep.
+
+import argparse
+import json
+import sys
+
+CCOUNT_MASK = 0xFFFFFFFF
+TIME_WRAP = 1 << 32
+
+
+def open_input(path):
+    if path is None:
+        return sys.stdin.buffer
+
+    try:
+        import serial
+        return serial.Serial(path, 115200)
+    except (ImportError, ValueError, OSError):
+        return open(path, 'rb')
+
+
+def read_dump(stream):
+    lines = []
+
+    for raw in stream:
+        line = raw.decode('latin-1').rstrip('\r\n')
+
+        # The binary telemetry frames can precede a line
+        start = line.find('CT:')
+
+        if start < 0:
+            continue
+
+        line = line[start:]
+
+        if line.startswith('CT:H,'):
+            lines = [line]
+        elif lines:
+            lines.append(line)
+
+            if line == 'CT:F':
+                return lines
+
+    return None
+
+
+def convert(lines):
+    _, cores, lost = lines[0].split(',')
+    tasks = {'00000000': 'ISR'}
+    events = []
+    open_sections = {}
+    last_time = {}
+    offset = {}
+    unmatched = 0
+
+    for line in lines[1:-1]:
+        fields = line.split(',', 6)
+
+        if fields[0] == 'CT:T':
+            tasks[fields[1]] = fields[2]
+            continue
+
+        if fields[0] != 'CT:E' or len(fields) != 7:
+            continue
+
+        _, core, time_us, ccount, phase, task, name = fields
+        core = int(core)
+        time_us = int(time_us)
+
+        # The time is recorded in 32 bits, it wraps after 71 minutes
+        if time_us < last_time.get(core, 0):
+            offset[core] = offset.get(core, 0) + TIME_WRAP
+
+        last_time[core] = time_us
+        time_us += offset.get(core, 0)
+        key = (core, task, name)
+
+        if phase == 'B':
+            open_sections.setdefault(key, []).append((time_us, int(ccount)))
+            continue
+
+        # The begin of the oldest sections may have been overwritten
+        if not open_sections.get(key):
+            unmatched += 1
+            continue
+
+        begin_us, begin_ccount = open_sections[key].pop()
+        events.append({
+            'name': name,
+            'ph': 'X',
+            'ts': begin_us,
+            'dur': time_us - begin_us,
+            'pid': core,
+            'tid': int(task, 16),
+            'args': {'cycles': (int(ccount) - begin_ccount) & CCOUNT_MASK},
+        })
+
+    unmatched += sum(len(begins) for begins in open_sections.values())
+
+    # Thread names, the handles of deleted tasks are kept as they are
+    threads = {(event['pid'], event['tid']) for event in events}
+
+    for pid, tid in sorted(threads):
+        events.append({
+            'name': 'thread_name',
+            'ph': 'M',
+            'pid': pid,
+            'tid': tid,
+            'args': {'name': tasks.get(f'{tid:08x}', f'task {tid:08x}')},
+        })
+
+    for pid in range(int(cores)):
+        events.append({'name': 'process_name', 'ph': 'M', 'pid': pid, 'args': {'name': f'core {pid}'}})
+
+    return events, int(lost), unmatched
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a cycle trace dump to Chrome trace JSON")
+    parser.add_argument('input', nargs='?', help='capture file or serial port')
+    parser.add_argument('-o', '--output', help='JSON file, stdout if omitted')
+    args = parser.parse_args()
+
+    try:
+        lines = read_dump(open_input(args.input))
+    except KeyboardInterrupt:
+        lines = None
+
+    if lines is None:
+        print('No complete dump found', file=sys.stderr)
+        sys.exit(1)
+
+    events, lost, unmatched = convert(lines)
+    output = open(args.output, 'w') if args.output else sys.stdout
+    json.dump({'traceEvents': events, 'displayTimeUnit': 'ms'}, output)
+
+    sections = sum(1 for event in events if event['ph'] == 'X')
+    print(f'{sections} sections converted, {unmatched} unmatched, {lost} events overwritten', file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
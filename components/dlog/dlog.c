@@ -0,0 +1,252 @@
+/**
+  ******************************************************************************
+  * @file           : dlog.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Deferred logging through a lock-free ring buffer
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <inttypes.h>
+#include <stdatomic.h>
+
+#include "dlog.h"
+
+#include "freertos/task.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define RING_SIZE	CONFIG_DLOG_RING_SIZE
+#define RING_MASK	(RING_SIZE - 1)
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+/* Ring slot, seq + index is the position it expects next: pos while free
+ * for the producer claiming pos, pos + 1 once that message is written */
+typedef struct {
+	atomic_uint seq;
+	const char *format;
+	const char *tag;
+	uint32_t timestamp;
+	uint8_t level;
+	uint8_t args_num;
+	uint32_t args[DLOG_MAX_ARGS];
+} msg_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const char *TAG = "dlog";
+
+_Static_assert((RING_SIZE & RING_MASK) == 0, "CONFIG_DLOG_RING_SIZE must be a power of two");
+
+/* Zero initialized slots are free, messages can be recorded before
+ * dlog_init() */
+static msg_t ring[RING_SIZE];
+static atomic_uint tail;			/* Next position claimed by a producer */
+static uint32_t head;				/* Next position read by the log task */
+static atomic_uint printed;			/* Position up to which the messages are out */
+static atomic_uint dropped;			/* Since boot, never reset */
+static uint32_t dropped_reported;
+static TaskHandle_t task_handle;
+
+static const char level_letters[] = {'N', 'E', 'W', 'I', 'D', 'V'};
+static const char *level_colors[] = {"", LOG_COLOR_E, LOG_COLOR_W, LOG_COLOR_I, LOG_COLOR_D, LOG_COLOR_V};
+
+/* Private function prototypes -----------------------------------------------*/
+static void log_task(void *arg);
+static bool msg_read(msg_t *msg);
+static void msg_print(const msg_t *msg);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief Function to create the task formatting the deferred messages
+  */
+esp_err_t dlog_init(UBaseType_t priority) {
+	ESP_LOGI(TAG, "Initializing deferred log...");
+
+	if (xTaskCreate(log_task,
+			"dlog task",
+			CONFIG_DLOG_TASK_STACK_SIZE,
+			NULL,
+			priority,
+			&task_handle) != pdPASS) {
+		ESP_LOGE(TAG, "Failed to create the log task");
+		return ESP_ERR_NO_MEM;
+	}
+
+	return ESP_OK;
+}
+
+/**
+  * @brief Function to record a message, used by the DLOGx macros
+  */
+void dlog_write(esp_log_level_t level, const char *tag, const char *format, uint8_t args_num, const uint32_t *args) {
+	uint32_t pos = atomic_load_explicit(&tail, memory_order_relaxed);
+	msg_t *msg;
+
+	/* Claim a free slot, bounded MPMC queue with per slot sequences */
+	for (;;) {
+		msg = &ring[pos & RING_MASK];
+
+		int32_t diff = (int32_t)(atomic_load_explicit(&msg->seq, memory_order_acquire) + (pos & RING_MASK) - pos);
+
+		if (diff == 0) {
+			if (atomic_compare_exchange_weak_explicit(&tail, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed)) {
+				break;
+			}
+		}
+		else if (diff < 0) {
+			/* Full, the log task is a lap behind */
+			atomic_fetch_add_explicit(&dropped, 1, memory_order_relaxed);
+			return;
+		}
+		else {
+			pos = atomic_load_explicit(&tail, memory_order_relaxed);
+		}
+	}
+
+	msg->format = format;
+	msg->tag = tag;
+	msg->timestamp = esp_log_timestamp();
+	msg->level = level;
+	msg->args_num = args_num > DLOG_MAX_ARGS ? DLOG_MAX_ARGS : args_num;
+
+	for (uint8_t i = 0; i < msg->args_num; i++) {
+		msg->args[i] = args[i];
+	}
+
+	atomic_store_explicit(&msg->seq, pos + 1 - (pos & RING_MASK), memory_order_release);
+
+	if (task_handle == NULL) {
+		return;
+	}
+
+	/* The notification count keeps the wakeups given while the task is busy */
+	if (xPortInIsrContext()) {
+		vTaskNotifyGiveFromISR(task_handle, NULL);
+	}
+	else {
+		xTaskNotifyGive(task_handle);
+	}
+}
+
+/**
+  * @brief Function to get the number of messages dropped because the ring
+  *        buffer was full
+  */
+uint32_t dlog_get_dropped(void) {
+	return atomic_load_explicit(&dropped, memory_order_relaxed);
+}
+
+/**
+  * @brief Function to wait for the log task to print the messages recorded
+  */
+esp_err_t dlog_flush(TickType_t timeout) {
+	TickType_t start = xTaskGetTickCount();
+
+	/* The log task runs at a low priority, give it the CPU until it catches
+	 * up */
+	while (atomic_load_explicit(&printed, memory_order_relaxed) != atomic_load_explicit(&tail, memory_order_relaxed)) {
+		if (task_handle == NULL || xTaskGetTickCount() - start >= timeout) {
+			return ESP_ERR_TIMEOUT;
+		}
+
+		vTaskDelay(1);
+	}
+
+	return ESP_OK;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static void log_task(void *arg) {
+	msg_t msg;
+
+	/* Drain first, the messages recorded before the task was created didn't
+	 * notify it */
+	for (;;) {
+		while (msg_read(&msg)) {
+			msg_print(&msg);
+			atomic_store_explicit(&printed, head, memory_order_relaxed);
+		}
+
+		uint32_t lost = atomic_load_explicit(&dropped, memory_order_relaxed) - dropped_reported;
+
+		if (lost) {
+			dropped_reported += lost;
+			ESP_LOGW(TAG, "%" PRIu32 " messages dropped", lost);
+		}
+
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+	}
+}
+
+static bool msg_read(msg_t *msg) {
+	msg_t *slot = &ring[head & RING_MASK];
+	uint32_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire) + (head & RING_MASK);
+
+	if (seq != head + 1) {
+		return false;
+	}
+
+	msg->format = slot->format;
+	msg->tag = slot->tag;
+	msg->timestamp = slot->timestamp;
+	msg->level = slot->level;
+	msg->args_num = slot->args_num;
+
+	for (uint8_t i = 0; i < slot->args_num; i++) {
+		msg->args[i] = slot->args[i];
+	}
+
+	/* Free the slot for the producer a lap ahead */
+	atomic_store_explicit(&slot->seq, head + RING_SIZE - (head & RING_MASK), memory_order_release);
+	head++;
+
+	return true;
+}
+
+static void msg_print(const msg_t *msg) {
+	char line[CONFIG_DLOG_LINE_SIZE];
+	uint8_t level = msg->level <= ESP_LOG_VERBOSE ? msg->level : ESP_LOG_VERBOSE;
+
+	/* Same layout as ESP_LOGx, with the time the message was recorded */
+	int len = snprintf(line, sizeof(line), "%s%c (%" PRIu32 ") %s: ",
+			level_colors[level], level_letters[level], msg->timestamp, msg->tag);
+
+	if (len > 0 && len < (int)sizeof(line)) {
+		/* The unused arguments are ignored by the format */
+		snprintf(&line[len], sizeof(line) - len, msg->format,
+				msg->args[0], msg->args[1], msg->args[2], msg->args[3], msg->args[4], msg->args[5]);
+	}
+
+	esp_log_write(level, msg->tag, "%s" LOG_RESET_COLOR "\n", line);
+}
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,162 @@
+/**
+  ******************************************************************************
+  * @file           : dlog.h
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Deferred logging through a lock-free ring buffer
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef DLOG_H_
+#define DLOG_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+#include "freertos/FreeRTOS.h"
+
+/* Exported macro ------------------------------------------------------------*/
+#define DLOG_MAX_ARGS	6
+
+#ifdef CONFIG_DLOG_ENABLE
+/* Arguments are recorded as 32 bits words, the types that don't fit fail to
+ * link instead of being truncated */
+#define DLOG_ARG(x)	_Generic((x), \
+		float: dlog_arg_not_supported(), \
+		double: dlog_arg_not_supported(), \
+		long long: dlog_arg_not_supported(), \
+		unsigned long long: dlog_arg_not_supported(), \
+		default: (uint32_t)(uintptr_t)(x))
+
+#define DLOG_ARGS_1(a)		DLOG_ARG(a)
+#define DLOG_ARGS_2(a, ...)	DLOG_ARG(a), DLOG_ARGS_1(__VA_ARGS__)
+#define DLOG_ARGS_3(a, ...)	DLOG_ARG(a), DLOG_ARGS_2(__VA_ARGS__)
+#define DLOG_ARGS_4(a, ...)	DLOG_ARG(a), DLOG_ARGS_3(__VA_ARGS__)
+#define DLOG_ARGS_5(a, ...)	DLOG_ARG(a), DLOG_ARGS_4(__VA_ARGS__)
+#define DLOG_ARGS_6(a, ...)	DLOG_ARG(a), DLOG_ARGS_5(__VA_ARGS__)
+#define DLOG_ARGS_SELECT(_1, _2, _3, _4, _5, _6, name, ...)	name
+#define DLOG_ARGS(...)		DLOG_ARGS_SELECT(__VA_ARGS__, DLOG_ARGS_6, DLOG_ARGS_5, DLOG_ARGS_4, \
+								DLOG_ARGS_3, DLOG_ARGS_2, DLOG_ARGS_1, )(__VA_ARGS__)
+
+/* The format is checked against the arguments as with ESP_LOGx, the check is
+ * never run. String arguments are recorded as pointers and must outlive the
+ * message */
+#define DLOG_LEVEL(level, tag, format, ...) do { \
+		if (LOG_LOCAL_LEVEL >= (level)) { \
+			const uint32_t dlog_args[] = {0 __VA_OPT__(, DLOG_ARGS(__VA_ARGS__))}; \
+			dlog_write((level), (tag), (format), sizeof(dlog_args) / sizeof(dlog_args[0]) - 1, &dlog_args[1]); \
+			if (0) { \
+				esp_log_write((level), (tag), (format), ##__VA_ARGS__); \
+			} \
+		} \
+	} while (0)
+
+#define DLOGE(tag, format, ...)	DLOG_LEVEL(ESP_LOG_ERROR, tag, format, ##__VA_ARGS__)
+#define DLOGW(tag, format, ...)	DLOG_LEVEL(ESP_LOG_WARN, tag, format, ##__VA_ARGS__)
+#define DLOGI(tag, format, ...)	DLOG_LEVEL(ESP_LOG_INFO, tag, format, ##__VA_ARGS__)
+#define DLOGD(tag, format, ...)	DLOG_LEVEL(ESP_LOG_DEBUG, tag, format, ##__VA_ARGS__)
+#define DLOGV(tag, format, ...)	DLOG_LEVEL(ESP_LOG_VERBOSE, tag, format, ##__VA_ARGS__)
+#else
+#define DLOGE(tag, format, ...)	ESP_LOGE(tag, format, ##__VA_ARGS__)
+#define DLOGW(tag, format, ...)	ESP_LOGW(tag, format, ##__VA_ARGS__)
+#define DLOGI(tag, format, ...)	ESP_LOGI(tag, format, ##__VA_ARGS__)
+#define DLOGD(tag, format, ...)	ESP_LOGD(tag, format, ##__VA_ARGS__)
+#define DLOGV(tag, format, ...)	ESP_LOGV(tag, format, ##__VA_ARGS__)
+#endif /* CONFIG_DLOG_ENABLE */
+
+/* Exported typedef ----------------------------------------------------------*/
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions prototypes ---------------------------------------------*/
+/**
+  * @brief Function to create the task formatting the deferred messages
+  *
+  * @note The messages recorded before are kept
+  *
+  * @param priority : Priority of the log task, it should be low
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_NO_MEM if the task can't be created
+  */
+esp_err_t dlog_init(UBaseType_t priority);
+
+/**
+  * @brief Function to record a message, used by the DLOGx macros
+  *
+  * @note It doesn't block and can be called from an ISR
+  *
+  * @param level    : Log level
+  * @param tag      : Tag, not copied
+  * @param format   : Format string, not copied
+  * @param args_num : Number of arguments, DLOG_MAX_ARGS at most
+  * @param args     : Arguments as 32 bits words
+  */
+void dlog_write(esp_log_level_t level, const char *tag, const char *format, uint8_t args_num, const uint32_t *args);
+
+/**
+  * @brief Function to get the number of messages dropped because the ring
+  *        buffer was full
+  *
+  * @retval Messages dropped since boot
+  */
+uint32_t dlog_get_dropped(void);
+
+/**
+  * @brief Function to wait for the log task to print the messages recorded,
+  *        before a deep sleep or a restart
+  *
+  * @param timeout : Ticks to wait
+  *
+  * @retval
+  * 	- ESP_OK if every message was printed
+  * 	- ESP_ERR_TIMEOUT otherwise, or if the log task isn't created
+  */
+esp_err_t dlog_flush(TickType_t timeout);
+
+/* Not defined, referenced by DLOG_ARG() for the unsupported types */
+uint32_t dlog_arg_not_supported(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DLOG_H_ */
+
+/***************************** END OF FILE ************************************/
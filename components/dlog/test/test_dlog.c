@@ -0,0 +1,360 @@
+/**
+  ******************************************************************************
+  * @file           : test_dlog.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Host test of the deferred logger
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "host_test.h"
+#include "dlog.h"
+
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define LOG_PRIORITY			1
+#define FLUSH_TICKS				pdMS_TO_TICKS(5000)
+#define LINES_NUM				8
+#define STRESS_TASKS			4
+#define STRESS_MESSAGES			20000
+#define LATENCY_MESSAGES		20000
+#define LATENCY_BATCH			(CONFIG_DLOG_RING_SIZE / 2)	/* Fit the ring */
+#define LATENCY_P99_NS_MAX		50000	/* On the host */
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static const char *TAG = "test";
+static const char *STRESS_TAG = "stress";
+static const char *LATENCY_TAG = "latency";	/* Not kept by the hook */
+static uint32_t latencies[LATENCY_MESSAGES];
+
+/* Lines printed by the log task. The pointers in the arguments are 32 bits
+ * on the target only, the messages of the host test take integers */
+static pthread_mutex_t lines_lock = PTHREAD_MUTEX_INITIALIZER;
+static char lines[LINES_NUM][CONFIG_DLOG_LINE_SIZE + 8];
+static uint32_t lines_num;
+static uint32_t dropped_reported;
+
+/* Stress messages seen, the next expected from each task */
+static uint32_t stress_printed;
+static uint32_t stress_next[STRESS_TASKS];
+static uint32_t stress_unordered;
+
+static atomic_bool hold;
+static SemaphoreHandle_t held;
+static SemaphoreHandle_t release;
+static SemaphoreHandle_t finished;
+
+/* Private function prototypes -----------------------------------------------*/
+static void log_hook(esp_log_level_t level, const char *tag, const char *line);
+static void lines_reset(void);
+static uint32_t reported_wait(uint32_t expected);
+static void stress_task(void *arg);
+static int64_t time_ns(void);
+static int latency_compare(const void *a, const void *b);
+static uint32_t latency_print(const char *name, uint32_t *ns, uint32_t n);
+static void test_before_init(void);
+static void test_format(void);
+static void test_truncation(void);
+static void test_dropped(void);
+static void test_stress(void);
+static void test_latency(void);
+
+/* Main ----------------------------------------------------------------------*/
+int main(void) {
+	held = xSemaphoreCreateBinary();
+	release = xSemaphoreCreateBinary();
+	finished = xSemaphoreCreateCounting(STRESS_TASKS, 0);
+	host_log_set_hook(log_hook);
+
+	RUN_TEST(test_before_init);
+	RUN_TEST(test_format);
+	RUN_TEST(test_truncation);
+	RUN_TEST(test_dropped);
+	RUN_TEST(test_stress);
+	RUN_TEST(test_latency);
+
+	return 0;
+}
+
+/* Private functions ---------------------------------------------------------*/
+/* Runs on the log task, which can be held in it */
+static void log_hook(esp_log_level_t level, const char *tag, const char *line) {
+	pthread_mutex_lock(&lines_lock);
+
+	if (strcmp(tag, STRESS_TAG) == 0) {
+		uint32_t task;
+		uint32_t i;
+
+		if (sscanf(strchr(line, ':') + 1, "%" SCNu32 " %" SCNu32, &task, &i) == 2 && task < STRESS_TASKS) {
+			stress_unordered += i < stress_next[task];
+			stress_next[task] = i + 1;
+			stress_printed++;
+		}
+	}
+	else if (strcmp(tag, "dlog") == 0) {
+		uint32_t lost;
+
+		if (sscanf(strstr(line, "dlog: ") + 6, "%" SCNu32, &lost) == 1) {
+			dropped_reported += lost;
+		}
+	}
+	else if (strcmp(tag, TAG) == 0 && lines_num < LINES_NUM) {
+		snprintf(lines[lines_num++], sizeof(lines[0]), "%s", line);
+	}
+
+	pthread_mutex_unlock(&lines_lock);
+
+	if (atomic_load(&hold)) {
+		xSemaphoreGive(held);
+		xSemaphoreTake(release, portMAX_DELAY);
+	}
+}
+
+static void lines_reset(void) {
+	pthread_mutex_lock(&lines_lock);
+	lines_num = 0;
+	pthread_mutex_unlock(&lines_lock);
+}
+
+/* The drops are reported after the messages that made it */
+static uint32_t reported_wait(uint32_t expected) {
+	uint32_t reported = 0;
+
+	for (TickType_t i = 0; i < FLUSH_TICKS; i++) {
+		pthread_mutex_lock(&lines_lock);
+		reported = dropped_reported;
+		pthread_mutex_unlock(&lines_lock);
+
+		if (reported == expected) {
+			break;
+		}
+
+		vTaskDelay(1);
+	}
+
+	return reported;
+}
+
+static void stress_task(void *arg) {
+	uint32_t task = (uint32_t)(uintptr_t)arg;
+
+	for (uint32_t i = 0; i < STRESS_MESSAGES; i++) {
+		DLOGW(STRESS_TAG, "%" PRIu32 " %" PRIu32, task, i);
+
+		if (i % 64 == 0) {
+			taskYIELD();
+		}
+	}
+
+	xSemaphoreGive(finished);
+	vTaskDelete(NULL);
+}
+
+static int64_t time_ns(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static int latency_compare(const void *a, const void *b) {
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+/* Sorts the latencies, prints their distribution and returns the p99 */
+static uint32_t latency_print(const char *name, uint32_t *ns, uint32_t n) {
+	qsort(ns, n, sizeof(ns[0]), latency_compare);
+
+	printf("%s: p50 %" PRIu32 " ns, p90 %" PRIu32 " ns, p99 %" PRIu32 " ns, max %" PRIu32 " ns\n",
+			name, ns[n / 2], ns[n * 9 / 10], ns[n * 99 / 100], ns[n - 1]);
+
+	return ns[n * 99 / 100];
+}
+
+/* The messages recorded before the log task exists are printed once it is
+ * created */
+static void test_before_init(void) {
+	DLOGI(TAG, "early %d", 1);
+	DLOGW(TAG, "early %d", 2);
+
+	TEST_ASSERT_EQUAL(ESP_ERR_TIMEOUT, dlog_flush(1));
+	TEST_ASSERT_EQUAL(0, lines_num);
+
+	TEST_ASSERT_EQUAL(ESP_OK, dlog_init(LOG_PRIORITY));
+	TEST_ASSERT_EQUAL(ESP_OK, dlog_flush(FLUSH_TICKS));
+
+	TEST_ASSERT_EQUAL(2, lines_num);
+	TEST_ASSERT(strstr(lines[0], ") test: early 1\n") != NULL);
+	TEST_ASSERT(strstr(lines[1], ") test: early 2\n") != NULL);
+}
+
+/* Same layout as ESP_LOGx, with the time the message was recorded and up to
+ * six arguments */
+static void test_format(void) {
+	char letter;
+	uint32_t timestamp;
+	uint32_t before = esp_log_timestamp();
+
+	lines_reset();
+
+	DLOGE(TAG, "no arguments");
+	DLOGI(TAG, "%d %u %x %c %ld %" PRIu8, -1, 2u, 0xABu, 'z', 5L, (uint8_t)200);
+	DLOGW(TAG, "%" PRIu32 " of %" PRIu32, 3, 4);
+
+	TEST_ASSERT_EQUAL(ESP_OK, dlog_flush(FLUSH_TICKS));
+	TEST_ASSERT_EQUAL(3, lines_num);
+
+	TEST_ASSERT_EQUAL(2, sscanf(lines[0], "%c (%" SCNu32 ")", &letter, &timestamp));
+	TEST_ASSERT_EQUAL('E', letter);
+	TEST_ASSERT(timestamp >= before && timestamp <= esp_log_timestamp());
+	TEST_ASSERT(strstr(lines[0], ") test: no arguments\n") != NULL);
+	TEST_ASSERT(strstr(lines[1], ") test: -1 2 ab z 5 200\n") != NULL);
+	TEST_ASSERT(lines[2][0] == 'W' && strstr(lines[2], ") test: 3 of 4\n") != NULL);
+}
+
+/* A line longer than the buffer is cut, not overflowed */
+static void test_truncation(void) {
+	lines_reset();
+
+	DLOGI(TAG, "%0200d|", 7);
+
+	TEST_ASSERT_EQUAL(ESP_OK, dlog_flush(FLUSH_TICKS));
+	TEST_ASSERT_EQUAL(1, lines_num);
+	/* The cut line and the newline */
+	TEST_ASSERT_EQUAL(CONFIG_DLOG_LINE_SIZE, strlen(lines[0]));
+	TEST_ASSERT(strchr(lines[0], '|') == NULL);
+}
+
+/* While the log task is behind the ring fills, the messages that don't fit
+ * are dropped without blocking, counted and reported */
+static void test_dropped(void) {
+	const uint32_t extra = 10;
+
+	lines_reset();
+	atomic_store(&hold, true);
+
+	DLOGI(TAG, "held");
+	TEST_ASSERT(xSemaphoreTake(held, FLUSH_TICKS));
+
+	/* The held message is out of the ring already */
+	for (uint32_t i = 0; i < CONFIG_DLOG_RING_SIZE + extra; i++) {
+		DLOGI(TAG, "%" PRIu32, i);
+	}
+
+	TEST_ASSERT_EQUAL(extra, dlog_get_dropped());
+	TEST_ASSERT_EQUAL(ESP_ERR_TIMEOUT, dlog_flush(2));
+
+	atomic_store(&hold, false);
+	xSemaphoreGive(release);
+
+	TEST_ASSERT_EQUAL(ESP_OK, dlog_flush(FLUSH_TICKS));
+	TEST_ASSERT_EQUAL(extra, dlog_get_dropped());
+	TEST_ASSERT_EQUAL(extra, reported_wait(extra));
+	TEST_ASSERT(strstr(lines[1], ") test: 0\n") != NULL);
+}
+
+/* Tasks log at once, each one's messages come out in order and every
+ * message is either printed or counted as dropped */
+static void test_stress(void) {
+	uint32_t dropped_before = dlog_get_dropped();
+
+	for (uint32_t i = 0; i < STRESS_TASKS; i++) {
+		TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(stress_task, "stress", 4096, (void *)(uintptr_t)i, 5, NULL));
+	}
+
+	for (uint32_t i = 0; i < STRESS_TASKS; i++) {
+		TEST_ASSERT(xSemaphoreTake(finished, pdMS_TO_TICKS(60000)));
+	}
+
+	TEST_ASSERT_EQUAL(ESP_OK, dlog_flush(FLUSH_TICKS));
+
+	uint32_t dropped = dlog_get_dropped() - dropped_before;
+
+	printf("%" PRIu32 " printed, %" PRIu32 " dropped\n", stress_printed, dropped);
+
+	TEST_ASSERT_EQUAL(0, stress_unordered);
+	TEST_ASSERT_EQUAL(STRESS_TASKS * STRESS_MESSAGES, stress_printed + dropped);
+	TEST_ASSERT_EQUAL(dlog_get_dropped(), reported_wait(dlog_get_dropped()));
+}
+
+/* Time a caller spends in a message, against ESP_LOGI formatting it on the
+ * spot. The host prints to memory, on the target ESP_LOGI also waits for the
+ * UART, milliseconds per line at 115200 baud. The tail of DLOGI is the host
+ * waking the log task up. The batches fit the ring, the log task drains it
+ * in between */
+static void test_latency(void) {
+	uint32_t dropped_before = dlog_get_dropped();
+
+	for (uint32_t i = 0; i < LATENCY_MESSAGES; i++) {
+		if (i % LATENCY_BATCH == 0) {
+			TEST_ASSERT_EQUAL(ESP_OK, dlog_flush(FLUSH_TICKS));
+		}
+
+		int64_t start = time_ns();
+
+		DLOGI(LATENCY_TAG, "%" PRIu32 " of %" PRIu32, i, (uint32_t)LATENCY_MESSAGES);
+		latencies[i] = time_ns() - start;
+	}
+
+	TEST_ASSERT_EQUAL(ESP_OK, dlog_flush(FLUSH_TICKS));
+	TEST_ASSERT_EQUAL(dropped_before, dlog_get_dropped());
+
+	uint32_t dlog_p99 = latency_print("DLOGI", latencies, LATENCY_MESSAGES);
+	uint32_t dlog_p50 = latencies[LATENCY_MESSAGES / 2];
+
+	for (uint32_t i = 0; i < LATENCY_MESSAGES; i++) {
+		int64_t start = time_ns();
+
+		ESP_LOGI(LATENCY_TAG, "%" PRIu32 " of %" PRIu32, i, (uint32_t)LATENCY_MESSAGES);
+		latencies[i] = time_ns() - start;
+	}
+
+	latency_print("ESP_LOGI", latencies, LATENCY_MESSAGES);
+
+	TEST_ASSERT(dlog_p50 < latencies[LATENCY_MESSAGES / 2]);
+	TEST_ASSERT(dlog_p99 < LATENCY_P99_NS_MAX);
+}
+
+/***************************** END OF FILE ************************************/
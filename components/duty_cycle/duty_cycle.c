@@ -0,0 +1,177 @@
+/**
+  ******************************************************************************
+  * @file           : duty_cycle.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Deep sleep duty cycle fed to the TPL5010 watchdog
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <inttypes.h>
+#include <sys/time.h>
+
+#include "duty_cycle.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_sleep.h"
+#include "esp_system.h"
+#include "esp_attr.h"
+#include "esp_rom_sys.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define RTC_MAGIC			0x44435943		/* "DCYC" */
+#define PERIOD_US			((int64_t)CONFIG_DUTY_CYCLE_PERIOD_S * 1000000)
+
+/* Shortest sleep, a cycle woken up later than its slot skips to the next */
+#define MIN_SLEEP_US		20000
+
+/* TPL5010 DONE pulse, 100 ns minimum */
+#define DONE_PULSE_US		1
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static const char *TAG = "duty_cycle";
+
+RTC_NOINIT_ATTR static duty_cycle_rtc_t rtc;
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief Function to start a cycle, to call first thing after boot
+  */
+esp_err_t duty_cycle_init(duty_cycle_t * const me, gpio_num_t done_gpio) {
+	me->done_gpio = done_gpio;
+	me->rtc = &rtc;
+	me->resumed = esp_reset_reason() == ESP_RST_DEEPSLEEP && rtc.magic == RTC_MAGIC;
+
+	if (!me->resumed) {
+		rtc.magic = RTC_MAGIC;
+		rtc.cycles = 0;
+		rtc.overruns = 0;
+		rtc.wake_time = duty_cycle_get_time();
+		rtc.awake_us = 0;
+		rtc.awake_total_us = 0;
+	}
+
+	rtc.cycles++;
+
+	/* Held low during the previous sleep */
+	gpio_hold_dis(done_gpio);
+
+	gpio_config_t io_conf = {
+			.pin_bit_mask = 1ULL << done_gpio,
+			.mode = GPIO_MODE_OUTPUT,
+			.pull_up_en = GPIO_PULLUP_DISABLE,
+			.pull_down_en = GPIO_PULLDOWN_DISABLE,
+			.intr_type = GPIO_INTR_DISABLE,
+	};
+
+	esp_err_t ret = gpio_config(&io_conf);
+
+	if (ret != ESP_OK) {
+		return ret;
+	}
+
+	gpio_set_level(done_gpio, 0);
+
+	ESP_LOGI(TAG, "Cycle %" PRIu32 ", previous one awake %" PRIu32 " ms", rtc.cycles, rtc.awake_us / 1000);
+
+	return ESP_OK;
+}
+
+/**
+  * @brief Function to get the time kept across deep sleep
+  */
+int64_t duty_cycle_get_time(void) {
+	struct timeval tv;
+
+	/* Kept by the RTC timer across deep sleep, unlike esp_timer */
+	gettimeofday(&tv, NULL);
+
+	return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+/**
+  * @brief Function to get the awake time left in the budget of the cycle
+  */
+uint32_t duty_cycle_get_remaining_ms(duty_cycle_t * const me) {
+	int64_t awake_ms = esp_timer_get_time() / 1000;
+
+	if (awake_ms >= CONFIG_DUTY_CYCLE_AWAKE_BUDGET_MS) {
+		return 0;
+	}
+
+	return CONFIG_DUTY_CYCLE_AWAKE_BUDGET_MS - awake_ms;
+}
+
+/**
+  * @brief Function to end the cycle, the TPL5010 is fed and the chip deep
+  *        sleeps until the next one
+  */
+void duty_cycle_sleep(duty_cycle_t * const me) {
+	/* esp_timer starts with the application, the boot before isn't counted */
+	int64_t awake_us = esp_timer_get_time();
+
+	if (awake_us > (int64_t)CONFIG_DUTY_CYCLE_AWAKE_BUDGET_MS * 1000) {
+		rtc.overruns++;
+	}
+
+	/* A cycle hung for more than 71 minutes doesn't fit the field */
+	rtc.awake_us = awake_us < UINT32_MAX ? (uint32_t)awake_us : UINT32_MAX;
+	rtc.awake_total_us += awake_us;
+
+	/* Fixed cadence from the scheduled wake up, the slots missed by a long
+	 * cycle are skipped */
+	int64_t now = duty_cycle_get_time();
+
+	do {
+		rtc.wake_time += PERIOD_US;
+	} while (rtc.wake_time - now < MIN_SLEEP_US);
+
+	/* Restarts the TPL5010 interval, it resets the chip if a cycle hangs */
+	gpio_set_level(me->done_gpio, 1);
+	esp_rom_delay_us(DONE_PULSE_US);
+	gpio_set_level(me->done_gpio, 0);
+
+	gpio_hold_en(me->done_gpio);
+	gpio_deep_sleep_hold_en();
+
+	/* The TPL5010 WAKE output isn't on an RTC GPIO, the RTC timer wakes the
+	 * chip up instead */
+	esp_sleep_enable_timer_wakeup(rtc.wake_time - now);
+	esp_deep_sleep_start();
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/***************************** END OF FILE ************************************/
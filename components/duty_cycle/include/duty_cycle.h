@@ -0,0 +1,117 @@
+/**
+  ******************************************************************************
+  * @file           : duty_cycle.h
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Deep sleep duty cycle fed to the TPL5010 watchdog
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef DUTY_CYCLE_H_
+#define DUTY_CYCLE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "esp_err.h"
+#include "sdkconfig.h"
+#include "driver/gpio.h"
+
+/* Exported macro ------------------------------------------------------------*/
+
+/* Exported typedef ----------------------------------------------------------*/
+/* Kept in RTC memory across deep sleep */
+typedef struct {
+	uint32_t magic;
+	uint32_t cycles;			/* Cycles since power on */
+	uint32_t overruns;			/* Cycles cut by the awake time budget */
+	int64_t wake_time;			/* RTC time in us of the scheduled wake up */
+	uint32_t awake_us;			/* Awake time of the previous cycle */
+	uint64_t awake_total_us;	/* Awake time since power on */
+} duty_cycle_rtc_t;
+
+typedef struct {
+	gpio_num_t done_gpio;
+	bool resumed;				/* Woken up from deep sleep, RTC memory kept */
+	duty_cycle_rtc_t *rtc;
+} duty_cycle_t;
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions prototypes ---------------------------------------------*/
+/**
+  * @brief Function to start a cycle, to call first thing after boot
+  *
+  * @note The statistics are reset unless the chip woke up from deep sleep
+  *
+  * @param me        : Pointer to a duty_cycle_t structure
+  * @param done_gpio : GPIO of the TPL5010 DONE input
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- Others from gpio_config()
+  */
+esp_err_t duty_cycle_init(duty_cycle_t * const me, gpio_num_t done_gpio);
+
+/**
+  * @brief Function to get the time kept across deep sleep
+  *
+  * @retval RTC time in us
+  */
+int64_t duty_cycle_get_time(void);
+
+/**
+  * @brief Function to get the awake time left in the budget of the cycle
+  *
+  * @param me : Pointer to a duty_cycle_t structure
+  *
+  * @retval Time left in ms, 0 if it is over
+  */
+uint32_t duty_cycle_get_remaining_ms(duty_cycle_t * const me);
+
+/**
+  * @brief Function to end the cycle, the TPL5010 is fed and the chip deep
+  *        sleeps until the next one
+  *
+  * @param me : Pointer to a duty_cycle_t structure
+  */
+void duty_cycle_sleep(duty_cycle_t * const me) __attribute__((noreturn));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DUTY_CYCLE_H_ */
+
+/***************************** END OF FILE ************************************/
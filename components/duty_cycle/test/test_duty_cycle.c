@@ -0,0 +1,305 @@
+/**
+  ******************************************************************************
+  * @file           : test_duty_cycle.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Host test of the duty cycle cadence and awake budget
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <setjmp.h>
+#include <sys/time.h>
+
+#include "host_test.h"
+#include "duty_cycle.h"
+#include "esp_sleep.h"
+#include "esp_system.h"
+#include "esp_rom_sys.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define DONE_GPIO				GPIO_NUM_38
+#define PERIOD_US				((int64_t)CONFIG_DUTY_CYCLE_PERIOD_S * 1000000)
+#define BUDGET_US				((int64_t)CONFIG_DUTY_CYCLE_AWAKE_BUDGET_MS * 1000)
+#define START_S					1700000000	/* RTC time at power on */
+#define SLACK_US				50000		/* Real time a loaded host takes in a cycle */
+#define CYCLES_NUM				100
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static duty_cycle_t duty_cycle;
+static esp_reset_reason_t reset_reason;
+static jmp_buf sleep_jmp;
+static int64_t start;				/* RTC time of the first cycle */
+static int64_t sleep_us;			/* Timer wake up of the last deep sleep */
+
+/* DONE pin */
+static gpio_mode_t done_mode;
+static uint32_t done_level;
+static bool done_held;
+static bool done_sleep_held;
+static uint32_t done_pulses;
+static uint32_t done_pulse_us;		/* Shortest high time */
+
+/* Private function prototypes -----------------------------------------------*/
+static void power_on(void);
+static void cycle(int64_t awake_us);
+static void test_power_on(void);
+static void test_cadence(void);
+static void test_budget(void);
+static void test_skip(void);
+static void test_reset(void);
+static void test_hang(void);
+
+/* Main ----------------------------------------------------------------------*/
+int main(void) {
+	RUN_TEST(test_power_on);
+	RUN_TEST(test_cadence);
+	RUN_TEST(test_budget);
+	RUN_TEST(test_skip);
+	RUN_TEST(test_reset);
+	RUN_TEST(test_hang);
+
+	return 0;
+}
+
+/* Fake chip -----------------------------------------------------------------*/
+esp_reset_reason_t esp_reset_reason(void) {
+	return reset_reason;
+}
+
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t time_in_us) {
+	sleep_us = time_in_us;
+
+	return ESP_OK;
+}
+
+/* Back to the cycle that went to sleep */
+void esp_deep_sleep_start(void) {
+	longjmp(sleep_jmp, 1);
+}
+
+void esp_rom_delay_us(uint32_t us) {
+	if (done_level && us < done_pulse_us) {
+		done_pulse_us = us;
+	}
+}
+
+esp_err_t gpio_config(const gpio_config_t *config) {
+	TEST_ASSERT_EQUAL(1ULL << DONE_GPIO, config->pin_bit_mask);
+	done_mode = config->mode;
+
+	return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level) {
+	TEST_ASSERT_EQUAL(DONE_GPIO, gpio_num);
+	TEST_ASSERT(!done_held);
+
+	if (done_level && !level) {
+		done_pulses++;
+	}
+
+	done_level = level;
+
+	return ESP_OK;
+}
+
+esp_err_t gpio_hold_en(gpio_num_t gpio_num) {
+	done_held = true;
+
+	return ESP_OK;
+}
+
+esp_err_t gpio_hold_dis(gpio_num_t gpio_num) {
+	done_held = false;
+	done_sleep_held = false;
+
+	return ESP_OK;
+}
+
+void gpio_deep_sleep_hold_en(void) {
+	done_sleep_held = true;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static void power_on(void) {
+	struct timeval tv = {.tv_sec = START_S};
+
+	host_deep_sleep(0);
+	settimeofday(&tv, NULL);
+	start = (int64_t)START_S * 1000000;
+	reset_reason = ESP_RST_POWERON;
+	done_pulses = 0;
+	done_pulse_us = UINT32_MAX;
+}
+
+/* Runs a cycle awake for a time, then sleeps until the next boot */
+static void cycle(int64_t awake_us) {
+	TEST_ASSERT_EQUAL(ESP_OK, duty_cycle_init(&duty_cycle, DONE_GPIO));
+	TEST_ASSERT_EQUAL(GPIO_MODE_OUTPUT, done_mode);
+	TEST_ASSERT(!done_held);
+	TEST_ASSERT_EQUAL(0, done_level);
+
+	host_time_advance(awake_us);
+
+	uint32_t pulses = done_pulses;
+
+	if (setjmp(sleep_jmp) == 0) {
+		duty_cycle_sleep(&duty_cycle);
+	}
+
+	/* DONE pulsed once and held low while asleep */
+	TEST_ASSERT_EQUAL(pulses + 1, done_pulses);
+	TEST_ASSERT(done_pulse_us >= 1);
+	TEST_ASSERT_EQUAL(0, done_level);
+	TEST_ASSERT(done_held && done_sleep_held);
+
+	host_deep_sleep(sleep_us);
+	reset_reason = ESP_RST_DEEPSLEEP;
+}
+
+static void test_power_on(void) {
+	power_on();
+
+	TEST_ASSERT_EQUAL(ESP_OK, duty_cycle_init(&duty_cycle, DONE_GPIO));
+	TEST_ASSERT(!duty_cycle.resumed);
+	TEST_ASSERT_EQUAL(1, duty_cycle.rtc->cycles);
+	TEST_ASSERT_EQUAL(0, duty_cycle.rtc->overruns);
+	TEST_ASSERT_EQUAL(0, duty_cycle.rtc->awake_total_us);
+	TEST_ASSERT(duty_cycle_get_time() - start < SLACK_US);
+}
+
+/* The wake ups keep the period from the first one, whatever the awake time */
+static void test_cadence(void) {
+	power_on();
+
+	for (uint32_t i = 0; i < CYCLES_NUM; i++) {
+		int64_t awake_us = 100000 + (i % 4) * 100000;
+
+		cycle(awake_us);
+		TEST_ASSERT(sleep_us > PERIOD_US - awake_us - SLACK_US && sleep_us <= PERIOD_US - awake_us);
+
+		/* On the slot, late only by the time the host took */
+		int64_t late = duty_cycle_get_time() - (start + (i + 1) * PERIOD_US);
+
+		TEST_ASSERT(late >= 0 && late < SLACK_US);
+	}
+
+	TEST_ASSERT_EQUAL(ESP_OK, duty_cycle_init(&duty_cycle, DONE_GPIO));
+	TEST_ASSERT(duty_cycle.resumed);
+	TEST_ASSERT_EQUAL(CYCLES_NUM + 1, duty_cycle.rtc->cycles);
+	TEST_ASSERT_EQUAL(0, duty_cycle.rtc->overruns);
+	TEST_ASSERT_EQUAL(CYCLES_NUM, done_pulses);
+
+	/* 250 ms on average */
+	int64_t total_us = duty_cycle.rtc->awake_total_us;
+
+	TEST_ASSERT(total_us >= CYCLES_NUM * 250000LL && total_us < CYCLES_NUM * (250000LL + SLACK_US));
+}
+
+static void test_budget(void) {
+	power_on();
+
+	TEST_ASSERT_EQUAL(ESP_OK, duty_cycle_init(&duty_cycle, DONE_GPIO));
+
+	uint32_t remaining = duty_cycle_get_remaining_ms(&duty_cycle);
+
+	TEST_ASSERT(remaining <= CONFIG_DUTY_CYCLE_AWAKE_BUDGET_MS && remaining > CONFIG_DUTY_CYCLE_AWAKE_BUDGET_MS - SLACK_US / 1000);
+
+	host_time_advance(BUDGET_US - 200000);
+	remaining = duty_cycle_get_remaining_ms(&duty_cycle);
+	TEST_ASSERT(remaining <= 200 && remaining > 200 - SLACK_US / 1000);
+
+	host_time_advance(200000);
+	TEST_ASSERT_EQUAL(0, duty_cycle_get_remaining_ms(&duty_cycle));
+
+	/* A cycle over the budget is counted, the next one starts within it */
+	power_on();
+	cycle(BUDGET_US + 300000);
+	cycle(BUDGET_US / 2);
+
+	TEST_ASSERT_EQUAL(ESP_OK, duty_cycle_init(&duty_cycle, DONE_GPIO));
+	TEST_ASSERT_EQUAL(1, duty_cycle.rtc->overruns);
+	TEST_ASSERT(duty_cycle.rtc->awake_us >= BUDGET_US / 2 && duty_cycle.rtc->awake_us < BUDGET_US / 2 + SLACK_US);
+	TEST_ASSERT(duty_cycle_get_remaining_ms(&duty_cycle) > CONFIG_DUTY_CYCLE_AWAKE_BUDGET_MS - SLACK_US / 1000);
+}
+
+/* A cycle ending after its slot, or too close to it, skips to the next one */
+static void test_skip(void) {
+	power_on();
+
+	cycle(PERIOD_US + 1000000);
+	TEST_ASSERT(duty_cycle_get_time() - (start + 2 * PERIOD_US) < SLACK_US);
+
+	cycle(PERIOD_US - 10000);
+	TEST_ASSERT(duty_cycle_get_time() - (start + 4 * PERIOD_US) < SLACK_US);
+
+	cycle(PERIOD_US / 2);
+	TEST_ASSERT(duty_cycle_get_time() - (start + 5 * PERIOD_US) < SLACK_US);
+	TEST_ASSERT(sleep_us >= 20000);
+}
+
+/* Only a deep sleep wake up with a valid RTC memory goes on */
+static void test_reset(void) {
+	power_on();
+	cycle(100000);
+	cycle(100000);
+
+	reset_reason = ESP_RST_BROWNOUT;
+	TEST_ASSERT_EQUAL(ESP_OK, duty_cycle_init(&duty_cycle, DONE_GPIO));
+	TEST_ASSERT(!duty_cycle.resumed);
+	TEST_ASSERT_EQUAL(1, duty_cycle.rtc->cycles);
+
+	/* RTC memory lost, as after a power cut in deep sleep */
+	duty_cycle.rtc->magic = 0;
+	reset_reason = ESP_RST_DEEPSLEEP;
+	TEST_ASSERT_EQUAL(ESP_OK, duty_cycle_init(&duty_cycle, DONE_GPIO));
+	TEST_ASSERT(!duty_cycle.resumed);
+	TEST_ASSERT_EQUAL(1, duty_cycle.rtc->cycles);
+	TEST_ASSERT_EQUAL(0, duty_cycle.rtc->awake_total_us);
+}
+
+/* A cycle awake for longer than the 32 bits of the last awake time holds is
+ * still an overrun, its time is clamped and fully added to the total */
+static void test_hang(void) {
+	int64_t awake_us = (int64_t)UINT32_MAX + BUDGET_US;
+
+	power_on();
+	cycle(awake_us);
+
+	TEST_ASSERT_EQUAL(ESP_OK, duty_cycle_init(&duty_cycle, DONE_GPIO));
+	TEST_ASSERT_EQUAL(1, duty_cycle.rtc->overruns);
+	TEST_ASSERT_EQUAL(UINT32_MAX, duty_cycle.rtc->awake_us);
+	TEST_ASSERT(duty_cycle.rtc->awake_total_us >= awake_us && duty_cycle.rtc->awake_total_us < awake_us + SLACK_US);
+}
+
+/***************************** END OF FILE ************************************/
@@ -33,10 +33,16 @@
   */
 
 /* Includes ------------------------------------------------------------------*/
+#include <stdatomic.h>
+
 #include "esp_buzzer.h"
 #include "esp_log.h"
+#include "task_prof.h"
 
 /* Private macro -------------------------------------------------------------*/
+#define LEDC_MODE			LEDC_LOW_SPEED_MODE
+#define LEDC_RESOLUTION		LEDC_TIMER_10_BIT
+#define LEDC_DUTY_MAX		((1 << LEDC_RESOLUTION) / 2)	/* 50% is the loudest */
 
 /* External variables --------------------------------------------------------*/
 
@@ -46,71 +52,132 @@
 /* Tag for debug */
 static const char * TAG = "esp_buzzer";
 
+/* LEDC timers and channels taken by the LEDC backend instances, bit i is set
+ * while the index i is taken */
+static atomic_uint ledc_slots;
+
+TASK_PROF_HIST_DEFINE(timer_hist, "buzzer_timer");
+
 /* Private function prototypes -----------------------------------------------*/
-static void buzzer_timer_handler(TimerHandle_t timer);
-static void buzzer_pause_timer_handler(TimerHandle_t timer);
+static esp_err_t buzzer_ledc_init(esp_buzzer_t *const me);
+static void buzzer_ledc_free(esp_buzzer_t *const me);
+static void buzzer_output(esp_buzzer_t *const me, bool level, uint16_t tone);
+static void buzzer_timer_handler(void *arg);
+static void buzzer_expire(esp_buzzer_t *const me);
+static void buzzer_unlock(esp_buzzer_t *const me);
+static void buzzer_next_step(esp_buzzer_t *const me);
+static void buzzer_halt(esp_buzzer_t *const me);
 
 /* Exported functions --------------------------------------------------------*/
 /**
   * @brief Initialize a buzzer instance
   */
-esp_err_t esp_buzzer_init(esp_buzzer_t *const me, gpio_num_t gpio) {
+esp_err_t esp_buzzer_init(esp_buzzer_t *const me, gpio_num_t gpio, esp_buzzer_backend_e backend) {
 	ESP_LOGI(TAG, "Initializing buzzer...");
 
 	esp_err_t ret = ESP_OK;
 
+	if (backend >= ESP_BUZZER_MAX_BACKEND) {
+		ESP_LOGE(TAG, "Invalid buzzer backend");
+		return ESP_ERR_INVALID_ARG;
+	}
+
 	/* Fill the members structure with their default values*/
-	me->on_time = 0;
-	me->off_time = 0;
-	me->level = true;
+	me->level = false;
 	me->gpio = gpio;
+	me->backend = backend;
+	me->tone = CONFIG_ESP_BUZZER_LEDC_TONE;
+	me->ledc_freq = 0;
+	me->volume = 100;
 	me->state = BUZZER_STOP_STATE;
+	me->current.seq.steps = NULL;
+	me->current.seq.steps_num = 0;
+	me->step_index = 0;
+	me->times_counter = 0;
+	atomic_init(&me->expired, false);
+
+	if (me->backend == ESP_BUZZER_LEDC_BACKEND) {
+		ret = buzzer_ledc_init(me);
+
+#ifdef CONFIG_PM_ENABLE
+		/* The LEDC timer runs from the APB clock, the tone would shift with
+		 * the frequency scaling and stop in light sleep */
+		if (ret == ESP_OK) {
+			ret = esp_pm_lock_create(ESP_PM_APB_FREQ_MAX, 0, "esp_buzzer", &me->pm_lock);
+
+			if (ret != ESP_OK) {
+				buzzer_ledc_free(me);
+			}
+		}
+#endif
+	}
+	else {
+		/* Configure a GPIO to drive the buzzer */
+		gpio_config_t gpio_conf;
+		gpio_conf.intr_type = GPIO_INTR_DISABLE;
+		gpio_conf.mode = GPIO_MODE_OUTPUT;
+		gpio_conf.pin_bit_mask = 1ULL << me->gpio;
+		gpio_conf.pull_down_en = GPIO_PULLDOWN_DISABLE;
+		gpio_conf.pull_up_en = GPIO_PULLUP_DISABLE;
+
+		ret = gpio_config(&gpio_conf);
+
+		if (ret != ESP_OK) {
+			ESP_LOGE(TAG, "Failed to configure buzzer GPIO");
+			return ret;
+		}
 
-	/* Configure a GPIO to drive the buzzer */
-	gpio_config_t gpio_conf;
-	gpio_conf.intr_type = GPIO_INTR_DISABLE;
-	gpio_conf.mode = GPIO_MODE_OUTPUT;
-	gpio_conf.pin_bit_mask = 1ULL << me->gpio;
-	gpio_conf.pull_down_en = GPIO_PULLDOWN_DISABLE;
-	gpio_conf.pull_up_en = GPIO_PULLUP_DISABLE;
-
-	ret = gpio_config(&gpio_conf);
+		/* Turn off the buzzer */
+		ret = gpio_set_level(me->gpio, false);
+	}
 
 	if (ret != ESP_OK) {
-		ESP_LOGE(TAG, "Failed to configure buzzer GPIO");
+		ESP_LOGE(TAG, "Failed to turn off the buzzer");
 		return ret;
 	}
 
-	/* Turn off the buzzer */
-	ret = gpio_set_level(me->gpio, false);
+	/* Create the queue of sequences waiting to be played */
+	me->queue_handle = xQueueCreateStatic(ESP_BUZZER_QUEUE_LENGTH,
+			sizeof(esp_buzzer_seq_item_t),
+			me->queue_storage,
+			&me->queue_buffer);
 
-	if (ret != ESP_OK) {
-		ESP_LOGE(TAG, "Failed to turn off the buzzer");
-		return ret;
+	if (me->queue_handle == NULL) {
+		ESP_LOGE(TAG, "Failed to create buzzer queue");
+		return ESP_FAIL;
 	}
 
-	/* Create a timer to control the buzzer function */
-	me->timer_handle = xTimerCreate("Buzzer timer",
-			100, /* fixme: define better */
-			pdTRUE,
-			(void *)me,
-			buzzer_timer_handler);
+	/* Serialize the API with the timer callback, the callback never waits
+	 * for it */
+	me->mutex = xSemaphoreCreateMutexStatic(&me->mutex_buffer);
 
-	if (me->timer_handle == NULL) {
-		ESP_LOGE(TAG, "Failed to create buzzer timer");
+	if (me->mutex == NULL) {
+		ESP_LOGE(TAG, "Failed to create buzzer mutex");
 		return ESP_FAIL;
 	}
 
-	/* Create a timer to pause the buzzer funciton */
-	me->pause_timer_handle = xTimerCreate("Buzzer pause timer",
-			100, /* fixme: define better */
-			pdFALSE,
-			(void *)me,
-			buzzer_pause_timer_handler);
+	/* Create a one-shot timer to time each step, it also times the pauses.
+	 * Unlike a FreeRTOS timer it isn't rounded to the tick */
+	const esp_timer_create_args_t timer_args = {
+			.callback = buzzer_timer_handler,
+			.arg = (void *)me,
+			.dispatch_method = ESP_TIMER_TASK,
+			.name = "Buzzer timer",
+	};
+
+	ret = esp_timer_create(&timer_args, &me->timer_handle);
 
-	if (me->pause_timer_handle == NULL) {
+	if (ret != ESP_OK) {
 		ESP_LOGE(TAG, "Failed to create buzzer timer");
-		return ESP_FAIL;
+
+		if (me->backend == ESP_BUZZER_LEDC_BACKEND) {
+#ifdef CONFIG_PM_ENABLE
+			esp_pm_lock_delete(me->pm_lock);
+#endif
+			buzzer_ledc_free(me);
+		}
+
+		return ret;
 	}
 
 	/* Return ESP_OK */
@@ -121,41 +188,149 @@ esp_err_t esp_buzzer_init(esp_buzzer_t *const me, gpio_num_t gpio) {
   * @brief Start a buzzer instance
   */
 void esp_buzzer_start(esp_buzzer_t *const me, uint16_t on_time, uint16_t off_time, uint8_t times) {
-	/* Store the new buzzer parameters */
-	me->on_time = pdMS_TO_TICKS(on_time);
-	me->off_time = pdMS_TO_TICKS(off_time);
-	me->times = times;
-	me->state = BUZZER_RUN_STATE;
+	/* Build an on/off sequence, the steps travel with it in the queue */
+	esp_buzzer_seq_item_t item = {
+			.seq = {
+					.steps = NULL,
+					.steps_num = off_time ? 2 : 1,
+					.times = times,
+			},
+			.steps = {
+					{.level = true, .duration = on_time},
+					{.level = false, .duration = off_time},
+			},
+	};
+
+	if (on_time == 0) {
+		esp_buzzer_stop(me);
+		return;
+	}
+
+	xSemaphoreTake(me->mutex, portMAX_DELAY);
+
+	/* Replace whatever is playing or waiting */
+	xQueueReset(me->queue_handle);
+	xQueueSend(me->queue_handle, &item, 0);
+	me->current.seq.steps_num = 0;
+	me->deadline = esp_timer_get_time();
+	buzzer_next_step(me);
+
+	buzzer_unlock(me);
+}
+
+/**
+  * @brief Queue a sequence to be played after the current one
+  */
+esp_err_t esp_buzzer_enqueue(esp_buzzer_t *const me, const esp_buzzer_seq_t *seq, TickType_t timeout) {
+	uint32_t duration = 0;
+
+	if (seq == NULL || seq->steps == NULL) {
+		return ESP_ERR_INVALID_ARG;
+	}
+
+	/* A sequence without duration would never release the timer task */
+	for (uint8_t i = 0; i < seq->steps_num; i++) {
+		duration += seq->steps[i].duration;
+	}
 
-	/* Change the timer period and start */
-	xTimerChangePeriod(me->timer_handle, pdMS_TO_TICKS(me->on_time), 0);
+	if (duration == 0) {
+		return ESP_ERR_INVALID_ARG;
+	}
+
+	esp_buzzer_seq_item_t item = {
+			.seq = *seq,
+	};
+
+	if (xQueueSend(me->queue_handle, &item, timeout) != pdTRUE) {
+		return ESP_ERR_TIMEOUT;
+	}
+
+	/* Start playing if the buzzer is idle */
+	xSemaphoreTake(me->mutex, portMAX_DELAY);
 
-	/* Turn on the buzzer */
-	gpio_set_level(me->gpio, true);
+	if (me->state == BUZZER_STOP_STATE) {
+		me->deadline = esp_timer_get_time();
+		buzzer_next_step(me);
+	}
+
+	buzzer_unlock(me);
+
+	return ESP_OK;
 }
 
 /**
   * @brief Stop a buzzer instance
   */
 void esp_buzzer_stop(esp_buzzer_t * const me) {
-	me->state = BUZZER_STOP_STATE;
+	xSemaphoreTake(me->mutex, portMAX_DELAY);
 
-	/* Stop the buzzer timer to stop the buzzer */
-	xTimerStop(me->timer_handle, 0);
-	gpio_set_level(me->gpio, false);
+	xQueueReset(me->queue_handle);
+	buzzer_halt(me);
+
+	buzzer_unlock(me);
 }
 
 /**
   * @brief Pause a buzzer instance
   */
 void esp_buzzer_pause(esp_buzzer_t *const me, uint32_t time) {
-	me->pause_time = pdMS_TO_TICKS(time);
-	me->state = BUZZER_PAUSE_STATE;
+	xSemaphoreTake(me->mutex, portMAX_DELAY);
+
+	if (me->state != BUZZER_STOP_STATE) {
+		/* Turn off the buzzer until the timer expires */
+		me->state = BUZZER_PAUSE_STATE;
+		buzzer_output(me, false, 0);
+
+		esp_timer_stop(me->timer_handle);
+		esp_timer_start_once(me->timer_handle, (uint64_t)time * 1000);
+	}
+
+	buzzer_unlock(me);
+}
+
+/**
+  * @brief Set the default tone of a buzzer instance
+  */
+esp_err_t esp_buzzer_set_tone(esp_buzzer_t *const me, uint16_t tone) {
+	if (me->backend != ESP_BUZZER_LEDC_BACKEND) {
+		return ESP_ERR_NOT_SUPPORTED;
+	}
+
+	if (tone == 0) {
+		return ESP_ERR_INVALID_ARG;
+	}
+
+	/* Used from the next step on */
+	me->tone = tone;
+
+	return ESP_OK;
+}
+
+/**
+  * @brief Set the volume of a buzzer instance
+  */
+esp_err_t esp_buzzer_set_volume(esp_buzzer_t *const me, uint8_t volume) {
+	if (me->backend != ESP_BUZZER_LEDC_BACKEND) {
+		return ESP_ERR_NOT_SUPPORTED;
+	}
+
+	if (volume > 100) {
+		return ESP_ERR_INVALID_ARG;
+	}
+
+	xSemaphoreTake(me->mutex, portMAX_DELAY);
 
-	/* Turn off the buzzer */
-	gpio_set_level(me->gpio, false);
+	me->volume = volume;
 
-	xTimerChangePeriod(me->pause_timer_handle, me->pause_time, 0);
+	/* Apply it right away if the buzzer is sounding */
+	if (me->level) {
+		ledc_set_duty(LEDC_MODE, me->ledc_channel, LEDC_DUTY_MAX * me->volume / 100);
+		ledc_update_duty(LEDC_MODE, me->ledc_channel);
+	}
+
+	buzzer_unlock(me);
+
+	return ESP_OK;
 }
 
 /**
@@ -166,45 +341,236 @@ buzzer_state_e esp_buzzer_get_state(esp_buzzer_t *const me) {
 }
 
 /* Private functions ---------------------------------------------------------*/
-static void buzzer_timer_handler(TimerHandle_t timer) {
+static esp_err_t buzzer_ledc_init(esp_buzzer_t *const me) {
+	/* Claim the lowest free index first, concurrent initializations get
+	 * different ones */
+	uint32_t slots = atomic_load(&ledc_slots);
+	uint32_t index;
+
+	do {
+		index = __builtin_ctz(~slots);
+
+		if (CONFIG_ESP_BUZZER_LEDC_TIMER + index >= LEDC_TIMER_MAX ||
+				CONFIG_ESP_BUZZER_LEDC_CHANNEL + index >= LEDC_CHANNEL_MAX) {
+			ESP_LOGE(TAG, "No LEDC timer or channel left for the buzzer");
+			return ESP_ERR_NOT_FOUND;
+		}
+	} while (!atomic_compare_exchange_weak(&ledc_slots, &slots, slots | 1U << index));
+
+	/* Each instance has its own timer, so it can play its own tone */
+	me->ledc_timer = CONFIG_ESP_BUZZER_LEDC_TIMER + index;
+	me->ledc_channel = CONFIG_ESP_BUZZER_LEDC_CHANNEL + index;
+
+	ledc_timer_config_t timer_conf = {
+			.speed_mode = LEDC_MODE,
+			.duty_resolution = LEDC_RESOLUTION,
+			.timer_num = me->ledc_timer,
+			.freq_hz = me->tone,
+			.clk_cfg = LEDC_AUTO_CLK,
+	};
+
+	esp_err_t ret = ledc_timer_config(&timer_conf);
+
+	if (ret != ESP_OK) {
+		ESP_LOGE(TAG, "Failed to configure buzzer LEDC timer");
+		buzzer_ledc_free(me);
+		return ret;
+	}
+
+	/* The channel starts silent, with a duty cycle of 0 */
+	ledc_channel_config_t channel_conf = {
+			.gpio_num = me->gpio,
+			.speed_mode = LEDC_MODE,
+			.channel = me->ledc_channel,
+			.intr_type = LEDC_INTR_DISABLE,
+			.timer_sel = me->ledc_timer,
+			.duty = 0,
+			.hpoint = 0,
+	};
+
+	ret = ledc_channel_config(&channel_conf);
+
+	if (ret != ESP_OK) {
+		ESP_LOGE(TAG, "Failed to configure buzzer LEDC channel");
+		buzzer_ledc_free(me);
+		return ret;
+	}
+
+	me->ledc_freq = me->tone;
+
+	return ESP_OK;
+}
+
+/* Give the LEDC timer and channel back, for an initialization that failed */
+static void buzzer_ledc_free(esp_buzzer_t *const me) {
+	atomic_fetch_and(&ledc_slots, ~(1U << (me->ledc_timer - CONFIG_ESP_BUZZER_LEDC_TIMER)));
+}
+
+/* Drive the buzzer with the backend of the instance */
+static void buzzer_output(esp_buzzer_t *const me, bool level, uint16_t tone) {
+#ifdef CONFIG_PM_ENABLE
+	bool was_on = me->level;
+#endif
+
+	me->level = level;
+
+	/* A GPIO level is kept in light sleep, the esp_timer wakes the chip up
+	 * for the next step */
+	if (me->backend == ESP_BUZZER_GPIO_BACKEND) {
+		gpio_set_level(me->gpio, level);
+		return;
+	}
+
+#ifdef CONFIG_PM_ENABLE
+	if (level && !was_on) {
+		esp_pm_lock_acquire(me->pm_lock);
+	}
+#endif
+
+	/* The PWM generates the tone edges, the CPU only changes the step */
+	if (level) {
+		tone = tone ? tone : me->tone;
+
+		if (tone != me->ledc_freq) {
+			ledc_set_freq(LEDC_MODE, me->ledc_timer, tone);
+			me->ledc_freq = tone;
+		}
+	}
+
+	ledc_set_duty(LEDC_MODE, me->ledc_channel, level ? LEDC_DUTY_MAX * me->volume / 100 : 0);
+	ledc_update_duty(LEDC_MODE, me->ledc_channel);
+
+	/* Silent steps and pauses can sleep */
+#ifdef CONFIG_PM_ENABLE
+	if (!level && was_on) {
+		esp_pm_lock_release(me->pm_lock);
+	}
+#endif
+}
+
+static void buzzer_timer_handler(void *arg) {
+	TASK_PROF_START(start);
+
 	/* Get the buzzer instance parameters */
-	esp_buzzer_t *buzzer = (esp_buzzer_t *)pvTimerGetTimerID(timer);
-
-	/* Check if the buzzer is active */
-	if (buzzer->state == BUZZER_RUN_STATE) {
-		/* If the buzzer off time is not equal to zero, do the toggle function */
-		if (buzzer->off_time) {
-			/* Toggle the buzzer level */
-			buzzer->level = !buzzer->level;
-
-			/* Change the buzzer timer period according its level */
-			xTimerChangePeriod(buzzer->timer_handle,
-					buzzer->level ? buzzer->on_time : buzzer->off_time,
-					0);
-
-			/* Turn on or turn off the buzzer */
-			gpio_set_level(buzzer->gpio, buzzer->level);
+	esp_buzzer_t *buzzer = (esp_buzzer_t *)arg;
+
+	/* Blocking here would stall every esp_timer, if a task holds the mutex
+	 * it plays the next step when it gives the mutex back */
+	atomic_store(&buzzer->expired, true);
+
+	if (xSemaphoreTake(buzzer->mutex, 0) == pdTRUE) {
+		if (atomic_exchange(&buzzer->expired, false)) {
+			buzzer_expire(buzzer);
 		}
 
-		/* Count the times the buzzer must be toggled */
-		static uint16_t times_counter = 0;
+		buzzer_unlock(buzzer);
+	}
+
+	TASK_PROF_END(timer_hist, start);
+}
+
+/* Must be called with the mutex taken */
+static void buzzer_expire(esp_buzzer_t *const me) {
+	/* The timer was restarted since it expired */
+	if (esp_timer_is_active(me->timer_handle)) {
+		return;
+	}
+
+	if (me->state == BUZZER_PAUSE_STATE) {
+		/* Play the interrupted step again */
+		me->state = BUZZER_RUN_STATE;
+		me->deadline = esp_timer_get_time();
+
+		if (me->step_index) {
+			me->step_index--;
+		}
+	}
+
+	buzzer_next_step(me);
+}
+
+/* Give the mutex back, and handle the timer expiries the callback left
+ * while it was taken */
+static void buzzer_unlock(esp_buzzer_t *const me) {
+	for (;;) {
+		xSemaphoreGive(me->mutex);
+
+		/* The callback sets the flag before it tries the mutex, so an expiry
+		 * is either seen here or handled by the callback itself. If the mutex
+		 * was taken again, its new holder handles it */
+		if (!atomic_load(&me->expired) || xSemaphoreTake(me->mutex, 0) != pdTRUE) {
+			return;
+		}
+
+		if (atomic_exchange(&me->expired, false)) {
+			buzzer_expire(me);
+		}
+	}
+}
+
+/* Must be called with the mutex taken, and deadline set to when the step
+ * starts */
+static void buzzer_next_step(esp_buzzer_t *const me) {
+	for (;;) {
+		const esp_buzzer_seq_t *seq = &me->current.seq;
 
-		if (buzzer->level && buzzer->times != 0) {
-			times_counter++;
+		if (seq->steps_num != 0 && me->step_index >= seq->steps_num) {
+			/* End of the steps, repeat them or move to the next sequence */
+			me->times_counter++;
 
-			if (times_counter >= buzzer->times) {
-				times_counter = 0;
-				esp_buzzer_stop(buzzer);
+			if (seq->times == 0 || me->times_counter < seq->times) {
+				me->step_index = 0;
 			}
+			else {
+				me->current.seq.steps_num = 0;
+			}
+		}
+
+		if (seq->steps_num == 0) {
+			if (xQueueReceive(me->queue_handle, &me->current, 0) != pdTRUE) {
+				/* Nothing else to play */
+				buzzer_halt(me);
+
+				return;
+			}
+
+			/* The steps of esp_buzzer_start() are stored in the item */
+			if (me->current.seq.steps == NULL) {
+				me->current.seq.steps = me->current.steps;
+			}
+
+			me->step_index = 0;
+			me->times_counter = 0;
+			me->state = BUZZER_RUN_STATE;
+		}
+
+		const esp_buzzer_step_t *step = &seq->steps[me->step_index++];
+
+		if (step->duration == 0) {
+			continue;
 		}
+
+		buzzer_output(me, step->level, step->tone);
+
+		/* Count from the planned step start, so the callback latency doesn't
+		 * accumulate along the sequence */
+		me->deadline += (int64_t)step->duration * 1000;
+		int64_t timeout = me->deadline - esp_timer_get_time();
+
+		esp_timer_stop(me->timer_handle);
+		esp_timer_start_once(me->timer_handle, timeout > 0 ? timeout : 0);
+
+		return;
 	}
 }
 
-static void buzzer_pause_timer_handler(TimerHandle_t timer) {
-	/* Get the buzzer instance parameters */
-	esp_buzzer_t *buzzer = (esp_buzzer_t *)pvTimerGetTimerID(timer);
+static void buzzer_halt(esp_buzzer_t *const me) {
+	me->state = BUZZER_STOP_STATE;
+	me->current.seq.steps_num = 0;
 
-	buzzer->state = BUZZER_RUN_STATE;
+	/* Stop the buzzer timer to stop the buzzer */
+	esp_timer_stop(me->timer_handle);
+	buzzer_output(me, false, 0);
 }
 
 /***************************** END OF FILE ************************************/
@@ -43,13 +43,21 @@ extern "C" {
 /* Includes ------------------------------------------------------------------*/
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 
 #include "driver/gpio.h"
+#include "driver/ledc.h"
+#include "esp_timer.h"
+#include "esp_pm.h"
 
 #include "freertos/FreeRTOS.h"
-#include "freertos/timers.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+
+#include "sdkconfig.h"
 
 /* Exported macro ------------------------------------------------------------*/
+#define ESP_BUZZER_QUEUE_LENGTH	CONFIG_ESP_BUZZER_QUEUE_LENGTH
 
 /* Exported typedef ----------------------------------------------------------*/
 typedef enum {
@@ -59,17 +67,57 @@ typedef enum {
 	BUZER_MAX_STATE
 } buzzer_state_e;
 
+typedef enum {
+	ESP_BUZZER_GPIO_BACKEND = 0,	/* Drive the GPIO level, for active buzzers */
+	ESP_BUZZER_LEDC_BACKEND,		/* Drive a LEDC PWM tone, for passive piezos */
+	ESP_BUZZER_MAX_BACKEND
+} esp_buzzer_backend_e;
+
+/* Buzzer sequence step */
+typedef struct {
+	bool level;				/* Buzzer level during the step */
+	uint16_t duration;		/* Step duration in ms */
+	uint16_t tone;			/* Tone in Hz, 0 uses the instance tone. LEDC backend only */
+} esp_buzzer_step_t;
+
+/* Buzzer sequence */
+typedef struct {
+	const esp_buzzer_step_t *steps;	/* Steps array, not copied */
+	uint8_t steps_num;
+	uint8_t times;			/* Times the steps are played, 0 plays them forever */
+} esp_buzzer_seq_t;
+
+/* Queued sequence, with room for the steps of esp_buzzer_start() */
+typedef struct {
+	esp_buzzer_seq_t seq;
+	esp_buzzer_step_t steps[2];
+} esp_buzzer_seq_item_t;
+
 /* Buzzer data type */
 typedef struct {
 	gpio_num_t gpio;
-	TimerHandle_t timer_handle;
+	esp_buzzer_backend_e backend;
+	ledc_timer_t ledc_timer;
+	ledc_channel_t ledc_channel;
+	uint16_t tone;					/* Default tone in Hz */
+	uint16_t ledc_freq;				/* Frequency the LEDC timer runs at */
+	uint8_t volume;					/* Volume in percent */
+	esp_timer_handle_t timer_handle;
+	int64_t deadline;				/* Time in us the current step ends */
+	SemaphoreHandle_t mutex;
+	StaticSemaphore_t mutex_buffer;
+	atomic_bool expired;			/* Timer expiry left to the mutex holder */
 	bool level;
-	uint32_t on_time;
-	uint32_t off_time;
-	uint8_t times;
 	buzzer_state_e state;
-	uint32_t pause_time;
-	TimerHandle_t pause_timer_handle;
+	esp_buzzer_seq_item_t current;	/* Sequence being played */
+	uint8_t step_index;				/* Next step to play */
+	uint8_t times_counter;			/* Times the current sequence was played */
+	QueueHandle_t queue_handle;
+	StaticQueue_t queue_buffer;
+	uint8_t queue_storage[ESP_BUZZER_QUEUE_LENGTH * sizeof(esp_buzzer_seq_item_t)];
+#ifdef CONFIG_PM_ENABLE
+	esp_pm_lock_handle_t pm_lock;	/* Held while the LEDC tone sounds */
+#endif
 } esp_buzzer_t;
 
 /* Exported variables --------------------------------------------------------*/
@@ -78,28 +126,54 @@ typedef struct {
 /**
   * @brief Initialize a buzzer instance
   *
-  * @param me   : Pointer to a esp_buzzer_t structure
-  * @param gpio : GPIO number to drive the buzzer
+  * @note The LEDC backend takes a LEDC timer and channel per instance,
+  *       starting from the ones selected in menuconfig
+  *
+  * @param me      : Pointer to a esp_buzzer_t structure
+  * @param gpio    : GPIO number to drive the buzzer
+  * @param backend : Peripheral used to drive the buzzer
   *
   * @retval
   * 	- ESP_OK on success
   * 	- ESP_FAIL on fail
   */
-esp_err_t esp_buzzer_init(esp_buzzer_t * const me, gpio_num_t gpio);
+esp_err_t esp_buzzer_init(esp_buzzer_t * const me, gpio_num_t gpio, esp_buzzer_backend_e backend);
 
 /**
   * @brief Start a buzzer instance
   *
+  * @note The queued sequences are discarded and the sequence being played is
+  *       replaced by this one
+  *
   * @param me       : Pointer to a esp_buzzer_t structure
-  * @param on_time  : GPIO number to drive the buzzer
-  * @param off_time : GPIO number to drive the buzzer
-  * @param times    : GPIO number to drive the buzzer
+  * @param on_time  : Time in ms the buzzer is on
+  * @param off_time : Time in ms the buzzer is off
+  * @param times    : Times the buzzer is turned on, 0 to beep until stopped
   */
 void esp_buzzer_start(esp_buzzer_t *const me, uint16_t on_time, uint16_t off_time, uint8_t times);
 
+/**
+  * @brief Queue a sequence to be played after the current one
+  *
+  * @note It can be called from any task, no memory is allocated. The steps
+  *       are not copied, so they must stay valid until played
+  *
+  * @param me      : Pointer to a esp_buzzer_t structure
+  * @param seq     : Pointer to the sequence
+  * @param timeout : Ticks to wait for room in the queue
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_INVALID_ARG if the sequence is empty or lasts 0 ms
+  * 	- ESP_ERR_TIMEOUT if the queue is full
+  */
+esp_err_t esp_buzzer_enqueue(esp_buzzer_t *const me, const esp_buzzer_seq_t *seq, TickType_t timeout);
+
 /**
   * @brief Stop a buzzer instance
   *
+  * @note The queued sequences are discarded
+  *
   * @param me : Pointer to a esp_buzzer_t structure
   */
 void esp_buzzer_stop(esp_buzzer_t *const me);
@@ -107,11 +181,39 @@ void esp_buzzer_stop(esp_buzzer_t *const me);
 /**
   * @brief Pause a buzzer instance
   *
+  * @note The interrupted step is played again from its start after the pause
+  *
   * @param me   : Pointer to a esp_buzzer_t structure
   * @param time : Time in ms to pause the buzzer
   */
 void esp_buzzer_pause(esp_buzzer_t *const me, uint32_t time);
 
+/**
+  * @brief Set the default tone of a buzzer instance
+  *
+  * @param me   : Pointer to a esp_buzzer_t structure
+  * @param tone : Tone in Hz, used by the steps without their own tone
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_INVALID_ARG if the tone is 0
+  * 	- ESP_ERR_NOT_SUPPORTED with the GPIO backend
+  */
+esp_err_t esp_buzzer_set_tone(esp_buzzer_t *const me, uint16_t tone);
+
+/**
+  * @brief Set the volume of a buzzer instance
+  *
+  * @param me     : Pointer to a esp_buzzer_t structure
+  * @param volume : Volume in percent, 100 is a 50% PWM duty cycle
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_INVALID_ARG if the volume is above 100
+  * 	- ESP_ERR_NOT_SUPPORTED with the GPIO backend
+  */
+esp_err_t esp_buzzer_set_volume(esp_buzzer_t *const me, uint8_t volume);
+
 /**
   * @brief Get the state of the buzzer instance
   *
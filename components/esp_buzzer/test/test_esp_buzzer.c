@@ -0,0 +1,421 @@
+/**
+  ******************************************************************************
+  * @file           : test_esp_buzzer.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Host test of the esp_buzzer sequencer
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+#include "host_test.h"
+#include "esp_buzzer.h"
+
+#include "freertos/task.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define GPIO_BUZZER				GPIO_NUM_5
+#define GPIO_PIEZO				GPIO_NUM_6
+#define EVENTS_MAX				64
+#define LATENCY_US				50000	/* Late callbacks allowed on a loaded host */
+#define DUTY_MAX				512		/* 50% of the 10 bit resolution */
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum {
+	EVENT_GPIO = 0,
+	EVENT_DUTY,
+	EVENT_FREQ,
+} event_type_e;
+
+typedef struct {
+	int64_t time;
+	event_type_e type;
+	uint32_t value;
+} event_t;
+
+/* Private variables ---------------------------------------------------------*/
+static portMUX_TYPE events_lock = portMUX_INITIALIZER_UNLOCKED;
+static event_t events[EVENTS_MAX];
+static uint32_t events_num;
+static ledc_timer_config_t ledc_timers[LEDC_TIMER_MAX];
+static ledc_timer_t ledc_last_timer;
+static esp_err_t ledc_error;
+
+static esp_buzzer_t buzzer;
+static esp_buzzer_t piezo;
+
+/* Private function prototypes -----------------------------------------------*/
+static void event_add(event_type_e type, uint32_t value);
+static uint32_t events_get(event_type_e type, event_t *out);
+static void events_reset(void);
+static bool wait_stopped(esp_buzzer_t * const me, uint32_t timeout_ms);
+static void levels_check(const event_t *ev, uint32_t num, const uint32_t *expected_ms, uint32_t expected_num);
+static void test_start(void);
+static void test_enqueue(void);
+static void test_enqueue_args(void);
+static void test_stop(void);
+static void test_pause(void);
+static void test_ledc(void);
+static void test_ledc_error(void);
+static void test_ledc_instances(void);
+
+/* Main ----------------------------------------------------------------------*/
+int main(void) {
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_buzzer_init(&buzzer, GPIO_BUZZER, ESP_BUZZER_MAX_BACKEND));
+	TEST_ASSERT_EQUAL(ESP_OK, esp_buzzer_init(&buzzer, GPIO_BUZZER, ESP_BUZZER_GPIO_BACKEND));
+	TEST_ASSERT_EQUAL(ESP_OK, esp_buzzer_init(&piezo, GPIO_PIEZO, ESP_BUZZER_LEDC_BACKEND));
+
+	RUN_TEST(test_start);
+	RUN_TEST(test_enqueue);
+	RUN_TEST(test_enqueue_args);
+	RUN_TEST(test_stop);
+	RUN_TEST(test_pause);
+	RUN_TEST(test_ledc);
+	RUN_TEST(test_ledc_error);
+	RUN_TEST(test_ledc_instances);
+
+	return 0;
+}
+
+/* Fake GPIO and LEDC drivers ------------------------------------------------*/
+esp_err_t gpio_config(const gpio_config_t *config) {
+	TEST_ASSERT(config->mode == GPIO_MODE_OUTPUT);
+
+	return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level) {
+	TEST_ASSERT_EQUAL(GPIO_BUZZER, gpio_num);
+	event_add(EVENT_GPIO, level);
+
+	return ESP_OK;
+}
+
+esp_err_t ledc_timer_config(const ledc_timer_config_t *timer_conf) {
+	ledc_timers[timer_conf->timer_num] = *timer_conf;
+	ledc_last_timer = timer_conf->timer_num;
+
+	return ESP_OK;
+}
+
+esp_err_t ledc_channel_config(const ledc_channel_config_t *ledc_conf) {
+	TEST_ASSERT_EQUAL(0, ledc_conf->duty);
+	TEST_ASSERT_EQUAL(ledc_conf->channel, ledc_conf->timer_sel);
+
+	return ledc_error;
+}
+
+esp_err_t ledc_set_freq(ledc_mode_t speed_mode, ledc_timer_t timer_num, uint32_t freq_hz) {
+	TEST_ASSERT_EQUAL(piezo.ledc_timer, timer_num);
+	event_add(EVENT_FREQ, freq_hz);
+
+	return ESP_OK;
+}
+
+esp_err_t ledc_set_duty(ledc_mode_t speed_mode, ledc_channel_t channel, uint32_t duty) {
+	TEST_ASSERT_EQUAL(piezo.ledc_channel, channel);
+	event_add(EVENT_DUTY, duty);
+
+	return ESP_OK;
+}
+
+esp_err_t ledc_update_duty(ledc_mode_t speed_mode, ledc_channel_t channel) {
+	return ESP_OK;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static void event_add(event_type_e type, uint32_t value) {
+	portENTER_CRITICAL(&events_lock);
+
+	if (events_num < EVENTS_MAX) {
+		events[events_num].time = esp_timer_get_time();
+		events[events_num].type = type;
+		events[events_num].value = value;
+		events_num++;
+	}
+
+	portEXIT_CRITICAL(&events_lock);
+}
+
+static uint32_t events_get(event_type_e type, event_t *out) {
+	uint32_t num = 0;
+
+	portENTER_CRITICAL(&events_lock);
+
+	for (uint32_t i = 0; i < events_num; i++) {
+		if (events[i].type == type) {
+			out[num++] = events[i];
+		}
+	}
+
+	portEXIT_CRITICAL(&events_lock);
+
+	return num;
+}
+
+static void events_reset(void) {
+	portENTER_CRITICAL(&events_lock);
+	events_num = 0;
+	portEXIT_CRITICAL(&events_lock);
+}
+
+static bool wait_stopped(esp_buzzer_t * const me, uint32_t timeout_ms) {
+	for (uint32_t i = 0; i < timeout_ms / portTICK_PERIOD_MS; i++) {
+		if (esp_buzzer_get_state(me) == BUZZER_STOP_STATE) {
+			return true;
+		}
+
+		vTaskDelay(1);
+	}
+
+	return false;
+}
+
+/* The levels alternate from on and the buzzer is turned off at the end.
+ * Each level starts at the sum of the previous durations from the first,
+ * late callbacks don't add up */
+static void levels_check(const event_t *ev, uint32_t num, const uint32_t *expected_ms, uint32_t expected_num) {
+	int64_t planned = 0;
+
+	TEST_ASSERT_EQUAL(expected_num + 1, num);
+
+	for (uint32_t i = 0; i < num; i++) {
+		int64_t offset = ev[i].time - ev[0].time;
+
+		TEST_ASSERT_EQUAL(i < expected_num && i % 2 == 0, ev[i].value);
+		TEST_ASSERT(offset >= planned);
+		TEST_ASSERT(offset < planned + LATENCY_US);
+
+		if (i < expected_num) {
+			planned += expected_ms[i] * 1000;
+		}
+	}
+}
+
+/* An on/off sequence is played the given times and ends off */
+static void test_start(void) {
+	const uint32_t expected_ms[] = {30, 20, 30, 20, 30, 20};
+	event_t ev[EVENTS_MAX];
+
+	events_reset();
+	esp_buzzer_start(&buzzer, 30, 20, 3);
+	TEST_ASSERT_EQUAL(BUZZER_RUN_STATE, esp_buzzer_get_state(&buzzer));
+	TEST_ASSERT(wait_stopped(&buzzer, 1000));
+
+	levels_check(ev, events_get(EVENT_GPIO, ev), expected_ms, 6);
+}
+
+/* Queued sequences play back to back, after the current one */
+static void test_enqueue(void) {
+	static const esp_buzzer_step_t steps_a[] = {
+			{.level = true, .duration = 20},
+			{.level = false, .duration = 10},
+	};
+	static const esp_buzzer_step_t steps_b[] = {
+			{.level = false, .duration = 0},	/* Skipped */
+			{.level = true, .duration = 40},
+			{.level = false, .duration = 15},
+	};
+	const esp_buzzer_seq_t seq_a = {.steps = steps_a, .steps_num = 2, .times = 2};
+	const esp_buzzer_seq_t seq_b = {.steps = steps_b, .steps_num = 3, .times = 1};
+	const uint32_t expected_ms[] = {20, 10, 20, 10, 40, 15};
+	event_t ev[EVENTS_MAX];
+
+	events_reset();
+	TEST_ASSERT_EQUAL(ESP_OK, esp_buzzer_enqueue(&buzzer, &seq_a, 0));
+	TEST_ASSERT_EQUAL(ESP_OK, esp_buzzer_enqueue(&buzzer, &seq_b, 0));
+	TEST_ASSERT(wait_stopped(&buzzer, 1000));
+
+	levels_check(ev, events_get(EVENT_GPIO, ev), expected_ms, 6);
+}
+
+/* Empty sequences are rejected, a full queue times out */
+static void test_enqueue_args(void) {
+	static const esp_buzzer_step_t steps[] = {
+			{.level = true, .duration = 100},
+			{.level = false, .duration = 0},
+	};
+	esp_buzzer_seq_t seq = {.steps = NULL, .steps_num = 2, .times = 1};
+
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_buzzer_enqueue(&buzzer, NULL, 0));
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_buzzer_enqueue(&buzzer, &seq, 0));
+	seq.steps = &steps[1];
+	seq.steps_num = 1;
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_buzzer_enqueue(&buzzer, &seq, 0));
+	seq.steps = steps;
+	seq.steps_num = 2;
+
+	/* The first one plays right away and leaves the queue */
+	for (uint32_t i = 0; i < ESP_BUZZER_QUEUE_LENGTH + 1; i++) {
+		TEST_ASSERT_EQUAL(ESP_OK, esp_buzzer_enqueue(&buzzer, &seq, 0));
+	}
+
+	TEST_ASSERT_EQUAL(ESP_ERR_TIMEOUT, esp_buzzer_enqueue(&buzzer, &seq, 0));
+
+	/* Stopping drops the queued ones */
+	esp_buzzer_stop(&buzzer);
+	TEST_ASSERT_EQUAL(BUZZER_STOP_STATE, esp_buzzer_get_state(&buzzer));
+	TEST_ASSERT_EQUAL(0, uxQueueMessagesWaiting(buzzer.queue_handle));
+}
+
+/* A beep played forever is silenced by the stop and doesn't come back */
+static void test_stop(void) {
+	event_t ev[EVENTS_MAX];
+
+	esp_buzzer_start(&buzzer, 20, 20, 0);
+	vTaskDelay(pdMS_TO_TICKS(130));
+	TEST_ASSERT_EQUAL(BUZZER_RUN_STATE, esp_buzzer_get_state(&buzzer));
+
+	esp_buzzer_stop(&buzzer);
+	events_reset();
+	vTaskDelay(pdMS_TO_TICKS(100));
+
+	TEST_ASSERT_EQUAL(0, events_get(EVENT_GPIO, ev));
+	TEST_ASSERT_EQUAL(BUZZER_STOP_STATE, esp_buzzer_get_state(&buzzer));
+	TEST_ASSERT(!buzzer.level);
+
+	/* A start without on time is a stop */
+	esp_buzzer_start(&buzzer, 20, 20, 0);
+	esp_buzzer_start(&buzzer, 0, 20, 0);
+	TEST_ASSERT_EQUAL(BUZZER_STOP_STATE, esp_buzzer_get_state(&buzzer));
+	TEST_ASSERT(!buzzer.level);
+}
+
+/* The step interrupted by a pause is played again in full */
+static void test_pause(void) {
+	event_t ev[EVENTS_MAX];
+
+	events_reset();
+	esp_buzzer_start(&buzzer, 80, 0, 1);
+	vTaskDelay(pdMS_TO_TICKS(20));
+
+	esp_buzzer_pause(&buzzer, 50);
+	TEST_ASSERT_EQUAL(BUZZER_PAUSE_STATE, esp_buzzer_get_state(&buzzer));
+	TEST_ASSERT(wait_stopped(&buzzer, 1000));
+
+	uint32_t num = events_get(EVENT_GPIO, ev);
+
+	TEST_ASSERT_EQUAL(4, num);
+	TEST_ASSERT_EQUAL(1, ev[0].value);
+	TEST_ASSERT_EQUAL(0, ev[1].value);
+	TEST_ASSERT_EQUAL(1, ev[2].value);
+	TEST_ASSERT_EQUAL(0, ev[3].value);
+	TEST_ASSERT(ev[2].time - ev[1].time >= 50000);
+	TEST_ASSERT(ev[3].time - ev[2].time >= 80000);
+
+	/* Nothing to pause once stopped */
+	esp_buzzer_pause(&buzzer, 50);
+	TEST_ASSERT_EQUAL(BUZZER_STOP_STATE, esp_buzzer_get_state(&buzzer));
+}
+
+/* The LEDC backend plays the step tones at the set volume, and keeps the
+ * APB clock only while it sounds */
+static void test_ledc(void) {
+	static const esp_buzzer_step_t steps[] = {
+			{.level = true, .duration = 30, .tone = 440},
+			{.level = false, .duration = 20},
+			{.level = true, .duration = 30},
+			{.level = false, .duration = 20},
+	};
+	const esp_buzzer_seq_t seq = {.steps = steps, .steps_num = 4, .times = 1};
+	event_t ev[EVENTS_MAX];
+	uint32_t num;
+
+	TEST_ASSERT_EQUAL(ESP_ERR_NOT_SUPPORTED, esp_buzzer_set_tone(&buzzer, 1000));
+	TEST_ASSERT_EQUAL(ESP_ERR_NOT_SUPPORTED, esp_buzzer_set_volume(&buzzer, 50));
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_buzzer_set_tone(&piezo, 0));
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_buzzer_set_volume(&piezo, 101));
+	TEST_ASSERT_EQUAL(CONFIG_ESP_BUZZER_LEDC_TONE, ledc_timers[piezo.ledc_timer].freq_hz);
+	TEST_ASSERT_EQUAL(LEDC_TIMER_10_BIT, ledc_timers[piezo.ledc_timer].duty_resolution);
+
+	events_reset();
+	TEST_ASSERT_EQUAL(ESP_OK, esp_buzzer_set_volume(&piezo, 50));
+	TEST_ASSERT_EQUAL(ESP_OK, esp_buzzer_enqueue(&piezo, &seq, 0));
+	TEST_ASSERT_EQUAL(1, host_pm_lock_count(piezo.pm_lock));
+	TEST_ASSERT(wait_stopped(&piezo, 1000));
+	TEST_ASSERT_EQUAL(0, host_pm_lock_count(piezo.pm_lock));
+
+	num = events_get(EVENT_FREQ, ev);
+	TEST_ASSERT_EQUAL(2, num);
+	TEST_ASSERT_EQUAL(440, ev[0].value);
+	TEST_ASSERT_EQUAL(CONFIG_ESP_BUZZER_LEDC_TONE, ev[1].value);
+
+	num = events_get(EVENT_DUTY, ev);
+	TEST_ASSERT_EQUAL(5, num);
+
+	for (uint32_t i = 0; i < 4; i++) {
+		TEST_ASSERT_EQUAL(i % 2 ? 0 : DUTY_MAX / 2, ev[i].value);
+	}
+
+	/* A volume change is heard right away while sounding */
+	TEST_ASSERT_EQUAL(ESP_OK, esp_buzzer_set_tone(&piezo, 1000));
+	esp_buzzer_start(&piezo, 200, 0, 1);
+	events_reset();
+	TEST_ASSERT_EQUAL(ESP_OK, esp_buzzer_set_volume(&piezo, 100));
+	num = events_get(EVENT_DUTY, ev);
+	TEST_ASSERT_EQUAL(1, num);
+	TEST_ASSERT_EQUAL(DUTY_MAX, ev[0].value);
+
+	esp_buzzer_stop(&piezo);
+	TEST_ASSERT_EQUAL(0, host_pm_lock_count(piezo.pm_lock));
+}
+
+/* A failed initialization gives its timer and channel back */
+static void test_ledc_error(void) {
+	esp_buzzer_t failed;
+
+	ledc_error = ESP_FAIL;
+
+	for (uint32_t i = 0; i < LEDC_TIMER_MAX * 2; i++) {
+		TEST_ASSERT_EQUAL(ESP_FAIL, esp_buzzer_init(&failed, GPIO_PIEZO, ESP_BUZZER_LEDC_BACKEND));
+		TEST_ASSERT_EQUAL(piezo.ledc_timer + 1, ledc_last_timer);
+	}
+
+	ledc_error = ESP_OK;
+}
+
+/* Each LEDC instance takes its own timer and channel until they run out */
+static void test_ledc_instances(void) {
+	esp_buzzer_t piezos[LEDC_TIMER_MAX];
+	uint32_t num = 0;
+
+	while (num < LEDC_TIMER_MAX && esp_buzzer_init(&piezos[num], GPIO_PIEZO, ESP_BUZZER_LEDC_BACKEND) == ESP_OK) {
+		TEST_ASSERT_EQUAL(piezo.ledc_timer + num + 1, piezos[num].ledc_timer);
+		TEST_ASSERT_EQUAL(piezo.ledc_channel + num + 1, piezos[num].ledc_channel);
+		num++;
+	}
+
+	TEST_ASSERT_EQUAL(LEDC_TIMER_MAX - 1 - CONFIG_ESP_BUZZER_LEDC_TIMER, num);
+	TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_buzzer_init(&piezos[num], GPIO_PIEZO, ESP_BUZZER_LEDC_BACKEND));
+}
+
+/***************************** END OF FILE ************************************/
@@ -35,8 +35,12 @@
 /* Includes ------------------------------------------------------------------*/
 #include "esp_rgb_led.h"
 #include "esp_log.h"
+#include "task_prof.h"
+#include "cycle_trace.h"
 
 /* Private macro -------------------------------------------------------------*/
+#define ANIM_FRAME_TICKS	(pdMS_TO_TICKS(1000 / CONFIG_ESP_RGB_LED_ANIM_FPS) ? \
+		pdMS_TO_TICKS(1000 / CONFIG_ESP_RGB_LED_ANIM_FPS) : 1)
 
 /* External variables --------------------------------------------------------*/
 
@@ -45,8 +49,13 @@
 /* Private variables ---------------------------------------------------------*/
 static const char * TAG = "rgb_led";
 
+TASK_PROF_HIST_DEFINE(timer_hist, "timer_handler");
+
 /* Private function prototypes -----------------------------------------------*/
 static void timer_handler(TimerHandle_t timer);
+static void blink_halt(esp_rgb_led_t * const me);
+static void anim_task(void *arg);
+static esp_err_t led_refresh(esp_rgb_led_t * const me);
 
 /* Exported functions --------------------------------------------------------*/
 /**
@@ -61,6 +70,10 @@ esp_err_t esp_rgb_led_init(esp_rgb_led_t * const me, uint32_t gpio_num, uint16_t
 	me->gpio_num = gpio_num;
 	me->led_num = led_num;
 	me->led_state = true;
+	me->hw_blink = false;
+	me->anim_task = NULL;
+	me->anim.type = ESP_RGB_LED_ANIM_NONE;
+	me->anim_gen = 0;
 
 	/* Configure the PGIO and the RGB LEDs number */
 	led_strip_config_t rgb_led_config = {
@@ -71,6 +84,7 @@ esp_err_t esp_rgb_led_init(esp_rgb_led_t * const me, uint32_t gpio_num, uint16_t
 	/* Configure RMT ticks resolution */
 	led_strip_rmt_config_t rmt_config = {
 			.resolution_hz = 10 * 1000 * 1000,
+			.mem_block_symbols = CONFIG_ESP_RGB_LED_RMT_MEM_BLOCK_SYMBOLS,
 	};
 
 	ret = led_strip_new_rmt_device(&rgb_led_config, &rmt_config, &me->led_handle);
@@ -95,6 +109,14 @@ esp_err_t esp_rgb_led_init(esp_rgb_led_t * const me, uint32_t gpio_num, uint16_t
 			(void *)me,
 			timer_handler);
 
+	/* Serialize the animation frames with the start and stop requests */
+	me->anim_mutex = xSemaphoreCreateMutex();
+
+	if (me->timer_handle == NULL || me->anim_mutex == NULL) {
+		ESP_LOGE(TAG, "Error allocating the blink timer or the animation mutex");
+		return ESP_ERR_NO_MEM;
+	}
+
 	ESP_LOGI(TAG, "Done ");
 
 	/* Return ESP_OK */
@@ -106,10 +128,25 @@ esp_err_t esp_rgb_led_init(esp_rgb_led_t * const me, uint32_t gpio_num, uint16_t
   */
 void esp_rgb_led_set(esp_rgb_led_t * const me, uint8_t r, uint8_t g, uint8_t b) {
 	/* Turning on all the RGB LEDs */
-	for (uint8_t i = 0; i < me->led_num; i++) {
-		led_strip_set_pixel(me->led_handle, i, r, g, b);
+	led_strip_fill(me->led_handle, 0, me->led_num, r, g, b);
+
+	/* Start the transfer and return, the strip keeps a copy of the frame */
+	led_refresh(me);
+}
+
+/**
+  * @brief Function to set the global brightness of all RGB LEDs
+  */
+esp_err_t esp_rgb_led_set_brightness(esp_rgb_led_t * const me, uint8_t brightness) {
+	esp_err_t ret = led_strip_set_brightness(me->led_handle, brightness);
+
+	if (ret != ESP_OK) {
+		ESP_LOGE(TAG, "Error setting the RGB LEDs brightness");
+		return ret;
 	}
-	led_strip_refresh(me->led_handle);
+
+	/* Send the current colors again with the new brightness */
+	return led_refresh(me);
 }
 
 /**
@@ -127,6 +164,22 @@ void esp_rgb_led_blink_start(esp_rgb_led_t * const me, uint16_t time, uint8_t r,
 	me->rgb.g = g;
 	me->rgb.b = b;
 
+	esp_rgb_led_anim_stop(me);
+	blink_halt(me);
+	led_strip_fill(me->led_handle, 0, me->led_num, r, g, b);
+
+	/* Let the RMT peripheral loop the blink, if it fits in its memory */
+#ifdef CONFIG_ESP_RGB_LED_HW_BLINK
+	if (led_strip_blink_start(me->led_handle, time, time) == ESP_OK) {
+		me->hw_blink = true;
+		return;
+	}
+#endif
+
+	/* Fall back to the software timer */
+	me->hw_blink = false;
+	me->led_state = true;
+
 	xTimerChangePeriod(me->timer_handle,
 			pdMS_TO_TICKS(time),
 			0);
@@ -139,22 +192,135 @@ void esp_rgb_led_blink_start(esp_rgb_led_t * const me, uint16_t time, uint8_t r,
   * @brief Function to stop the blink operation
   */
 void esp_rgb_led_blink_stop(esp_rgb_led_t * const me) {
-	xTimerStop(me->timer_handle, 0);
+	blink_halt(me);
 	esp_rgb_led_clear(me);
 }
 
+/**
+  * @brief Function to start an animation
+  */
+esp_err_t esp_rgb_led_anim_start(esp_rgb_led_t * const me, const esp_rgb_led_anim_t * const anim) {
+	if (anim == NULL || anim->type == ESP_RGB_LED_ANIM_NONE || anim->type >= ESP_RGB_LED_ANIM_MAX ||
+			(anim->type == ESP_RGB_LED_ANIM_KEYFRAMES && (anim->keyframes == NULL || anim->keyframes_num == 0))) {
+		ESP_LOGE(TAG, "Invalid animation");
+		return ESP_ERR_INVALID_ARG;
+	}
+
+	/* Create the animation task the first time it is needed */
+	if (me->anim_task == NULL) {
+		if (xTaskCreate(anim_task,
+				"RGB LED Anim Task",
+				CONFIG_ESP_RGB_LED_ANIM_TASK_STACK_SIZE,
+				(void *)me,
+				CONFIG_ESP_RGB_LED_ANIM_TASK_PRIORITY,
+				&me->anim_task) != pdPASS) {
+			ESP_LOGE(TAG, "Error creating the animation task");
+			return ESP_ERR_NO_MEM;
+		}
+	}
+
+	blink_halt(me);
+
+	xSemaphoreTake(me->anim_mutex, portMAX_DELAY);
+	me->anim = *anim;
+	me->anim_gen++;
+	xSemaphoreGive(me->anim_mutex);
+
+	/* Wake up the animation task if it is idle */
+	xTaskNotifyGive(me->anim_task);
+
+	return ESP_OK;
+}
+
+/**
+  * @brief Function to stop the running animation
+  */
+void esp_rgb_led_anim_stop(esp_rgb_led_t * const me) {
+	/* Once the mutex is released the task doesn't send any other frame */
+	xSemaphoreTake(me->anim_mutex, portMAX_DELAY);
+	me->anim.type = ESP_RGB_LED_ANIM_NONE;
+	xSemaphoreGive(me->anim_mutex);
+}
+
 /* Private functions ---------------------------------------------------------*/
+static void blink_halt(esp_rgb_led_t * const me) {
+	if (me->hw_blink) {
+		led_strip_blink_stop(me->led_handle);
+		me->hw_blink = false;
+	}
+	else {
+		xTimerStop(me->timer_handle, 0);
+	}
+}
+
+static void anim_task(void *arg) {
+	esp_rgb_led_t * rgb_led = (esp_rgb_led_t *)arg;
+	TickType_t last_wake = xTaskGetTickCount();
+	TickType_t start = last_wake;
+	uint32_t gen = rgb_led->anim_gen;
+
+	for (;;) {
+		xSemaphoreTake(rgb_led->anim_mutex, portMAX_DELAY);
+
+		if (rgb_led->anim.type == ESP_RGB_LED_ANIM_NONE) {
+			xSemaphoreGive(rgb_led->anim_mutex);
+
+			/* Sleep until the next animation is started */
+			ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+			last_wake = xTaskGetTickCount();
+			continue;
+		}
+
+		/* Restart the clock when a new animation was started */
+		if (rgb_led->anim_gen != gen) {
+			gen = rgb_led->anim_gen;
+			start = xTaskGetTickCount();
+		}
+
+		rgb_t rgb;
+		uint32_t time_ms = (xTaskGetTickCount() - start) * portTICK_PERIOD_MS;
+		bool running = esp_rgb_led_anim_render(&rgb_led->anim, time_ms, &rgb);
+
+		/* One refresh per frame at most, unchanged frames are skipped by the driver */
+		led_strip_fill(rgb_led->led_handle, 0, rgb_led->led_num, rgb.r, rgb.g, rgb.b);
+		led_refresh(rgb_led);
+
+		if (!running) {
+			rgb_led->anim.type = ESP_RGB_LED_ANIM_NONE;
+		}
+
+		xSemaphoreGive(rgb_led->anim_mutex);
+
+		vTaskDelayUntil(&last_wake, ANIM_FRAME_TICKS);
+	}
+}
+
+static esp_err_t led_refresh(esp_rgb_led_t * const me) {
+	/* Only the submission is traced, the frame is sent in the background */
+	CYCLE_TRACE_BEGIN("led_strip_refresh");
+	esp_err_t ret = led_strip_refresh_async(me->led_handle);
+	CYCLE_TRACE_END("led_strip_refresh");
+
+	return ret;
+}
+
 static void timer_handler(TimerHandle_t timer) {
+	TASK_PROF_START(start);
+	CYCLE_TRACE_BEGIN("rgb_led_timer");
 	esp_rgb_led_t * rgb_led = (esp_rgb_led_t *)pvTimerGetTimerID(timer);
 
 	rgb_led->led_state = !rgb_led->led_state;
 
+	/* Don't block the timer daemon task waiting for the RMT transfer */
 	if (rgb_led->led_state) {
 		esp_rgb_led_set(rgb_led, rgb_led->rgb.r, rgb_led->rgb.g, rgb_led->rgb.b);
 	}
 	else {
-		led_strip_clear(rgb_led->led_handle);
+		esp_rgb_led_set(rgb_led, 0, 0, 0);
 	}
+
+	CYCLE_TRACE_END("rgb_led_timer");
+	TASK_PROF_END(timer_hist, start);
 }
 
 /***************************** END OF FILE ************************************/
@@ -0,0 +1,190 @@
+/**
+  ******************************************************************************
+  * @file           : esp_rgb_led_anim.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Fixed-point keyframe animations for RGB LEDs
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "esp_rgb_led_anim.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define Q16_ONE	(1UL << 16)
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t ease(uint32_t t, esp_rgb_led_ease_e mode);
+static uint8_t lerp(uint8_t a, uint8_t b, uint32_t t);
+static void lerp_rgb(const led_strip_rgb_t *a, const led_strip_rgb_t *b, uint32_t t, led_strip_rgb_t *rgb);
+static bool render_keyframes(const esp_rgb_led_anim_t * const anim, uint32_t time_ms, led_strip_rgb_t *rgb);
+static void render_breathe(const esp_rgb_led_anim_t * const anim, uint32_t time_ms, led_strip_rgb_t *rgb);
+static void render_hue(const esp_rgb_led_anim_t * const anim, uint32_t time_ms, led_strip_rgb_t *rgb);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief Function to render the color of an animation at a given time
+  */
+bool esp_rgb_led_anim_render(const esp_rgb_led_anim_t * const anim, uint32_t time_ms, led_strip_rgb_t *rgb) {
+	switch (anim->type) {
+		case ESP_RGB_LED_ANIM_KEYFRAMES:
+			return render_keyframes(anim, time_ms, rgb);
+
+		case ESP_RGB_LED_ANIM_BREATHE:
+			render_breathe(anim, time_ms, rgb);
+			return true;
+
+		case ESP_RGB_LED_ANIM_HUE:
+			render_hue(anim, time_ms, rgb);
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+/**
+  * @brief Function to convert a HSV color to RGB
+  */
+void esp_rgb_led_anim_hsv_to_rgb(uint16_t hue, uint8_t saturation, uint8_t value, led_strip_rgb_t *rgb) {
+	hue %= ESP_RGB_LED_ANIM_HUE_MAX;
+
+	uint32_t sector = hue >> 8;
+	uint32_t f = hue & 0xFF;
+	uint8_t p = value * (255 - saturation) / 255;
+	uint8_t q = value * (255 * 255 - saturation * f) / (255 * 255);
+	uint8_t t = value * (255 * 255 - saturation * (255 - f)) / (255 * 255);
+
+	switch (sector) {
+		case 0:  *rgb = (led_strip_rgb_t){.r = value, .g = t, .b = p}; break;
+		case 1:  *rgb = (led_strip_rgb_t){.r = q, .g = value, .b = p}; break;
+		case 2:  *rgb = (led_strip_rgb_t){.r = p, .g = value, .b = t}; break;
+		case 3:  *rgb = (led_strip_rgb_t){.r = p, .g = q, .b = value}; break;
+		case 4:  *rgb = (led_strip_rgb_t){.r = t, .g = p, .b = value}; break;
+		default: *rgb = (led_strip_rgb_t){.r = value, .g = p, .b = q}; break;
+	}
+}
+
+/* Private functions ---------------------------------------------------------*/
+/* Map a Q16 progress through the easing curve */
+static uint32_t ease(uint32_t t, esp_rgb_led_ease_e mode) {
+	switch (mode) {
+		case ESP_RGB_LED_EASE_IN_OUT:
+			/* t * t * (3 - 2 * t) */
+			return (uint32_t)(((uint64_t)t * t >> 16) * (3 * Q16_ONE - 2 * t) >> 16);
+
+		case ESP_RGB_LED_EASE_STEP:
+			return t < Q16_ONE ? 0 : Q16_ONE;
+
+		default:
+			return t;
+	}
+}
+
+static uint8_t lerp(uint8_t a, uint8_t b, uint32_t t) {
+	return a + (((int32_t)b - a) * (int32_t)(t >> 1) >> 15);
+}
+
+static void lerp_rgb(const led_strip_rgb_t *a, const led_strip_rgb_t *b, uint32_t t, led_strip_rgb_t *rgb) {
+	rgb->r = lerp(a->r, b->r, t);
+	rgb->g = lerp(a->g, b->g, t);
+	rgb->b = lerp(a->b, b->b, t);
+}
+
+static bool render_keyframes(const esp_rgb_led_anim_t * const anim, uint32_t time_ms, led_strip_rgb_t *rgb) {
+	const esp_rgb_led_keyframe_t *kf = anim->keyframes;
+	uint16_t num = anim->keyframes_num;
+
+	if (kf == NULL || num == 0) {
+		return false;
+	}
+
+	uint32_t length = kf[num - 1].time_ms;
+
+	if (time_ms >= length) {
+		if (!anim->loop || length == 0) {
+			*rgb = kf[num - 1].rgb;
+			return false;
+		}
+
+		time_ms %= length;
+	}
+
+	/* Before the first keyframe its color is held */
+	if (time_ms <= kf[0].time_ms) {
+		*rgb = kf[0].rgb;
+		return true;
+	}
+
+	/* A handful of keyframes is expected, a linear search is enough */
+	uint16_t i = 1;
+
+	while (kf[i].time_ms <= time_ms) {
+		i++;
+	}
+
+	uint32_t span = kf[i].time_ms - kf[i - 1].time_ms;
+	uint32_t t = (uint32_t)(((uint64_t)(time_ms - kf[i - 1].time_ms) << 16) / span);
+
+	lerp_rgb(&kf[i - 1].rgb, &kf[i].rgb, ease(t, kf[i].ease), rgb);
+
+	return true;
+}
+
+static void render_breathe(const esp_rgb_led_anim_t * const anim, uint32_t time_ms, led_strip_rgb_t *rgb) {
+	static const led_strip_rgb_t off = {0};
+
+	if (anim->period_ms == 0) {
+		*rgb = anim->rgb;
+		return;
+	}
+
+	/* Triangle wave, eased so the LEDs linger at both ends */
+	uint32_t phase = (uint32_t)(((uint64_t)(time_ms % anim->period_ms) << 16) / anim->period_ms);
+	uint32_t level = phase < Q16_ONE / 2 ? phase * 2 : (Q16_ONE - phase) * 2;
+
+	lerp_rgb(&off, &anim->rgb, ease(level, ESP_RGB_LED_EASE_IN_OUT), rgb);
+}
+
+static void render_hue(const esp_rgb_led_anim_t * const anim, uint32_t time_ms, led_strip_rgb_t *rgb) {
+	uint16_t hue = 0;
+
+	if (anim->period_ms) {
+		hue = (uint64_t)(time_ms % anim->period_ms) * ESP_RGB_LED_ANIM_HUE_MAX / anim->period_ms;
+	}
+
+	esp_rgb_led_anim_hsv_to_rgb(hue, anim->saturation, anim->value, rgb);
+}
+
+/***************************** END OF FILE ************************************/
@@ -45,17 +45,16 @@ extern "C" {
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/timers.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
 
 #include "led_strip.h"
+#include "esp_rgb_led_anim.h"
 
 /* Exported macro ------------------------------------------------------------*/
 
 /* Exported typedef ----------------------------------------------------------*/
-typedef struct {
-	uint8_t r;
-	uint8_t g;
-	uint8_t b;
-} rgb_t;
+typedef led_strip_rgb_t rgb_t;
 
 typedef struct {
 	led_strip_handle_t led_handle;
@@ -63,7 +62,12 @@ typedef struct {
 	uint16_t led_num;
 	TimerHandle_t timer_handle;
 	bool led_state;
+	bool hw_blink;
 	rgb_t rgb;
+	TaskHandle_t anim_task;
+	SemaphoreHandle_t anim_mutex;
+	esp_rgb_led_anim_t anim;
+	uint32_t anim_gen;
 } esp_rgb_led_t;
 /* Exported variables --------------------------------------------------------*/
 
@@ -91,6 +95,21 @@ esp_err_t esp_rgb_led_init(esp_rgb_led_t * const me, uint32_t gpio_num, uint16_t
   */
 void esp_rgb_led_set(esp_rgb_led_t * const me, uint8_t r, uint8_t g, uint8_t b);
 
+/**
+  * @brief Function to set the global brightness of all RGB LEDs
+  *
+  * @note The stored colors are kept, the brightness is applied while they
+  *       are sent to the LEDs
+  *
+  * @param me         : Pointer to a esp_rgb_led_t structure
+  * @param brightness : Brightness value, 255 is full brightness
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_NOT_SUPPORTED if the LED driver can't scale colors
+  */
+esp_err_t esp_rgb_led_set_brightness(esp_rgb_led_t * const me, uint8_t brightness);
+
 /**
   * @brief Function to clear all RGB LEDs
   *
@@ -101,6 +120,9 @@ void esp_rgb_led_clear(esp_rgb_led_t * const me);
 /**
   * @brief Function to start the blink operation
   *
+  * @note The blink is looped by the RMT peripheral when the pattern fits in
+  *       its memory, otherwise a software timer toggles the RGB LEDs
+  *
   * @param me   : Pointer to a esp_rgb_led_t structure
   * @param time : Blink time in miliseconds
   * @param r    : Red color value
@@ -116,6 +138,35 @@ void esp_rgb_led_blink_start(esp_rgb_led_t * const me, uint16_t time, uint8_t r,
   */
 void esp_rgb_led_blink_stop(esp_rgb_led_t * const me);
 
+/**
+  * @brief Function to start an animation
+  *
+  * @note The frames are rendered by a dedicated task at
+  *       CONFIG_ESP_RGB_LED_ANIM_FPS, created on the first call. Any blink is
+  *       stopped, and the animation owns the RGB LEDs until it finishes or
+  *       esp_rgb_led_anim_stop() is called
+  *
+  * @param me   : Pointer to a esp_rgb_led_t structure
+  * @param anim : Pointer to the animation, it is copied but its keyframes
+  *               must stay valid while it runs
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_INVALID_ARG if the animation is invalid
+  * 	- ESP_ERR_NO_MEM if the animation task can't be created
+  */
+esp_err_t esp_rgb_led_anim_start(esp_rgb_led_t * const me, const esp_rgb_led_anim_t * const anim);
+
+/**
+  * @brief Function to stop the running animation
+  *
+  * @note The RGB LEDs keep the last rendered color, no frame is sent once
+  *       this function returns
+  *
+  * @param me : Pointer to a esp_rgb_led_t structure
+  */
+void esp_rgb_led_anim_stop(esp_rgb_led_t * const me);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,121 @@
+/**
+  ******************************************************************************
+  * @file           : esp_rgb_led_anim.h
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Fixed-point keyframe animations for RGB LEDs
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ESP_RGB_LED_ANIM_H_
+#define ESP_RGB_LED_ANIM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "led_strip_types.h"
+
+/* Exported macro ------------------------------------------------------------*/
+#define ESP_RGB_LED_ANIM_HUE_MAX	1536	/* 6 sectors of 256 steps */
+
+/* Exported typedef ----------------------------------------------------------*/
+typedef enum {
+	ESP_RGB_LED_ANIM_NONE = 0,
+	ESP_RGB_LED_ANIM_KEYFRAMES,	/* Interpolate between keyframes */
+	ESP_RGB_LED_ANIM_BREATHE,	/* Fade a color in and out */
+	ESP_RGB_LED_ANIM_HUE,		/* Rotate the hue around the color wheel */
+	ESP_RGB_LED_ANIM_MAX,
+} esp_rgb_led_anim_type_e;
+
+typedef enum {
+	ESP_RGB_LED_EASE_LINEAR = 0,
+	ESP_RGB_LED_EASE_IN_OUT,	/* Smoothstep, slow at both ends */
+	ESP_RGB_LED_EASE_STEP,		/* Jump to the keyframe color at its time */
+} esp_rgb_led_ease_e;
+
+typedef struct {
+	uint32_t time_ms;			/* Time the color is reached, from the animation start */
+	led_strip_rgb_t rgb;
+	esp_rgb_led_ease_e ease;	/* Interpolation from the previous keyframe */
+} esp_rgb_led_keyframe_t;
+
+typedef struct {
+	esp_rgb_led_anim_type_e type;
+	const esp_rgb_led_keyframe_t *keyframes;	/* Keyframes sorted by time, not copied */
+	uint16_t keyframes_num;
+	bool loop;					/* Restart the keyframes after the last one */
+	led_strip_rgb_t rgb;		/* Breathe color */
+	uint32_t period_ms;			/* Breathe and hue rotation period */
+	uint8_t saturation;			/* Hue rotation saturation */
+	uint8_t value;				/* Hue rotation value */
+} esp_rgb_led_anim_t;
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions prototypes ---------------------------------------------*/
+/**
+  * @brief Function to render the color of an animation at a given time
+  *
+  * @note Only integer arithmetic is used, so it can run at any frame rate
+  *       without the FPU and it renders the same on the host
+  *
+  * @param anim    : Pointer to a esp_rgb_led_anim_t structure
+  * @param time_ms : Time elapsed since the animation start in milliseconds
+  * @param rgb     : Rendered color
+  *
+  * @retval
+  * 	- true while the animation is running
+  * 	- false once a non looping animation has finished, rgb holds its last
+  * 	  color
+  */
+bool esp_rgb_led_anim_render(const esp_rgb_led_anim_t * const anim, uint32_t time_ms, led_strip_rgb_t *rgb);
+
+/**
+  * @brief Function to convert a HSV color to RGB
+  *
+  * @param hue        : Hue, from 0 to ESP_RGB_LED_ANIM_HUE_MAX - 1
+  * @param saturation : Saturation
+  * @param value      : Value
+  * @param rgb        : Converted color
+  */
+void esp_rgb_led_anim_hsv_to_rgb(uint16_t hue, uint8_t saturation, uint8_t value, led_strip_rgb_t *rgb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESP_RGB_LED_ANIM_H_ */
+
+/***************************** END OF FILE ************************************/
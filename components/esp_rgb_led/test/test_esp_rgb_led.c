@@ -0,0 +1,462 @@
+/**
+  ******************************************************************************
+  * @file           : test_esp_rgb_led.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Host test of the esp_rgb_led animations
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <time.h>
+
+#include "host_test.h"
+#include "esp_rgb_led.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define LED_GPIO				18
+#define LED_NUM					4
+#define FRAMES_MAX				256
+#define FRAME_MS				(1000 / CONFIG_ESP_RGB_LED_ANIM_FPS)
+#define RENDER_FRAMES			100000
+#define RENDER_FRAME_NS_MAX		10000	/* On the host, 0.05 % of a frame at 50 FPS */
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+	led_strip_rgb_t rgb;
+	TickType_t tick;
+} frame_t;
+
+/* Fake strip, every pixel gets the same color so only one is kept. A
+ * refresh sends a frame when the color changed since the previous one */
+struct led_strip_t {
+	led_strip_rgb_t rgb;
+	bool dirty;
+	uint32_t refreshes;
+	uint32_t frames_num;
+	frame_t frames[FRAMES_MAX];
+};
+
+/* Private variables ---------------------------------------------------------*/
+static struct led_strip_t strip;
+static portMUX_TYPE strip_lock = portMUX_INITIALIZER_UNLOCKED;
+static esp_rgb_led_t rgb_led;
+
+static const esp_rgb_led_keyframe_t keyframes[] = {
+		{0, {255, 0, 0}, ESP_RGB_LED_EASE_LINEAR},
+		{1000, {0, 0, 255}, ESP_RGB_LED_EASE_LINEAR},
+		{2000, {0, 255, 0}, ESP_RGB_LED_EASE_IN_OUT},
+		{3000, {0, 0, 0}, ESP_RGB_LED_EASE_STEP},
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static void strip_reset(void);
+static uint32_t strip_frames(frame_t *last);
+static bool rgb_equal(led_strip_rgb_t a, uint8_t r, uint8_t g, uint8_t b);
+static void test_keyframes(void);
+static void test_keyframes_loop(void);
+static void test_breathe(void);
+static void test_hue(void);
+static uint64_t render_frame_ns(const esp_rgb_led_anim_t *anim);
+static void test_render_time(void);
+static void test_anim_args(void);
+static void test_anim_run(void);
+static void test_anim_stop(void);
+static void test_anim_blink(void);
+
+/* Main ----------------------------------------------------------------------*/
+int main(void) {
+	RUN_TEST(test_keyframes);
+	RUN_TEST(test_keyframes_loop);
+	RUN_TEST(test_breathe);
+	RUN_TEST(test_hue);
+	RUN_TEST(test_render_time);
+
+	TEST_ASSERT_EQUAL(ESP_OK, esp_rgb_led_init(&rgb_led, LED_GPIO, LED_NUM));
+
+	RUN_TEST(test_anim_args);
+	RUN_TEST(test_anim_run);
+	RUN_TEST(test_anim_stop);
+	RUN_TEST(test_anim_blink);
+
+	return 0;
+}
+
+/* Fake led_strip ------------------------------------------------------------*/
+esp_err_t led_strip_new_rmt_device(const led_strip_config_t *led_config, const led_strip_rmt_config_t *rmt_config, led_strip_handle_t *ret_strip) {
+	TEST_ASSERT_EQUAL(LED_NUM, led_config->max_leds);
+	*ret_strip = &strip;
+
+	return ESP_OK;
+}
+
+esp_err_t led_strip_fill(led_strip_handle_t strip, uint32_t start, uint32_t count, uint32_t red, uint32_t green, uint32_t blue) {
+	TEST_ASSERT(start == 0 && count == LED_NUM);
+
+	portENTER_CRITICAL(&strip_lock);
+
+	if (!rgb_equal(strip->rgb, red, green, blue)) {
+		strip->rgb = (led_strip_rgb_t){.r = red, .g = green, .b = blue};
+		strip->dirty = true;
+	}
+
+	portEXIT_CRITICAL(&strip_lock);
+
+	return ESP_OK;
+}
+
+esp_err_t led_strip_refresh_async(led_strip_handle_t strip) {
+	portENTER_CRITICAL(&strip_lock);
+
+	strip->refreshes++;
+
+	if (strip->dirty && strip->frames_num < FRAMES_MAX) {
+		strip->frames[strip->frames_num].rgb = strip->rgb;
+		strip->frames[strip->frames_num].tick = xTaskGetTickCount();
+		strip->frames_num++;
+	}
+
+	strip->dirty = false;
+
+	portEXIT_CRITICAL(&strip_lock);
+
+	return ESP_OK;
+}
+
+esp_err_t led_strip_clear(led_strip_handle_t strip) {
+	led_strip_fill(strip, 0, LED_NUM, 0, 0, 0);
+
+	return led_strip_refresh_async(strip);
+}
+
+esp_err_t led_strip_set_brightness(led_strip_handle_t strip, uint8_t brightness) {
+	return ESP_OK;
+}
+
+esp_err_t led_strip_blink_start(led_strip_handle_t strip, uint32_t on_ms, uint32_t off_ms) {
+	return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t led_strip_blink_stop(led_strip_handle_t strip) {
+	return ESP_OK;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static void strip_reset(void) {
+	portENTER_CRITICAL(&strip_lock);
+	strip.refreshes = 0;
+	strip.frames_num = 0;
+	portEXIT_CRITICAL(&strip_lock);
+}
+
+static uint32_t strip_frames(frame_t *last) {
+	portENTER_CRITICAL(&strip_lock);
+
+	uint32_t frames_num = strip.frames_num;
+
+	if (last != NULL && frames_num) {
+		*last = strip.frames[frames_num - 1];
+	}
+
+	portEXIT_CRITICAL(&strip_lock);
+
+	return frames_num;
+}
+
+static bool rgb_equal(led_strip_rgb_t a, uint8_t r, uint8_t g, uint8_t b) {
+	return a.r == r && a.g == g && a.b == b;
+}
+
+/* The keyframe colors are reached at their time, the ease shapes the way */
+static void test_keyframes(void) {
+	esp_rgb_led_anim_t anim = {
+			.type = ESP_RGB_LED_ANIM_KEYFRAMES,
+			.keyframes = keyframes,
+			.keyframes_num = sizeof(keyframes) / sizeof(keyframes[0]),
+	};
+	led_strip_rgb_t rgb;
+	led_strip_rgb_t prev;
+
+	TEST_ASSERT(esp_rgb_led_anim_render(&anim, 0, &rgb));
+	TEST_ASSERT(rgb_equal(rgb, 255, 0, 0));
+	TEST_ASSERT(esp_rgb_led_anim_render(&anim, 500, &rgb));
+	TEST_ASSERT(rgb_equal(rgb, 127, 0, 127));
+	TEST_ASSERT(esp_rgb_led_anim_render(&anim, 1000, &rgb));
+	TEST_ASSERT(rgb_equal(rgb, 0, 0, 255));
+
+	/* Smoothstep is at half way in the middle, slower than linear before */
+	TEST_ASSERT(esp_rgb_led_anim_render(&anim, 1500, &rgb));
+	TEST_ASSERT(rgb_equal(rgb, 0, 127, 127));
+	TEST_ASSERT(esp_rgb_led_anim_render(&anim, 1250, &rgb));
+	TEST_ASSERT(rgb.g < 255 / 4);
+
+	/* A step holds the previous color until the keyframe time */
+	TEST_ASSERT(esp_rgb_led_anim_render(&anim, 2999, &rgb));
+	TEST_ASSERT(rgb_equal(rgb, 0, 255, 0));
+
+	/* Then the last color is held and the animation ends */
+	TEST_ASSERT(!esp_rgb_led_anim_render(&anim, 3000, &rgb));
+	TEST_ASSERT(rgb_equal(rgb, 0, 0, 0));
+	TEST_ASSERT(!esp_rgb_led_anim_render(&anim, UINT32_MAX, &rgb));
+
+	/* A linear segment only moves towards the next keyframe */
+	esp_rgb_led_anim_render(&anim, 0, &prev);
+
+	for (uint32_t t = 10; t <= 1000; t += 10) {
+		esp_rgb_led_anim_render(&anim, t, &rgb);
+		TEST_ASSERT(rgb.r <= prev.r && rgb.b >= prev.b);
+		prev = rgb;
+	}
+}
+
+/* A looped animation wraps at the last keyframe, an empty one is rejected */
+static void test_keyframes_loop(void) {
+	esp_rgb_led_anim_t anim = {
+			.type = ESP_RGB_LED_ANIM_KEYFRAMES,
+			.keyframes = keyframes,
+			.keyframes_num = 2,
+			.loop = true,
+	};
+	led_strip_rgb_t a;
+	led_strip_rgb_t b;
+
+	for (uint32_t t = 0; t < 1000; t += 37) {
+		TEST_ASSERT(esp_rgb_led_anim_render(&anim, t, &a));
+		TEST_ASSERT(esp_rgb_led_anim_render(&anim, t + 3000, &b));
+		TEST_ASSERT(memcmp(&a, &b, sizeof(a)) == 0);
+	}
+
+	anim.keyframes_num = 0;
+	TEST_ASSERT(!esp_rgb_led_anim_render(&anim, 0, &a));
+}
+
+/* The breathe fades in and out symmetrically around the half period */
+static void test_breathe(void) {
+	esp_rgb_led_anim_t anim = {
+			.type = ESP_RGB_LED_ANIM_BREATHE,
+			.rgb = {200, 100, 50},
+			.period_ms = 2000,
+	};
+	led_strip_rgb_t a;
+	led_strip_rgb_t b;
+
+	TEST_ASSERT(esp_rgb_led_anim_render(&anim, 0, &a));
+	TEST_ASSERT(rgb_equal(a, 0, 0, 0));
+	TEST_ASSERT(esp_rgb_led_anim_render(&anim, 1000, &a));
+	TEST_ASSERT(rgb_equal(a, 200, 100, 50));
+	TEST_ASSERT(esp_rgb_led_anim_render(&anim, 2000, &a));
+	TEST_ASSERT(rgb_equal(a, 0, 0, 0));
+
+	for (uint32_t t = 0; t <= 1000; t += 50) {
+		esp_rgb_led_anim_render(&anim, t, &a);
+		esp_rgb_led_anim_render(&anim, 2000 - t, &b);
+		TEST_ASSERT(memcmp(&a, &b, sizeof(a)) == 0);
+	}
+
+	/* Without a period the color is steady */
+	anim.period_ms = 0;
+	esp_rgb_led_anim_render(&anim, 1234, &a);
+	TEST_ASSERT(rgb_equal(a, 200, 100, 50));
+}
+
+/* The hue goes around the color wheel once per period */
+static void test_hue(void) {
+	esp_rgb_led_anim_t anim = {
+			.type = ESP_RGB_LED_ANIM_HUE,
+			.period_ms = 6000,
+			.saturation = 255,
+			.value = 255,
+	};
+	led_strip_rgb_t rgb;
+
+	esp_rgb_led_anim_hsv_to_rgb(0, 255, 255, &rgb);
+	TEST_ASSERT(rgb_equal(rgb, 255, 0, 0));
+	esp_rgb_led_anim_hsv_to_rgb(ESP_RGB_LED_ANIM_HUE_MAX / 3, 255, 255, &rgb);
+	TEST_ASSERT(rgb_equal(rgb, 0, 255, 0));
+	esp_rgb_led_anim_hsv_to_rgb(ESP_RGB_LED_ANIM_HUE_MAX * 2 / 3, 255, 255, &rgb);
+	TEST_ASSERT(rgb_equal(rgb, 0, 0, 255));
+	esp_rgb_led_anim_hsv_to_rgb(ESP_RGB_LED_ANIM_HUE_MAX, 255, 255, &rgb);
+	TEST_ASSERT(rgb_equal(rgb, 255, 0, 0));
+	esp_rgb_led_anim_hsv_to_rgb(700, 0, 80, &rgb);
+	TEST_ASSERT(rgb_equal(rgb, 80, 80, 80));
+
+	TEST_ASSERT(esp_rgb_led_anim_render(&anim, 2000, &rgb));
+	TEST_ASSERT(rgb_equal(rgb, 0, 255, 0));
+	TEST_ASSERT(esp_rgb_led_anim_render(&anim, 10000, &rgb));
+	TEST_ASSERT(rgb_equal(rgb, 0, 0, 255));
+}
+
+/* CPU time to render a frame, the frames step by the frame period */
+static uint64_t render_frame_ns(const esp_rgb_led_anim_t *anim) {
+	led_strip_rgb_t rgb;
+	uint32_t sum = 0;
+	clock_t start = clock();
+
+	for (uint32_t i = 0; i < RENDER_FRAMES; i++) {
+		esp_rgb_led_anim_render(anim, i * FRAME_MS, &rgb);
+		sum += rgb.r + rgb.g + rgb.b;
+	}
+
+	clock_t elapsed = clock() - start;
+
+	/* Keeps the renders from being left out */
+	TEST_ASSERT(sum > 0);
+
+	return (uint64_t)elapsed * 1000000000 / CLOCKS_PER_SEC / RENDER_FRAMES;
+}
+
+/* Each kind of animation renders a frame in a small share of its period. The
+ * CPU time of the process doesn't depend on the load of the host */
+static void test_render_time(void) {
+	const esp_rgb_led_anim_t anims[] = {
+			{.type = ESP_RGB_LED_ANIM_KEYFRAMES, .keyframes = keyframes, .keyframes_num = sizeof(keyframes) / sizeof(keyframes[0]), .loop = true},
+			{.type = ESP_RGB_LED_ANIM_BREATHE, .rgb = {200, 100, 50}, .period_ms = 2000},
+			{.type = ESP_RGB_LED_ANIM_HUE, .period_ms = 6000, .saturation = 255, .value = 255},
+	};
+	static const char *names[] = {"keyframes", "breathe", "hue"};
+
+	for (size_t i = 0; i < sizeof(anims) / sizeof(anims[0]); i++) {
+		uint64_t ns = render_frame_ns(&anims[i]);
+
+		printf("%s: %" PRIu64 " ns per frame, the frame period is %d ms\n", names[i], ns, FRAME_MS);
+		TEST_ASSERT(ns < RENDER_FRAME_NS_MAX);
+	}
+}
+
+static void test_anim_args(void) {
+	esp_rgb_led_anim_t anim = {.type = ESP_RGB_LED_ANIM_KEYFRAMES};
+
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_rgb_led_anim_start(&rgb_led, NULL));
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_rgb_led_anim_start(&rgb_led, &anim));
+	anim.type = ESP_RGB_LED_ANIM_NONE;
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_rgb_led_anim_start(&rgb_led, &anim));
+	anim.type = ESP_RGB_LED_ANIM_MAX;
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_rgb_led_anim_start(&rgb_led, &anim));
+	TEST_ASSERT(rgb_led.anim_task == NULL);
+}
+
+/* A finished animation leaves its last color and sends one refresh per frame
+ * at most */
+static void test_anim_run(void) {
+	static const esp_rgb_led_keyframe_t fade[] = {
+			{0, {255, 0, 0}, ESP_RGB_LED_EASE_LINEAR},
+			{200, {0, 0, 255}, ESP_RGB_LED_EASE_LINEAR},
+	};
+	esp_rgb_led_anim_t anim = {
+			.type = ESP_RGB_LED_ANIM_KEYFRAMES,
+			.keyframes = fade,
+			.keyframes_num = 2,
+	};
+	frame_t last;
+
+	strip_reset();
+	TickType_t start = xTaskGetTickCount();
+
+	TEST_ASSERT_EQUAL(ESP_OK, esp_rgb_led_anim_start(&rgb_led, &anim));
+	vTaskDelay(pdMS_TO_TICKS(400));
+
+	TEST_ASSERT_EQUAL(ESP_RGB_LED_ANIM_NONE, rgb_led.anim.type);
+	TEST_ASSERT(strip_frames(&last) >= 200 / FRAME_MS / 2);
+	TEST_ASSERT(rgb_equal(last.rgb, 0, 0, 255));
+
+	uint32_t elapsed_ms = (xTaskGetTickCount() - start) * portTICK_PERIOD_MS;
+
+	TEST_ASSERT(strip.refreshes <= elapsed_ms / FRAME_MS + 2);
+
+	/* The idle task sends nothing */
+	uint32_t refreshes = strip.refreshes;
+
+	vTaskDelay(pdMS_TO_TICKS(100));
+	TEST_ASSERT_EQUAL(refreshes, strip.refreshes);
+}
+
+/* No frame is sent once the stop returns */
+static void test_anim_stop(void) {
+	esp_rgb_led_anim_t anim = {
+			.type = ESP_RGB_LED_ANIM_BREATHE,
+			.rgb = {0, 255, 0},
+			.period_ms = 200,
+	};
+
+	strip_reset();
+	TEST_ASSERT_EQUAL(ESP_OK, esp_rgb_led_anim_start(&rgb_led, &anim));
+	vTaskDelay(pdMS_TO_TICKS(150));
+	esp_rgb_led_anim_stop(&rgb_led);
+
+	uint32_t frames_num = strip_frames(NULL);
+	uint32_t refreshes = strip.refreshes;
+
+	TEST_ASSERT(frames_num > 0);
+	vTaskDelay(pdMS_TO_TICKS(100));
+	TEST_ASSERT_EQUAL(frames_num, strip_frames(NULL));
+	TEST_ASSERT_EQUAL(refreshes, strip.refreshes);
+}
+
+/* A blink takes the LEDs over from a running animation */
+static void test_anim_blink(void) {
+	esp_rgb_led_anim_t anim = {
+			.type = ESP_RGB_LED_ANIM_HUE,
+			.period_ms = 300,
+			.saturation = 255,
+			.value = 255,
+	};
+	frame_t frame;
+
+	TEST_ASSERT_EQUAL(ESP_OK, esp_rgb_led_anim_start(&rgb_led, &anim));
+	vTaskDelay(pdMS_TO_TICKS(60));
+
+	esp_rgb_led_blink_start(&rgb_led, 50, 10, 20, 30);
+	TEST_ASSERT_EQUAL(ESP_RGB_LED_ANIM_NONE, rgb_led.anim.type);
+
+	uint32_t first = strip_frames(&frame);
+
+	TEST_ASSERT(rgb_equal(frame.rgb, 10, 20, 30));
+	vTaskDelay(pdMS_TO_TICKS(280));
+
+	/* Only the blink colors alternate from then on */
+	uint32_t frames_num = strip_frames(NULL);
+
+	TEST_ASSERT(frames_num - first >= 3);
+
+	for (uint32_t i = first; i < frames_num; i++) {
+		led_strip_rgb_t rgb = strip.frames[i].rgb;
+
+		TEST_ASSERT((i - first) % 2 ? rgb_equal(rgb, 10, 20, 30) : rgb_equal(rgb, 0, 0, 0));
+	}
+
+	esp_rgb_led_blink_stop(&rgb_led);
+	frames_num = strip_frames(&frame);
+	TEST_ASSERT(rgb_equal(frame.rgb, 0, 0, 0));
+	vTaskDelay(pdMS_TO_TICKS(120));
+	TEST_ASSERT_EQUAL(frames_num, strip_frames(NULL));
+}
+
+/***************************** END OF FILE ************************************/
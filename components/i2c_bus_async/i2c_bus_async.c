@@ -0,0 +1,265 @@
+/**
+  ******************************************************************************
+  * @file           : i2c_bus_async.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Queued asynchronous transfers on an i2c_bus
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include "i2c_bus_async.h"
+#include "esp_log.h"
+#include "dlog.h"
+#include "esp_timer.h"
+#include "cycle_trace.h"
+
+/* Private macro -------------------------------------------------------------*/
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static const char *TAG = "i2c_bus_async";
+
+/* Private function prototypes -----------------------------------------------*/
+static void worker_task(void *arg);
+static void pending_insert(i2c_bus_async_t * const me, i2c_bus_async_xfer_t *xfer);
+static void xfer_run(i2c_bus_async_t * const me, i2c_bus_async_xfer_t *xfer);
+static void chain_complete(i2c_bus_async_t * const me, i2c_bus_async_xfer_t *head);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief Function to initialize the transfer queue and create its worker
+  *        task
+  */
+esp_err_t i2c_bus_async_init(i2c_bus_async_t * const me, UBaseType_t priority) {
+	ESP_LOGI(TAG, "Initializing I2C bus async instance...");
+
+	me->pending = NULL;
+	me->xfers = 0;
+	me->chains = 0;
+
+	me->queue = xQueueCreateStatic(I2C_BUS_ASYNC_QUEUE_LENGTH,
+			sizeof(i2c_bus_async_xfer_t *),
+			me->queue_storage,
+			&me->queue_buffer);
+
+	if (me->queue == NULL) {
+		ESP_LOGE(TAG, "Failed to create the transfer queue");
+		return ESP_FAIL;
+	}
+
+#ifdef CONFIG_PM_ENABLE
+	/* The I2C clock is derived from the APB clock */
+	esp_err_t ret = esp_pm_lock_create(ESP_PM_APB_FREQ_MAX, 0, "i2c_bus_async", &me->pm_lock);
+
+	if (ret != ESP_OK) {
+		ESP_LOGE(TAG, "Failed to create the power management lock");
+		return ret;
+	}
+#endif
+
+	if (xTaskCreate(worker_task,
+			"i2c bus async task",
+			CONFIG_I2C_BUS_ASYNC_TASK_STACK_SIZE,
+			(void *)me,
+			priority,
+			&me->task_handle) != pdPASS) {
+		ESP_LOGE(TAG, "Failed to create the worker task");
+		return ESP_ERR_NO_MEM;
+	}
+
+	return ESP_OK;
+}
+
+/**
+  * @brief Function to submit a chain of transfers
+  */
+esp_err_t i2c_bus_async_submit(i2c_bus_async_t * const me, i2c_bus_async_xfer_t *xfer, TickType_t timeout) {
+	for (i2c_bus_async_xfer_t *x = xfer; x != NULL; x = x->next) {
+		if (x->dev == NULL) {
+			return ESP_ERR_INVALID_ARG;
+		}
+	}
+
+	xfer->ret = ESP_OK;
+
+	if (xQueueSend(me->queue, &xfer, timeout) != pdPASS) {
+		return ESP_ERR_TIMEOUT;
+	}
+
+	return ESP_OK;
+}
+
+/**
+  * @brief Function to submit a chain of transfers and wait for it to
+  *        complete
+  */
+esp_err_t i2c_bus_async_transfer(i2c_bus_async_t * const me, i2c_bus_async_xfer_t *xfer) {
+	xfer->cb = NULL;
+	xfer->notify = xTaskGetCurrentTaskHandle();
+
+	esp_err_t ret = i2c_bus_async_submit(me, xfer, portMAX_DELAY);
+
+	if (ret != ESP_OK) {
+		return ret;
+	}
+
+	ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+	return xfer->ret;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static void worker_task(void *arg) {
+	i2c_bus_async_t *bus = (i2c_bus_async_t *)arg;
+	i2c_bus_async_xfer_t *xfer;
+
+	for (;;) {
+		TickType_t ticks = portMAX_DELAY;
+		int64_t now = esp_timer_get_time();
+
+		/* Don't wait for new chains if a transfer is due, otherwise wait up
+		 * to the earliest due time, rounding up so the task doesn't wake up
+		 * just before it */
+		if (bus->pending != NULL) {
+			int64_t wait_us = bus->pending->due - now;
+
+			if (wait_us <= 0) {
+				ticks = 0;
+			}
+			else {
+				int64_t wait_ms = (wait_us + 999) / 1000;
+				ticks = (wait_ms + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS;
+			}
+		}
+
+		/* Take in the submitted chains before running anything, so a chain
+		 * runs its transfers interleaved with the ones already pending */
+		if (xQueueReceive(bus->queue, &xfer, ticks) == pdPASS) {
+			xfer->head = xfer;
+			xfer->due = esp_timer_get_time() + (int64_t)xfer->delay * 1000;
+			pending_insert(bus, xfer);
+
+			continue;
+		}
+
+		if (bus->pending == NULL || bus->pending->due > esp_timer_get_time()) {
+			continue;
+		}
+
+		xfer = bus->pending;
+		bus->pending = xfer->link;
+
+		xfer_run(bus, xfer);
+	}
+}
+
+static void pending_insert(i2c_bus_async_t * const me, i2c_bus_async_xfer_t *xfer) {
+	i2c_bus_async_xfer_t **p = &me->pending;
+
+	/* Keep the submission order between transfers due at the same time */
+	while (*p != NULL && (*p)->due <= xfer->due) {
+		p = &(*p)->link;
+	}
+
+	xfer->link = *p;
+	*p = xfer;
+}
+
+static void xfer_run(i2c_bus_async_t * const me, i2c_bus_async_xfer_t *xfer) {
+	i2c_bus_dev_t *dev = xfer->dev;
+	uint8_t *reg_addr = xfer->reg_addr_len ? xfer->reg_addr : NULL;
+	int8_t rslt;
+
+	/* A transfer can take several I2C commands, the APB clock stays at
+	 * 80 MHz until the last one ends */
+#ifdef CONFIG_PM_ENABLE
+	esp_pm_lock_acquire(me->pm_lock);
+#endif
+
+	CYCLE_TRACE_BEGIN("i2c_xfer");
+
+	if (xfer->op == I2C_BUS_ASYNC_READ) {
+		rslt = dev->read(reg_addr, xfer->reg_addr_len, xfer->data, xfer->data_len, dev);
+	}
+	else {
+		rslt = dev->write(reg_addr, xfer->reg_addr_len, xfer->data, xfer->data_len, dev);
+	}
+
+	CYCLE_TRACE_END("i2c_xfer");
+
+#ifdef CONFIG_PM_ENABLE
+	esp_pm_lock_release(me->pm_lock);
+#endif
+
+	me->xfers++;
+
+	i2c_bus_async_xfer_t *head = xfer->head;
+
+	if (rslt != 0) {
+		DLOGW(TAG, "Transfer to 0x%02X failed", dev->addr);
+		head->ret = ESP_FAIL;
+		chain_complete(me, head);
+
+		return;
+	}
+
+	if (xfer->next == NULL) {
+		chain_complete(me, head);
+
+		return;
+	}
+
+	/* The wait of the next transfer counts from this one completing */
+	xfer = xfer->next;
+	xfer->head = head;
+	xfer->due = esp_timer_get_time() + (int64_t)xfer->delay * 1000;
+	pending_insert(me, xfer);
+}
+
+static void chain_complete(i2c_bus_async_t * const me, i2c_bus_async_xfer_t *head) {
+	/* The callback may release the chain, the task to notify is read before */
+	TaskHandle_t notify = head->notify;
+
+	me->chains++;
+
+	/* Notify last, a waiting task may release the chain right away */
+	if (head->cb != NULL) {
+		head->cb(head);
+	}
+
+	if (notify != NULL) {
+		xTaskNotifyGive(notify);
+	}
+}
+
+/***************************** END OF FILE ************************************/
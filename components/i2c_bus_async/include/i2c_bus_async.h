@@ -0,0 +1,162 @@
+/**
+  ******************************************************************************
+  * @file           : i2c_bus_async.h
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Queued asynchronous transfers on an i2c_bus
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef I2C_BUS_ASYNC_H_
+#define I2C_BUS_ASYNC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "esp_pm.h"
+#include "sdkconfig.h"
+#include "i2c_bus.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+
+/* Exported macro ------------------------------------------------------------*/
+#define I2C_BUS_ASYNC_QUEUE_LENGTH	CONFIG_I2C_BUS_ASYNC_QUEUE_LENGTH
+
+/* Exported typedef ----------------------------------------------------------*/
+typedef enum {
+	I2C_BUS_ASYNC_WRITE = 0,
+	I2C_BUS_ASYNC_READ
+} i2c_bus_async_op_e;
+
+typedef struct i2c_bus_async_xfer i2c_bus_async_xfer_t;
+
+/* Completion callback, called from the worker task with the chain head. The
+ * chain can be released from it */
+typedef void (*i2c_bus_async_cb_t)(i2c_bus_async_xfer_t *xfer);
+
+struct i2c_bus_async_xfer {
+	i2c_bus_dev_t *dev;
+	i2c_bus_async_op_e op;
+	uint8_t reg_addr[2];		/* Register or command bytes sent first */
+	uint8_t reg_addr_len;
+	uint8_t *data;				/* Data to write or buffer to read into */
+	uint32_t data_len;
+	uint32_t delay;				/* Wait in ms before the transfer runs, from the
+								   previous one of the chain completing */
+	i2c_bus_async_xfer_t *next;	/* Transfer run after this one, NULL ends the chain */
+
+	/* Completion, only used in the chain head */
+	i2c_bus_async_cb_t cb;
+	void *arg;
+	TaskHandle_t notify;		/* Task notified when the chain completes */
+	esp_err_t ret;				/* Result of the chain, first error or ESP_OK */
+
+	/* Private, used by the worker */
+	i2c_bus_async_xfer_t *head;
+	i2c_bus_async_xfer_t *link;
+	int64_t due;
+};
+
+typedef struct {
+	QueueHandle_t queue;
+	StaticQueue_t queue_buffer;
+	uint8_t queue_storage[I2C_BUS_ASYNC_QUEUE_LENGTH * sizeof(i2c_bus_async_xfer_t *)];
+	TaskHandle_t task_handle;
+	i2c_bus_async_xfer_t *pending;	/* Transfers ordered by due time */
+	uint32_t xfers;					/* Transfers run */
+	uint32_t chains;				/* Chains completed */
+#ifdef CONFIG_PM_ENABLE
+	esp_pm_lock_handle_t pm_lock;	/* Held while a transfer runs, not during the waits */
+#endif
+} i2c_bus_async_t;
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions prototypes ---------------------------------------------*/
+/**
+  * @brief Function to initialize the transfer queue and create its worker
+  *        task
+  *
+  * @param me       : Pointer to a i2c_bus_async_t structure
+  * @param priority : Priority of the worker task
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_NO_MEM if the task can't be created
+  */
+esp_err_t i2c_bus_async_init(i2c_bus_async_t * const me, UBaseType_t priority);
+
+/**
+  * @brief Function to submit a chain of transfers
+  *
+  * @note The transfers are run in chain order, a failing transfer ends the
+  *       chain. The descriptors and buffers must stay valid until the chain
+  *       completes. Transfers of different chains are interleaved, the
+  *       ones due at the same time run in submission order
+  *
+  * @param me      : Pointer to a i2c_bus_async_t structure
+  * @param xfer    : Chain head, holds the completion callback and result
+  * @param timeout : Ticks to wait for room in the queue
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_INVALID_ARG if a transfer of the chain has no device
+  * 	- ESP_ERR_TIMEOUT if the queue is full
+  */
+esp_err_t i2c_bus_async_submit(i2c_bus_async_t * const me, i2c_bus_async_xfer_t *xfer, TickType_t timeout);
+
+/**
+  * @brief Function to submit a chain of transfers and wait for it to
+  *        complete
+  *
+  * @note The calling task waits on its notification value, the chain head
+  *       callback and notify fields are overwritten
+  *
+  * @param me   : Pointer to a i2c_bus_async_t structure
+  * @param xfer : Chain head
+  *
+  * @retval Result of the chain, or the i2c_bus_async_submit() error
+  */
+esp_err_t i2c_bus_async_transfer(i2c_bus_async_t * const me, i2c_bus_async_xfer_t *xfer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* I2C_BUS_ASYNC_H_ */
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,434 @@
+/**
+  ******************************************************************************
+  * @file           : test_i2c_bus_async.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Host test of the I2C transfer engine against loopback fakes
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <time.h>
+
+#include "host_test.h"
+#include "i2c_fake.h"
+#include "i2c_bus_async.h"
+
+#include "esp_timer.h"
+
+#include "freertos/semphr.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define WORKER_PRIORITY			5
+
+/* A chain of delayed reads on one device, single writes on another */
+#define FAIR_CHAIN_LEN			8
+#define FAIR_DELAY_MS			100
+#define FAIR_CHAINS				8
+
+/* Single byte writes, 3 bytes and 29 bits on the bus each, 290 us at the
+ * 100 kHz standard mode */
+#define THROUGHPUT_CHAINS		4096
+#define THROUGHPUT_BUS_PER_S	(1000000 / 290)
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+	i2c_bus_async_xfer_t *head;
+	esp_err_t ret;
+	TaskHandle_t task;
+	uint32_t calls;
+} cb_record_t;
+
+/* Private variables ---------------------------------------------------------*/
+static i2c_bus_async_t bus;
+static i2c_fake_t dev_a;
+static i2c_fake_t dev_b;
+static SemaphoreHandle_t done;
+static SemaphoreHandle_t entered;
+static SemaphoreHandle_t release;
+static uint32_t completed;
+
+/* Private function prototypes -----------------------------------------------*/
+static void xfer_set(i2c_bus_async_xfer_t *xfer, i2c_fake_t *dev, i2c_bus_async_op_e op, uint8_t reg, uint8_t *data, uint32_t len, uint32_t delay);
+static void record_cb(i2c_bus_async_xfer_t *xfer);
+static void count_cb(i2c_bus_async_xfer_t *xfer);
+static int8_t blocking_model(i2c_fake_t *fake, const i2c_fake_xfer_t *xfer, uint8_t *data);
+static void setup(void);
+static void test_chain_order(void);
+static void test_delays(void);
+static void test_errors(void);
+static void test_queue_full(void);
+static void test_callbacks(void);
+static void test_fairness(void);
+static void test_throughput(void);
+
+/* Main ----------------------------------------------------------------------*/
+int main(void) {
+	done = xSemaphoreCreateCounting(32, 0);
+	entered = xSemaphoreCreateBinary();
+	release = xSemaphoreCreateBinary();
+
+	TEST_ASSERT_EQUAL(ESP_OK, i2c_bus_async_init(&bus, WORKER_PRIORITY));
+
+	RUN_TEST(test_chain_order);
+	RUN_TEST(test_delays);
+	RUN_TEST(test_errors);
+	RUN_TEST(test_queue_full);
+	RUN_TEST(test_callbacks);
+	RUN_TEST(test_fairness);
+	RUN_TEST(test_throughput);
+
+	return 0;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static void xfer_set(i2c_bus_async_xfer_t *xfer, i2c_fake_t *dev, i2c_bus_async_op_e op, uint8_t reg, uint8_t *data, uint32_t len, uint32_t delay) {
+	memset(xfer, 0, sizeof(*xfer));
+	xfer->dev = &dev->dev;
+	xfer->op = op;
+	xfer->reg_addr[0] = reg;
+	xfer->reg_addr_len = 1;
+	xfer->data = data;
+	xfer->data_len = len;
+	xfer->delay = delay;
+}
+
+static void record_cb(i2c_bus_async_xfer_t *xfer) {
+	cb_record_t *record = xfer->arg;
+
+	record->head = xfer;
+	record->ret = xfer->ret;
+	record->task = xTaskGetCurrentTaskHandle();
+	record->calls++;
+
+	xSemaphoreGive(done);
+}
+
+static void count_cb(i2c_bus_async_xfer_t *xfer) {
+	completed++;
+}
+
+/* Holds the worker inside the transfer until the test releases it */
+static int8_t blocking_model(i2c_fake_t *fake, const i2c_fake_xfer_t *xfer, uint8_t *data) {
+	xSemaphoreGive(entered);
+	xSemaphoreTake(release, portMAX_DELAY);
+
+	return 0;
+}
+
+static void setup(void) {
+	i2c_fake_init(&dev_a, "dev a", 0x10);
+	i2c_fake_init(&dev_b, "dev b", 0x20);
+}
+
+/* The transfers of a chain run in order on the worker task, a read sees the
+ * data written by the previous transfer */
+static void test_chain_order(void) {
+	uint8_t out[3] = {1, 2, 3};
+	uint8_t in[3] = {0};
+	uint8_t cmd = 0x5A;
+	i2c_bus_async_xfer_t xfers[3];
+	uint32_t xfers_before = bus.xfers;
+	uint32_t chains_before = bus.chains;
+
+	setup();
+	xfer_set(&xfers[0], &dev_a, I2C_BUS_ASYNC_WRITE, 0x10, out, sizeof(out), 0);
+	xfer_set(&xfers[1], &dev_a, I2C_BUS_ASYNC_READ, 0x10, in, sizeof(in), 0);
+	xfer_set(&xfers[2], &dev_b, I2C_BUS_ASYNC_WRITE, 0x20, &cmd, 1, 0);
+	xfers[0].next = &xfers[1];
+	xfers[1].next = &xfers[2];
+
+	TEST_ASSERT_EQUAL(ESP_OK, i2c_bus_async_transfer(&bus, &xfers[0]));
+
+	TEST_ASSERT(memcmp(in, out, sizeof(out)) == 0);
+	TEST_ASSERT_EQUAL(cmd, dev_b.mem[0x20]);
+	TEST_ASSERT_EQUAL(2, dev_a.xfers_num);
+	TEST_ASSERT_EQUAL(1, dev_b.xfers_num);
+	TEST_ASSERT_EQUAL(I2C_FAKE_WRITE, dev_a.xfers[0].op);
+	TEST_ASSERT_EQUAL(I2C_FAKE_READ, dev_a.xfers[1].op);
+	TEST_ASSERT(dev_a.xfers[0].time <= dev_a.xfers[1].time);
+	TEST_ASSERT(dev_a.xfers[1].time <= dev_b.xfers[0].time);
+	TEST_ASSERT(dev_a.xfers[0].task == bus.task_handle);
+	TEST_ASSERT(dev_b.xfers[0].task == bus.task_handle);
+
+	TEST_ASSERT_EQUAL(3, bus.xfers - xfers_before);
+	TEST_ASSERT_EQUAL(1, bus.chains - chains_before);
+	TEST_ASSERT_EQUAL(0, host_pm_lock_count(bus.pm_lock));
+}
+
+/* A delay counts from the previous transfer of its chain completing, the
+ * other chains run in the meantime */
+static void test_delays(void) {
+	uint8_t data[4] = {0};
+	i2c_bus_async_xfer_t chain_a[2];
+	i2c_bus_async_xfer_t chain_b[2];
+	cb_record_t record_a = {0};
+	cb_record_t record_b = {0};
+
+	setup();
+	xfer_set(&chain_a[0], &dev_a, I2C_BUS_ASYNC_WRITE, 1, &data[0], 1, 0);
+	xfer_set(&chain_a[1], &dev_a, I2C_BUS_ASYNC_READ, 2, &data[1], 1, 50);
+	xfer_set(&chain_b[0], &dev_a, I2C_BUS_ASYNC_WRITE, 3, &data[2], 1, 0);
+	xfer_set(&chain_b[1], &dev_a, I2C_BUS_ASYNC_READ, 4, &data[3], 1, 20);
+	chain_a[0].next = &chain_a[1];
+	chain_a[0].cb = record_cb;
+	chain_a[0].arg = &record_a;
+	chain_b[0].next = &chain_b[1];
+	chain_b[0].cb = record_cb;
+	chain_b[0].arg = &record_b;
+
+	TEST_ASSERT_EQUAL(ESP_OK, i2c_bus_async_submit(&bus, &chain_a[0], portMAX_DELAY));
+	TEST_ASSERT_EQUAL(ESP_OK, i2c_bus_async_submit(&bus, &chain_b[0], portMAX_DELAY));
+	TEST_ASSERT(xSemaphoreTake(done, pdMS_TO_TICKS(1000)));
+	TEST_ASSERT(xSemaphoreTake(done, pdMS_TO_TICKS(1000)));
+
+	/* Both chains start right away, the shorter delay ends first */
+	TEST_ASSERT_EQUAL(4, dev_a.xfers_num);
+	TEST_ASSERT_EQUAL(1, dev_a.xfers[0].reg_addr[0]);
+	TEST_ASSERT_EQUAL(3, dev_a.xfers[1].reg_addr[0]);
+	TEST_ASSERT_EQUAL(4, dev_a.xfers[2].reg_addr[0]);
+	TEST_ASSERT_EQUAL(2, dev_a.xfers[3].reg_addr[0]);
+	TEST_ASSERT(dev_a.xfers[2].time - dev_a.xfers[1].time >= 20000);
+	TEST_ASSERT(dev_a.xfers[3].time - dev_a.xfers[0].time >= 50000);
+	TEST_ASSERT_EQUAL(ESP_OK, record_a.ret);
+	TEST_ASSERT_EQUAL(ESP_OK, record_b.ret);
+}
+
+/* A failing transfer ends its chain with ESP_FAIL, the next chain runs */
+static void test_errors(void) {
+	uint8_t data[3] = {0};
+	i2c_bus_async_xfer_t xfers[3];
+	uint32_t xfers_before = bus.xfers;
+	uint32_t chains_before = bus.chains;
+
+	setup();
+	xfer_set(&xfers[0], &dev_a, I2C_BUS_ASYNC_WRITE, 0, &data[0], 1, 0);
+	xfer_set(&xfers[1], &dev_a, I2C_BUS_ASYNC_WRITE, 1, &data[1], 1, 0);
+	xfer_set(&xfers[2], &dev_a, I2C_BUS_ASYNC_WRITE, 2, &data[2], 1, 0);
+	xfers[0].next = &xfers[1];
+	xfers[1].next = &xfers[2];
+
+	/* Checked before anything is queued */
+	xfers[2].dev = NULL;
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, i2c_bus_async_submit(&bus, &xfers[0], 0));
+	xfers[2].dev = &dev_a.dev;
+
+	dev_a.fail_at = 2;
+	TEST_ASSERT_EQUAL(ESP_FAIL, i2c_bus_async_transfer(&bus, &xfers[0]));
+	TEST_ASSERT_EQUAL(2, dev_a.xfers_num);
+	TEST_ASSERT_EQUAL(-1, dev_a.xfers[1].rslt);
+	TEST_ASSERT_EQUAL(2, bus.xfers - xfers_before);
+	TEST_ASSERT_EQUAL(1, bus.chains - chains_before);
+
+	/* The same chain again, its result is reset on submission */
+	TEST_ASSERT_EQUAL(ESP_OK, i2c_bus_async_transfer(&bus, &xfers[0]));
+	TEST_ASSERT_EQUAL(5, dev_a.xfers_num);
+	TEST_ASSERT_EQUAL(0, host_pm_lock_count(bus.pm_lock));
+}
+
+/* With the worker held in a transfer the queue fills up, the queued chains
+ * then run in submission order */
+static void test_queue_full(void) {
+	uint8_t data[I2C_BUS_ASYNC_QUEUE_LENGTH + 1] = {0};
+	i2c_bus_async_xfer_t blocker;
+	i2c_bus_async_xfer_t xfers[I2C_BUS_ASYNC_QUEUE_LENGTH + 1];
+	cb_record_t records[I2C_BUS_ASYNC_QUEUE_LENGTH + 1] = {0};
+
+	setup();
+	dev_a.model = blocking_model;
+	xfer_set(&blocker, &dev_a, I2C_BUS_ASYNC_WRITE, 0, &data[0], 1, 0);
+	blocker.cb = record_cb;
+	blocker.arg = &records[I2C_BUS_ASYNC_QUEUE_LENGTH];
+
+	TEST_ASSERT_EQUAL(ESP_OK, i2c_bus_async_submit(&bus, &blocker, portMAX_DELAY));
+	TEST_ASSERT(xSemaphoreTake(entered, pdMS_TO_TICKS(1000)));
+
+	for (uint8_t i = 0; i < I2C_BUS_ASYNC_QUEUE_LENGTH + 1; i++) {
+		xfer_set(&xfers[i], &dev_b, I2C_BUS_ASYNC_WRITE, i, &data[i], 1, 0);
+		xfers[i].cb = record_cb;
+		xfers[i].arg = &records[i];
+	}
+
+	for (uint8_t i = 0; i < I2C_BUS_ASYNC_QUEUE_LENGTH; i++) {
+		TEST_ASSERT_EQUAL(ESP_OK, i2c_bus_async_submit(&bus, &xfers[i], 0));
+	}
+
+	TEST_ASSERT_EQUAL(ESP_ERR_TIMEOUT, i2c_bus_async_submit(&bus, &xfers[I2C_BUS_ASYNC_QUEUE_LENGTH], 0));
+	TEST_ASSERT_EQUAL(0, dev_b.xfers_num);
+
+	xSemaphoreGive(release);
+
+	for (uint8_t i = 0; i < I2C_BUS_ASYNC_QUEUE_LENGTH + 1; i++) {
+		TEST_ASSERT(xSemaphoreTake(done, pdMS_TO_TICKS(1000)));
+	}
+
+	TEST_ASSERT_EQUAL(I2C_BUS_ASYNC_QUEUE_LENGTH, dev_b.xfers_num);
+
+	for (uint8_t i = 0; i < I2C_BUS_ASYNC_QUEUE_LENGTH; i++) {
+		TEST_ASSERT_EQUAL(i, dev_b.xfers[i].reg_addr[0]);
+		TEST_ASSERT_EQUAL(1, records[i].calls);
+	}
+
+	/* The blocker shares its record with the rejected chain, which never ran */
+	TEST_ASSERT_EQUAL(1, records[I2C_BUS_ASYNC_QUEUE_LENGTH].calls);
+}
+
+/* The callback runs once on the worker task with the chain head, before the
+ * waiting task is notified */
+static void test_callbacks(void) {
+	uint8_t data[2] = {0};
+	i2c_bus_async_xfer_t xfers[2];
+	cb_record_t record = {0};
+
+	setup();
+	xfer_set(&xfers[0], &dev_a, I2C_BUS_ASYNC_WRITE, 0, &data[0], 1, 0);
+	xfer_set(&xfers[1], &dev_a, I2C_BUS_ASYNC_READ, 0, &data[1], 1, 0);
+	xfers[0].next = &xfers[1];
+	xfers[0].cb = record_cb;
+	xfers[0].arg = &record;
+	xfers[0].notify = xTaskGetCurrentTaskHandle();
+
+	TEST_ASSERT_EQUAL(ESP_OK, i2c_bus_async_submit(&bus, &xfers[0], portMAX_DELAY));
+	TEST_ASSERT(ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000)));
+
+	TEST_ASSERT_EQUAL(1, record.calls);
+	TEST_ASSERT(record.head == &xfers[0]);
+	TEST_ASSERT_EQUAL(ESP_OK, record.ret);
+	TEST_ASSERT(record.task == bus.task_handle);
+	TEST_ASSERT(xSemaphoreTake(done, 0));
+
+	/* A blocking transfer doesn't call the callback of a previous use */
+	TEST_ASSERT_EQUAL(ESP_OK, i2c_bus_async_transfer(&bus, &xfers[0]));
+	TEST_ASSERT_EQUAL(1, record.calls);
+	TEST_ASSERT(xfers[0].cb == NULL);
+}
+
+/* The chains submitted while another one waits on its delays run in the
+ * meantime, they don't wait for it to end */
+static void test_fairness(void) {
+	uint8_t data[FAIR_CHAIN_LEN + FAIR_CHAINS] = {0};
+	i2c_bus_async_xfer_t chain[FAIR_CHAIN_LEN];
+	i2c_bus_async_xfer_t singles[FAIR_CHAINS];
+	cb_record_t records[FAIR_CHAINS + 1] = {0};
+	int64_t submitted[FAIR_CHAINS];
+	int64_t wait_max = 0;
+
+	setup();
+
+	for (uint8_t i = 0; i < FAIR_CHAIN_LEN; i++) {
+		xfer_set(&chain[i], &dev_a, I2C_BUS_ASYNC_READ, i, &data[i], 1, i ? FAIR_DELAY_MS : 0);
+		chain[i].next = i + 1 < FAIR_CHAIN_LEN ? &chain[i + 1] : NULL;
+	}
+
+	chain[0].cb = record_cb;
+	chain[0].arg = &records[FAIR_CHAINS];
+
+	TEST_ASSERT_EQUAL(ESP_OK, i2c_bus_async_submit(&bus, &chain[0], portMAX_DELAY));
+
+	for (uint8_t i = 0; i < FAIR_CHAINS; i++) {
+		xfer_set(&singles[i], &dev_b, I2C_BUS_ASYNC_WRITE, i, &data[FAIR_CHAIN_LEN + i], 1, 0);
+		singles[i].cb = record_cb;
+		singles[i].arg = &records[i];
+		submitted[i] = esp_timer_get_time();
+		TEST_ASSERT_EQUAL(ESP_OK, i2c_bus_async_submit(&bus, &singles[i], portMAX_DELAY));
+	}
+
+	for (uint8_t i = 0; i < FAIR_CHAINS + 1; i++) {
+		TEST_ASSERT(xSemaphoreTake(done, pdMS_TO_TICKS(1000)));
+	}
+
+	TEST_ASSERT_EQUAL(FAIR_CHAIN_LEN, dev_a.xfers_num);
+	TEST_ASSERT_EQUAL(FAIR_CHAINS, dev_b.xfers_num);
+
+	for (uint8_t i = 0; i < FAIR_CHAINS; i++) {
+		int64_t wait = dev_b.xfers[i].time - submitted[i];
+
+		wait_max = wait > wait_max ? wait : wait_max;
+		TEST_ASSERT_EQUAL(ESP_OK, records[i].ret);
+	}
+
+	int64_t chain_us = dev_a.xfers[FAIR_CHAIN_LEN - 1].time - dev_a.xfers[0].time;
+
+	printf("dev b waited %" PRId64 " us at most, dev a chain of %d transfers took %" PRId64 " us\n",
+			wait_max, FAIR_CHAIN_LEN, chain_us);
+
+	/* All of them ran before the second transfer of the chain was due */
+	TEST_ASSERT(wait_max < FAIR_DELAY_MS * 1000);
+	TEST_ASSERT(dev_b.xfers[FAIR_CHAINS - 1].time < dev_a.xfers[1].time);
+	TEST_ASSERT(chain_us >= (FAIR_CHAIN_LEN - 1) * FAIR_DELAY_MS * 1000);
+	TEST_ASSERT_EQUAL(ESP_OK, records[FAIR_CHAINS].ret);
+}
+
+/* The worker keeps up with the bus, it runs more transfers per second of CPU
+ * time than a standard mode bus carries. The CPU time of the process doesn't
+ * depend on the load of the host */
+static void test_throughput(void) {
+	static i2c_bus_async_xfer_t xfers[THROUGHPUT_CHAINS];
+	static uint8_t data[THROUGHPUT_CHAINS];
+	uint32_t xfers_before = bus.xfers;
+
+	setup();
+	completed = 0;
+
+	for (uint32_t i = 0; i < THROUGHPUT_CHAINS; i++) {
+		xfer_set(&xfers[i], &dev_b, I2C_BUS_ASYNC_WRITE, (uint8_t)i, &data[i], 1, 0);
+		xfers[i].cb = count_cb;
+	}
+
+	xfers[THROUGHPUT_CHAINS - 1].notify = xTaskGetCurrentTaskHandle();
+
+	int64_t start = esp_timer_get_time();
+	clock_t cpu_start = clock();
+
+	/* The queue full blocks the submission until the worker takes the next */
+	for (uint32_t i = 0; i < THROUGHPUT_CHAINS; i++) {
+		TEST_ASSERT_EQUAL(ESP_OK, i2c_bus_async_submit(&bus, &xfers[i], portMAX_DELAY));
+	}
+
+	TEST_ASSERT(ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(10000)));
+
+	int64_t elapsed = esp_timer_get_time() - start;
+	int64_t cpu_us = (int64_t)(clock() - cpu_start) * 1000000 / CLOCKS_PER_SEC;
+	uint64_t per_s = (uint64_t)THROUGHPUT_CHAINS * 1000000 / (elapsed ? elapsed : 1);
+	uint64_t per_cpu_s = (uint64_t)THROUGHPUT_CHAINS * 1000000 / (cpu_us ? cpu_us : 1);
+
+	printf("%d transfers in %" PRId64 " us, %" PRIu64 " transfers/s, %" PRIu64 " per CPU second, the bus carries %d/s\n",
+			THROUGHPUT_CHAINS, elapsed, per_s, per_cpu_s, THROUGHPUT_BUS_PER_S);
+
+	/* The chains complete in order, the last one notifies after the others */
+	TEST_ASSERT_EQUAL(THROUGHPUT_CHAINS, completed);
+	TEST_ASSERT_EQUAL(THROUGHPUT_CHAINS, dev_b.xfers_num);
+	TEST_ASSERT_EQUAL(THROUGHPUT_CHAINS, bus.xfers - xfers_before);
+	TEST_ASSERT(per_cpu_s > THROUGHPUT_BUS_PER_S);
+	TEST_ASSERT_EQUAL(0, host_pm_lock_count(bus.pm_lock));
+}
+
+/***************************** END OF FILE ************************************/
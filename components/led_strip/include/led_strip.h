@@ -0,0 +1,254 @@
+/*
+ * SPDX-FileCopyrightText: 2022 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "led_strip_rmt.h"
+#include "led_strip_spi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Set RGB for a specific pixel
+ *
+ * @param strip: LED strip
+ * @param index: index of pixel to set
+ * @param red: red part of color
+ * @param green: green part of color
+ * @param blue: blue part of color
+ *
+ * @return
+ *      - ESP_OK: Set RGB for a specific pixel successfully
+ *      - ESP_ERR_INVALID_ARG: Set RGB for a specific pixel failed because of invalid parameters
+ *      - ESP_FAIL: Set RGB for a specific pixel failed because other error occurred
+ */
+esp_err_t led_strip_set_pixel(led_strip_handle_t strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue);
+
+/**
+ * @brief Set RGBW for a specific pixel
+ *
+ * @note Only call this function if your led strip does have the white component (e.g. SK6812-RGBW)
+ * @note Also see `led_strip_set_pixel` if you only want to specify the RGB part of the color and bypass the white component
+ *
+ * @param strip: LED strip
+ * @param index: index of pixel to set
+ * @param red: red part of color
+ * @param green: green part of color
+ * @param blue: blue part of color
+ * @param white: separate white component
+ *
+ * @return
+ *      - ESP_OK: Set RGBW color for a specific pixel successfully
+ *      - ESP_ERR_INVALID_ARG: Set RGBW color for a specific pixel failed because of an invalid argument
+ *      - ESP_FAIL: Set RGBW color for a specific pixel failed because other error occurred
+ */
+esp_err_t led_strip_set_pixel_rgbw(led_strip_handle_t strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue, uint32_t white);
+
+/**
+ * @brief Set RGB for a run of consecutive pixels
+ *
+ * @note The range is validated once, which makes this much cheaper than calling `led_strip_set_pixel` in a loop
+ *
+ * @param strip: LED strip
+ * @param start: index of the first pixel to set
+ * @param count: number of pixels to set
+ * @param src: RGB colors, one per pixel
+ *
+ * @return
+ *      - ESP_OK: Set RGB for the pixels successfully
+ *      - ESP_ERR_INVALID_ARG: Set RGB for the pixels failed because of invalid parameters
+ *      - ESP_FAIL: Set RGB for the pixels failed because other error occurred
+ */
+esp_err_t led_strip_set_pixels(led_strip_handle_t strip, uint32_t start, uint32_t count, const led_strip_rgb_t *src);
+
+/**
+ * @brief Set the same RGB for a run of consecutive pixels
+ *
+ * @param strip: LED strip
+ * @param start: index of the first pixel to set
+ * @param count: number of pixels to set
+ * @param red: red part of color
+ * @param green: green part of color
+ * @param blue: blue part of color
+ *
+ * @return
+ *      - ESP_OK: Fill the pixels successfully
+ *      - ESP_ERR_INVALID_ARG: Fill the pixels failed because of invalid parameters
+ *      - ESP_FAIL: Fill the pixels failed because other error occurred
+ */
+esp_err_t led_strip_fill(led_strip_handle_t strip, uint32_t start, uint32_t count, uint32_t red, uint32_t green, uint32_t blue);
+
+/**
+ * @brief Copy pixels already laid out in the strip format
+ *
+ * @note `raw` holds 3 bytes per pixel in GRB order, or 4 bytes per pixel in GRBW order for `LED_PIXEL_FORMAT_GRBW`
+ *
+ * @param strip: LED strip
+ * @param start: index of the first pixel to set
+ * @param count: number of pixels to set
+ * @param raw: pixel bytes in the strip format
+ *
+ * @return
+ *      - ESP_OK: Copy the pixels successfully
+ *      - ESP_ERR_INVALID_ARG: Copy the pixels failed because of invalid parameters
+ *      - ESP_FAIL: Copy the pixels failed because other error occurred
+ */
+esp_err_t led_strip_blit(led_strip_handle_t strip, uint32_t start, uint32_t count, const uint8_t *raw);
+
+/**
+ * @brief Refresh memory colors to LEDs
+ *
+ * @param strip: LED strip
+ *
+ * @return
+ *      - ESP_OK: Refresh successfully
+ *      - ESP_FAIL: Refresh failed because some other error occurred
+ *
+ * @note:
+ *      After updating the LED colors in the memory, a following invocation of this API is needed to flush colors to strip.
+ */
+esp_err_t led_strip_refresh(led_strip_handle_t strip);
+
+/**
+ * @brief Start flushing memory colors to LEDs and return without waiting for the transfer
+ *
+ * @param strip: LED strip
+ *
+ * @return
+ *      - ESP_OK: Refresh started successfully
+ *      - ESP_FAIL: Refresh failed because some other error occurred
+ *
+ * @note:
+ *      The frame is latched when this function returns, so the pixels can be updated again right away
+ *      without disturbing the transfer in flight. Use `led_strip_wait_refresh_done` to wait for the wire.
+ * @note:
+ *      One frame is in flight at most. If the previous frame is still being sent, this function waits for it
+ *      to end before queueing the new one, that is up to one frame time (about 30 us per WS2812 LED).
+ *      Refreshes spaced by more than a frame time never block.
+ */
+esp_err_t led_strip_refresh_async(led_strip_handle_t strip);
+
+/**
+ * @brief Wait for the transfer started by `led_strip_refresh_async` to finish
+ *
+ * @param strip: LED strip
+ * @param timeout_ms: timeout value for waiting, -1 means wait forever
+ *
+ * @return
+ *      - ESP_OK: Refresh finished
+ *      - ESP_ERR_TIMEOUT: Refresh still in progress when the timeout expired
+ *      - ESP_FAIL: Wait failed because some other error occurred
+ */
+esp_err_t led_strip_wait_refresh_done(led_strip_handle_t strip, int32_t timeout_ms);
+
+/**
+ * @brief Clear LED strip (turn off all LEDs)
+ *
+ * @param strip: LED strip
+ *
+ * @return
+ *      - ESP_OK: Clear LEDs successfully
+ *      - ESP_FAIL: Clear LEDs failed because some other error occurred
+ */
+esp_err_t led_strip_clear(led_strip_handle_t strip);
+
+/**
+ * @brief Blink the pixels in memory, letting the peripheral repeat the pattern on its own
+ *
+ * @note The on frame, the off frame and the delays between them are encoded once, so the blink timing
+ *       doesn't depend on any task. The blink runs until `led_strip_blink_stop`, or until the next refresh.
+ *       With power management the RMT backend keeps the chip out of light sleep while it blinks, a refresh
+ *       only does it until the frame is sent.
+ *
+ * @param strip: LED strip
+ * @param on_ms: time the pixels are shown, in milliseconds
+ * @param off_ms: time the LEDs are off, in milliseconds
+ *
+ * @return
+ *      - ESP_OK: Blink started successfully
+ *      - ESP_ERR_NOT_SUPPORTED: The LED strip backend (or its configuration) can't loop a pattern
+ *      - ESP_ERR_INVALID_SIZE: The blink pattern doesn't fit in the backend memory, use a software timer instead
+ *      - ESP_FAIL: Blink failed because some other error occurred
+ */
+esp_err_t led_strip_blink_start(led_strip_handle_t strip, uint32_t on_ms, uint32_t off_ms);
+
+/**
+ * @brief Stop the blink started by `led_strip_blink_start`
+ *
+ * @note The LEDs are left in an undefined state, refresh or clear the strip afterwards
+ *
+ * @param strip: LED strip
+ *
+ * @return
+ *      - ESP_OK: Blink stopped successfully, or no blink was running
+ *      - ESP_FAIL: Blink stop failed because some other error occurred
+ */
+esp_err_t led_strip_blink_stop(led_strip_handle_t strip);
+
+/**
+ * @brief Set the global brightness of the LED strip
+ *
+ * @note The scale is applied while the pixels are sent out, the stored colors are not modified.
+ *       Call `led_strip_refresh` afterwards to show the change.
+ *
+ * @param strip: LED strip
+ * @param brightness: brightness scale, 255 sends the stored colors unchanged
+ *
+ * @return
+ *      - ESP_OK: Set brightness successfully
+ *      - ESP_ERR_NOT_SUPPORTED: The LED strip backend can't scale colors on the fly
+ *      - ESP_FAIL: Set brightness failed because some other error occurred
+ */
+esp_err_t led_strip_set_brightness(led_strip_handle_t strip, uint8_t brightness);
+
+/**
+ * @brief Set the gamma correction table of the LED strip
+ *
+ * @note Like the brightness, the correction is applied while the pixels are sent out.
+ *       The table is not copied, so it must stay valid while it is in use.
+ *
+ * @param strip: LED strip
+ * @param gamma_table: 256 entry table mapping a stored color byte to the sent one, NULL disables gamma correction
+ *
+ * @return
+ *      - ESP_OK: Set gamma table successfully
+ *      - ESP_ERR_NOT_SUPPORTED: The LED strip backend can't correct colors on the fly
+ *      - ESP_FAIL: Set gamma table failed because some other error occurred
+ */
+esp_err_t led_strip_set_gamma(led_strip_handle_t strip, const uint8_t *gamma_table);
+
+/**
+ * @brief Get the refresh statistics of the LED strip
+ *
+ * @note A refresh is skipped, without touching the wire, when no pixel changed since the last frame sent
+ *
+ * @param strip: LED strip
+ * @param stats: returned statistics
+ *
+ * @return
+ *      - ESP_OK: Get statistics successfully
+ *      - ESP_ERR_INVALID_ARG: Get statistics failed because of invalid parameters
+ *      - ESP_ERR_NOT_SUPPORTED: The LED strip backend doesn't keep statistics
+ */
+esp_err_t led_strip_get_stats(led_strip_handle_t strip, led_strip_stats_t *stats);
+
+/**
+ * @brief Free LED strip resources
+ *
+ * @param strip: LED strip
+ *
+ * @return
+ *      - ESP_OK: Free resources successfully
+ *      - ESP_FAIL: Free resources failed because error occurred
+ */
+esp_err_t led_strip_del(led_strip_handle_t strip);
+
+#ifdef __cplusplus
+}
+#endif
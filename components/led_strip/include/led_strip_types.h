@@ -30,6 +30,24 @@ typedef enum {
     LED_MODEL_INVALID /*!< Invalid LED strip model */
 } led_model_t;
 
+/**
+ * @brief RGB color of a single pixel, as consumed by the bulk pixel functions
+ */
+typedef struct {
+    uint8_t r; /*!< Red part of color */
+    uint8_t g; /*!< Green part of color */
+    uint8_t b; /*!< Blue part of color */
+} led_strip_rgb_t;
+
+/**
+ * @brief LED strip refresh statistics
+ */
+typedef struct {
+    uint32_t frames_requested; /*!< Number of refresh requests */
+    uint32_t frames_sent;      /*!< Number of frames actually sent to the LEDs */
+    uint32_t frames_skipped;   /*!< Number of refresh requests skipped because the LEDs already showed the frame */
+} led_strip_stats_t;
+
 /**
  * @brief LED strip handle
  */
@@ -0,0 +1,231 @@
+/*
+ * SPDX-FileCopyrightText: 2022 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "led_strip_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct led_strip_t led_strip_t; /*!< Type of LED strip */
+
+/**
+ * @brief LED strip interface definition
+ */
+struct led_strip_t {
+    /**
+     * @brief Set RGB for a specific pixel
+     *
+     * @param strip: LED strip
+     * @param index: index of pixel to set
+     * @param red: red part of color
+     * @param green: green part of color
+     * @param blue: blue part of color
+     *
+     * @return
+     *      - ESP_OK: Set RGB for a specific pixel successfully
+     *      - ESP_ERR_INVALID_ARG: Set RGB for a specific pixel failed because of invalid parameters
+     *      - ESP_FAIL: Set RGB for a specific pixel failed because other error occurred
+     */
+    esp_err_t (*set_pixel)(led_strip_t *strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue);
+
+    /**
+     * @brief Set RGBW for a specific pixel. Similar to `set_pixel` but also set the white component
+     *
+     * @param strip: LED strip
+     * @param index: index of pixel to set
+     * @param red: red part of color
+     * @param green: green part of color
+     * @param blue: blue part of color
+     * @param white: separate white component
+     *
+     * @return
+     *      - ESP_OK: Set RGBW color for a specific pixel successfully
+     *      - ESP_ERR_INVALID_ARG: Set RGBW color for a specific pixel failed because of an invalid argument
+     *      - ESP_FAIL: Set RGBW color for a specific pixel failed because other error occurred
+     */
+    esp_err_t (*set_pixel_rgbw)(led_strip_t *strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue, uint32_t white);
+
+    /**
+     * @brief Set RGB for a run of consecutive pixels
+     *
+     * @param strip: LED strip
+     * @param start: index of the first pixel to set
+     * @param count: number of pixels to set
+     * @param src: RGB colors, one per pixel
+     *
+     * @return
+     *      - ESP_OK: Set RGB for the pixels successfully
+     *      - ESP_ERR_INVALID_ARG: Set RGB for the pixels failed because of invalid parameters
+     *      - ESP_FAIL: Set RGB for the pixels failed because other error occurred
+     */
+    esp_err_t (*set_pixels)(led_strip_t *strip, uint32_t start, uint32_t count, const led_strip_rgb_t *src);
+
+    /**
+     * @brief Set the same RGB for a run of consecutive pixels
+     *
+     * @param strip: LED strip
+     * @param start: index of the first pixel to set
+     * @param count: number of pixels to set
+     * @param red: red part of color
+     * @param green: green part of color
+     * @param blue: blue part of color
+     *
+     * @return
+     *      - ESP_OK: Fill the pixels successfully
+     *      - ESP_ERR_INVALID_ARG: Fill the pixels failed because of invalid parameters
+     *      - ESP_FAIL: Fill the pixels failed because other error occurred
+     */
+    esp_err_t (*fill)(led_strip_t *strip, uint32_t start, uint32_t count, uint32_t red, uint32_t green, uint32_t blue);
+
+    /**
+     * @brief Copy pixels already laid out in the strip format (GRB or GRBW)
+     *
+     * @param strip: LED strip
+     * @param start: index of the first pixel to set
+     * @param count: number of pixels to set
+     * @param raw: pixel bytes, `count` times the bytes per pixel of the strip
+     *
+     * @return
+     *      - ESP_OK: Copy the pixels successfully
+     *      - ESP_ERR_INVALID_ARG: Copy the pixels failed because of invalid parameters
+     *      - ESP_FAIL: Copy the pixels failed because other error occurred
+     */
+    esp_err_t (*blit)(led_strip_t *strip, uint32_t start, uint32_t count, const uint8_t *raw);
+
+    /**
+     * @brief Refresh memory colors to LEDs
+     *
+     * @param strip: LED strip
+     * @param timeout_ms: timeout value for refreshing task
+     *
+     * @return
+     *      - ESP_OK: Refresh successfully
+     *      - ESP_FAIL: Refresh failed because some other error occurred
+     *
+     * @note:
+     *      After updating the LED colors in the memory, a following invocation of this API is needed to flush colors to strip.
+     */
+    esp_err_t (*refresh)(led_strip_t *strip);
+
+    /**
+     * @brief Start flushing memory colors to LEDs without waiting for the transfer to finish
+     *
+     * @param strip: LED strip
+     *
+     * @return
+     *      - ESP_OK: Refresh started successfully
+     *      - ESP_FAIL: Refresh failed because some other error occurred
+     *
+     * @note:
+     *      Backends that don't provide this hook fall back to the blocking `refresh`.
+     */
+    esp_err_t (*refresh_async)(led_strip_t *strip);
+
+    /**
+     * @brief Wait for the refresh started by `refresh_async` to finish
+     *
+     * @param strip: LED strip
+     * @param timeout_ms: timeout value for waiting, -1 means wait forever
+     *
+     * @return
+     *      - ESP_OK: Refresh finished
+     *      - ESP_ERR_TIMEOUT: Refresh still in progress when the timeout expired
+     *      - ESP_FAIL: Wait failed because some other error occurred
+     */
+    esp_err_t (*wait_refresh_done)(led_strip_t *strip, int32_t timeout_ms);
+
+    /**
+     * @brief Clear LED strip (turn off all LEDs)
+     *
+     * @param strip: LED strip
+     * @param timeout_ms: timeout value for clearing task
+     *
+     * @return
+     *      - ESP_OK: Clear LEDs successfully
+     *      - ESP_FAIL: Clear LEDs failed because some other error occurred
+     */
+    esp_err_t (*clear)(led_strip_t *strip);
+
+    /**
+     * @brief Blink the current pixels in hardware, without CPU involvement
+     *
+     * @param strip: LED strip
+     * @param on_ms: time the pixels are shown, in milliseconds
+     * @param off_ms: time the LEDs are off, in milliseconds
+     *
+     * @return
+     *      - ESP_OK: Blink started successfully
+     *      - ESP_ERR_INVALID_SIZE: The blink pattern is too long for the backend
+     *      - ESP_FAIL: Blink failed because some other error occurred
+     */
+    esp_err_t (*blink_start)(led_strip_t *strip, uint32_t on_ms, uint32_t off_ms);
+
+    /**
+     * @brief Stop the blink started by `blink_start`
+     *
+     * @param strip: LED strip
+     *
+     * @return
+     *      - ESP_OK: Blink stopped successfully
+     *      - ESP_FAIL: Blink stop failed because some other error occurred
+     */
+    esp_err_t (*blink_stop)(led_strip_t *strip);
+
+    /**
+     * @brief Set the global brightness applied when the pixels are sent out
+     *
+     * @param strip: LED strip
+     * @param brightness: brightness scale, 255 sends the stored colors unchanged
+     *
+     * @return
+     *      - ESP_OK: Set brightness successfully
+     *      - ESP_FAIL: Set brightness failed because some other error occurred
+     */
+    esp_err_t (*set_brightness)(led_strip_t *strip, uint8_t brightness);
+
+    /**
+     * @brief Set the gamma correction table applied when the pixels are sent out
+     *
+     * @param strip: LED strip
+     * @param gamma_table: 256 entry table, NULL disables gamma correction
+     *
+     * @return
+     *      - ESP_OK: Set gamma table successfully
+     *      - ESP_FAIL: Set gamma table failed because some other error occurred
+     */
+    esp_err_t (*set_gamma)(led_strip_t *strip, const uint8_t *gamma_table);
+
+    /**
+     * @brief Get the refresh statistics of the LED strip
+     *
+     * @param strip: LED strip
+     * @param stats: returned statistics
+     *
+     * @return
+     *      - ESP_OK: Get statistics successfully
+     *      - ESP_FAIL: Get statistics failed because some other error occurred
+     */
+    esp_err_t (*get_stats)(led_strip_t *strip, led_strip_stats_t *stats);
+
+    /**
+     * @brief Free LED strip resources
+     *
+     * @param strip: LED strip
+     *
+     * @return
+     *      - ESP_OK: Free resources successfully
+     *      - ESP_FAIL: Free resources failed because error occurred
+     */
+    esp_err_t (*del)(led_strip_t *strip);
+};
+
+#ifdef __cplusplus
+}
+#endif
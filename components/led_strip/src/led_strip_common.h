@@ -0,0 +1,42 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Check that the pixel range [start, start + count) lies inside a strip of `strip_len` pixels
+ */
+static inline bool led_strip_range_is_valid(uint32_t strip_len, uint32_t start, uint32_t count)
+{
+    return count <= strip_len && start <= strip_len - count;
+}
+
+/**
+ * @brief Replicate the first `pattern_size` bytes of `buf` until `count` patterns are written
+ *
+ * @note Every copy doubles the filled area, so a long run costs a handful of wide memcpy calls
+ */
+static inline void led_strip_fill_pattern(uint8_t *buf, size_t pattern_size, uint32_t count)
+{
+    size_t total = pattern_size * count;
+    size_t filled = pattern_size;
+    while (filled < total) {
+        size_t chunk = total - filled < filled ? total - filled : filled;
+        memcpy(buf + filled, buf, chunk);
+        filled += chunk;
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
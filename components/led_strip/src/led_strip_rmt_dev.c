@@ -0,0 +1,572 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <sys/cdefs.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/timers.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "driver/rmt_tx.h"
+#include "led_strip.h"
+#include "led_strip_interface.h"
+#include "led_strip_rmt_encoder.h"
+#include "led_strip_common.h"
+
+#define LED_STRIP_RMT_DEFAULT_RESOLUTION 10000000 // 10MHz resolution
+#define LED_STRIP_RMT_DEFAULT_TRANS_QUEUE_SIZE 4
+// longest low level carried by one RMT symbol, each of its two halves has a 15 bit duration
+#define LED_STRIP_RMT_MAX_HOLD_TICKS (0x7FFF * 2)
+// the memory size of each RMT channel, in words (4 bytes)
+#if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+#define LED_STRIP_RMT_DEFAULT_MEM_BLOCK_SYMBOLS 64
+#else
+#define LED_STRIP_RMT_DEFAULT_MEM_BLOCK_SYMBOLS 48
+#endif
+
+static const char *TAG = "led_strip_rmt";
+
+typedef struct {
+    led_strip_t base;
+    rmt_channel_handle_t rmt_chan;
+    rmt_encoder_handle_t strip_encoder;
+    rmt_encoder_handle_t copy_encoder;  // sends the pre-rendered blink pattern
+    rmt_symbol_word_t *blink_symbols;   // blink pattern, looped by the RMT peripheral
+    uint32_t resolution;
+    size_t mem_block_symbols;
+    bool with_dma;
+    bool blinking;
+    bool enabled;                       // the channel holds the RMT power management lock while enabled
+    SemaphoreHandle_t lock;             // serializes the channel state with the release run by the timer task
+    atomic_uint frames_in_flight;       // frames queued and not sent yet, the blink loop isn't counted
+    uint32_t strip_len;
+    uint8_t bytes_per_pixel;
+    uint8_t *front_buf; // frame owned by the RMT driver while it is being transmitted
+    uint8_t *back_buf;  // frame the set_pixel functions write into
+    bool dirty;           // back buffer differs from what the LEDs show, or the way it is sent changed
+    uint32_t dirty_first; // first pixel changed since the last frame sent
+    uint32_t dirty_last;  // last pixel changed since the last frame sent
+    led_strip_stats_t stats;
+    uint8_t pixel_buf[];
+} led_strip_rmt_obj;
+
+// mark pixels [first, last] as changed since the last frame sent
+static inline void led_strip_rmt_mark_dirty(led_strip_rmt_obj *rmt_strip, uint32_t first, uint32_t last)
+{
+    rmt_strip->dirty = true;
+    if (first < rmt_strip->dirty_first) {
+        rmt_strip->dirty_first = first;
+    }
+    if (last > rmt_strip->dirty_last) {
+        rmt_strip->dirty_last = last;
+    }
+}
+
+// forget the changes once they have been handed to the RMT driver
+static inline void led_strip_rmt_clear_dirty(led_strip_rmt_obj *rmt_strip)
+{
+    rmt_strip->dirty = false;
+    rmt_strip->dirty_first = UINT32_MAX;
+    rmt_strip->dirty_last = 0;
+}
+
+// copy `count` pixels in the wire format into the back buffer, only marking them dirty if they differ
+static void led_strip_rmt_update(led_strip_rmt_obj *rmt_strip, uint32_t index, const uint8_t *pixels, uint32_t count)
+{
+    uint8_t *buf = rmt_strip->back_buf + index * rmt_strip->bytes_per_pixel;
+    size_t size = count * rmt_strip->bytes_per_pixel;
+    if (count && memcmp(buf, pixels, size)) {
+        memcpy(buf, pixels, size);
+        led_strip_rmt_mark_dirty(rmt_strip, index, index + count - 1);
+    }
+}
+
+static esp_err_t led_strip_rmt_set_pixel(led_strip_t *strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    ESP_RETURN_ON_FALSE(index < rmt_strip->strip_len, ESP_ERR_INVALID_ARG, TAG, "index out of maximum number of LEDs");
+    // In thr order of GRB, as LED strip like WS2812 sends out pixels in this order
+    uint8_t pixel[4] = {green & 0xFF, red & 0xFF, blue & 0xFF, 0};
+    led_strip_rmt_update(rmt_strip, index, pixel, 1);
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_rmt_set_pixel_rgbw(led_strip_t *strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue, uint32_t white)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    ESP_RETURN_ON_FALSE(index < rmt_strip->strip_len, ESP_ERR_INVALID_ARG, TAG, "index out of maximum number of LEDs");
+    ESP_RETURN_ON_FALSE(rmt_strip->bytes_per_pixel == 4, ESP_ERR_INVALID_ARG, TAG, "wrong LED pixel format, expected 4 bytes per pixel");
+    // SK6812 component order is GRBW
+    uint8_t pixel[4] = {green & 0xFF, red & 0xFF, blue & 0xFF, white & 0xFF};
+    led_strip_rmt_update(rmt_strip, index, pixel, 1);
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_rmt_set_pixels(led_strip_t *strip, uint32_t start, uint32_t count, const led_strip_rgb_t *src)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    ESP_RETURN_ON_FALSE(led_strip_range_is_valid(rmt_strip->strip_len, start, count), ESP_ERR_INVALID_ARG, TAG, "pixel range out of maximum number of LEDs");
+    uint8_t bytes_per_pixel = rmt_strip->bytes_per_pixel;
+    uint8_t *buf = rmt_strip->back_buf + start * bytes_per_pixel;
+    uint32_t first = UINT32_MAX;
+    uint32_t last = 0;
+    for (uint32_t i = 0; i < count; i++, buf += bytes_per_pixel) {
+        uint8_t pixel[4] = {src[i].g, src[i].r, src[i].b, 0};
+        if (memcmp(buf, pixel, bytes_per_pixel)) {
+            memcpy(buf, pixel, bytes_per_pixel);
+            first = first == UINT32_MAX ? start + i : first;
+            last = start + i;
+        }
+    }
+    if (first != UINT32_MAX) {
+        led_strip_rmt_mark_dirty(rmt_strip, first, last);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_rmt_fill(led_strip_t *strip, uint32_t start, uint32_t count, uint32_t red, uint32_t green, uint32_t blue)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    ESP_RETURN_ON_FALSE(led_strip_range_is_valid(rmt_strip->strip_len, start, count), ESP_ERR_INVALID_ARG, TAG, "pixel range out of maximum number of LEDs");
+    uint8_t bytes_per_pixel = rmt_strip->bytes_per_pixel;
+    uint8_t pixel[4] = {green & 0xFF, red & 0xFF, blue & 0xFF, 0};
+    // skip the leading pixels that already have the color
+    uint8_t *buf = rmt_strip->back_buf + start * bytes_per_pixel;
+    while (count && !memcmp(buf, pixel, bytes_per_pixel)) {
+        buf += bytes_per_pixel;
+        start++;
+        count--;
+    }
+    if (!count) {
+        return ESP_OK;
+    }
+    // write the first pixel, then replicate it over the rest of the range
+    memcpy(buf, pixel, bytes_per_pixel);
+    led_strip_fill_pattern(buf, bytes_per_pixel, count);
+    led_strip_rmt_mark_dirty(rmt_strip, start, start + count - 1);
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_rmt_blit(led_strip_t *strip, uint32_t start, uint32_t count, const uint8_t *raw)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    ESP_RETURN_ON_FALSE(led_strip_range_is_valid(rmt_strip->strip_len, start, count), ESP_ERR_INVALID_ARG, TAG, "pixel range out of maximum number of LEDs");
+    // the pixel buffer is already in the wire format, nothing to convert
+    led_strip_rmt_update(rmt_strip, start, raw, count);
+    return ESP_OK;
+}
+
+// append low level symbols lasting `ticks`, returns the number of symbols used
+static size_t led_strip_rmt_render_hold(rmt_symbol_word_t *symbols, uint64_t ticks)
+{
+    size_t num_symbols = 0;
+    while (ticks) {
+        uint32_t symbol_ticks = ticks > LED_STRIP_RMT_MAX_HOLD_TICKS ? LED_STRIP_RMT_MAX_HOLD_TICKS : ticks;
+        // a zero duration is the end marker, so a single tick is stretched to two
+        if (symbol_ticks < 2) {
+            symbol_ticks = 2;
+        }
+        symbols[num_symbols++] = (rmt_symbol_word_t) {
+            .level0 = 0,
+            .duration0 = (symbol_ticks + 1) / 2,
+            .level1 = 0,
+            .duration1 = symbol_ticks / 2,
+        };
+        ticks -= ticks > symbol_ticks ? symbol_ticks : ticks;
+    }
+    return num_symbols;
+}
+
+static size_t led_strip_rmt_hold_symbols(uint64_t ticks)
+{
+    return (ticks + LED_STRIP_RMT_MAX_HOLD_TICKS - 1) / LED_STRIP_RMT_MAX_HOLD_TICKS;
+}
+
+// enable the channel before sending, it is only enabled while it has something to send
+// so the RMT power management lock doesn't keep the chip out of light sleep. Called with the lock taken
+static esp_err_t led_strip_rmt_acquire(led_strip_rmt_obj *rmt_strip)
+{
+    if (!rmt_strip->enabled) {
+        ESP_RETURN_ON_ERROR(rmt_enable(rmt_strip->rmt_chan), TAG, "enable RMT channel failed");
+        rmt_strip->enabled = true;
+    }
+    return ESP_OK;
+}
+
+// undo led_strip_rmt_acquire when nothing was started on the channel, so it doesn't hold the RMT power
+// management lock for good. Called with the lock taken
+static void led_strip_rmt_abort(led_strip_rmt_obj *rmt_strip)
+{
+    if (rmt_strip->enabled && !rmt_strip->blinking && atomic_load(&rmt_strip->frames_in_flight) == 0) {
+        rmt_disable(rmt_strip->rmt_chan);
+        rmt_strip->enabled = false;
+    }
+}
+
+#if CONFIG_PM_ENABLE
+// run by the timer task once the last frame queued has left the wire, rmt_disable can't be called from the ISR
+static void led_strip_rmt_release(void *arg, uint32_t unused)
+{
+    led_strip_rmt_obj *rmt_strip = (led_strip_rmt_obj *)arg;
+    xSemaphoreTake(rmt_strip->lock, portMAX_DELAY);
+    // a frame or the blink loop may have been started since the callback
+    if (rmt_strip->enabled && !rmt_strip->blinking && atomic_load(&rmt_strip->frames_in_flight) == 0) {
+        // only collects the finished transactions, nothing is in flight
+        rmt_tx_wait_all_done(rmt_strip->rmt_chan, -1);
+        rmt_disable(rmt_strip->rmt_chan);
+        rmt_strip->enabled = false;
+    }
+    xSemaphoreGive(rmt_strip->lock);
+}
+
+static void led_strip_rmt_sync(void *arg, uint32_t unused)
+{
+    xTaskNotifyGive((TaskHandle_t)arg);
+}
+
+static bool led_strip_rmt_on_trans_done(rmt_channel_handle_t chan, const rmt_tx_done_event_data_t *edata, void *user_ctx)
+{
+    led_strip_rmt_obj *rmt_strip = (led_strip_rmt_obj *)user_ctx;
+    BaseType_t task_woken = pdFALSE;
+    if (atomic_fetch_sub(&rmt_strip->frames_in_flight, 1) == 1) {
+        xTimerPendFunctionCallFromISR(led_strip_rmt_release, rmt_strip, 0, &task_woken);
+    }
+    return task_woken == pdTRUE;
+}
+#endif
+
+// abort the blink loop, the channel is left disabled. Called with the lock taken
+static esp_err_t led_strip_rmt_loop_stop(led_strip_rmt_obj *rmt_strip)
+{
+    if (!rmt_strip->blinking) {
+        return ESP_OK;
+    }
+    // an infinite loop never completes, disabling the channel aborts it
+    ESP_RETURN_ON_ERROR(rmt_disable(rmt_strip->rmt_chan), TAG, "disable RMT channel failed");
+    rmt_strip->enabled = false;
+    rmt_strip->blinking = false;
+    // the loop was stopped at an arbitrary point, the next refresh must send the frame again
+    rmt_strip->dirty = true;
+    return ESP_OK;
+}
+
+// make the channel idle: abort the blink loop or wait for the frame in flight. Called with the lock taken
+static esp_err_t led_strip_rmt_flush(led_strip_rmt_obj *rmt_strip)
+{
+    if (rmt_strip->blinking) {
+        return led_strip_rmt_loop_stop(rmt_strip);
+    }
+    if (!rmt_strip->enabled) {
+        return ESP_OK;
+    }
+    return rmt_tx_wait_all_done(rmt_strip->rmt_chan, -1);
+}
+
+static esp_err_t led_strip_rmt_blink_stop(led_strip_t *strip)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    xSemaphoreTake(rmt_strip->lock, portMAX_DELAY);
+    esp_err_t ret = led_strip_rmt_loop_stop(rmt_strip);
+    xSemaphoreGive(rmt_strip->lock);
+    return ret;
+}
+
+static esp_err_t led_strip_rmt_loop_start(led_strip_rmt_obj *rmt_strip, uint32_t on_ms, uint32_t off_ms)
+{
+    // the peripheral can only loop over what fits in its own memory
+    ESP_RETURN_ON_FALSE(!rmt_strip->with_dma, ESP_ERR_NOT_SUPPORTED, TAG, "blink loop not supported with DMA");
+    size_t frame_size = rmt_strip->strip_len * rmt_strip->bytes_per_pixel;
+    // holding the line low for at least 50us latches the frame, like the reset code does
+    uint64_t min_hold_ticks = rmt_strip->resolution / 1000000 * 50;
+    uint64_t on_ticks = (uint64_t)on_ms * rmt_strip->resolution / 1000;
+    uint64_t off_ticks = (uint64_t)off_ms * rmt_strip->resolution / 1000;
+    on_ticks = on_ticks < min_hold_ticks ? min_hold_ticks : on_ticks;
+    off_ticks = off_ticks < min_hold_ticks ? min_hold_ticks : off_ticks;
+    size_t num_symbols = frame_size * 8 * 2 + led_strip_rmt_hold_symbols(on_ticks) + led_strip_rmt_hold_symbols(off_ticks);
+    // one more word is taken by the end marker
+    ESP_RETURN_ON_FALSE(num_symbols < rmt_strip->mem_block_symbols, ESP_ERR_INVALID_SIZE, TAG, "blink pattern doesn't fit in RMT memory");
+
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_ERROR(led_strip_rmt_flush(rmt_strip), TAG, "flush RMT channel failed");
+    ESP_RETURN_ON_ERROR(led_strip_rmt_acquire(rmt_strip), TAG, "acquire RMT channel failed");
+    if (!rmt_strip->copy_encoder) {
+        rmt_copy_encoder_config_t copy_encoder_config = {};
+        ESP_GOTO_ON_ERROR(rmt_new_copy_encoder(&copy_encoder_config, &rmt_strip->copy_encoder), err, TAG, "create copy encoder failed");
+    }
+    if (!rmt_strip->blink_symbols) {
+        rmt_strip->blink_symbols = calloc(rmt_strip->mem_block_symbols, sizeof(rmt_symbol_word_t));
+        ESP_GOTO_ON_FALSE(rmt_strip->blink_symbols, ESP_ERR_NO_MEM, err, TAG, "no mem for blink pattern");
+    }
+
+    // on frame, hold, off frame, hold: rendered once, then repeated by the peripheral without the CPU
+    rmt_symbol_word_t *symbols = rmt_strip->blink_symbols;
+    symbols += rmt_led_strip_encoder_render(rmt_strip->strip_encoder, rmt_strip->back_buf, frame_size, symbols);
+    symbols += led_strip_rmt_render_hold(symbols, on_ticks);
+    symbols += rmt_led_strip_encoder_render(rmt_strip->strip_encoder, NULL, frame_size, symbols);
+    symbols += led_strip_rmt_render_hold(symbols, off_ticks);
+
+    rmt_transmit_config_t tx_conf = {
+        .loop_count = -1,
+    };
+    ESP_GOTO_ON_ERROR(rmt_transmit(rmt_strip->rmt_chan, rmt_strip->copy_encoder, rmt_strip->blink_symbols,
+                                   (symbols - rmt_strip->blink_symbols) * sizeof(rmt_symbol_word_t), &tx_conf),
+                      err, TAG, "transmit blink pattern by RMT failed");
+    rmt_strip->blinking = true;
+    // whatever the LEDs show now, a refresh must end the loop and send the frame
+    rmt_strip->dirty = true;
+    return ESP_OK;
+err:
+    led_strip_rmt_abort(rmt_strip);
+    return ret;
+}
+
+static esp_err_t led_strip_rmt_blink_start(led_strip_t *strip, uint32_t on_ms, uint32_t off_ms)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    xSemaphoreTake(rmt_strip->lock, portMAX_DELAY);
+    esp_err_t ret = led_strip_rmt_loop_start(rmt_strip, on_ms, off_ms);
+    xSemaphoreGive(rmt_strip->lock);
+    return ret;
+}
+
+static esp_err_t led_strip_rmt_send(led_strip_rmt_obj *rmt_strip)
+{
+    rmt_transmit_config_t tx_conf = {
+        .loop_count = 0,
+    };
+
+    rmt_strip->stats.frames_requested++;
+    if (!rmt_strip->dirty) {
+        // the LEDs already show this frame
+        rmt_strip->stats.frames_skipped++;
+        return ESP_OK;
+    }
+
+    // the front buffer is recycled as the next back buffer, so the previous frame must have left the wire:
+    // one frame is in flight at most, a refresh within a frame time waits for the rest of it.
+    // A refresh also ends the blink loop, the last call wins
+    ESP_RETURN_ON_ERROR(led_strip_rmt_flush(rmt_strip), TAG, "flush RMT channel failed");
+    ESP_RETURN_ON_ERROR(led_strip_rmt_acquire(rmt_strip), TAG, "acquire RMT channel failed");
+    atomic_fetch_add(&rmt_strip->frames_in_flight, 1);
+    esp_err_t ret = rmt_transmit(rmt_strip->rmt_chan, rmt_strip->strip_encoder, rmt_strip->back_buf,
+                                 rmt_strip->strip_len * rmt_strip->bytes_per_pixel, &tx_conf);
+    if (ret != ESP_OK) {
+        atomic_fetch_sub(&rmt_strip->frames_in_flight, 1);
+        led_strip_rmt_abort(rmt_strip);
+        ESP_LOGE(TAG, "transmit pixels by RMT failed");
+        return ret;
+    }
+    rmt_strip->stats.frames_sent++;
+    // swap the buffers and carry the frame over, so the next frame starts from what is being displayed.
+    // The recycled buffer holds the previous frame, it only differs from the sent one in the dirty range
+    uint8_t *sent_buf = rmt_strip->back_buf;
+    rmt_strip->back_buf = rmt_strip->front_buf;
+    rmt_strip->front_buf = sent_buf;
+    if (rmt_strip->dirty_first <= rmt_strip->dirty_last) {
+        size_t offset = rmt_strip->dirty_first * rmt_strip->bytes_per_pixel;
+        size_t size = (rmt_strip->dirty_last - rmt_strip->dirty_first + 1) * rmt_strip->bytes_per_pixel;
+        memcpy(rmt_strip->back_buf + offset, rmt_strip->front_buf + offset, size);
+    }
+    led_strip_rmt_clear_dirty(rmt_strip);
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_rmt_refresh_async(led_strip_t *strip)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    xSemaphoreTake(rmt_strip->lock, portMAX_DELAY);
+    esp_err_t ret = led_strip_rmt_send(rmt_strip);
+    xSemaphoreGive(rmt_strip->lock);
+    return ret;
+}
+
+static esp_err_t led_strip_rmt_wait_refresh_done(led_strip_t *strip, int32_t timeout_ms)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    esp_err_t ret = ESP_OK;
+    xSemaphoreTake(rmt_strip->lock, portMAX_DELAY);
+    // the blink loop is not a refresh, it would never be done. A disabled channel has nothing in flight
+    if (!rmt_strip->blinking && rmt_strip->enabled) {
+        ret = rmt_tx_wait_all_done(rmt_strip->rmt_chan, timeout_ms);
+    }
+    xSemaphoreGive(rmt_strip->lock);
+    return ret;
+}
+
+static esp_err_t led_strip_rmt_refresh(led_strip_t *strip)
+{
+    ESP_RETURN_ON_ERROR(led_strip_rmt_refresh_async(strip), TAG, "start refresh failed");
+    ESP_RETURN_ON_ERROR(led_strip_rmt_wait_refresh_done(strip, -1), TAG, "flush RMT channel failed");
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_rmt_clear(led_strip_t *strip)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    // Write zero to turn off all leds
+    ESP_RETURN_ON_ERROR(led_strip_rmt_fill(strip, 0, rmt_strip->strip_len, 0, 0, 0), TAG, "clear pixels failed");
+    return led_strip_rmt_refresh(strip);
+}
+
+static esp_err_t led_strip_rmt_set_brightness(led_strip_t *strip, uint8_t brightness)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    xSemaphoreTake(rmt_strip->lock, portMAX_DELAY);
+    // the encoder reads its LUT from the RMT ISR, don't swap it under a frame in flight
+    esp_err_t ret = led_strip_rmt_flush(rmt_strip);
+    if (ret == ESP_OK) {
+        // the pixels are unchanged, but the next refresh must send them again
+        rmt_strip->dirty = true;
+        ret = rmt_led_strip_encoder_set_brightness(rmt_strip->strip_encoder, brightness);
+    }
+    xSemaphoreGive(rmt_strip->lock);
+    return ret;
+}
+
+static esp_err_t led_strip_rmt_set_gamma(led_strip_t *strip, const uint8_t *gamma_table)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    xSemaphoreTake(rmt_strip->lock, portMAX_DELAY);
+    esp_err_t ret = led_strip_rmt_flush(rmt_strip);
+    if (ret == ESP_OK) {
+        rmt_strip->dirty = true;
+        ret = rmt_led_strip_encoder_set_gamma(rmt_strip->strip_encoder, gamma_table);
+    }
+    xSemaphoreGive(rmt_strip->lock);
+    return ret;
+}
+
+static esp_err_t led_strip_rmt_get_stats(led_strip_t *strip, led_strip_stats_t *stats)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    *stats = rmt_strip->stats;
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_rmt_del(led_strip_t *strip)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    ESP_RETURN_ON_ERROR(led_strip_rmt_flush(rmt_strip), TAG, "flush RMT channel failed");
+#if CONFIG_PM_ENABLE
+    // a release pended by the last frame must run before the strip is freed, the timer task runs them in order
+    xTimerPendFunctionCall(led_strip_rmt_sync, xTaskGetCurrentTaskHandle(), 0, portMAX_DELAY);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+#endif
+    if (rmt_strip->enabled) {
+        ESP_RETURN_ON_ERROR(rmt_disable(rmt_strip->rmt_chan), TAG, "disable RMT channel failed");
+    }
+    ESP_RETURN_ON_ERROR(rmt_del_channel(rmt_strip->rmt_chan), TAG, "delete RMT channel failed");
+    ESP_RETURN_ON_ERROR(rmt_del_encoder(rmt_strip->strip_encoder), TAG, "delete strip encoder failed");
+    if (rmt_strip->copy_encoder) {
+        ESP_RETURN_ON_ERROR(rmt_del_encoder(rmt_strip->copy_encoder), TAG, "delete copy encoder failed");
+    }
+    free(rmt_strip->blink_symbols);
+    vSemaphoreDelete(rmt_strip->lock);
+    free(rmt_strip);
+    return ESP_OK;
+}
+
+esp_err_t led_strip_new_rmt_device(const led_strip_config_t *led_config, const led_strip_rmt_config_t *rmt_config, led_strip_handle_t *ret_strip)
+{
+    led_strip_rmt_obj *rmt_strip = NULL;
+    esp_err_t ret = ESP_OK;
+    ESP_GOTO_ON_FALSE(led_config && rmt_config && ret_strip, ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
+    ESP_GOTO_ON_FALSE(led_config->led_pixel_format < LED_PIXEL_FORMAT_INVALID, ESP_ERR_INVALID_ARG, err, TAG, "invalid led_pixel_format");
+    uint8_t bytes_per_pixel = 3;
+    if (led_config->led_pixel_format == LED_PIXEL_FORMAT_GRBW) {
+        bytes_per_pixel = 4;
+    } else if (led_config->led_pixel_format == LED_PIXEL_FORMAT_GRB) {
+        bytes_per_pixel = 3;
+    } else {
+        assert(false);
+    }
+    // two frames: one owned by the RMT driver while the other one is being written
+    rmt_strip = calloc(1, sizeof(led_strip_rmt_obj) + led_config->max_leds * bytes_per_pixel * 2);
+    ESP_GOTO_ON_FALSE(rmt_strip, ESP_ERR_NO_MEM, err, TAG, "no mem for rmt strip");
+    uint32_t resolution = rmt_config->resolution_hz ? rmt_config->resolution_hz : LED_STRIP_RMT_DEFAULT_RESOLUTION;
+
+    // for backward compatibility, if the user does not set the clk_src, use the default value
+    rmt_clock_source_t clk_src = RMT_CLK_SRC_DEFAULT;
+    if (rmt_config->clk_src) {
+        clk_src = rmt_config->clk_src;
+    }
+    size_t mem_block_symbols = LED_STRIP_RMT_DEFAULT_MEM_BLOCK_SYMBOLS;
+    // override the default value if the user sets it
+    if (rmt_config->mem_block_symbols) {
+        mem_block_symbols = rmt_config->mem_block_symbols;
+    }
+    rmt_tx_channel_config_t rmt_chan_config = {
+        .clk_src = clk_src,
+        .gpio_num = led_config->strip_gpio_num,
+        .mem_block_symbols = mem_block_symbols,
+        .resolution_hz = resolution,
+        .trans_queue_depth = LED_STRIP_RMT_DEFAULT_TRANS_QUEUE_SIZE,
+        .flags.with_dma = rmt_config->flags.with_dma,
+        .flags.invert_out = led_config->flags.invert_out,
+    };
+    ESP_GOTO_ON_ERROR(rmt_new_tx_channel(&rmt_chan_config, &rmt_strip->rmt_chan), err, TAG, "create RMT TX channel failed");
+
+    led_strip_encoder_config_t strip_encoder_conf = {
+        .resolution = resolution,
+        .led_model = led_config->led_model
+    };
+    ESP_GOTO_ON_ERROR(rmt_new_led_strip_encoder(&strip_encoder_conf, &rmt_strip->strip_encoder), err, TAG, "create LED strip encoder failed");
+    rmt_strip->lock = xSemaphoreCreateMutex();
+    ESP_GOTO_ON_FALSE(rmt_strip->lock, ESP_ERR_NO_MEM, err, TAG, "no mem for strip lock");
+    // the channel is enabled by the first refresh. With power management it is disabled again once its frames are sent
+#if CONFIG_PM_ENABLE
+    rmt_tx_event_callbacks_t cbs = {
+        .on_trans_done = led_strip_rmt_on_trans_done,
+    };
+    ESP_GOTO_ON_ERROR(rmt_tx_register_event_callbacks(rmt_strip->rmt_chan, &cbs, rmt_strip), err, TAG, "register RMT callbacks failed");
+#endif
+
+    rmt_strip->bytes_per_pixel = bytes_per_pixel;
+    rmt_strip->resolution = resolution;
+    rmt_strip->mem_block_symbols = mem_block_symbols;
+    rmt_strip->with_dma = rmt_config->flags.with_dma;
+    rmt_strip->strip_len = led_config->max_leds;
+    rmt_strip->front_buf = rmt_strip->pixel_buf;
+    rmt_strip->back_buf = rmt_strip->pixel_buf + led_config->max_leds * bytes_per_pixel;
+    // the LEDs content is unknown at power up, so the first refresh is always sent
+    led_strip_rmt_clear_dirty(rmt_strip);
+    rmt_strip->dirty = true;
+    rmt_strip->base.set_pixel = led_strip_rmt_set_pixel;
+    rmt_strip->base.set_pixel_rgbw = led_strip_rmt_set_pixel_rgbw;
+    rmt_strip->base.set_pixels = led_strip_rmt_set_pixels;
+    rmt_strip->base.fill = led_strip_rmt_fill;
+    rmt_strip->base.blit = led_strip_rmt_blit;
+    rmt_strip->base.refresh = led_strip_rmt_refresh;
+    rmt_strip->base.refresh_async = led_strip_rmt_refresh_async;
+    rmt_strip->base.wait_refresh_done = led_strip_rmt_wait_refresh_done;
+    rmt_strip->base.clear = led_strip_rmt_clear;
+    rmt_strip->base.blink_start = led_strip_rmt_blink_start;
+    rmt_strip->base.blink_stop = led_strip_rmt_blink_stop;
+    rmt_strip->base.set_brightness = led_strip_rmt_set_brightness;
+    rmt_strip->base.set_gamma = led_strip_rmt_set_gamma;
+    rmt_strip->base.get_stats = led_strip_rmt_get_stats;
+    rmt_strip->base.del = led_strip_rmt_del;
+
+    *ret_strip = &rmt_strip->base;
+    return ESP_OK;
+err:
+    if (rmt_strip) {
+        if (rmt_strip->rmt_chan) {
+            rmt_del_channel(rmt_strip->rmt_chan);
+        }
+        if (rmt_strip->strip_encoder) {
+            rmt_del_encoder(rmt_strip->strip_encoder);
+        }
+        if (rmt_strip->lock) {
+            vSemaphoreDelete(rmt_strip->lock);
+        }
+        free(rmt_strip);
+    }
+    return ret;
+}
@@ -7,6 +7,9 @@
 #include "esp_check.h"
 #include "led_strip_rmt_encoder.h"
 
+// how many color bytes are corrected on the stack before being handed to the bytes encoder
+#define LED_STRIP_ENCODER_CHUNK_SIZE 16
+
 static const char *TAG = "led_rmt_encoder";
 
 typedef struct {
@@ -14,9 +17,57 @@ typedef struct {
     rmt_encoder_t *bytes_encoder;
     rmt_encoder_t *copy_encoder;
     int state;
+    size_t byte_index;           // next color byte to encode when the LUT is in use
     rmt_symbol_word_t reset_code;
+    rmt_symbol_word_t bit0;      // symbols of the bytes encoder, kept to render frames without it
+    rmt_symbol_word_t bit1;
+    uint8_t brightness;
+    const uint8_t *gamma_table;
+    bool use_lut;                // false when the LUT is the identity, so the pixel bytes are sent as they are
+    uint8_t lut[256];            // gamma correction and brightness folded into one table
 } rmt_led_strip_encoder_t;
 
+static size_t rmt_encode_led_strip_lut(rmt_led_strip_encoder_t *led_encoder, rmt_channel_handle_t channel,
+                                       const uint8_t *data, size_t data_size, rmt_encode_state_t *ret_state)
+{
+    rmt_encoder_handle_t bytes_encoder = led_encoder->bytes_encoder;
+    rmt_encode_state_t session_state = 0;
+    size_t encoded_symbols = 0;
+    uint8_t chunk[LED_STRIP_ENCODER_CHUNK_SIZE];
+
+    *ret_state = 0;
+    while (led_encoder->byte_index < data_size) {
+        size_t chunk_size = data_size - led_encoder->byte_index;
+        if (chunk_size > LED_STRIP_ENCODER_CHUNK_SIZE) {
+            chunk_size = LED_STRIP_ENCODER_CHUNK_SIZE;
+        }
+        // the bytes encoder resumes a partially encoded chunk by position, so rebuilding it yields the same bytes
+        for (size_t i = 0; i < chunk_size; i++) {
+            chunk[i] = led_encoder->lut[data[led_encoder->byte_index + i]];
+        }
+        encoded_symbols += bytes_encoder->encode(bytes_encoder, channel, chunk, chunk_size, &session_state);
+        if (session_state & RMT_ENCODING_COMPLETE) {
+            led_encoder->byte_index += chunk_size;
+        }
+        if (session_state & RMT_ENCODING_MEM_FULL) {
+            *ret_state |= RMT_ENCODING_MEM_FULL;
+            return encoded_symbols; // yield if there's no free space for encoding artifacts
+        }
+    }
+    led_encoder->byte_index = 0;
+    *ret_state |= RMT_ENCODING_COMPLETE;
+    return encoded_symbols;
+}
+
+static void rmt_led_strip_encoder_update_lut(rmt_led_strip_encoder_t *led_encoder)
+{
+    for (int i = 0; i < 256; i++) {
+        uint32_t value = led_encoder->gamma_table ? led_encoder->gamma_table[i] : i;
+        led_encoder->lut[i] = (value * led_encoder->brightness + 127) / 255;
+    }
+    led_encoder->use_lut = led_encoder->gamma_table || led_encoder->brightness != 255;
+}
+
 static size_t rmt_encode_led_strip(rmt_encoder_t *encoder, rmt_channel_handle_t channel, const void *primary_data, size_t data_size, rmt_encode_state_t *ret_state)
 {
     rmt_led_strip_encoder_t *led_encoder = __containerof(encoder, rmt_led_strip_encoder_t, base);
@@ -27,7 +78,11 @@ static size_t rmt_encode_led_strip(rmt_encoder_t *encoder, rmt_channel_handle_t
     size_t encoded_symbols = 0;
     switch (led_encoder->state) {
     case 0: // send RGB data
-        encoded_symbols += bytes_encoder->encode(bytes_encoder, channel, primary_data, data_size, &session_state);
+        if (led_encoder->use_lut) {
+            encoded_symbols += rmt_encode_led_strip_lut(led_encoder, channel, primary_data, data_size, &session_state);
+        } else {
+            encoded_symbols += bytes_encoder->encode(bytes_encoder, channel, primary_data, data_size, &session_state);
+        }
         if (session_state & RMT_ENCODING_COMPLETE) {
             led_encoder->state = 1; // switch to next state when current encoding session finished
         }
@@ -68,9 +123,44 @@ static esp_err_t rmt_led_strip_encoder_reset(rmt_encoder_t *encoder)
     rmt_encoder_reset(led_encoder->bytes_encoder);
     rmt_encoder_reset(led_encoder->copy_encoder);
     led_encoder->state = 0;
+    led_encoder->byte_index = 0;
+    return ESP_OK;
+}
+
+esp_err_t rmt_led_strip_encoder_set_brightness(rmt_encoder_handle_t encoder, uint8_t brightness)
+{
+    ESP_RETURN_ON_FALSE(encoder, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    rmt_led_strip_encoder_t *led_encoder = __containerof(encoder, rmt_led_strip_encoder_t, base);
+    led_encoder->brightness = brightness;
+    rmt_led_strip_encoder_update_lut(led_encoder);
     return ESP_OK;
 }
 
+esp_err_t rmt_led_strip_encoder_set_gamma(rmt_encoder_handle_t encoder, const uint8_t *gamma_table)
+{
+    ESP_RETURN_ON_FALSE(encoder, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    rmt_led_strip_encoder_t *led_encoder = __containerof(encoder, rmt_led_strip_encoder_t, base);
+    led_encoder->gamma_table = gamma_table;
+    rmt_led_strip_encoder_update_lut(led_encoder);
+    return ESP_OK;
+}
+
+size_t rmt_led_strip_encoder_render(rmt_encoder_handle_t encoder, const uint8_t *data, size_t data_size, rmt_symbol_word_t *symbols)
+{
+    rmt_led_strip_encoder_t *led_encoder = __containerof(encoder, rmt_led_strip_encoder_t, base);
+    for (size_t i = 0; i < data_size; i++) {
+        uint8_t byte = 0;
+        if (data) {
+            byte = led_encoder->use_lut ? led_encoder->lut[data[i]] : data[i];
+        }
+        // both supported models send the MSB first
+        for (int bit = 7; bit >= 0; bit--) {
+            *symbols++ = (byte & (1 << bit)) ? led_encoder->bit1 : led_encoder->bit0;
+        }
+    }
+    return data_size * 8;
+}
+
 esp_err_t rmt_new_led_strip_encoder(const led_strip_encoder_config_t *config, rmt_encoder_handle_t *ret_encoder)
 {
     esp_err_t ret = ESP_OK;
@@ -82,6 +172,8 @@ esp_err_t rmt_new_led_strip_encoder(const led_strip_encoder_config_t *config, rm
     led_encoder->base.encode = rmt_encode_led_strip;
     led_encoder->base.del = rmt_del_led_strip_encoder;
     led_encoder->base.reset = rmt_led_strip_encoder_reset;
+    led_encoder->brightness = 255;
+    rmt_led_strip_encoder_update_lut(led_encoder);
     rmt_bytes_encoder_config_t bytes_encoder_config;
     if (config->led_model == LED_MODEL_SK6812) {
         bytes_encoder_config = (rmt_bytes_encoder_config_t) {
@@ -119,6 +211,8 @@ esp_err_t rmt_new_led_strip_encoder(const led_strip_encoder_config_t *config, rm
     } else {
         assert(false);
     }
+    led_encoder->bit0 = bytes_encoder_config.bit0;
+    led_encoder->bit1 = bytes_encoder_config.bit1;
     ESP_GOTO_ON_ERROR(rmt_new_bytes_encoder(&bytes_encoder_config, &led_encoder->bytes_encoder), err, TAG, "create bytes encoder failed");
     rmt_copy_encoder_config_t copy_encoder_config = {};
     ESP_GOTO_ON_ERROR(rmt_new_copy_encoder(&copy_encoder_config, &led_encoder->copy_encoder), err, TAG, "create copy encoder failed");
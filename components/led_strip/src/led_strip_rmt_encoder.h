@@ -0,0 +1,77 @@
+/*
+ * SPDX-FileCopyrightText: 2022 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdint.h>
+#include "driver/rmt_encoder.h"
+#include "led_strip_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Type of led strip encoder configuration
+ */
+typedef struct {
+    uint32_t resolution;   /*!< Encoder resolution, in Hz */
+    led_model_t led_model; /*!< LED model */
+} led_strip_encoder_config_t;
+
+/**
+ * @brief Create RMT encoder for encoding LED strip pixels into RMT symbols
+ *
+ * @param[in] config Encoder configuration
+ * @param[out] ret_encoder Returned encoder handle
+ * @return
+ *      - ESP_ERR_INVALID_ARG for any invalid arguments
+ *      - ESP_ERR_NO_MEM out of memory when creating led strip encoder
+ *      - ESP_OK if creating encoder successfully
+ */
+esp_err_t rmt_new_led_strip_encoder(const led_strip_encoder_config_t *config, rmt_encoder_handle_t *ret_encoder);
+
+/**
+ * @brief Set the global brightness applied to every color byte while it is encoded
+ *
+ * @note Must not be called while a transaction using this encoder is in progress
+ *
+ * @param[in] encoder Encoder handle created by `rmt_new_led_strip_encoder`
+ * @param[in] brightness Brightness scale, 255 sends the pixel bytes unchanged
+ * @return
+ *      - ESP_ERR_INVALID_ARG for any invalid arguments
+ *      - ESP_OK if the brightness was set successfully
+ */
+esp_err_t rmt_led_strip_encoder_set_brightness(rmt_encoder_handle_t encoder, uint8_t brightness);
+
+/**
+ * @brief Set the gamma correction table applied to every color byte while it is encoded
+ *
+ * @note Must not be called while a transaction using this encoder is in progress
+ *
+ * @param[in] encoder Encoder handle created by `rmt_new_led_strip_encoder`
+ * @param[in] gamma_table 256 entry table, it must stay valid while in use. NULL disables gamma correction
+ * @return
+ *      - ESP_ERR_INVALID_ARG for any invalid arguments
+ *      - ESP_OK if the gamma table was set successfully
+ */
+esp_err_t rmt_led_strip_encoder_set_gamma(rmt_encoder_handle_t encoder, const uint8_t *gamma_table);
+
+/**
+ * @brief Render LED strip pixels into RMT symbols, applying the same correction as the encoder
+ *
+ * @note Unlike the encoder, no reset code is appended
+ *
+ * @param[in] encoder Encoder handle created by `rmt_new_led_strip_encoder`
+ * @param[in] data Pixel bytes in the wire format, NULL renders a frame of zeros without any correction
+ * @param[in] data_size Number of pixel bytes to render
+ * @param[out] symbols Returned symbols, room for `data_size * 8` of them is needed
+ * @return Number of rendered symbols
+ */
+size_t rmt_led_strip_encoder_render(rmt_encoder_handle_t encoder, const uint8_t *data, size_t data_size, rmt_symbol_word_t *symbols);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,358 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <sys/cdefs.h>
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_rom_gpio.h"
+#include "soc/spi_periph.h"
+#include "led_strip.h"
+#include "led_strip_interface.h"
+#include "hal/spi_hal.h"
+#include "led_strip_common.h"
+
+#define LED_STRIP_SPI_DEFAULT_RESOLUTION (2.5 * 1000 * 1000) // 2.5MHz resolution
+#define LED_STRIP_SPI_DEFAULT_TRANS_QUEUE_SIZE 4
+
+#define SPI_BYTES_PER_COLOR_BYTE 3
+#define SPI_BITS_PER_COLOR_BYTE (SPI_BYTES_PER_COLOR_BYTE * 8)
+
+static const char *TAG = "led_strip_spi";
+
+typedef struct {
+    led_strip_t base;
+    spi_host_device_t spi_host;
+    spi_device_handle_t spi_device;
+    uint32_t strip_len;
+    uint8_t bytes_per_pixel;
+    bool dirty; // SPI buffer differs from what the LEDs show
+    led_strip_stats_t stats;
+    uint8_t pixel_buf[];
+} led_strip_spi_obj;
+
+// Each color of 1 bit is represented by 3 bits of SPI, low_level:100 ,high_level:110
+// So a color byte occupies 3 bytes of SPI, this table holds the pattern of every color byte, MSB first.
+static const uint8_t __led_strip_spi_bit_lut[256][SPI_BYTES_PER_COLOR_BYTE] = {
+    {0x92, 0x49, 0x24}, {0x92, 0x49, 0x26}, {0x92, 0x49, 0x34}, {0x92, 0x49, 0x36},
+    {0x92, 0x49, 0xA4}, {0x92, 0x49, 0xA6}, {0x92, 0x49, 0xB4}, {0x92, 0x49, 0xB6},
+    {0x92, 0x4D, 0x24}, {0x92, 0x4D, 0x26}, {0x92, 0x4D, 0x34}, {0x92, 0x4D, 0x36},
+    {0x92, 0x4D, 0xA4}, {0x92, 0x4D, 0xA6}, {0x92, 0x4D, 0xB4}, {0x92, 0x4D, 0xB6},
+    {0x92, 0x69, 0x24}, {0x92, 0x69, 0x26}, {0x92, 0x69, 0x34}, {0x92, 0x69, 0x36},
+    {0x92, 0x69, 0xA4}, {0x92, 0x69, 0xA6}, {0x92, 0x69, 0xB4}, {0x92, 0x69, 0xB6},
+    {0x92, 0x6D, 0x24}, {0x92, 0x6D, 0x26}, {0x92, 0x6D, 0x34}, {0x92, 0x6D, 0x36},
+    {0x92, 0x6D, 0xA4}, {0x92, 0x6D, 0xA6}, {0x92, 0x6D, 0xB4}, {0x92, 0x6D, 0xB6},
+    {0x93, 0x49, 0x24}, {0x93, 0x49, 0x26}, {0x93, 0x49, 0x34}, {0x93, 0x49, 0x36},
+    {0x93, 0x49, 0xA4}, {0x93, 0x49, 0xA6}, {0x93, 0x49, 0xB4}, {0x93, 0x49, 0xB6},
+    {0x93, 0x4D, 0x24}, {0x93, 0x4D, 0x26}, {0x93, 0x4D, 0x34}, {0x93, 0x4D, 0x36},
+    {0x93, 0x4D, 0xA4}, {0x93, 0x4D, 0xA6}, {0x93, 0x4D, 0xB4}, {0x93, 0x4D, 0xB6},
+    {0x93, 0x69, 0x24}, {0x93, 0x69, 0x26}, {0x93, 0x69, 0x34}, {0x93, 0x69, 0x36},
+    {0x93, 0x69, 0xA4}, {0x93, 0x69, 0xA6}, {0x93, 0x69, 0xB4}, {0x93, 0x69, 0xB6},
+    {0x93, 0x6D, 0x24}, {0x93, 0x6D, 0x26}, {0x93, 0x6D, 0x34}, {0x93, 0x6D, 0x36},
+    {0x93, 0x6D, 0xA4}, {0x93, 0x6D, 0xA6}, {0x93, 0x6D, 0xB4}, {0x93, 0x6D, 0xB6},
+    {0x9A, 0x49, 0x24}, {0x9A, 0x49, 0x26}, {0x9A, 0x49, 0x34}, {0x9A, 0x49, 0x36},
+    {0x9A, 0x49, 0xA4}, {0x9A, 0x49, 0xA6}, {0x9A, 0x49, 0xB4}, {0x9A, 0x49, 0xB6},
+    {0x9A, 0x4D, 0x24}, {0x9A, 0x4D, 0x26}, {0x9A, 0x4D, 0x34}, {0x9A, 0x4D, 0x36},
+    {0x9A, 0x4D, 0xA4}, {0x9A, 0x4D, 0xA6}, {0x9A, 0x4D, 0xB4}, {0x9A, 0x4D, 0xB6},
+    {0x9A, 0x69, 0x24}, {0x9A, 0x69, 0x26}, {0x9A, 0x69, 0x34}, {0x9A, 0x69, 0x36},
+    {0x9A, 0x69, 0xA4}, {0x9A, 0x69, 0xA6}, {0x9A, 0x69, 0xB4}, {0x9A, 0x69, 0xB6},
+    {0x9A, 0x6D, 0x24}, {0x9A, 0x6D, 0x26}, {0x9A, 0x6D, 0x34}, {0x9A, 0x6D, 0x36},
+    {0x9A, 0x6D, 0xA4}, {0x9A, 0x6D, 0xA6}, {0x9A, 0x6D, 0xB4}, {0x9A, 0x6D, 0xB6},
+    {0x9B, 0x49, 0x24}, {0x9B, 0x49, 0x26}, {0x9B, 0x49, 0x34}, {0x9B, 0x49, 0x36},
+    {0x9B, 0x49, 0xA4}, {0x9B, 0x49, 0xA6}, {0x9B, 0x49, 0xB4}, {0x9B, 0x49, 0xB6},
+    {0x9B, 0x4D, 0x24}, {0x9B, 0x4D, 0x26}, {0x9B, 0x4D, 0x34}, {0x9B, 0x4D, 0x36},
+    {0x9B, 0x4D, 0xA4}, {0x9B, 0x4D, 0xA6}, {0x9B, 0x4D, 0xB4}, {0x9B, 0x4D, 0xB6},
+    {0x9B, 0x69, 0x24}, {0x9B, 0x69, 0x26}, {0x9B, 0x69, 0x34}, {0x9B, 0x69, 0x36},
+    {0x9B, 0x69, 0xA4}, {0x9B, 0x69, 0xA6}, {0x9B, 0x69, 0xB4}, {0x9B, 0x69, 0xB6},
+    {0x9B, 0x6D, 0x24}, {0x9B, 0x6D, 0x26}, {0x9B, 0x6D, 0x34}, {0x9B, 0x6D, 0x36},
+    {0x9B, 0x6D, 0xA4}, {0x9B, 0x6D, 0xA6}, {0x9B, 0x6D, 0xB4}, {0x9B, 0x6D, 0xB6},
+    {0xD2, 0x49, 0x24}, {0xD2, 0x49, 0x26}, {0xD2, 0x49, 0x34}, {0xD2, 0x49, 0x36},
+    {0xD2, 0x49, 0xA4}, {0xD2, 0x49, 0xA6}, {0xD2, 0x49, 0xB4}, {0xD2, 0x49, 0xB6},
+    {0xD2, 0x4D, 0x24}, {0xD2, 0x4D, 0x26}, {0xD2, 0x4D, 0x34}, {0xD2, 0x4D, 0x36},
+    {0xD2, 0x4D, 0xA4}, {0xD2, 0x4D, 0xA6}, {0xD2, 0x4D, 0xB4}, {0xD2, 0x4D, 0xB6},
+    {0xD2, 0x69, 0x24}, {0xD2, 0x69, 0x26}, {0xD2, 0x69, 0x34}, {0xD2, 0x69, 0x36},
+    {0xD2, 0x69, 0xA4}, {0xD2, 0x69, 0xA6}, {0xD2, 0x69, 0xB4}, {0xD2, 0x69, 0xB6},
+    {0xD2, 0x6D, 0x24}, {0xD2, 0x6D, 0x26}, {0xD2, 0x6D, 0x34}, {0xD2, 0x6D, 0x36},
+    {0xD2, 0x6D, 0xA4}, {0xD2, 0x6D, 0xA6}, {0xD2, 0x6D, 0xB4}, {0xD2, 0x6D, 0xB6},
+    {0xD3, 0x49, 0x24}, {0xD3, 0x49, 0x26}, {0xD3, 0x49, 0x34}, {0xD3, 0x49, 0x36},
+    {0xD3, 0x49, 0xA4}, {0xD3, 0x49, 0xA6}, {0xD3, 0x49, 0xB4}, {0xD3, 0x49, 0xB6},
+    {0xD3, 0x4D, 0x24}, {0xD3, 0x4D, 0x26}, {0xD3, 0x4D, 0x34}, {0xD3, 0x4D, 0x36},
+    {0xD3, 0x4D, 0xA4}, {0xD3, 0x4D, 0xA6}, {0xD3, 0x4D, 0xB4}, {0xD3, 0x4D, 0xB6},
+    {0xD3, 0x69, 0x24}, {0xD3, 0x69, 0x26}, {0xD3, 0x69, 0x34}, {0xD3, 0x69, 0x36},
+    {0xD3, 0x69, 0xA4}, {0xD3, 0x69, 0xA6}, {0xD3, 0x69, 0xB4}, {0xD3, 0x69, 0xB6},
+    {0xD3, 0x6D, 0x24}, {0xD3, 0x6D, 0x26}, {0xD3, 0x6D, 0x34}, {0xD3, 0x6D, 0x36},
+    {0xD3, 0x6D, 0xA4}, {0xD3, 0x6D, 0xA6}, {0xD3, 0x6D, 0xB4}, {0xD3, 0x6D, 0xB6},
+    {0xDA, 0x49, 0x24}, {0xDA, 0x49, 0x26}, {0xDA, 0x49, 0x34}, {0xDA, 0x49, 0x36},
+    {0xDA, 0x49, 0xA4}, {0xDA, 0x49, 0xA6}, {0xDA, 0x49, 0xB4}, {0xDA, 0x49, 0xB6},
+    {0xDA, 0x4D, 0x24}, {0xDA, 0x4D, 0x26}, {0xDA, 0x4D, 0x34}, {0xDA, 0x4D, 0x36},
+    {0xDA, 0x4D, 0xA4}, {0xDA, 0x4D, 0xA6}, {0xDA, 0x4D, 0xB4}, {0xDA, 0x4D, 0xB6},
+    {0xDA, 0x69, 0x24}, {0xDA, 0x69, 0x26}, {0xDA, 0x69, 0x34}, {0xDA, 0x69, 0x36},
+    {0xDA, 0x69, 0xA4}, {0xDA, 0x69, 0xA6}, {0xDA, 0x69, 0xB4}, {0xDA, 0x69, 0xB6},
+    {0xDA, 0x6D, 0x24}, {0xDA, 0x6D, 0x26}, {0xDA, 0x6D, 0x34}, {0xDA, 0x6D, 0x36},
+    {0xDA, 0x6D, 0xA4}, {0xDA, 0x6D, 0xA6}, {0xDA, 0x6D, 0xB4}, {0xDA, 0x6D, 0xB6},
+    {0xDB, 0x49, 0x24}, {0xDB, 0x49, 0x26}, {0xDB, 0x49, 0x34}, {0xDB, 0x49, 0x36},
+    {0xDB, 0x49, 0xA4}, {0xDB, 0x49, 0xA6}, {0xDB, 0x49, 0xB4}, {0xDB, 0x49, 0xB6},
+    {0xDB, 0x4D, 0x24}, {0xDB, 0x4D, 0x26}, {0xDB, 0x4D, 0x34}, {0xDB, 0x4D, 0x36},
+    {0xDB, 0x4D, 0xA4}, {0xDB, 0x4D, 0xA6}, {0xDB, 0x4D, 0xB4}, {0xDB, 0x4D, 0xB6},
+    {0xDB, 0x69, 0x24}, {0xDB, 0x69, 0x26}, {0xDB, 0x69, 0x34}, {0xDB, 0x69, 0x36},
+    {0xDB, 0x69, 0xA4}, {0xDB, 0x69, 0xA6}, {0xDB, 0x69, 0xB4}, {0xDB, 0x69, 0xB6},
+    {0xDB, 0x6D, 0x24}, {0xDB, 0x6D, 0x26}, {0xDB, 0x6D, 0x34}, {0xDB, 0x6D, 0x36},
+    {0xDB, 0x6D, 0xA4}, {0xDB, 0x6D, 0xA6}, {0xDB, 0x6D, 0xB4}, {0xDB, 0x6D, 0xB6},
+};
+
+// expand `len` color bytes into `len * SPI_BYTES_PER_COLOR_BYTE` bytes of SPI pattern, returns true if the buffer changed
+static inline bool __led_strip_spi_encode(const uint8_t *data, size_t len, uint8_t *buf)
+{
+    bool changed = false;
+    for (size_t i = 0; i < len; i++) {
+        const uint8_t *pattern = __led_strip_spi_bit_lut[data[i]];
+        if (memcmp(buf, pattern, SPI_BYTES_PER_COLOR_BYTE)) {
+            memcpy(buf, pattern, SPI_BYTES_PER_COLOR_BYTE);
+            changed = true;
+        }
+        buf += SPI_BYTES_PER_COLOR_BYTE;
+    }
+    return changed;
+}
+
+// encode `count` RGB triplets starting at pixel `index`, in one pass over the SPI buffer. Returns true if the buffer changed
+static bool __led_strip_spi_encode_rgb(led_strip_spi_obj *spi_strip, uint32_t index, const led_strip_rgb_t *rgb, uint32_t count)
+{
+    uint8_t bytes_per_pixel = spi_strip->bytes_per_pixel;
+    uint8_t *buf = spi_strip->pixel_buf + index * bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE;
+    bool changed = false;
+    for (uint32_t i = 0; i < count; i++, rgb++) {
+        // In the order of GRB, as LED strip like WS2812 sends out pixels in this order
+        uint8_t pixel[4] = {rgb->g, rgb->r, rgb->b, 0};
+        changed |= __led_strip_spi_encode(pixel, bytes_per_pixel, buf);
+        buf += bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE;
+    }
+    return changed;
+}
+
+static esp_err_t led_strip_spi_set_pixel(led_strip_t *strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue)
+{
+    led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
+    ESP_RETURN_ON_FALSE(index < spi_strip->strip_len, ESP_ERR_INVALID_ARG, TAG, "index out of maximum number of LEDs");
+    // LED_PIXEL_FORMAT_GRB takes 72bits(9bytes)
+    led_strip_rgb_t rgb = {.r = red & 0xFF, .g = green & 0xFF, .b = blue & 0xFF};
+    spi_strip->dirty |= __led_strip_spi_encode_rgb(spi_strip, index, &rgb, 1);
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_spi_set_pixel_rgbw(led_strip_t *strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue, uint32_t white)
+{
+    led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
+    ESP_RETURN_ON_FALSE(index < spi_strip->strip_len, ESP_ERR_INVALID_ARG, TAG, "index out of maximum number of LEDs");
+    ESP_RETURN_ON_FALSE(spi_strip->bytes_per_pixel == 4, ESP_ERR_INVALID_ARG, TAG, "wrong LED pixel format, expected 4 bytes per pixel");
+    // LED_PIXEL_FORMAT_GRBW takes 96bits(12bytes)
+    uint32_t start = index * spi_strip->bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE;
+    // SK6812 component order is GRBW
+    uint8_t grbw[4] = {green & 0xFF, red & 0xFF, blue & 0xFF, white & 0xFF};
+    spi_strip->dirty |= __led_strip_spi_encode(grbw, sizeof(grbw), &spi_strip->pixel_buf[start]);
+
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_spi_set_pixels(led_strip_t *strip, uint32_t start, uint32_t count, const led_strip_rgb_t *src)
+{
+    led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
+    ESP_RETURN_ON_FALSE(led_strip_range_is_valid(spi_strip->strip_len, start, count), ESP_ERR_INVALID_ARG, TAG, "pixel range out of maximum number of LEDs");
+    spi_strip->dirty |= __led_strip_spi_encode_rgb(spi_strip, start, src, count);
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_spi_fill(led_strip_t *strip, uint32_t start, uint32_t count, uint32_t red, uint32_t green, uint32_t blue)
+{
+    led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
+    ESP_RETURN_ON_FALSE(led_strip_range_is_valid(spi_strip->strip_len, start, count), ESP_ERR_INVALID_ARG, TAG, "pixel range out of maximum number of LEDs");
+    if (!count) {
+        return ESP_OK;
+    }
+    // encode the first pixel, then replicate its SPI pattern over the rest of the range if it isn't there yet
+    size_t pixel_size = spi_strip->bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE;
+    uint8_t *buf = spi_strip->pixel_buf + start * pixel_size;
+    led_strip_rgb_t rgb = {.r = red & 0xFF, .g = green & 0xFF, .b = blue & 0xFF};
+    spi_strip->dirty |= __led_strip_spi_encode_rgb(spi_strip, start, &rgb, 1);
+    for (uint32_t i = 1; i < count; i++) {
+        if (memcmp(buf + i * pixel_size, buf, pixel_size)) {
+            led_strip_fill_pattern(buf, pixel_size, count);
+            spi_strip->dirty = true;
+            break;
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_spi_blit(led_strip_t *strip, uint32_t start, uint32_t count, const uint8_t *raw)
+{
+    led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
+    ESP_RETURN_ON_FALSE(led_strip_range_is_valid(spi_strip->strip_len, start, count), ESP_ERR_INVALID_ARG, TAG, "pixel range out of maximum number of LEDs");
+    spi_strip->dirty |= __led_strip_spi_encode(raw, count * spi_strip->bytes_per_pixel,
+                                               spi_strip->pixel_buf + start * spi_strip->bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE);
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_spi_refresh(led_strip_t *strip)
+{
+    led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
+    spi_transaction_t tx_conf;
+    memset(&tx_conf, 0, sizeof(tx_conf));
+
+    spi_strip->stats.frames_requested++;
+    if (!spi_strip->dirty) {
+        // the LEDs already show this frame
+        spi_strip->stats.frames_skipped++;
+        return ESP_OK;
+    }
+
+    tx_conf.length = spi_strip->strip_len * spi_strip->bytes_per_pixel * SPI_BITS_PER_COLOR_BYTE;
+    tx_conf.tx_buffer = spi_strip->pixel_buf;
+    tx_conf.rx_buffer = NULL;
+    ESP_RETURN_ON_ERROR(spi_device_transmit(spi_strip->spi_device, &tx_conf), TAG, "transmit pixels by SPI failed");
+    spi_strip->stats.frames_sent++;
+    spi_strip->dirty = false;
+
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_spi_clear(led_strip_t *strip)
+{
+    led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
+    //Write zero to turn off all leds
+    ESP_RETURN_ON_ERROR(led_strip_spi_fill(strip, 0, spi_strip->strip_len, 0, 0, 0), TAG, "clear pixels failed");
+
+    return led_strip_spi_refresh(strip);
+}
+
+static esp_err_t led_strip_spi_get_stats(led_strip_t *strip, led_strip_stats_t *stats)
+{
+    led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
+    *stats = spi_strip->stats;
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_spi_del(led_strip_t *strip)
+{
+    led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
+
+    ESP_RETURN_ON_ERROR(spi_bus_remove_device(spi_strip->spi_device), TAG, "delete spi device failed");
+    ESP_RETURN_ON_ERROR(spi_bus_free(spi_strip->spi_host), TAG, "free spi bus failed");
+
+    free(spi_strip);
+    return ESP_OK;
+}
+
+esp_err_t led_strip_new_spi_device(const led_strip_config_t *led_config, const led_strip_spi_config_t *spi_config, led_strip_handle_t *ret_strip)
+{
+    led_strip_spi_obj *spi_strip = NULL;
+    esp_err_t ret = ESP_OK;
+    ESP_GOTO_ON_FALSE(led_config && spi_config && ret_strip, ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
+    ESP_GOTO_ON_FALSE(led_config->led_pixel_format < LED_PIXEL_FORMAT_INVALID, ESP_ERR_INVALID_ARG, err, TAG, "invalid led_pixel_format");
+    uint8_t bytes_per_pixel = 3;
+    if (led_config->led_pixel_format == LED_PIXEL_FORMAT_GRBW) {
+        bytes_per_pixel = 4;
+    } else if (led_config->led_pixel_format == LED_PIXEL_FORMAT_GRB) {
+        bytes_per_pixel = 3;
+    } else {
+        assert(false);
+    }
+    uint32_t mem_caps = MALLOC_CAP_DEFAULT;
+    if (spi_config->flags.with_dma) {
+        // DMA buffer must be placed in internal SRAM
+        mem_caps |= MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA;
+    }
+    spi_strip = heap_caps_calloc(1, sizeof(led_strip_spi_obj) + led_config->max_leds * bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE, mem_caps);
+
+    ESP_GOTO_ON_FALSE(spi_strip, ESP_ERR_NO_MEM, err, TAG, "no mem for spi strip");
+
+    spi_strip->spi_host = spi_config->spi_bus;
+    // for backward compatibility, if the user does not set the clk_src, use the default value
+    spi_clock_source_t clk_src = SPI_CLK_SRC_DEFAULT;
+    if (spi_config->clk_src) {
+        clk_src = spi_config->clk_src;
+    }
+
+    spi_bus_config_t spi_bus_cfg = {
+        .mosi_io_num = led_config->strip_gpio_num,
+        //Only use MOSI to generate the signal, set -1 when other pins are not used.
+        .miso_io_num = -1,
+        .sclk_io_num = -1,
+        .quadwp_io_num = -1,
+        .quadhd_io_num = -1,
+        .max_transfer_sz = led_config->max_leds * bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE,
+    };
+    ESP_GOTO_ON_ERROR(spi_bus_initialize(spi_strip->spi_host, &spi_bus_cfg, spi_config->flags.with_dma ? SPI_DMA_CH_AUTO : SPI_DMA_DISABLED), err, TAG, "create SPI bus failed");
+
+#if !CONFIG_IDF_TARGET_ESP32
+    //SPI_D_POL : This bit is used to set the idle polarity of MOSI. 1：high；0：low (ESP32 does not have this register, and its default polarity is low)
+    spi_dev_t *hw;
+    hw = SPI_LL_GET_HW(spi_strip->spi_host);
+    hw->ctrl.d_pol = 0;
+#endif
+
+    if (led_config->flags.invert_out == true) {
+        esp_rom_gpio_connect_out_signal(led_config->strip_gpio_num, spi_periph_signal[spi_strip->spi_host].spid_out, true, false);
+    }
+
+    spi_device_interface_config_t spi_dev_cfg = {
+        .clock_source = clk_src,
+        .command_bits = 0,
+        .address_bits = 0,
+        .dummy_bits = 0,
+        .clock_speed_hz = LED_STRIP_SPI_DEFAULT_RESOLUTION,
+        .mode = 0,
+        //set -1 when CS is not used
+        .spics_io_num = -1,
+        .queue_size = LED_STRIP_SPI_DEFAULT_TRANS_QUEUE_SIZE,
+    };
+
+    ESP_GOTO_ON_ERROR(spi_bus_add_device(spi_strip->spi_host, &spi_dev_cfg, &spi_strip->spi_device), err, TAG, "Failed to add spi device");
+
+    int clock_resolution_khz = 0;
+    spi_device_get_actual_freq(spi_strip->spi_device, &clock_resolution_khz);
+    // TODO: ideally we should decide the SPI_BYTES_PER_COLOR_BYTE by the real clock resolution
+    // But now, let's fixed the resolution, the downside is, we don't support a clock source whose frequency is not multiple of LED_STRIP_SPI_DEFAULT_RESOLUTION
+    ESP_GOTO_ON_FALSE(clock_resolution_khz == LED_STRIP_SPI_DEFAULT_RESOLUTION / 1000, ESP_ERR_NOT_SUPPORTED, err,
+                      TAG, "unsupported clock resolution:%dKHz", clock_resolution_khz);
+
+    //send dummy data to ensure the initial level of MOSI is low
+    uint8_t dummy_data = 0x00;
+    spi_transaction_t tx_conf = {
+        .length = 8,
+        .tx_buffer = &dummy_data,
+        .rx_buffer = NULL,
+    };
+    ESP_RETURN_ON_ERROR(spi_device_transmit(spi_strip->spi_device, &tx_conf), TAG, "dummy pixels by SPI failed");
+
+    spi_strip->bytes_per_pixel = bytes_per_pixel;
+    spi_strip->strip_len = led_config->max_leds;
+    // the LEDs content is unknown at power up, so the first refresh is always sent
+    spi_strip->dirty = true;
+    spi_strip->base.set_pixel = led_strip_spi_set_pixel;
+    spi_strip->base.set_pixel_rgbw = led_strip_spi_set_pixel_rgbw;
+    spi_strip->base.set_pixels = led_strip_spi_set_pixels;
+    spi_strip->base.fill = led_strip_spi_fill;
+    spi_strip->base.blit = led_strip_spi_blit;
+    spi_strip->base.refresh = led_strip_spi_refresh;
+    spi_strip->base.clear = led_strip_spi_clear;
+    spi_strip->base.get_stats = led_strip_spi_get_stats;
+    spi_strip->base.del = led_strip_spi_del;
+
+    *ret_strip = &spi_strip->base;
+    return ESP_OK;
+err:
+    if (spi_strip) {
+        if (spi_strip->spi_device) {
+            spi_bus_remove_device(spi_strip->spi_device);
+        }
+        if (spi_strip->spi_host) {
+            spi_bus_free(spi_strip->spi_host);
+        }
+        free(spi_strip);
+    }
+    return ret;
+}
@@ -0,0 +1,694 @@
+/**
+  ******************************************************************************
+  * @file           : test_led_strip.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Host test of the led_strip SPI encoder
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <time.h>
+
+#include "host_test.h"
+#include "led_strip.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define STRIP_GPIO				18
+#define SPI_BYTES_PER_COLOR_BYTE	3
+#define RMT_GPIO				19
+#define RMT_RESOLUTION			10000000	/* 0.1 us ticks */
+#define RMT_T0H					3			/* WS2812 bit times in ticks */
+#define RMT_T1H					9
+#define RMT_BIT_TICKS			12
+#define RMT_RESET_TICKS			500			/* 50 us */
+#define RMT_FRAME_US(bytes)		((int64_t)(bytes) * 8 * RMT_BIT_TICKS / 10 + RMT_RESET_TICKS / 10)
+#define RMT_MEM_BLOCK_SYMBOLS	64			/* Default of the ESP32-S2 */
+#define RMT_RELEASE_MS			1000		/* Real time the timer task has to disable the channel */
+#define LUT_FRAMES				100			/* Frames encoded per strip length */
+#define LUT_LEDS_MAX			10000
+
+/* Color bytes per second the SPI line sends at 2.5 MHz */
+#define SPI_LINE_BYTES_PER_S	(2500000 / 8 / SPI_BYTES_PER_COLOR_BYTE)
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+static led_strip_handle_t strip_create(uint32_t max_leds, led_pixel_format_t format);
+static void bit_expand(uint8_t data, uint8_t *buf);
+static void frame_decode(const uint8_t *frame, size_t len, uint8_t *data);
+static led_strip_handle_t rmt_strip_create(uint32_t max_leds, size_t mem_block_symbols);
+static size_t symbols_decode(const rmt_symbol_word_t *symbols, size_t num_symbols, uint8_t *data);
+static size_t symbols_hold(const rmt_symbol_word_t *symbols, size_t num_symbols, uint64_t *ticks);
+static void rmt_frame_check(const uint8_t *expected, size_t len);
+static bool rmt_released(void);
+static uint64_t lut_bytes_per_s(led_strip_handle_t strip, const uint8_t *raw, uint32_t leds);
+static uint64_t expand_bytes_per_s(const uint8_t *raw, uint32_t leds);
+static void test_lut(void);
+static void test_lut_speed(void);
+static void test_pixel_order(void);
+static void test_rgbw(void);
+static void test_refresh_skip(void);
+static void test_args(void);
+static void test_rmt_async(void);
+static void test_rmt_correction(void);
+static void test_rmt_refresh_skip(void);
+static void test_rmt_blink(void);
+
+/* Main ----------------------------------------------------------------------*/
+int main(void) {
+	RUN_TEST(test_lut);
+	RUN_TEST(test_lut_speed);
+	RUN_TEST(test_pixel_order);
+	RUN_TEST(test_rgbw);
+	RUN_TEST(test_refresh_skip);
+	RUN_TEST(test_args);
+	RUN_TEST(test_rmt_async);
+	RUN_TEST(test_rmt_correction);
+	RUN_TEST(test_rmt_refresh_skip);
+	RUN_TEST(test_rmt_blink);
+
+	return 0;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static led_strip_handle_t strip_create(uint32_t max_leds, led_pixel_format_t format) {
+	led_strip_config_t led_config = {
+			.strip_gpio_num = STRIP_GPIO,
+			.max_leds = max_leds,
+			.led_pixel_format = format,
+			.led_model = LED_MODEL_WS2812,
+	};
+	led_strip_spi_config_t spi_config = {
+			.spi_bus = SPI2_HOST,
+			.flags.with_dma = true,
+	};
+	led_strip_handle_t strip = NULL;
+	const uint8_t *frame;
+	size_t len;
+	uint32_t count;
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_new_spi_device(&led_config, &spi_config, &strip));
+
+	/* A dummy byte sets the idle level of MOSI */
+	frame = host_spi_last_tx(&len, &count);
+	TEST_ASSERT_EQUAL(1, len);
+	TEST_ASSERT_EQUAL(0x00, frame[0]);
+
+	return strip;
+}
+
+/* The expander the table replaced, a bit is sent as 110 when set and as 100
+ * when clear, MSB first */
+static void bit_expand(uint8_t data, uint8_t *buf) {
+	memset(buf, 0, SPI_BYTES_PER_COLOR_BYTE);
+
+	*(buf + 2) |= data & BIT(0) ? BIT(2) | BIT(1) : BIT(2);
+	*(buf + 2) |= data & BIT(1) ? BIT(5) | BIT(4) : BIT(5);
+	*(buf + 2) |= data & BIT(2) ? BIT(7) : 0x00;
+	*(buf + 1) |= BIT(0);
+	*(buf + 1) |= data & BIT(3) ? BIT(3) | BIT(2) : BIT(3);
+	*(buf + 1) |= data & BIT(4) ? BIT(6) | BIT(5) : BIT(6);
+	*(buf + 0) |= data & BIT(5) ? BIT(1) | BIT(0) : BIT(1);
+	*(buf + 0) |= data & BIT(6) ? BIT(4) | BIT(3) : BIT(4);
+	*(buf + 0) |= data & BIT(7) ? BIT(7) | BIT(6) : BIT(7);
+}
+
+/* Reads the color bytes back from the SPI frame, failing on a symbol that is
+ * neither 110 nor 100 */
+static void frame_decode(const uint8_t *frame, size_t len, uint8_t *data) {
+	for (size_t i = 0; i < len / SPI_BYTES_PER_COLOR_BYTE; i++) {
+		const uint8_t *p = &frame[i * SPI_BYTES_PER_COLOR_BYTE];
+		uint32_t bits = (uint32_t)p[0] << 16 | (uint32_t)p[1] << 8 | p[2];
+
+		data[i] = 0;
+
+		for (int b = 7; b >= 0; b--) {
+			uint32_t symbol = (bits >> (b * 3)) & 0x07;
+
+			TEST_ASSERT(symbol == 0x06 || symbol == 0x04);
+			data[i] = data[i] << 1 | (symbol == 0x06);
+		}
+	}
+}
+
+static led_strip_handle_t rmt_strip_create(uint32_t max_leds, size_t mem_block_symbols) {
+	led_strip_config_t led_config = {
+			.strip_gpio_num = RMT_GPIO,
+			.max_leds = max_leds,
+			.led_pixel_format = LED_PIXEL_FORMAT_GRB,
+			.led_model = LED_MODEL_WS2812,
+	};
+	led_strip_rmt_config_t rmt_config = {
+			.resolution_hz = RMT_RESOLUTION,
+			.mem_block_symbols = mem_block_symbols,
+	};
+	led_strip_handle_t strip = NULL;
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_new_rmt_device(&led_config, &rmt_config, &strip));
+	TEST_ASSERT(host_rmt_channel(RMT_GPIO) != NULL);
+
+	return strip;
+}
+
+/* Reads the color bytes back from the RMT symbols, failing on a symbol that
+ * is neither a WS2812 0 nor 1. Returns the number of symbols read */
+static size_t symbols_decode(const rmt_symbol_word_t *symbols, size_t num_symbols, uint8_t *data) {
+	size_t i;
+
+	for (i = 0; i + 8 <= num_symbols && symbols[i].level0; i += 8) {
+		uint8_t byte = 0;
+
+		for (size_t b = 0; b < 8; b++) {
+			rmt_symbol_word_t symbol = symbols[i + b];
+
+			TEST_ASSERT(symbol.level0 == 1 && symbol.level1 == 0);
+			TEST_ASSERT_EQUAL(RMT_BIT_TICKS, symbol.duration0 + symbol.duration1);
+			TEST_ASSERT(symbol.duration0 == RMT_T0H || symbol.duration0 == RMT_T1H);
+			byte = byte << 1 | (symbol.duration0 == RMT_T1H);
+		}
+
+		data[i / 8] = byte;
+	}
+
+	return i;
+}
+
+/* Reads a low level hold, returns the number of symbols it takes */
+static size_t symbols_hold(const rmt_symbol_word_t *symbols, size_t num_symbols, uint64_t *ticks) {
+	size_t i;
+
+	*ticks = 0;
+
+	for (i = 0; i < num_symbols && !symbols[i].level0; i++) {
+		TEST_ASSERT(symbols[i].level1 == 0 && symbols[i].duration0 && symbols[i].duration1);
+		*ticks += symbols[i].duration0 + symbols[i].duration1;
+	}
+
+	return i;
+}
+
+/* The last frame sent is the expected bytes and the reset code */
+static void rmt_frame_check(const uint8_t *expected, size_t len) {
+	static uint8_t data[4096];
+	size_t num_symbols;
+	uint32_t count;
+	const rmt_symbol_word_t *symbols = host_rmt_last_tx(host_rmt_channel(RMT_GPIO), &num_symbols, &count);
+
+	TEST_ASSERT(len <= sizeof(data));
+	TEST_ASSERT_EQUAL(len * 8 + 1, num_symbols);
+	TEST_ASSERT_EQUAL(len * 8, symbols_decode(symbols, num_symbols, data));
+	TEST_ASSERT(memcmp(data, expected, len) == 0);
+	TEST_ASSERT(symbols[len * 8].level0 == 0 && symbols[len * 8].level1 == 0);
+	TEST_ASSERT_EQUAL(RMT_RESET_TICKS, symbols[len * 8].duration0 + symbols[len * 8].duration1);
+}
+
+/* With power management the channel is disabled from the timer task once its
+ * frames are sent, it holds a light sleep lock while enabled */
+static bool rmt_released(void) {
+	for (uint32_t i = 0; i < RMT_RELEASE_MS; i++) {
+		if (!host_rmt_enabled(host_rmt_channel(RMT_GPIO))) {
+			return true;
+		}
+
+		vTaskDelay(pdMS_TO_TICKS(1));
+	}
+
+	return false;
+}
+
+/* Color bytes the table encodes per second of CPU time, blitting whole
+ * frames that differ from the previous one */
+static uint64_t lut_bytes_per_s(led_strip_handle_t strip, const uint8_t *raw, uint32_t leds) {
+	clock_t start = clock();
+
+	for (uint32_t i = 0; i < LUT_FRAMES; i++) {
+		TEST_ASSERT_EQUAL(ESP_OK, led_strip_blit(strip, 0, leds, &raw[i % 2]));
+	}
+
+	clock_t elapsed = clock() - start;
+
+	return (uint64_t)LUT_FRAMES * leds * 3 * CLOCKS_PER_SEC / (elapsed ? elapsed : 1);
+}
+
+/* The same with the replaced expander */
+static uint64_t expand_bytes_per_s(const uint8_t *raw, uint32_t leds) {
+	static uint8_t buf[LUT_LEDS_MAX * 3 * SPI_BYTES_PER_COLOR_BYTE];
+	clock_t start = clock();
+
+	for (uint32_t i = 0; i < LUT_FRAMES; i++) {
+		for (uint32_t j = 0; j < leds * 3; j++) {
+			bit_expand(raw[i % 2 + j], &buf[j * SPI_BYTES_PER_COLOR_BYTE]);
+		}
+	}
+
+	clock_t elapsed = clock() - start;
+
+	return (uint64_t)LUT_FRAMES * leds * 3 * CLOCKS_PER_SEC / (elapsed ? elapsed : 1);
+}
+
+/* Every color byte is sent as the pattern of the replaced expander */
+static void test_lut(void) {
+	uint8_t raw[258] = {0};
+	uint8_t expected[SPI_BYTES_PER_COLOR_BYTE];
+	const uint8_t *frame;
+	size_t len;
+	uint32_t count;
+
+	for (int i = 0; i < 256; i++) {
+		raw[i] = i;
+	}
+
+	led_strip_handle_t strip = strip_create(sizeof(raw) / 3, LED_PIXEL_FORMAT_GRB);
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_blit(strip, 0, sizeof(raw) / 3, raw));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_refresh(strip));
+
+	frame = host_spi_last_tx(&len, &count);
+	TEST_ASSERT_EQUAL(sizeof(raw) * SPI_BYTES_PER_COLOR_BYTE, len);
+
+	for (int i = 0; i < 256; i++) {
+		bit_expand(raw[i], expected);
+		TEST_ASSERT(memcmp(&frame[i * SPI_BYTES_PER_COLOR_BYTE], expected, sizeof(expected)) == 0);
+	}
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_del(strip));
+}
+
+/* The table encodes faster than the expander it replaced, and far faster
+ * than the line sends. The CPU time of the process doesn't depend on the
+ * load of the host */
+static void test_lut_speed(void) {
+	static const uint32_t lengths[] = {1000, LUT_LEDS_MAX};
+	static uint8_t raw[LUT_LEDS_MAX * 3 + 1];
+
+	for (size_t i = 0; i < sizeof(raw); i++) {
+		raw[i] = (uint8_t)(i * 37);
+	}
+
+	for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+		led_strip_handle_t strip = strip_create(lengths[i], LED_PIXEL_FORMAT_GRB);
+		uint64_t lut = lut_bytes_per_s(strip, raw, lengths[i]);
+		uint64_t expand = expand_bytes_per_s(raw, lengths[i]);
+
+		printf("%" PRIu32 " LEDs: %" PRIu64 " B/s with the table, %" PRIu64 " B/s with the expander, the line sends %d B/s\n",
+				lengths[i], lut, expand, SPI_LINE_BYTES_PER_S);
+
+		TEST_ASSERT(lut > expand);
+		TEST_ASSERT(lut > 10 * SPI_LINE_BYTES_PER_S);
+		TEST_ASSERT_EQUAL(ESP_OK, led_strip_del(strip));
+	}
+}
+
+/* The pixels are sent in GRB order by every way of setting them */
+static void test_pixel_order(void) {
+	const led_strip_rgb_t span[2] = {{0x41, 0x42, 0x43}, {0x51, 0x52, 0x53}};
+	const uint8_t expected[] = {
+			0x22, 0x11, 0x33,		/* set_pixel */
+			0x42, 0x41, 0x43,		/* set_pixels */
+			0x52, 0x51, 0x53,
+			0x72, 0x71, 0x73,		/* fill */
+			0x72, 0x71, 0x73,
+	};
+	uint8_t data[sizeof(expected)];
+	const uint8_t *frame;
+	size_t len;
+	uint32_t count;
+
+	led_strip_handle_t strip = strip_create(5, LED_PIXEL_FORMAT_GRB);
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_set_pixel(strip, 0, 0x11, 0x22, 0x33));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_set_pixels(strip, 1, 2, span));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_fill(strip, 3, 2, 0x71, 0x72, 0x73));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_refresh(strip));
+
+	frame = host_spi_last_tx(&len, &count);
+	TEST_ASSERT_EQUAL(sizeof(expected) * SPI_BYTES_PER_COLOR_BYTE, len);
+	frame_decode(frame, len, data);
+	TEST_ASSERT(memcmp(data, expected, sizeof(expected)) == 0);
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_del(strip));
+}
+
+/* A GRBW strip sends the white byte last, a GRB strip takes no white */
+static void test_rgbw(void) {
+	const uint8_t expected[] = {0x22, 0x11, 0x33, 0x44, 0x00, 0x00, 0x00, 0x00};
+	uint8_t data[sizeof(expected)];
+	const uint8_t *frame;
+	size_t len;
+	uint32_t count;
+
+	led_strip_handle_t strip = strip_create(2, LED_PIXEL_FORMAT_GRBW);
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_set_pixel_rgbw(strip, 0, 0x11, 0x22, 0x33, 0x44));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_set_pixel_rgbw(strip, 1, 0, 0, 0, 0));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_refresh(strip));
+
+	frame = host_spi_last_tx(&len, &count);
+	TEST_ASSERT_EQUAL(sizeof(expected) * SPI_BYTES_PER_COLOR_BYTE, len);
+	frame_decode(frame, len, data);
+	TEST_ASSERT(memcmp(data, expected, sizeof(expected)) == 0);
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_del(strip));
+
+	strip = strip_create(1, LED_PIXEL_FORMAT_GRB);
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, led_strip_set_pixel_rgbw(strip, 0, 1, 2, 3, 4));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_del(strip));
+}
+
+/* A refresh is only sent when the pattern changed since the last one */
+static void test_refresh_skip(void) {
+	led_strip_stats_t stats;
+	uint8_t data[4 * 3];
+	const uint8_t *frame;
+	size_t len;
+	uint32_t count;
+	uint32_t sent;
+
+	led_strip_handle_t strip = strip_create(4, LED_PIXEL_FORMAT_GRB);
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_fill(strip, 0, 4, 1, 2, 3));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_refresh(strip));
+	host_spi_last_tx(&len, &sent);
+
+	/* The same colors again */
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_refresh(strip));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_set_pixel(strip, 2, 1, 2, 3));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_fill(strip, 0, 4, 1, 2, 3));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_refresh(strip));
+	host_spi_last_tx(&len, &count);
+	TEST_ASSERT_EQUAL(sent, count);
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_set_pixel(strip, 2, 9, 2, 3));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_refresh(strip));
+	host_spi_last_tx(&len, &count);
+	TEST_ASSERT_EQUAL(sent + 1, count);
+
+	/* Clearing sends the zero pattern once */
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_clear(strip));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_clear(strip));
+	frame = host_spi_last_tx(&len, &count);
+	TEST_ASSERT_EQUAL(sent + 2, count);
+	frame_decode(frame, len, data);
+
+	for (size_t i = 0; i < sizeof(data); i++) {
+		TEST_ASSERT_EQUAL(0, data[i]);
+	}
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_get_stats(strip, &stats));
+	TEST_ASSERT_EQUAL(6, stats.frames_requested);
+	TEST_ASSERT_EQUAL(3, stats.frames_sent);
+	TEST_ASSERT_EQUAL(3, stats.frames_skipped);
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_del(strip));
+}
+
+/* Pixels out of the strip are rejected */
+static void test_args(void) {
+	const led_strip_rgb_t span[2] = {0};
+	const uint8_t raw[6] = {0};
+
+	led_strip_handle_t strip = strip_create(3, LED_PIXEL_FORMAT_GRB);
+
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, led_strip_set_pixel(strip, 3, 0, 0, 0));
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, led_strip_set_pixels(strip, 2, 2, span));
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, led_strip_fill(strip, 1, UINT32_MAX, 0, 0, 0));
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, led_strip_blit(strip, 2, 2, raw));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_blit(strip, 1, 2, raw));
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, led_strip_set_pixel(NULL, 0, 0, 0, 0));
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_del(strip));
+}
+
+/* The caller gets back while the frame is on the wire and only waits for it
+ * to reuse the buffer, once per frame at most */
+static void test_rmt_async(void) {
+	static uint8_t expected[1000 * 3];
+	const uint32_t leds = sizeof(expected) / 3;
+	const int64_t frame_us = RMT_FRAME_US(sizeof(expected));
+
+	led_strip_handle_t strip = rmt_strip_create(leds, 0);
+	rmt_channel_handle_t channel = host_rmt_channel(RMT_GPIO);
+
+	/* Enabled by the first refresh only */
+	TEST_ASSERT(!host_rmt_enabled(channel));
+
+	for (uint32_t i = 0; i < sizeof(expected); i++) {
+		expected[i] = i * 7;
+	}
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_blit(strip, 0, leds, expected));
+
+	int64_t start = esp_timer_get_time();
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_refresh_async(strip));
+	TEST_ASSERT(esp_timer_get_time() - start < frame_us);
+	TEST_ASSERT_EQUAL(1, host_rmt_in_flight(channel));
+
+	/* The next frame is drawn meanwhile, the one on the wire is untouched */
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_fill(strip, 0, leds, 1, 2, 3));
+	TEST_ASSERT_EQUAL(1, host_rmt_in_flight(channel));
+	TEST_ASSERT_EQUAL(ESP_ERR_TIMEOUT, led_strip_wait_refresh_done(strip, 1));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_wait_refresh_done(strip, -1));
+	TEST_ASSERT(esp_timer_get_time() - start >= frame_us);
+	TEST_ASSERT_EQUAL(0, host_rmt_in_flight(channel));
+	rmt_frame_check(expected, sizeof(expected));
+
+	/* A refresh within a frame time waits for the rest of the previous one */
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_refresh_async(strip));
+	start = esp_timer_get_time();
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_set_pixel(strip, 0, 9, 9, 9));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_refresh_async(strip));
+	TEST_ASSERT(esp_timer_get_time() - start >= frame_us / 2);
+	TEST_ASSERT_EQUAL(1, host_rmt_in_flight(channel));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_wait_refresh_done(strip, -1));
+
+	for (uint32_t i = 0; i < leds; i++) {
+		expected[i * 3] = i ? 2 : 9;
+		expected[i * 3 + 1] = i ? 1 : 9;
+		expected[i * 3 + 2] = i ? 3 : 9;
+	}
+
+	rmt_frame_check(expected, sizeof(expected));
+
+	/* Nothing left to send, the light sleep lock goes */
+	TEST_ASSERT(rmt_released());
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_del(strip));
+	TEST_ASSERT(host_rmt_channel(RMT_GPIO) == NULL);
+}
+
+/* Every color byte leaves the encoder through the gamma table and scaled by
+ * the brightness, also when the frame is encoded over many refills of a small
+ * memory block */
+static void test_rmt_correction(void) {
+	static const uint8_t brightnesses[] = {255, 128, 200, 255};
+	uint8_t gamma[256];
+	uint8_t raw[258];
+	uint8_t expected[sizeof(raw)];
+	size_t num_symbols;
+	uint32_t count;
+	uint32_t sent;
+
+	for (uint32_t i = 0; i < 256; i++) {
+		gamma[i] = i * i / 255;
+	}
+
+	for (uint32_t i = 0; i < sizeof(raw); i++) {
+		raw[i] = i;
+	}
+
+	/* 48 symbols hold 6 bytes, refilled by halves in the middle of the chunks
+	 * of the table */
+	led_strip_handle_t strip = rmt_strip_create(sizeof(raw) / 3, 48);
+	rmt_channel_handle_t channel = host_rmt_channel(RMT_GPIO);
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_blit(strip, 0, sizeof(raw) / 3, raw));
+
+	for (uint32_t i = 0; i < sizeof(brightnesses); i++) {
+		const uint8_t *table = i == 2 ? gamma : NULL;
+
+		TEST_ASSERT_EQUAL(ESP_OK, led_strip_set_gamma(strip, table));
+		TEST_ASSERT_EQUAL(ESP_OK, led_strip_set_brightness(strip, brightnesses[i]));
+		host_rmt_last_tx(channel, &num_symbols, &sent);
+
+		/* The same pixels are sent again with the new correction */
+		TEST_ASSERT_EQUAL(ESP_OK, led_strip_refresh(strip));
+		host_rmt_last_tx(channel, &num_symbols, &count);
+		TEST_ASSERT_EQUAL(sent + 1, count);
+
+		for (uint32_t j = 0; j < sizeof(raw); j++) {
+			uint32_t value = table ? table[raw[j]] : raw[j];
+
+			expected[j] = (value * brightnesses[i] + 127) / 255;
+		}
+
+		rmt_frame_check(expected, sizeof(expected));
+	}
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_del(strip));
+}
+
+/* As with SPI, and the pixels changed before a frame are carried over to the
+ * buffer of the next one */
+static void test_rmt_refresh_skip(void) {
+	led_strip_stats_t stats;
+	uint8_t expected[8 * 3];
+	size_t num_symbols;
+	uint32_t count;
+	uint32_t sent;
+
+	led_strip_handle_t strip = rmt_strip_create(8, 0);
+	rmt_channel_handle_t channel = host_rmt_channel(RMT_GPIO);
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_fill(strip, 0, 8, 1, 2, 3));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_refresh(strip));
+	host_rmt_last_tx(channel, &num_symbols, &sent);
+
+	/* The same colors again */
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_refresh(strip));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_fill(strip, 0, 8, 1, 2, 3));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_set_pixel(strip, 4, 1, 2, 3));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_refresh_async(strip));
+	host_rmt_last_tx(channel, &num_symbols, &count);
+	TEST_ASSERT_EQUAL(sent, count);
+
+	/* Changed in two frames, both changes are in the second one */
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_set_pixel(strip, 2, 9, 8, 7));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_refresh_async(strip));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_set_pixel(strip, 5, 6, 5, 4));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_refresh(strip));
+	host_rmt_last_tx(channel, &num_symbols, &count);
+	TEST_ASSERT_EQUAL(sent + 2, count);
+
+	for (uint32_t i = 0; i < 8; i++) {
+		expected[i * 3] = i == 2 ? 8 : i == 5 ? 5 : 2;
+		expected[i * 3 + 1] = i == 2 ? 9 : i == 5 ? 6 : 1;
+		expected[i * 3 + 2] = i == 2 ? 7 : i == 5 ? 4 : 3;
+	}
+
+	rmt_frame_check(expected, sizeof(expected));
+
+	/* Set back to what the LEDs show */
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_set_pixel(strip, 5, 6, 5, 4));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_refresh(strip));
+
+	/* Clearing sends the zero pattern once */
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_clear(strip));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_clear(strip));
+	host_rmt_last_tx(channel, &num_symbols, &count);
+	TEST_ASSERT_EQUAL(sent + 3, count);
+	memset(expected, 0, sizeof(expected));
+	rmt_frame_check(expected, sizeof(expected));
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_get_stats(strip, &stats));
+	TEST_ASSERT_EQUAL(8, stats.frames_requested);
+	TEST_ASSERT_EQUAL(4, stats.frames_sent);
+	TEST_ASSERT_EQUAL(4, stats.frames_skipped);
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_del(strip));
+}
+
+/* The on frame, a hold, the off frame and another hold are looped from the
+ * memory block of the channel, which is released by the stop */
+static void test_rmt_blink(void) {
+	const uint8_t color[3] = {0x20, 0x10, 0x30};
+	const uint8_t off[3] = {0};
+	uint8_t data[3];
+	uint64_t ticks;
+	size_t num_symbols;
+	uint32_t count;
+	uint32_t sent;
+
+	led_strip_handle_t strip = rmt_strip_create(1, RMT_MEM_BLOCK_SYMBOLS);
+	rmt_channel_handle_t channel = host_rmt_channel(RMT_GPIO);
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_set_pixel(strip, 0, 0x10, 0x20, 0x30));
+
+	/* Released when the pattern can't be set up */
+	host_rmt_encoder_error(ESP_ERR_NO_MEM);
+	TEST_ASSERT_EQUAL(ESP_ERR_NO_MEM, led_strip_blink_start(strip, 5, 10));
+	host_rmt_encoder_error(ESP_OK);
+	TEST_ASSERT(!host_rmt_enabled(channel));
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_blink_start(strip, 5, 10));
+	TEST_ASSERT(host_rmt_enabled(channel));
+	TEST_ASSERT_EQUAL(1, host_rmt_in_flight(channel));
+
+	/* The end marker takes one more word */
+	const rmt_symbol_word_t *symbols = host_rmt_last_tx(channel, &num_symbols, &sent);
+
+	TEST_ASSERT(num_symbols < RMT_MEM_BLOCK_SYMBOLS);
+
+	size_t i = symbols_decode(symbols, num_symbols, data);
+
+	TEST_ASSERT(i == 24 && memcmp(data, color, sizeof(data)) == 0);
+	i += symbols_hold(&symbols[i], num_symbols - i, &ticks);
+	TEST_ASSERT_EQUAL(5 * RMT_RESOLUTION / 1000, ticks);
+	TEST_ASSERT_EQUAL(24, symbols_decode(&symbols[i], num_symbols - i, data));
+	TEST_ASSERT(memcmp(data, off, sizeof(data)) == 0);
+	i += 24;
+	i += symbols_hold(&symbols[i], num_symbols - i, &ticks);
+	TEST_ASSERT_EQUAL(10 * RMT_RESOLUTION / 1000, ticks);
+	TEST_ASSERT_EQUAL(num_symbols, i);
+
+	/* Not a refresh, nothing to wait for */
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_wait_refresh_done(strip, -1));
+
+	/* Too long a hold for the memory block, the loop goes on */
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, led_strip_blink_start(strip, 100, 10));
+	TEST_ASSERT_EQUAL(1, host_rmt_in_flight(channel));
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_blink_stop(strip));
+	TEST_ASSERT(!host_rmt_enabled(channel));
+	TEST_ASSERT_EQUAL(0, host_rmt_in_flight(channel));
+
+	/* Stopped anywhere, the frame is sent again */
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_refresh(strip));
+	host_rmt_last_tx(channel, &num_symbols, &count);
+	TEST_ASSERT_EQUAL(sent + 1, count);
+	rmt_frame_check(color, sizeof(color));
+	TEST_ASSERT(rmt_released());
+
+	/* A refresh ends the loop too */
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_blink_start(strip, 5, 10));
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_refresh(strip));
+	rmt_frame_check(color, sizeof(color));
+	TEST_ASSERT(rmt_released());
+
+	TEST_ASSERT_EQUAL(ESP_OK, led_strip_del(strip));
+}
+
+/***************************** END OF FILE ************************************/
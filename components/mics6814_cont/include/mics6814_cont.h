@@ -0,0 +1,124 @@
+/**
+  ******************************************************************************
+  * @file           : mics6814_cont.h
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Batched continuous ADC sampling of the MiCS-6814
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef MICS6814_CONT_H_
+#define MICS6814_CONT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "sdkconfig.h"
+#include "mics6814.h"
+#include "esp_adc/adc_continuous.h"
+
+/* Exported macro ------------------------------------------------------------*/
+#define MICS6814_CONT_CHANNEL_NUM	3
+#define MICS6814_CONT_GAS_NUM		(C2H5OH_GAS + 1)
+#define MICS6814_CONT_FRAME_SIZE	(CONFIG_MICS6814_CONT_OVERSAMPLING * MICS6814_CONT_CHANNEL_NUM * SOC_ADC_DIGI_RESULT_BYTES)
+
+/* Exported typedef ----------------------------------------------------------*/
+typedef struct {
+	float gas[MICS6814_CONT_GAS_NUM];	/* Concentration in ppm indexed by gas_e,
+										   -1 if the channel isn't calibrated */
+} mics6814_gases_t;
+
+typedef struct {
+	adc_continuous_handle_t handle;
+	adc_channel_t channels[MICS6814_CONT_CHANNEL_NUM];	/* Indexed by mics6814_channel_e */
+	calibration_values_t calib_values;
+	uint16_t values[MICS6814_CONT_CHANNEL_NUM];			/* Last averages, 13 bits */
+	uint8_t frame[MICS6814_CONT_FRAME_SIZE];
+} mics6814_cont_t;
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions prototypes ---------------------------------------------*/
+/**
+  * @brief Function to initialize the continuous ADC sampling of a MiCS-6814
+  *
+  * @note It replaces mics6814_init(), the one-shot and continuous ADC
+  *       drivers can't share the ADC unit
+  *
+  * @param me          : Pointer to a mics6814_cont_t structure
+  * @param nh3_channel : ADC channel of the NH3 sensor
+  * @param co_channel  : ADC channel of the CO sensor
+  * @param no2_channel : ADC channel of the NO2 sensor
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- An error code of the ADC continuous driver otherwise
+  */
+esp_err_t mics6814_cont_init(mics6814_cont_t * const me, adc_channel_t nh3_channel, adc_channel_t co_channel, adc_channel_t no2_channel);
+
+/**
+  * @brief Function to load the readings of each channel in clean air, 13 bits
+  *
+  * @param me        : Pointer to a mics6814_cont_t structure
+  * @param nh3_value : NH3 channel reading
+  * @param co_value  : CO channel reading
+  * @param no2_value : NO2 channel reading
+  */
+void mics6814_cont_load_calibration_data(mics6814_cont_t * const me, uint16_t nh3_value, uint16_t co_value, uint16_t no2_value);
+
+/**
+  * @brief Function to sample the three channels in one frame and compute
+  *        every gas concentration
+  *
+  * @note The ADC only runs while the frame is filled, the power management
+  *       lock of the ADC driver is only held then
+  *
+  * @param me    : Pointer to a mics6814_cont_t structure
+  * @param gases : Pointer to store the gas concentrations
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_TIMEOUT if the frame isn't filled in time
+  * 	- An error code of the ADC continuous driver otherwise
+  */
+esp_err_t mics6814_get_all_gases(mics6814_cont_t * const me, mics6814_gases_t *gases);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MICS6814_CONT_H_ */
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,100 @@
+/**
+  ******************************************************************************
+  * @file           : mics6814_curve.h
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Fixed-point MiCS-6814 gas curves
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef MICS6814_CURVE_H_
+#define MICS6814_CURVE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "mics6814.h"
+
+/* Exported macro ------------------------------------------------------------*/
+#define MICS6814_CURVE_INVALID	INT32_MIN	/* Ratio that can't be computed */
+
+/* Exported typedef ----------------------------------------------------------*/
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions prototypes ---------------------------------------------*/
+/**
+  * @brief Function to compute the base 2 logarithm of the Rs/R0 ratio of a
+  *        channel from its divider readings, without divisions
+  *
+  * @param value : Channel reading, 13 bits
+  * @param base  : Channel reading in clean air, 13 bits
+  *
+  * @retval log2(Rs/R0) in Q16, MICS6814_CURVE_INVALID if a reading is 0 or
+  *         full scale
+  */
+int32_t mics6814_curve_log2_ratio(uint16_t value, uint16_t base);
+
+/**
+  * @brief Function to get the channel a gas curve is evaluated on
+  *
+  * @param gas : Gas
+  *
+  * @retval Channel sensing the gas
+  */
+mics6814_channel_e mics6814_curve_get_channel(gas_e gas);
+
+/**
+  * @brief Function to evaluate a gas curve, ppm = factor * ratio ^ exponent,
+  *        with table driven log2/exp2 in Q16
+  *
+  * @note Maximum relative error against the pow() reference, over every
+  *       13 bits reading and calibration value: CH4 0.037 %, C3H8 0.021 %,
+  *       C4H10 0.018 %, H2 0.016 %, NH3 0.015 %, C2H5OH 0.014 %, CO 0.011 %,
+  *       NO2 0.010 %
+  *
+  * @param gas        : Gas
+  * @param log2_ratio : log2(Rs/R0) in Q16 of the gas channel
+  *
+  * @retval Concentration in ppm, -1 if the ratio is invalid
+  */
+float mics6814_curve_eval(gas_e gas, int32_t log2_ratio);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MICS6814_CURVE_H_ */
+
+/***************************** END OF FILE ************************************/
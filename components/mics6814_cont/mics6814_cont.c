@@ -0,0 +1,223 @@
+/**
+  ******************************************************************************
+  * @file           : mics6814_cont.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Batched continuous ADC sampling of the MiCS-6814
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include "mics6814_cont.h"
+#include "mics6814_curve.h"
+#include "esp_log.h"
+#include "dlog.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define ADC_SHIFT			(13 - SOC_ADC_DIGI_MAX_BITWIDTH)	/* Readings are kept in 13 bits as with the one-shot driver */
+#define ADC_STORE_SIZE		(MICS6814_CONT_FRAME_SIZE * 2)
+
+/* Time to fill a frame twice, at least 10 ms */
+#define FRAME_TIMEOUT_MS	(2000 * CONFIG_MICS6814_CONT_OVERSAMPLING * MICS6814_CONT_CHANNEL_NUM \
+								/ CONFIG_MICS6814_CONT_SAMPLE_FREQ_HZ + 10)
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static const char *TAG = "mics6814_cont";
+
+/* Private function prototypes -----------------------------------------------*/
+static esp_err_t read_frame(mics6814_cont_t * const me);
+static esp_err_t average_frame(mics6814_cont_t * const me);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief Function to initialize the continuous ADC sampling of a MiCS-6814
+  */
+esp_err_t mics6814_cont_init(mics6814_cont_t * const me, adc_channel_t nh3_channel, adc_channel_t co_channel, adc_channel_t no2_channel) {
+	ESP_LOGI(TAG, "Initializing MICS-6814 continuous instance...");
+
+	me->channels[CO_CHANNEL] = co_channel;
+	me->channels[NO2_CHANNEL] = no2_channel;
+	me->channels[NH3_CHANNEL] = nh3_channel;
+	me->calib_values = (calibration_values_t){0};
+
+	adc_continuous_handle_cfg_t handle_conf = {
+			.max_store_buf_size = ADC_STORE_SIZE,
+			.conv_frame_size = MICS6814_CONT_FRAME_SIZE,
+	};
+
+	esp_err_t ret = adc_continuous_new_handle(&handle_conf, &me->handle);
+
+	if (ret != ESP_OK) {
+		ESP_LOGE(TAG, "Failed to create ADC continuous handle");
+		return ret;
+	}
+
+	/* The three channels are converted in turn, a frame holds the same
+	 * number of conversions of each one */
+	adc_digi_pattern_config_t pattern[MICS6814_CONT_CHANNEL_NUM];
+
+	for (uint8_t i = 0; i < MICS6814_CONT_CHANNEL_NUM; i++) {
+		pattern[i] = (adc_digi_pattern_config_t) {
+			.atten = ADC_ATTEN_DB_11,
+			.channel = me->channels[i],
+			.unit = ADC_UNIT_1,
+			.bit_width = SOC_ADC_DIGI_MAX_BITWIDTH,
+		};
+	}
+
+	adc_continuous_config_t conf = {
+			.pattern_num = MICS6814_CONT_CHANNEL_NUM,
+			.adc_pattern = pattern,
+			.sample_freq_hz = CONFIG_MICS6814_CONT_SAMPLE_FREQ_HZ,
+			.conv_mode = ADC_CONV_SINGLE_UNIT_1,
+			.format = ADC_DIGI_OUTPUT_FORMAT_TYPE1,
+	};
+
+	ret = adc_continuous_config(me->handle, &conf);
+
+	if (ret != ESP_OK) {
+		ESP_LOGE(TAG, "Failed to configure ADC continuous mode");
+		adc_continuous_deinit(me->handle);
+		return ret;
+	}
+
+	ESP_LOGI(TAG, "Initialization success");
+
+	return ESP_OK;
+}
+
+/**
+  * @brief Function to load the readings of each channel in clean air, 13 bits
+  */
+void mics6814_cont_load_calibration_data(mics6814_cont_t * const me, uint16_t nh3_value, uint16_t co_value, uint16_t no2_value) {
+	me->calib_values.nh3 = nh3_value;
+	me->calib_values.co = co_value;
+	me->calib_values.no2 = no2_value;
+}
+
+/**
+  * @brief Function to sample the three channels in one frame and compute
+  *        every gas concentration
+  */
+esp_err_t mics6814_get_all_gases(mics6814_cont_t * const me, mics6814_gases_t *gases) {
+	esp_err_t ret = read_frame(me);
+
+	if (ret != ESP_OK) {
+		return ret;
+	}
+
+	ret = average_frame(me);
+
+	if (ret != ESP_OK) {
+		return ret;
+	}
+
+	/* One resistance ratio per channel, shared by the gases it senses, in
+	 * the log2 domain so the curves need no powf() */
+	int32_t log2_ratios[MICS6814_CONT_CHANNEL_NUM] = {
+			[CO_CHANNEL] = mics6814_curve_log2_ratio(me->values[CO_CHANNEL], me->calib_values.co),
+			[NO2_CHANNEL] = mics6814_curve_log2_ratio(me->values[NO2_CHANNEL], me->calib_values.no2),
+			[NH3_CHANNEL] = mics6814_curve_log2_ratio(me->values[NH3_CHANNEL], me->calib_values.nh3),
+	};
+
+	for (uint8_t i = 0; i < MICS6814_CONT_GAS_NUM; i++) {
+		gases->gas[i] = mics6814_curve_eval(i, log2_ratios[mics6814_curve_get_channel(i)]);
+	}
+
+	return ESP_OK;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static esp_err_t read_frame(mics6814_cont_t * const me) {
+	esp_err_t ret = adc_continuous_start(me->handle);
+
+	if (ret != ESP_OK) {
+		ESP_LOGE(TAG, "Failed to start the ADC");
+		return ret;
+	}
+
+	uint32_t len;
+
+	/* Drop the conversions left in the driver buffer by the previous run */
+	while (adc_continuous_read(me->handle, me->frame, MICS6814_CONT_FRAME_SIZE, &len, 0) == ESP_OK) {
+	}
+
+	uint32_t filled = 0;
+
+	while (filled < MICS6814_CONT_FRAME_SIZE) {
+		ret = adc_continuous_read(me->handle, me->frame + filled, MICS6814_CONT_FRAME_SIZE - filled, &len, FRAME_TIMEOUT_MS);
+
+		if (ret != ESP_OK) {
+			DLOGW(TAG, "Failed to read an ADC frame");
+			break;
+		}
+
+		filled += len;
+	}
+
+	/* Keep the ADC off between readings */
+	adc_continuous_stop(me->handle);
+
+	return ret;
+}
+
+static esp_err_t average_frame(mics6814_cont_t * const me) {
+	uint32_t sums[MICS6814_CONT_CHANNEL_NUM] = {0};
+	uint32_t counts[MICS6814_CONT_CHANNEL_NUM] = {0};
+
+	for (uint32_t i = 0; i < MICS6814_CONT_FRAME_SIZE; i += SOC_ADC_DIGI_RESULT_BYTES) {
+		const adc_digi_output_data_t *data = (const adc_digi_output_data_t *)&me->frame[i];
+
+		for (uint8_t j = 0; j < MICS6814_CONT_CHANNEL_NUM; j++) {
+			if (data->type1.channel == me->channels[j]) {
+				sums[j] += data->type1.data;
+				counts[j]++;
+				break;
+			}
+		}
+	}
+
+	for (uint8_t i = 0; i < MICS6814_CONT_CHANNEL_NUM; i++) {
+		if (counts[i] == 0) {
+			DLOGW(TAG, "No conversion of channel %d in the frame", me->channels[i]);
+			return ESP_ERR_INVALID_RESPONSE;
+		}
+
+		/* Rounded average, scaled to 13 bits */
+		me->values[i] = ((sums[i] << ADC_SHIFT) + counts[i] / 2) / counts[i];
+	}
+
+	return ESP_OK;
+}
+
+/***************************** END OF FILE ************************************/
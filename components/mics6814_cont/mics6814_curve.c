@@ -0,0 +1,159 @@
+/**
+  ******************************************************************************
+  * @file           : mics6814_curve.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Fixed-point MiCS-6814 gas curves
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+
+#include "mics6814_curve.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define Q16_ONE			65536
+#define TABLE_BITS		6		/* 64 segments over [1, 2) */
+#define SEGMENT_BITS	(16 - TABLE_BITS)
+#define ADC_FULL_SCALE	8192
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+/* Gas curve, ppm = factor * ratio ^ exponent, evaluated as
+ * exp2(log2(factor) + exponent * log2(ratio)) */
+typedef struct {
+	mics6814_channel_e channel;
+	int32_t exponent;			/* Q16 */
+	int32_t log2_factor;		/* Q16 */
+} gas_curve_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const gas_curve_t gas_curves[C2H5OH_GAS + 1] = {
+		[CO_GAS] = {CO_CHANNEL, -77267, 139761},			/* -1.179, 4.385 */
+		[NO2_GAS] = {NO2_CHANNEL, 65995, -182004},			/* 1.007, 1 / 6.855 */
+		[NH3_GAS] = {NH3_CHANNEL, -109445, -36426},			/* -1.67, 1 / 1.47 */
+		[C3H8_GAS] = {NH3_CHANNEL, -165020, 599997},		/* -2.518, 570.164 */
+		[C4H10_GAS] = {NH3_CHANNEL, -140116, 566035},		/* -2.138, 398.107 */
+		[CH4_GAS] = {CO_CHANNEL, -285934, 609576},			/* -4.363, 630.957 */
+		[H2_GAS] = {CO_CHANNEL, -117965, -29755},			/* -1.8, 0.73 */
+		[C2H5OH_GAS] = {CO_CHANNEL, -101712, 45729},		/* -1.552, 1.622 */
+};
+
+/* log2(1 + i / 64) in Q16 */
+static const uint32_t log2_table[(1 << TABLE_BITS) + 1] = {
+		0, 1466, 2909, 4331, 5732, 7112, 8473, 9814,
+		11136, 12440, 13727, 14996, 16248, 17484, 18704, 19909,
+		21098, 22272, 23433, 24579, 25711, 26830, 27936, 29029,
+		30109, 31178, 32234, 33279, 34312, 35334, 36346, 37346,
+		38336, 39316, 40286, 41246, 42196, 43137, 44068, 44990,
+		45904, 46809, 47705, 48593, 49472, 50344, 51207, 52063,
+		52911, 53751, 54584, 55410, 56229, 57040, 57845, 58643,
+		59434, 60219, 60997, 61769, 62534, 63294, 64047, 64794,
+		65536,
+};
+
+/* 2 ^ (i / 64) in Q16 */
+static const uint32_t exp2_table[(1 << TABLE_BITS) + 1] = {
+		65536, 66250, 66971, 67700, 68438, 69183, 69936, 70698,
+		71468, 72246, 73032, 73828, 74632, 75444, 76266, 77096,
+		77936, 78785, 79642, 80510, 81386, 82273, 83169, 84074,
+		84990, 85915, 86851, 87796, 88752, 89719, 90696, 91684,
+		92682, 93691, 94711, 95743, 96785, 97839, 98905, 99982,
+		101070, 102171, 103283, 104408, 105545, 106694, 107856, 109031,
+		110218, 111418, 112631, 113858, 115098, 116351, 117618, 118899,
+		120194, 121502, 122825, 124163, 125515, 126882, 128263, 129660,
+		131072,
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t table_interpolate(const uint32_t *table, uint32_t frac);
+static int32_t log2_q16(uint32_t x);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief Function to compute the base 2 logarithm of the Rs/R0 ratio of a
+  *        channel from its divider readings, without divisions
+  */
+int32_t mics6814_curve_log2_ratio(uint16_t value, uint16_t base) {
+	if (value == 0 || base == 0 || value >= ADC_FULL_SCALE || base >= ADC_FULL_SCALE) {
+		return MICS6814_CURVE_INVALID;
+	}
+
+	/* Rs / R0 = value / base * (full scale - base) / (full scale - value) */
+	return log2_q16(value) + log2_q16(ADC_FULL_SCALE - base) - log2_q16(base) - log2_q16(ADC_FULL_SCALE - value);
+}
+
+/**
+  * @brief Function to get the channel a gas curve is evaluated on
+  */
+mics6814_channel_e mics6814_curve_get_channel(gas_e gas) {
+	return gas_curves[gas].channel;
+}
+
+/**
+  * @brief Function to evaluate a gas curve, ppm = factor * ratio ^ exponent,
+  *        with table driven log2/exp2 in Q16
+  */
+float mics6814_curve_eval(gas_e gas, int32_t log2_ratio) {
+	if (log2_ratio == MICS6814_CURVE_INVALID) {
+		return -1.0f;
+	}
+
+	const gas_curve_t *curve = &gas_curves[gas];
+	int32_t y = curve->log2_factor + (int32_t)(((int64_t)curve->exponent * log2_ratio) >> 16);
+
+	/* exp2(y) = 2 ^ floor(y) * 2 ^ frac(y), the float is only built at the
+	 * end from the Q16 mantissa */
+	int32_t exponent = y >> 16;
+	uint32_t mantissa = table_interpolate(exp2_table, y & 0xFFFF);
+
+	return ldexpf((float)mantissa, exponent - 16);
+}
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t table_interpolate(const uint32_t *table, uint32_t frac) {
+	/* Linear interpolation between the table points around a Q16 fraction */
+	uint32_t i = frac >> SEGMENT_BITS;
+	uint32_t t = frac & ((1 << SEGMENT_BITS) - 1);
+
+	return table[i] + (((table[i + 1] - table[i]) * t + (1 << (SEGMENT_BITS - 1))) >> SEGMENT_BITS);
+}
+
+static int32_t log2_q16(uint32_t x) {
+	/* x = 2 ^ n * (1 + frac), x is at most 13 bits so the mantissa fits in
+	 * Q16 without losing bits */
+	int32_t n = 31 - __builtin_clz(x);
+	uint32_t frac = (x << (16 - n)) - Q16_ONE;
+
+	return (n << 16) + (int32_t)table_interpolate(log2_table, frac);
+}
+
+/***************************** END OF FILE ************************************/
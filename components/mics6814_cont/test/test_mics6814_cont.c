@@ -0,0 +1,494 @@
+/**
+  ******************************************************************************
+  * @file           : test_mics6814_cont.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Host test of the MiCS-6814 continuous sampling
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+#include "host_test.h"
+#include "mics6814_cont.h"
+#include "mics6814_curve.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define NH3_ADC_CHANNEL			ADC_CHANNEL_5
+#define CO_ADC_CHANNEL			ADC_CHANNEL_6
+#define NO2_ADC_CHANNEL			ADC_CHANNEL_7
+
+#define CONVERSIONS_NUM			(MICS6814_CONT_FRAME_SIZE / SOC_ADC_DIGI_RESULT_BYTES)
+#define READ_CHUNK_SIZE			60		/* Not a multiple of a round */
+#define STALE_SIZE				(2 * READ_CHUNK_SIZE)
+#define JITTER					3		/* Around the channel value, averages out */
+
+#define ADC_FULL_SCALE			8192
+#define BASE_STEP				37		/* Calibration values swept */
+#define SPEED_BASE_STEP			509		/* Calibration values timed */
+#define READINGS_NUM			1000
+#define FRAME_US				((int64_t)CONVERSIONS_NUM * 1000000 / CONFIG_MICS6814_CONT_SAMPLE_FREQ_HZ)
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+/* ADC sampling the pattern in turn. Only the conversions of the previous run
+ * are available to a read that doesn't wait */
+typedef struct {
+	adc_continuous_handle_cfg_t handle_cfg;
+	adc_continuous_config_t config;
+	adc_digi_pattern_config_t pattern[MICS6814_CONT_CHANNEL_NUM];
+	bool configured;
+	bool running;
+	uint32_t starts;
+	uint16_t values[ADC_CHANNEL_9 + 1];	/* 12 bits, per ADC channel */
+	uint16_t stale_value;				/* Of the previous run conversions */
+	uint32_t stale_left;
+	uint32_t conversions;				/* Since the start */
+	int skip_channel;					/* Channel never converted, -1 for none */
+	bool stalled;						/* No conversion completes */
+} adc_fake_t;
+
+typedef struct {
+	double exponent;
+	double factor;
+	double max_error;			/* Relative, documented in mics6814_curve.h
+								   rounded up */
+} curve_ref_t;
+
+/* Private variables ---------------------------------------------------------*/
+static adc_fake_t adc;
+static mics6814_cont_t mics6814;
+static const curve_ref_t curve_refs[MICS6814_CONT_GAS_NUM] = {
+		[CO_GAS] = {-1.179, 4.385, 0.00011},
+		[NO2_GAS] = {1.007, 1 / 6.855, 0.00010},
+		[NH3_GAS] = {-1.67, 1 / 1.47, 0.00015},
+		[C3H8_GAS] = {-2.518, 570.164, 0.00021},
+		[C4H10_GAS] = {-2.138, 398.107, 0.00018},
+		[CH4_GAS] = {-4.363, 630.957, 0.00037},
+		[H2_GAS] = {-1.8, 0.73, 0.00016},
+		[C2H5OH_GAS] = {-1.552, 1.622, 0.00014},
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static void setup(void);
+static void test_config(void);
+static void test_average(void);
+static void test_clean_air(void);
+static void test_uncalibrated(void);
+static void test_missing_channel(void);
+static void test_timeout(void);
+static void test_curve_accuracy(void);
+static void test_curve_invalid(void);
+static void test_curve_speed(void);
+static void test_reading_time(void);
+
+/* Main ----------------------------------------------------------------------*/
+int main(void) {
+	RUN_TEST(test_config);
+	RUN_TEST(test_average);
+	RUN_TEST(test_clean_air);
+	RUN_TEST(test_uncalibrated);
+	RUN_TEST(test_missing_channel);
+	RUN_TEST(test_timeout);
+	RUN_TEST(test_curve_accuracy);
+	RUN_TEST(test_curve_invalid);
+	RUN_TEST(test_curve_speed);
+	RUN_TEST(test_reading_time);
+
+	return 0;
+}
+
+/* Fake ADC continuous driver ------------------------------------------------*/
+esp_err_t adc_continuous_new_handle(const adc_continuous_handle_cfg_t *hdl_config, adc_continuous_handle_t *ret_handle) {
+	adc.handle_cfg = *hdl_config;
+	*ret_handle = (adc_continuous_handle_t)&adc;
+
+	return ESP_OK;
+}
+
+esp_err_t adc_continuous_config(adc_continuous_handle_t handle, const adc_continuous_config_t *config) {
+	TEST_ASSERT(config->pattern_num <= MICS6814_CONT_CHANNEL_NUM);
+
+	adc.config = *config;
+	memcpy(adc.pattern, config->adc_pattern, config->pattern_num * sizeof(adc.pattern[0]));
+	adc.config.adc_pattern = adc.pattern;
+	adc.configured = true;
+
+	return ESP_OK;
+}
+
+esp_err_t adc_continuous_start(adc_continuous_handle_t handle) {
+	if (!adc.configured || adc.running) {
+		return ESP_ERR_INVALID_STATE;
+	}
+
+	adc.running = true;
+	adc.starts++;
+	adc.conversions = 0;
+
+	return ESP_OK;
+}
+
+esp_err_t adc_continuous_stop(adc_continuous_handle_t handle) {
+	if (!adc.running) {
+		return ESP_ERR_INVALID_STATE;
+	}
+
+	adc.running = false;
+
+	return ESP_OK;
+}
+
+esp_err_t adc_continuous_read(adc_continuous_handle_t handle, uint8_t *buf, uint32_t length_max, uint32_t *out_length, uint32_t timeout_ms) {
+	TEST_ASSERT(adc.running);
+
+	uint32_t len = length_max < READ_CHUNK_SIZE ? length_max : READ_CHUNK_SIZE;
+
+	len -= len % SOC_ADC_DIGI_RESULT_BYTES;
+
+	if (timeout_ms == 0) {
+		if (adc.stale_left == 0) {
+			return ESP_ERR_TIMEOUT;
+		}
+
+		len = len < adc.stale_left ? len : adc.stale_left;
+		adc.stale_left -= len;
+
+		for (uint32_t i = 0; i < len; i += SOC_ADC_DIGI_RESULT_BYTES) {
+			adc_digi_output_data_t *data = (adc_digi_output_data_t *)&buf[i];
+
+			data->type1.channel = adc.pattern[(i / SOC_ADC_DIGI_RESULT_BYTES) % adc.config.pattern_num].channel;
+			data->type1.data = adc.stale_value;
+		}
+
+		*out_length = len;
+
+		return ESP_OK;
+	}
+
+	if (adc.stalled) {
+		return ESP_ERR_TIMEOUT;
+	}
+
+	for (uint32_t i = 0; i < len; i += SOC_ADC_DIGI_RESULT_BYTES) {
+		adc_digi_output_data_t *data = (adc_digi_output_data_t *)&buf[i];
+		const adc_digi_pattern_config_t *pattern;
+
+		do {
+			pattern = &adc.pattern[adc.conversions % adc.config.pattern_num];
+			adc.conversions++;
+		} while (pattern->channel == adc.skip_channel);
+
+		/* +JITTER and -JITTER on the channel in alternate rounds */
+		uint32_t round = (adc.conversions - 1) / adc.config.pattern_num;
+
+		data->type1.channel = pattern->channel;
+		data->type1.data = adc.values[pattern->channel] + (round % 2 ? -JITTER : JITTER);
+	}
+
+	*out_length = len;
+
+	return ESP_OK;
+}
+
+esp_err_t adc_continuous_deinit(adc_continuous_handle_t handle) {
+	adc.configured = false;
+
+	return ESP_OK;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static void setup(void) {
+	memset(&adc, 0, sizeof(adc));
+	adc.skip_channel = -1;
+	adc.values[NH3_ADC_CHANNEL] = 1000;
+	adc.values[CO_ADC_CHANNEL] = 2000;
+	adc.values[NO2_ADC_CHANNEL] = 3000;
+
+	TEST_ASSERT_EQUAL(ESP_OK, mics6814_cont_init(&mics6814, NH3_ADC_CHANNEL, CO_ADC_CHANNEL, NO2_ADC_CHANNEL));
+}
+
+/* The three channels are converted in turn into frames of the oversampling
+ * rounds */
+static void test_config(void) {
+	setup();
+
+	TEST_ASSERT_EQUAL(MICS6814_CONT_FRAME_SIZE, adc.handle_cfg.conv_frame_size);
+	TEST_ASSERT(adc.handle_cfg.max_store_buf_size >= MICS6814_CONT_FRAME_SIZE);
+	TEST_ASSERT_EQUAL(CONFIG_MICS6814_CONT_SAMPLE_FREQ_HZ, adc.config.sample_freq_hz);
+	TEST_ASSERT_EQUAL(ADC_DIGI_OUTPUT_FORMAT_TYPE1, adc.config.format);
+	TEST_ASSERT_EQUAL(MICS6814_CONT_CHANNEL_NUM, adc.config.pattern_num);
+	TEST_ASSERT_EQUAL(CO_ADC_CHANNEL, adc.pattern[CO_CHANNEL].channel);
+	TEST_ASSERT_EQUAL(NO2_ADC_CHANNEL, adc.pattern[NO2_CHANNEL].channel);
+	TEST_ASSERT_EQUAL(NH3_ADC_CHANNEL, adc.pattern[NH3_CHANNEL].channel);
+
+	for (uint8_t i = 0; i < MICS6814_CONT_CHANNEL_NUM; i++) {
+		TEST_ASSERT_EQUAL(ADC_UNIT_1, adc.pattern[i].unit);
+		TEST_ASSERT_EQUAL(SOC_ADC_DIGI_MAX_BITWIDTH, adc.pattern[i].bit_width);
+	}
+
+	TEST_ASSERT(!adc.running);
+}
+
+/* The conversions left by the previous run are dropped, the frame is
+ * averaged per channel into 13 bits and the ADC is stopped after it */
+static void test_average(void) {
+	mics6814_gases_t gases;
+
+	setup();
+	adc.stale_value = 4000;
+	adc.stale_left = STALE_SIZE;
+
+	TEST_ASSERT_EQUAL(ESP_OK, mics6814_get_all_gases(&mics6814, &gases));
+
+	TEST_ASSERT_EQUAL(0, adc.stale_left);
+	TEST_ASSERT_EQUAL(CONVERSIONS_NUM, adc.conversions);
+	TEST_ASSERT_EQUAL(1, adc.starts);
+	TEST_ASSERT(!adc.running);
+
+	TEST_ASSERT_EQUAL(2000, mics6814.values[NH3_CHANNEL]);
+	TEST_ASSERT_EQUAL(4000, mics6814.values[CO_CHANNEL]);
+	TEST_ASSERT_EQUAL(6000, mics6814.values[NO2_CHANNEL]);
+
+	/* Each reading starts the ADC again */
+	TEST_ASSERT_EQUAL(ESP_OK, mics6814_get_all_gases(&mics6814, &gases));
+	TEST_ASSERT_EQUAL(2, adc.starts);
+	TEST_ASSERT(!adc.running);
+}
+
+/* In clean air the ratios are 1 and the curves give their factors, the gases
+ * of a channel move together */
+static void test_clean_air(void) {
+	mics6814_gases_t gases;
+	const float factors[MICS6814_CONT_GAS_NUM] = {
+			[CO_GAS] = 4.385f,
+			[NO2_GAS] = 1.0f / 6.855f,
+			[NH3_GAS] = 1.0f / 1.47f,
+			[C3H8_GAS] = 570.164f,
+			[C4H10_GAS] = 398.107f,
+			[CH4_GAS] = 630.957f,
+			[H2_GAS] = 0.73f,
+			[C2H5OH_GAS] = 1.622f,
+	};
+
+	setup();
+	mics6814_cont_load_calibration_data(&mics6814, 2000, 4000, 6000);
+
+	TEST_ASSERT_EQUAL(ESP_OK, mics6814_get_all_gases(&mics6814, &gases));
+
+	for (uint8_t i = 0; i < MICS6814_CONT_GAS_NUM; i++) {
+		TEST_ASSERT(fabsf(gases.gas[i] - factors[i]) <= factors[i] * 0.001f);
+	}
+
+	/* Less reducing gas raises the CO channel resistance */
+	adc.values[CO_ADC_CHANNEL] = 2500;
+
+	TEST_ASSERT_EQUAL(ESP_OK, mics6814_get_all_gases(&mics6814, &gases));
+	TEST_ASSERT(gases.gas[CO_GAS] < factors[CO_GAS]);
+	TEST_ASSERT(gases.gas[CH4_GAS] < factors[CH4_GAS]);
+	TEST_ASSERT(gases.gas[C2H5OH_GAS] < factors[C2H5OH_GAS]);
+	TEST_ASSERT(fabsf(gases.gas[NH3_GAS] - factors[NH3_GAS]) <= factors[NH3_GAS] * 0.001f);
+}
+
+static void test_uncalibrated(void) {
+	mics6814_gases_t gases;
+
+	setup();
+	mics6814_cont_load_calibration_data(&mics6814, 2000, 0, 6000);
+
+	TEST_ASSERT_EQUAL(ESP_OK, mics6814_get_all_gases(&mics6814, &gases));
+
+	for (uint8_t i = 0; i < MICS6814_CONT_GAS_NUM; i++) {
+		bool co_channel = mics6814_curve_get_channel(i) == CO_CHANNEL;
+
+		TEST_ASSERT(co_channel ? gases.gas[i] == -1.0f : gases.gas[i] > 0.0f);
+	}
+}
+
+static void test_missing_channel(void) {
+	mics6814_gases_t gases;
+
+	setup();
+	adc.skip_channel = NO2_ADC_CHANNEL;
+
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_RESPONSE, mics6814_get_all_gases(&mics6814, &gases));
+	TEST_ASSERT(!adc.running);
+}
+
+/* A stalled ADC doesn't block the caller, nor is left running */
+static void test_timeout(void) {
+	mics6814_gases_t gases;
+
+	setup();
+	adc.stalled = true;
+
+	TEST_ASSERT_EQUAL(ESP_ERR_TIMEOUT, mics6814_get_all_gases(&mics6814, &gases));
+	TEST_ASSERT(!adc.running);
+}
+
+/* The table driven curves stay within the documented error of the pow()
+ * reference over every reading and a sweep of calibration values */
+static void test_curve_accuracy(void) {
+	double max_errors[MICS6814_CONT_GAS_NUM] = {0};
+
+	for (uint16_t base = 1; base < ADC_FULL_SCALE; base += BASE_STEP) {
+		for (uint16_t value = 1; value < ADC_FULL_SCALE; value++) {
+			double ratio = (double)value / base * (ADC_FULL_SCALE - base) / (ADC_FULL_SCALE - value);
+			int32_t log2_ratio = mics6814_curve_log2_ratio(value, base);
+
+			for (uint8_t i = 0; i < MICS6814_CONT_GAS_NUM; i++) {
+				double expected = curve_refs[i].factor * pow(ratio, curve_refs[i].exponent);
+				double error = fabs(mics6814_curve_eval(i, log2_ratio) - expected) / expected;
+
+				max_errors[i] = error > max_errors[i] ? error : max_errors[i];
+			}
+		}
+	}
+
+	for (uint8_t i = 0; i < MICS6814_CONT_GAS_NUM; i++) {
+		printf("gas %u: %.4f %%\n", i, max_errors[i] * 100);
+
+		TEST_ASSERT(max_errors[i] < curve_refs[i].max_error);
+	}
+}
+
+/* Readings at the ends of the scale have no ratio */
+static void test_curve_invalid(void) {
+	TEST_ASSERT_EQUAL(MICS6814_CURVE_INVALID, mics6814_curve_log2_ratio(0, 4000));
+	TEST_ASSERT_EQUAL(MICS6814_CURVE_INVALID, mics6814_curve_log2_ratio(4000, 0));
+	TEST_ASSERT_EQUAL(MICS6814_CURVE_INVALID, mics6814_curve_log2_ratio(ADC_FULL_SCALE, 4000));
+	TEST_ASSERT_EQUAL(MICS6814_CURVE_INVALID, mics6814_curve_log2_ratio(4000, ADC_FULL_SCALE));
+	TEST_ASSERT_EQUAL(0, mics6814_curve_log2_ratio(4000, 4000));
+
+	for (uint8_t i = 0; i < MICS6814_CONT_GAS_NUM; i++) {
+		TEST_ASSERT(mics6814_curve_eval(i, MICS6814_CURVE_INVALID) == -1.0f);
+	}
+}
+
+/* The table driven curves against the pow() reference. The host has an FPU
+ * and pow() runs in hardware, on the ESP32-S2 it is emulated in software
+ * and the integer tables are the fast path. Here they only have to keep up
+ * with it. The CPU time of the process doesn't depend on the load of the
+ * host */
+static void test_curve_speed(void) {
+	uint32_t readings = 0;
+	double pow_sum = 0;
+	float table_sum = 0;
+	clock_t start = clock();
+
+	for (uint16_t base = 1; base < ADC_FULL_SCALE; base += SPEED_BASE_STEP) {
+		for (uint16_t value = 1; value < ADC_FULL_SCALE; value++) {
+			double ratio = (double)value / base * (ADC_FULL_SCALE - base) / (ADC_FULL_SCALE - value);
+
+			for (uint8_t i = 0; i < MICS6814_CONT_GAS_NUM; i++) {
+				pow_sum += curve_refs[i].factor * pow(ratio, curve_refs[i].exponent);
+			}
+
+			readings++;
+		}
+	}
+
+	clock_t pow_time = clock() - start;
+
+	start = clock();
+
+	for (uint16_t base = 1; base < ADC_FULL_SCALE; base += SPEED_BASE_STEP) {
+		for (uint16_t value = 1; value < ADC_FULL_SCALE; value++) {
+			int32_t log2_ratio = mics6814_curve_log2_ratio(value, base);
+
+			for (uint8_t i = 0; i < MICS6814_CONT_GAS_NUM; i++) {
+				table_sum += mics6814_curve_eval(i, log2_ratio);
+			}
+		}
+	}
+
+	clock_t table_time = clock() - start;
+	uint64_t pow_ns = (uint64_t)pow_time * 1000000000 / CLOCKS_PER_SEC / readings;
+	uint64_t table_ns = (uint64_t)table_time * 1000000000 / CLOCKS_PER_SEC / readings;
+
+	printf("%" PRIu32 " readings into %d gases: %" PRIu64 " ns each with the tables, %" PRIu64 " ns with pow()\n",
+			readings, MICS6814_CONT_GAS_NUM, table_ns, pow_ns);
+
+	/* Keeps the conversions from being left out */
+	TEST_ASSERT(pow_sum > 0 && table_sum > 0);
+	TEST_ASSERT(table_time < 2 * pow_time);
+}
+
+/* Averaging a frame and converting it into every gas takes a small share of
+ * the time the ADC takes to fill it, the pow() curves are timed on the same
+ * averages. The CPU time of the process doesn't depend on the load of the
+ * host */
+static void test_reading_time(void) {
+	static const mics6814_channel_e channels[MICS6814_CONT_GAS_NUM] = {
+			[CO_GAS] = CO_CHANNEL, [NO2_GAS] = NO2_CHANNEL, [NH3_GAS] = NH3_CHANNEL,
+			[C3H8_GAS] = NH3_CHANNEL, [C4H10_GAS] = NH3_CHANNEL, [CH4_GAS] = CO_CHANNEL,
+			[H2_GAS] = CO_CHANNEL, [C2H5OH_GAS] = CO_CHANNEL,
+	};
+	const uint16_t bases[MICS6814_CONT_CHANNEL_NUM] = {[CO_CHANNEL] = 3000, [NO2_CHANNEL] = 5000, [NH3_CHANNEL] = 1500};
+	mics6814_gases_t gases;
+	double pow_sum = 0;
+
+	setup();
+	mics6814_cont_load_calibration_data(&mics6814, bases[NH3_CHANNEL], bases[CO_CHANNEL], bases[NO2_CHANNEL]);
+
+	clock_t start = clock();
+
+	for (uint32_t i = 0; i < READINGS_NUM; i++) {
+		TEST_ASSERT_EQUAL(ESP_OK, mics6814_get_all_gases(&mics6814, &gases));
+	}
+
+	clock_t reading_time = clock() - start;
+
+	start = clock();
+
+	for (uint32_t i = 0; i < READINGS_NUM; i++) {
+		for (uint8_t gas = 0; gas < MICS6814_CONT_GAS_NUM; gas++) {
+			double value = mics6814.values[channels[gas]];
+			double base = bases[channels[gas]];
+			double ratio = value / base * (ADC_FULL_SCALE - base) / (ADC_FULL_SCALE - value);
+
+			pow_sum += curve_refs[gas].factor * pow(ratio, curve_refs[gas].exponent);
+		}
+	}
+
+	clock_t pow_time = clock() - start;
+	uint64_t reading_ns = (uint64_t)reading_time * 1000000000 / CLOCKS_PER_SEC / READINGS_NUM;
+	uint64_t pow_ns = (uint64_t)pow_time * 1000000000 / CLOCKS_PER_SEC / READINGS_NUM;
+
+	printf("%d conversions per frame, %" PRIu64 " ns per reading, %" PRIu64 " ns for its gases with pow(), the ADC fills a frame in %" PRId64 " us\n",
+			CONVERSIONS_NUM, reading_ns, pow_ns, FRAME_US);
+
+	TEST_ASSERT(pow_sum > 0);
+	TEST_ASSERT(reading_ns * 100 < FRAME_US * 1000);
+}
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,114 @@
+/**
+  ******************************************************************************
+  * @file           : power_mgmt.h
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Dynamic frequency scaling and automatic light sleep
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef POWER_MGMT_H_
+#define POWER_MGMT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "esp_pm.h"
+#include "sdkconfig.h"
+
+/* Exported macro ------------------------------------------------------------*/
+#define POWER_MGMT_DUMP_SIZE	1536
+
+/* Exported typedef ----------------------------------------------------------*/
+typedef enum {
+	POWER_MGMT_LIGHT_SLEEP_MODE = 0,
+	POWER_MGMT_APB_MIN_MODE,		/* Minimum CPU and APB frequency */
+	POWER_MGMT_APB_MAX_MODE,		/* 80 MHz APB, ESP_PM_APB_FREQ_MAX held */
+	POWER_MGMT_CPU_MAX_MODE,		/* Maximum CPU frequency, ESP_PM_CPU_FREQ_MAX held */
+	POWER_MGMT_MAX_MODE
+} power_mgmt_mode_e;
+
+typedef struct {
+	int64_t time_us[POWER_MGMT_MAX_MODE];	/* Indexed by power_mgmt_mode_e */
+} power_mgmt_stats_t;
+
+typedef struct {
+	esp_pm_config_t config;
+	power_mgmt_stats_t total;		/* Times at the previous power_mgmt_get_stats() */
+	char dump[POWER_MGMT_DUMP_SIZE];
+} power_mgmt_t;
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions prototypes ---------------------------------------------*/
+/**
+  * @brief Function to enable the dynamic frequency scaling and the automatic
+  *        light sleep
+  *
+  * @note The drivers hold power management locks during their transactions,
+  *       in between the CPU runs at the minimum frequency or sleeps
+  *
+  * @param me : Pointer to a power_mgmt_t structure
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_NOT_SUPPORTED if CONFIG_PM_ENABLE is not set, or light sleep
+  * 	  without CONFIG_FREERTOS_USE_TICKLESS_IDLE
+  * 	- ESP_ERR_INVALID_ARG if the frequencies are not supported
+  */
+esp_err_t power_mgmt_init(power_mgmt_t * const me);
+
+/**
+  * @brief Function to get the time spent in each power management mode since
+  *        the previous call, or since boot the first time
+  *
+  * @note The times are counted by ESP-IDF with CONFIG_PM_PROFILING
+  *
+  * @param me    : Pointer to a power_mgmt_t structure
+  * @param stats : Pointer to store the times
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_NOT_SUPPORTED if CONFIG_PM_PROFILING is not set
+  * 	- ESP_ERR_INVALID_SIZE if the ESP-IDF report doesn't fit in the buffer
+  */
+esp_err_t power_mgmt_get_stats(power_mgmt_t * const me, power_mgmt_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POWER_MGMT_H_ */
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,185 @@
+/**
+  ******************************************************************************
+  * @file           : power_mgmt.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Dynamic frequency scaling and automatic light sleep
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "power_mgmt.h"
+#include "esp_log.h"
+
+/* Private macro -------------------------------------------------------------*/
+/* Modes esp_pm_dump_locks() lists whatever the configuration */
+#define MODES_LISTED	((1 << POWER_MGMT_APB_MIN_MODE) | (1 << POWER_MGMT_APB_MAX_MODE) | \
+						(1 << POWER_MGMT_CPU_MAX_MODE))
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static const char *TAG = "power_mgmt";
+
+/* Mode names in the esp_pm_dump_locks() report, indexed by power_mgmt_mode_e */
+static const char *mode_names[POWER_MGMT_MAX_MODE] = {
+		[POWER_MGMT_LIGHT_SLEEP_MODE] = "SLEEP",
+		[POWER_MGMT_APB_MIN_MODE] = "APB_MIN",
+		[POWER_MGMT_APB_MAX_MODE] = "APB_MAX",
+		[POWER_MGMT_CPU_MAX_MODE] = "CPU_MAX",
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static esp_err_t stats_read(power_mgmt_t * const me, power_mgmt_stats_t *total);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief Function to enable the dynamic frequency scaling and the automatic
+  *        light sleep
+  */
+esp_err_t power_mgmt_init(power_mgmt_t * const me) {
+	ESP_LOGI(TAG, "Initializing power management instance...");
+
+	memset(&me->total, 0, sizeof(me->total));
+
+	me->config = (esp_pm_config_t) {
+			.max_freq_mhz = CONFIG_POWER_MGMT_MAX_CPU_FREQ_MHZ,
+			.min_freq_mhz = CONFIG_POWER_MGMT_MIN_CPU_FREQ_MHZ,
+#ifdef CONFIG_POWER_MGMT_LIGHT_SLEEP
+			.light_sleep_enable = true,
+#endif
+	};
+
+	esp_err_t ret = esp_pm_configure(&me->config);
+
+	if (ret != ESP_OK) {
+		ESP_LOGE(TAG, "Failed to configure power management: %s", esp_err_to_name(ret));
+		return ret;
+	}
+
+	ESP_LOGI(TAG, "CPU at %d-%d MHz, light sleep %s", me->config.min_freq_mhz, me->config.max_freq_mhz,
+			me->config.light_sleep_enable ? "on" : "off");
+
+	return ESP_OK;
+}
+
+/**
+  * @brief Function to get the time spent in each power management mode since
+  *        the previous call
+  */
+esp_err_t power_mgmt_get_stats(power_mgmt_t * const me, power_mgmt_stats_t *stats) {
+	power_mgmt_stats_t total;
+
+	esp_err_t ret = stats_read(me, &total);
+
+	if (ret != ESP_OK) {
+		return ret;
+	}
+
+	for (uint8_t i = 0; i < POWER_MGMT_MAX_MODE; i++) {
+		stats->time_us[i] = total.time_us[i] - me->total.time_us[i];
+	}
+
+	me->total = total;
+
+	return ESP_OK;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static esp_err_t stats_read(power_mgmt_t * const me, power_mgmt_stats_t *total) {
+#ifdef CONFIG_PM_PROFILING
+	/* ESP-IDF only reports its mode counters as text */
+	FILE *stream = fmemopen(me->dump, sizeof(me->dump), "w");
+
+	if (stream == NULL) {
+		return ESP_ERR_NO_MEM;
+	}
+
+	esp_pm_dump_locks(stream);
+	fclose(stream);
+
+	/* A report that fills the buffer is left without terminator by some C
+	 * libraries, it was cut anyway */
+	me->dump[sizeof(me->dump) - 1] = '\0';
+
+	/* Cut before the modes table, the lock names can't match a mode then */
+	char *line = strstr(me->dump, "Mode stats:");
+
+	if (line == NULL) {
+		return ESP_ERR_INVALID_SIZE;
+	}
+
+	memset(total, 0, sizeof(*total));
+	uint32_t found = 0;
+
+	while ((line = strchr(line, '\n')) != NULL) {
+		char name[16];
+		int64_t time_us;
+
+		line++;
+
+		/* A row cut by the end of the buffer may still parse, with part of
+		 * its time */
+		if (strchr(line, '\n') == NULL) {
+			break;
+		}
+
+		/* Mode, frequency padded before the M, time in us, percentage */
+		if (sscanf(line, "%15s %*d M %" SCNd64, name, &time_us) != 2) {
+			continue;
+		}
+
+		for (uint8_t i = 0; i < POWER_MGMT_MAX_MODE; i++) {
+			if (strcmp(name, mode_names[i]) == 0) {
+				total->time_us[i] = time_us;
+				found |= 1 << i;
+				break;
+			}
+		}
+	}
+
+	/* The light sleep row is only listed while light sleep is enabled, the
+	 * others always are and CPU_MAX comes last, missing it means the report
+	 * was cut */
+	if ((found & MODES_LISTED) != MODES_LISTED) {
+		return ESP_ERR_INVALID_SIZE;
+	}
+
+	return ESP_OK;
+#else
+	return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+/***************************** END OF FILE ************************************/
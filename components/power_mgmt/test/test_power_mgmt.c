@@ -0,0 +1,234 @@
+/**
+  ******************************************************************************
+  * @file           : test_power_mgmt.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Host test of the power management mode report parser
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+#include "host_test.h"
+#include "power_mgmt.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define CUT_LOCKS_MAX			30
+#define CUT_TIME_DIGITS_MAX		19
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static power_mgmt_t pm;
+
+/* esp_pm_dump_locks() of ESP-IDF 5.1 on the ESP32-S2 after a minute, with the
+ * automatic light sleep enabled */
+static const char *dump_sleep =
+		"Time: 60012345\n"
+		"Lock stats:\n"
+		"Name            Type           Arg   Active   Total_count   Time(us) Time(%) \n"
+		"rmt_0_0         APB_FREQ_MAX   0     0        3000           184211      0  %\n"
+		"esp_buzzer      APB_FREQ_MAX   0     0        12             1200433     2  %\n"
+		"i2c_bus_async   APB_FREQ_MAX   0     0        241            301877      0  %\n"
+		"rtos0           CPU_FREQ_MAX   0     1        6021           2413990     4  %\n"
+		"\n"
+		"Mode stats:\n"
+		"Mode      CPU_freq    Time(us)    Time(%)   \n"
+		"SLEEP     40 M        51830112    86%\n"
+		"APB_MIN   40 M        5302190     8 %\n"
+		"APB_MAX   80 M        466253      0 %\n"
+		"CPU_MAX   160M        2413790     4 %\n";
+
+/* The same a minute later */
+static const char *dump_sleep_later =
+		"Time: 120020011\n"
+		"Lock stats:\n"
+		"Name            Type           Arg   Active   Total_count   Time(us) Time(%) \n"
+		"rmt_0_0         APB_FREQ_MAX   0     0        6000           368422      0  %\n"
+		"esp_buzzer      APB_FREQ_MAX   0     0        12             1200433     1  %\n"
+		"i2c_bus_async   APB_FREQ_MAX   0     0        482            603754      0  %\n"
+		"rtos0           CPU_FREQ_MAX   0     1        12040          4827560     4  %\n"
+		"\n"
+		"Mode stats:\n"
+		"Mode      CPU_freq    Time(us)    Time(%)   \n"
+		"SLEEP     40 M        105160224   87%\n"
+		"APB_MIN   40 M        9564010     7 %\n"
+		"APB_MAX   80 M        468197      0 %\n"
+		"CPU_MAX   160M        4827580     4 %\n";
+
+/* Light sleep disabled, its row isn't listed */
+static const char *dump_no_sleep =
+		"Time: 60009870\n"
+		"Lock stats:\n"
+		"Name            Type           Arg   Active   Total_count   Time(us) Time(%) \n"
+		"i2c_bus_async   APB_FREQ_MAX   0     0        241            301877      0  %\n"
+		"rtos0           CPU_FREQ_MAX   0     1        6021           2413990     4  %\n"
+		"\n"
+		"Mode stats:\n"
+		"Mode      CPU_freq    Time(us)    Time(%)   \n"
+		"APB_MIN   40 M        57195903    95%\n"
+		"APB_MAX   80 M        400187      0 %\n"
+		"CPU_MAX   160M        2413780     4 %\n";
+
+static const int64_t times_sleep[POWER_MGMT_MAX_MODE] = {51830112, 5302190, 466253, 2413790};
+
+/* Private function prototypes -----------------------------------------------*/
+static size_t dump_build(char *buf, size_t size, uint32_t locks, int64_t now, bool sleep);
+static void test_dump_sleep(void);
+static void test_dump_no_sleep(void);
+static void test_dump_cut(void);
+
+/* Main ----------------------------------------------------------------------*/
+int main(void) {
+	RUN_TEST(test_dump_sleep);
+	RUN_TEST(test_dump_no_sleep);
+	RUN_TEST(test_dump_cut);
+
+	return 0;
+}
+
+/* Private functions ---------------------------------------------------------*/
+/* A report with the esp_pm_dump_locks() formats of ESP-IDF 5.1, the lock
+ * rows and the digits of the time move the end of the buffer over it */
+static size_t dump_build(char *buf, size_t size, uint32_t locks, int64_t now, bool sleep) {
+	static const char *modes[POWER_MGMT_MAX_MODE] = {"SLEEP", "APB_MIN", "APB_MAX", "CPU_MAX"};
+	static const uint32_t freqs[POWER_MGMT_MAX_MODE] = {40, 40, 80, 160};
+	size_t len = 0;
+
+	len += snprintf(buf + len, size - len, "Time: %" PRId64 "\n", now);
+	len += snprintf(buf + len, size - len, "Lock stats:\n");
+	len += snprintf(buf + len, size - len, "%-15s %-14s %-5s %-8s %-13s %-8s %-8s\n",
+			"Name", "Type", "Arg", "Active", "Total_count", "Time(us)", "Time(%)");
+
+	for (uint32_t i = 0; i < locks; i++) {
+		len += snprintf(buf + len, size - len, "%-15.15s %-14s %-5d %-8d ", "rmt_0_0", "APB_FREQ_MAX", 0, 0);
+		len += snprintf(buf + len, size - len, "%-14" PRIu32 " %-11" PRIu64 " %-3" PRIu32 "%%\n", i, (uint64_t)i * 1000, (uint32_t)0);
+	}
+
+	len += snprintf(buf + len, size - len, "\nMode stats:\n");
+	len += snprintf(buf + len, size - len, "%-8s  %-10s  %-10s  %-10s\n", "Mode", "CPU_freq", "Time(us)", "Time(%)");
+
+	for (uint8_t i = sleep ? 0 : 1; i < POWER_MGMT_MAX_MODE; i++) {
+		len += snprintf(buf + len, size - len, "%-8s  %-3" PRIu32 "M%-7s %-10" PRId64 "  %-2d%%\n",
+				modes[i], freqs[i], "", times_sleep[i], 8);
+	}
+
+	TEST_ASSERT(len < size);
+
+	return len;
+}
+
+/* Every mode row is read, and the times are the ones since the previous call */
+static void test_dump_sleep(void) {
+	power_mgmt_stats_t stats;
+
+	TEST_ASSERT_EQUAL(ESP_OK, power_mgmt_init(&pm));
+
+	host_pm_set_dump(dump_sleep);
+	TEST_ASSERT_EQUAL(ESP_OK, power_mgmt_get_stats(&pm, &stats));
+
+	for (uint8_t i = 0; i < POWER_MGMT_MAX_MODE; i++) {
+		TEST_ASSERT_EQUAL(times_sleep[i], stats.time_us[i]);
+	}
+
+	host_pm_set_dump(dump_sleep_later);
+	TEST_ASSERT_EQUAL(ESP_OK, power_mgmt_get_stats(&pm, &stats));
+	TEST_ASSERT_EQUAL(105160224 - 51830112, stats.time_us[POWER_MGMT_LIGHT_SLEEP_MODE]);
+	TEST_ASSERT_EQUAL(9564010 - 5302190, stats.time_us[POWER_MGMT_APB_MIN_MODE]);
+	TEST_ASSERT_EQUAL(468197 - 466253, stats.time_us[POWER_MGMT_APB_MAX_MODE]);
+	TEST_ASSERT_EQUAL(4827580 - 2413790, stats.time_us[POWER_MGMT_CPU_MAX_MODE]);
+}
+
+/* Without light sleep its time stays at 0, the others are read */
+static void test_dump_no_sleep(void) {
+	power_mgmt_stats_t stats;
+
+	TEST_ASSERT_EQUAL(ESP_OK, power_mgmt_init(&pm));
+
+	host_pm_set_dump(dump_no_sleep);
+	TEST_ASSERT_EQUAL(ESP_OK, power_mgmt_get_stats(&pm, &stats));
+	TEST_ASSERT_EQUAL(0, stats.time_us[POWER_MGMT_LIGHT_SLEEP_MODE]);
+	TEST_ASSERT_EQUAL(57195903, stats.time_us[POWER_MGMT_APB_MIN_MODE]);
+	TEST_ASSERT_EQUAL(400187, stats.time_us[POWER_MGMT_APB_MAX_MODE]);
+	TEST_ASSERT_EQUAL(2413780, stats.time_us[POWER_MGMT_CPU_MAX_MODE]);
+
+	/* A report with no mode row at all */
+	host_pm_set_dump("Lock stats:\n\nMode stats:\nMode      CPU_freq    Time(us)    Time(%)   \n");
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, power_mgmt_get_stats(&pm, &stats));
+}
+
+/* Wherever the end of the buffer cuts the report, the times are either all
+ * right or not returned */
+static void test_dump_cut(void) {
+	static char dump[2 * POWER_MGMT_DUMP_SIZE];
+	power_mgmt_stats_t stats;
+	uint32_t fit = 0;
+	uint32_t cut = 0;
+
+	TEST_ASSERT_EQUAL(ESP_OK, power_mgmt_init(&pm));
+
+	for (uint32_t locks = 0; locks <= CUT_LOCKS_MAX; locks++) {
+		int64_t now = 1;
+
+		for (uint8_t digits = 1; digits <= CUT_TIME_DIGITS_MAX; digits++, now *= 10) {
+			for (uint8_t sleep = 0; sleep < 2; sleep++) {
+				size_t len = dump_build(dump, sizeof(dump), locks, now, sleep);
+
+				/* Each report is read as the first one */
+				memset(&pm.total, 0, sizeof(pm.total));
+				host_pm_set_dump(dump);
+
+				esp_err_t ret = power_mgmt_get_stats(&pm, &stats);
+
+				/* The buffer holds the terminator too */
+				if (len >= POWER_MGMT_DUMP_SIZE) {
+					TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, ret);
+					cut++;
+					continue;
+				}
+
+				TEST_ASSERT_EQUAL(ESP_OK, ret);
+				fit++;
+
+				for (uint8_t i = 0; i < POWER_MGMT_MAX_MODE; i++) {
+					TEST_ASSERT_EQUAL(sleep || i ? times_sleep[i] : 0, stats.time_us[i]);
+				}
+			}
+		}
+	}
+
+	printf("%" PRIu32 " reports fit, %" PRIu32 " were cut\n", fit, cut);
+
+	TEST_ASSERT(fit > 0 && cut > 0);
+	host_pm_set_dump(NULL);
+}
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,148 @@
+/**
+  ******************************************************************************
+  * @file           : sample_bus.h
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Lock-free single writer bus of timestamped sensor samples
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef SAMPLE_BUS_H_
+#define SAMPLE_BUS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+/* Exported macro ------------------------------------------------------------*/
+#define SAMPLE_BUS_RING_SIZE	CONFIG_SAMPLE_BUS_RING_SIZE
+
+/* Exported typedef ----------------------------------------------------------*/
+/* Sensor sample */
+typedef struct {
+	int64_t timestamp;		/* Time the sample was taken in us */
+	float value;
+	uint16_t id;			/* Signal identifier, defined by the producer */
+	uint8_t accuracy;		/* Producer defined accuracy, 0 if unknown */
+} sample_t;
+
+/* Ring slot, guarded by its own sequence counter */
+typedef struct {
+	atomic_uint seq;		/* 2 * n + 1 while sample n is written, 2 * n + 2 once done */
+	sample_t sample;
+} sample_bus_slot_t;
+
+/* Channel of samples, written by a single producer */
+typedef struct {
+	const char *name;
+	atomic_uint head;		/* Number of samples published */
+	sample_bus_slot_t slots[SAMPLE_BUS_RING_SIZE];
+} sample_bus_channel_t;
+
+/* Consumer position in a channel history */
+typedef struct {
+	uint32_t next;			/* Next sample number to read */
+	uint32_t lost;			/* Samples overwritten before they were read */
+} sample_bus_reader_t;
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions prototypes ---------------------------------------------*/
+/**
+  * @brief Function to initialize a channel
+  *
+  * @param me   : Pointer to a sample_bus_channel_t structure
+  * @param name : Channel name, not copied
+  */
+void sample_bus_channel_init(sample_bus_channel_t * const me, const char *name);
+
+/**
+  * @brief Function to publish a sample in a channel
+  *
+  * @note Never blocks. Only one task may publish in a given channel, the
+  *       oldest sample is overwritten when the ring is full
+  *
+  * @param me     : Pointer to a sample_bus_channel_t structure
+  * @param sample : Pointer to the sample to publish
+  */
+void sample_bus_publish(sample_bus_channel_t * const me, const sample_t *sample);
+
+/**
+  * @brief Function to read the latest sample of a channel
+  *
+  * @note Never blocks, any number of tasks can read a channel
+  *
+  * @param me     : Pointer to a sample_bus_channel_t structure
+  * @param sample : Pointer to the returned sample
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_NOT_FOUND if nothing was published yet
+  */
+esp_err_t sample_bus_read_latest(sample_bus_channel_t * const me, sample_t *sample);
+
+/**
+  * @brief Function to initialize a reader at the current end of a channel
+  *
+  * @param me     : Pointer to a sample_bus_channel_t structure
+  * @param reader : Pointer to the reader, it only returns new samples
+  */
+void sample_bus_reader_init(sample_bus_channel_t * const me, sample_bus_reader_t *reader);
+
+/**
+  * @brief Function to read the next sample of the channel history
+  *
+  * @note Never blocks. If the producer laps the reader, the overwritten
+  *       samples are skipped and counted in reader->lost
+  *
+  * @param me     : Pointer to a sample_bus_channel_t structure
+  * @param reader : Pointer to the reader
+  * @param sample : Pointer to the returned sample
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_NOT_FOUND if the reader is up to date
+  */
+esp_err_t sample_bus_read_next(sample_bus_channel_t * const me, sample_bus_reader_t *reader, sample_t *sample);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SAMPLE_BUS_H_ */
+
+/***************************** END OF FILE ************************************/
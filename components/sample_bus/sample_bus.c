@@ -0,0 +1,157 @@
+/**
+  ******************************************************************************
+  * @file           : sample_bus.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Lock-free single writer bus of timestamped sensor samples
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+#include "sample_bus.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define SLOT_INDEX(n)	((n) & (SAMPLE_BUS_RING_SIZE - 1))
+
+_Static_assert((SAMPLE_BUS_RING_SIZE & (SAMPLE_BUS_RING_SIZE - 1)) == 0,
+		"The ring size must be a power of two");
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+static bool read_sample(sample_bus_channel_t * const me, uint32_t n, sample_t *sample);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief Function to initialize a channel
+  */
+void sample_bus_channel_init(sample_bus_channel_t * const me, const char *name) {
+	me->name = name;
+	atomic_init(&me->head, 0);
+
+	for (uint32_t i = 0; i < SAMPLE_BUS_RING_SIZE; i++) {
+		atomic_init(&me->slots[i].seq, 0);
+	}
+}
+
+/**
+  * @brief Function to publish a sample in a channel
+  */
+void sample_bus_publish(sample_bus_channel_t * const me, const sample_t *sample) {
+	/* Only this function writes head, so a relaxed load is enough */
+	uint32_t n = atomic_load_explicit(&me->head, memory_order_relaxed);
+	sample_bus_slot_t *slot = &me->slots[SLOT_INDEX(n)];
+
+	/* Odd sequence: the readers of the previous sample in this slot retry */
+	atomic_store_explicit(&slot->seq, 2 * n + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+
+	slot->sample = *sample;
+
+	atomic_store_explicit(&slot->seq, 2 * n + 2, memory_order_release);
+	atomic_store_explicit(&me->head, n + 1, memory_order_release);
+}
+
+/**
+  * @brief Function to read the latest sample of a channel
+  */
+esp_err_t sample_bus_read_latest(sample_bus_channel_t * const me, sample_t *sample) {
+	for (;;) {
+		uint32_t head = atomic_load_explicit(&me->head, memory_order_acquire);
+
+		if (head == 0) {
+			return ESP_ERR_NOT_FOUND;
+		}
+
+		/* Only fails if the producer wrapped the ring meanwhile, then a newer
+		 * sample is there */
+		if (read_sample(me, head - 1, sample)) {
+			return ESP_OK;
+		}
+	}
+}
+
+/**
+  * @brief Function to initialize a reader at the current end of a channel
+  */
+void sample_bus_reader_init(sample_bus_channel_t * const me, sample_bus_reader_t *reader) {
+	reader->next = atomic_load_explicit(&me->head, memory_order_acquire);
+	reader->lost = 0;
+}
+
+/**
+  * @brief Function to read the next sample of the channel history
+  */
+esp_err_t sample_bus_read_next(sample_bus_channel_t * const me, sample_bus_reader_t *reader, sample_t *sample) {
+	for (;;) {
+		uint32_t head = atomic_load_explicit(&me->head, memory_order_acquire);
+
+		if (reader->next == head) {
+			return ESP_ERR_NOT_FOUND;
+		}
+
+		/* Skip what the producer already overwrote */
+		if (head - reader->next > SAMPLE_BUS_RING_SIZE) {
+			reader->lost += head - reader->next - SAMPLE_BUS_RING_SIZE;
+			reader->next = head - SAMPLE_BUS_RING_SIZE;
+		}
+
+		if (read_sample(me, reader->next, sample)) {
+			reader->next++;
+			return ESP_OK;
+		}
+
+		/* Overwritten while it was read */
+		reader->next++;
+		reader->lost++;
+	}
+}
+
+/* Private functions ---------------------------------------------------------*/
+/* Copy sample n, returns false if its slot holds another sample */
+static bool read_sample(sample_bus_channel_t * const me, uint32_t n, sample_t *sample) {
+	sample_bus_slot_t *slot = &me->slots[SLOT_INDEX(n)];
+	uint32_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+
+	if (seq != 2 * n + 2) {
+		return false;
+	}
+
+	memcpy(sample, &slot->sample, sizeof(sample_t));
+	atomic_thread_fence(memory_order_acquire);
+
+	return atomic_load_explicit(&slot->seq, memory_order_relaxed) == seq;
+}
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,366 @@
+/**
+  ******************************************************************************
+  * @file           : test_sample_bus.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Host test of the sample_bus channels
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "host_test.h"
+#include "sample_bus.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define STRESS_SAMPLES			200000
+#define STRESS_BURST			(SAMPLE_BUS_RING_SIZE / 2)
+#define STRESS_READERS			3
+#define LATENCY_SAMPLES			100000
+#define LATENCY_P50_NS_MAX		1000	/* On the host */
+#define LATENCY_P99_NS_MAX		10000
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+	sample_bus_reader_t reader;
+	uint32_t got;
+	uint32_t torn;
+	uint32_t unordered;
+	uint32_t latest;
+} stress_reader_t;
+
+/* Private variables ---------------------------------------------------------*/
+static sample_bus_channel_t channel;
+static atomic_bool producer_done;
+static SemaphoreHandle_t finished;
+static stress_reader_t readers[STRESS_READERS];
+static uint32_t latencies[LATENCY_SAMPLES];
+
+/* Private function prototypes -----------------------------------------------*/
+static void sample_make(uint32_t n, sample_t *sample);
+static bool sample_check(const sample_t *sample);
+static void producer_task(void *arg);
+static void reader_task(void *arg);
+static int64_t time_ns(void);
+static int latency_compare(const void *a, const void *b);
+static void latency_print(const char *name, uint32_t *ns, uint32_t n);
+static void test_empty(void);
+static void test_history(void);
+static void test_lapped(void);
+static void test_latest(void);
+static void test_stress(void);
+static void test_latency(void);
+
+/* Main ----------------------------------------------------------------------*/
+int main(void) {
+	RUN_TEST(test_empty);
+	RUN_TEST(test_history);
+	RUN_TEST(test_lapped);
+	RUN_TEST(test_latest);
+	RUN_TEST(test_stress);
+	RUN_TEST(test_latency);
+
+	return 0;
+}
+
+/* Private functions ---------------------------------------------------------*/
+/* Every field is derived from the sample number, a torn read mixes two */
+static void sample_make(uint32_t n, sample_t *sample) {
+	sample->timestamp = n;
+	sample->value = (float)(n % 100000);
+	sample->id = n & 0xFFFF;
+	sample->accuracy = (n >> 16) & 0xFF;
+}
+
+static bool sample_check(const sample_t *sample) {
+	sample_t expected;
+
+	sample_make((uint32_t)sample->timestamp, &expected);
+
+	return sample->value == expected.value && sample->id == expected.id && sample->accuracy == expected.accuracy;
+}
+
+static void producer_task(void *arg) {
+	sample_t sample;
+
+	for (uint32_t n = 0; n < STRESS_SAMPLES; n++) {
+		sample_make(n, &sample);
+		sample_bus_publish(&channel, &sample);
+
+		/* Alternates short bursts the readers keep up with and long ones that
+		 * lap them */
+		if (n % STRESS_BURST == 0 && (n & 0x1000) == 0) {
+			taskYIELD();
+		}
+	}
+
+	atomic_store(&producer_done, true);
+	xSemaphoreGive(finished);
+	vTaskDelete(NULL);
+}
+
+/* Reads the history, and the latest sample now and then */
+static void reader_task(void *arg) {
+	stress_reader_t *me = arg;
+	sample_t sample;
+	int64_t last = -1;
+
+	for (;;) {
+		bool done = atomic_load(&producer_done);
+
+		while (sample_bus_read_next(&channel, &me->reader, &sample) == ESP_OK) {
+			me->got++;
+			me->torn += !sample_check(&sample);
+			me->unordered += sample.timestamp <= last || sample.timestamp != me->reader.next - 1;
+			last = sample.timestamp;
+
+			if ((me->got & 0x3FF) == 0 && sample_bus_read_latest(&channel, &sample) == ESP_OK) {
+				me->latest++;
+				me->torn += !sample_check(&sample);
+				me->unordered += sample.timestamp < last;
+			}
+		}
+
+		/* Drained after the last sample was published */
+		if (done) {
+			break;
+		}
+
+		taskYIELD();
+	}
+
+	xSemaphoreGive(finished);
+	vTaskDelete(NULL);
+}
+
+static int64_t time_ns(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static int latency_compare(const void *a, const void *b) {
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+/* Sorts the latencies and prints their distribution */
+static void latency_print(const char *name, uint32_t *ns, uint32_t n) {
+	qsort(ns, n, sizeof(ns[0]), latency_compare);
+
+	printf("%s: p50 %" PRIu32 " ns, p90 %" PRIu32 " ns, p99 %" PRIu32 " ns, p99.9 %" PRIu32 " ns, max %" PRIu32 " ns\n",
+			name, ns[n / 2], ns[n * 9 / 10], ns[n * 99 / 100], ns[n * 999 / 1000], ns[n - 1]);
+}
+
+/* Nothing to read before the first sample */
+static void test_empty(void) {
+	sample_bus_reader_t reader;
+	sample_t sample;
+
+	sample_bus_channel_init(&channel, "test");
+	sample_bus_reader_init(&channel, &reader);
+
+	TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, sample_bus_read_latest(&channel, &sample));
+	TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, sample_bus_read_next(&channel, &reader, &sample));
+	TEST_ASSERT_EQUAL(0, reader.lost);
+}
+
+/* A reader gets the samples published since it was initialized, in order */
+static void test_history(void) {
+	sample_bus_reader_t early;
+	sample_bus_reader_t late;
+	sample_t sample;
+
+	sample_bus_channel_init(&channel, "test");
+	sample_bus_reader_init(&channel, &early);
+
+	for (uint32_t n = 0; n < 3; n++) {
+		sample_make(n, &sample);
+		sample_bus_publish(&channel, &sample);
+	}
+
+	sample_bus_reader_init(&channel, &late);
+
+	for (uint32_t n = 3; n < 5; n++) {
+		sample_make(n, &sample);
+		sample_bus_publish(&channel, &sample);
+	}
+
+	for (uint32_t n = 0; n < 5; n++) {
+		TEST_ASSERT_EQUAL(ESP_OK, sample_bus_read_next(&channel, &early, &sample));
+		TEST_ASSERT_EQUAL(n, sample.timestamp);
+		TEST_ASSERT(sample_check(&sample));
+	}
+
+	for (uint32_t n = 3; n < 5; n++) {
+		TEST_ASSERT_EQUAL(ESP_OK, sample_bus_read_next(&channel, &late, &sample));
+		TEST_ASSERT_EQUAL(n, sample.timestamp);
+	}
+
+	TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, sample_bus_read_next(&channel, &early, &sample));
+	TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, sample_bus_read_next(&channel, &late, &sample));
+	TEST_ASSERT_EQUAL(0, early.lost);
+	TEST_ASSERT_EQUAL(0, late.lost);
+}
+
+/* A lapped reader skips to the oldest sample still in the ring and counts
+ * the overwritten ones */
+static void test_lapped(void) {
+	sample_bus_reader_t reader;
+	sample_t sample;
+	const uint32_t published = SAMPLE_BUS_RING_SIZE + 5;
+
+	sample_bus_channel_init(&channel, "test");
+	sample_bus_reader_init(&channel, &reader);
+
+	for (uint32_t n = 0; n < published; n++) {
+		sample_make(n, &sample);
+		sample_bus_publish(&channel, &sample);
+	}
+
+	for (uint32_t n = 5; n < published; n++) {
+		TEST_ASSERT_EQUAL(ESP_OK, sample_bus_read_next(&channel, &reader, &sample));
+		TEST_ASSERT_EQUAL(n, sample.timestamp);
+	}
+
+	TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, sample_bus_read_next(&channel, &reader, &sample));
+	TEST_ASSERT_EQUAL(5, reader.lost);
+}
+
+/* The latest sample doesn't move the readers */
+static void test_latest(void) {
+	sample_bus_reader_t reader;
+	sample_t sample;
+
+	sample_bus_channel_init(&channel, "test");
+	sample_bus_reader_init(&channel, &reader);
+
+	for (uint32_t n = 0; n < 3 * SAMPLE_BUS_RING_SIZE; n++) {
+		sample_make(n, &sample);
+		sample_bus_publish(&channel, &sample);
+		TEST_ASSERT_EQUAL(ESP_OK, sample_bus_read_latest(&channel, &sample));
+		TEST_ASSERT_EQUAL(n, sample.timestamp);
+	}
+
+	TEST_ASSERT_EQUAL(ESP_OK, sample_bus_read_next(&channel, &reader, &sample));
+	TEST_ASSERT_EQUAL(2 * SAMPLE_BUS_RING_SIZE, sample.timestamp);
+}
+
+/* One producer races several readers: no sample is torn or out of order,
+ * and every one is either read or counted as lost */
+static void test_stress(void) {
+	finished = xSemaphoreCreateCounting(STRESS_READERS + 1, 0);
+	atomic_store(&producer_done, false);
+	sample_bus_channel_init(&channel, "stress");
+
+	for (uint32_t i = 0; i < STRESS_READERS; i++) {
+		sample_bus_reader_init(&channel, &readers[i].reader);
+		TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(reader_task, "reader", 4096, &readers[i], 5, NULL));
+	}
+
+	TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(producer_task, "producer", 4096, NULL, 5, NULL));
+
+	for (uint32_t i = 0; i < STRESS_READERS + 1; i++) {
+		TEST_ASSERT(xSemaphoreTake(finished, pdMS_TO_TICKS(60000)));
+	}
+
+	for (uint32_t i = 0; i < STRESS_READERS; i++) {
+		printf("reader %" PRIu32 ": %" PRIu32 " read, %" PRIu32 " lost, %" PRIu32 " latest\n",
+				i, readers[i].got, readers[i].reader.lost, readers[i].latest);
+
+		TEST_ASSERT_EQUAL(0, readers[i].torn);
+		TEST_ASSERT_EQUAL(0, readers[i].unordered);
+		TEST_ASSERT_EQUAL(STRESS_SAMPLES, readers[i].got + readers[i].reader.lost);
+	}
+}
+
+/* The calls don't wait on each other, their latency stays short with the
+ * readers running. The maximum includes the host preempting the test and
+ * isn't bounded */
+static void test_latency(void) {
+	sample_t sample;
+
+	atomic_store(&producer_done, false);
+	sample_bus_channel_init(&channel, "latency");
+
+	for (uint32_t i = 0; i < STRESS_READERS; i++) {
+		readers[i] = (stress_reader_t) {0};
+		sample_bus_reader_init(&channel, &readers[i].reader);
+		TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(reader_task, "reader", 4096, &readers[i], 5, NULL));
+	}
+
+	for (uint32_t n = 0; n < LATENCY_SAMPLES; n++) {
+		sample_make(n, &sample);
+
+		int64_t start = time_ns();
+
+		sample_bus_publish(&channel, &sample);
+		latencies[n] = time_ns() - start;
+
+		if (n % STRESS_BURST == 0) {
+			taskYIELD();
+		}
+	}
+
+	latency_print("publish", latencies, LATENCY_SAMPLES);
+	TEST_ASSERT(latencies[LATENCY_SAMPLES / 2] < LATENCY_P50_NS_MAX);
+	TEST_ASSERT(latencies[LATENCY_SAMPLES * 99 / 100] < LATENCY_P99_NS_MAX);
+
+	for (uint32_t n = 0; n < LATENCY_SAMPLES; n++) {
+		int64_t start = time_ns();
+
+		TEST_ASSERT_EQUAL(ESP_OK, sample_bus_read_latest(&channel, &sample));
+		latencies[n] = time_ns() - start;
+	}
+
+	latency_print("read_latest", latencies, LATENCY_SAMPLES);
+	TEST_ASSERT(latencies[LATENCY_SAMPLES / 2] < LATENCY_P50_NS_MAX);
+	TEST_ASSERT(latencies[LATENCY_SAMPLES * 99 / 100] < LATENCY_P99_NS_MAX);
+
+	atomic_store(&producer_done, true);
+
+	for (uint32_t i = 0; i < STRESS_READERS; i++) {
+		TEST_ASSERT(xSemaphoreTake(finished, pdMS_TO_TICKS(60000)));
+		TEST_ASSERT_EQUAL(0, readers[i].torn);
+	}
+}
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,267 @@
+/**
+  ******************************************************************************
+  * @file           : sample_store.h
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Compressed circular store of samples in flash
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef SAMPLE_STORE_H_
+#define SAMPLE_STORE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+#include "esp_err.h"
+#include "esp_partition.h"
+#include "sdkconfig.h"
+#include "sample_bus.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+/* Exported macro ------------------------------------------------------------*/
+#define SAMPLE_STORE_BLOCK_SIZE		CONFIG_SAMPLE_STORE_BLOCK_SIZE
+#define SAMPLE_STORE_MAX_CHANNELS	CONFIG_SAMPLE_STORE_MAX_CHANNELS
+
+/* Exported typedef ----------------------------------------------------------*/
+/* Block header, followed in flash by len bytes of encoded samples */
+typedef struct {
+	uint16_t magic;
+	uint8_t channel;
+	uint8_t reserved;
+	uint16_t count;				/* Samples in the block */
+	uint16_t len;				/* Encoded bytes */
+	uint32_t timestamp_first;	/* Sample times in ms */
+	uint32_t timestamp_last;
+	float resolution;			/* Value quantization step */
+	uint32_t crc;				/* CRC32 of the header fields above and the data */
+} sample_store_block_t;
+
+/* Encoder or decoder state of a block */
+typedef struct {
+	uint32_t bits;				/* Bit position in the data */
+	uint32_t timestamp;			/* Previous sample time in ms */
+	int32_t delta;				/* Previous time delta in ms */
+	int32_t value;				/* Previous quantized value */
+	uint16_t id;
+	uint8_t accuracy;
+} sample_store_codec_t;
+
+/* Block being filled in RAM, the header and data are written at once */
+typedef struct {
+	sample_store_block_t header;
+	uint8_t data[SAMPLE_STORE_BLOCK_SIZE];
+	sample_store_codec_t codec;
+	float scale;				/* Inverse of the resolution */
+} sample_store_buffer_t;
+
+typedef struct {
+	const esp_partition_t *partition;
+	uint32_t sectors;
+	uint32_t sector;			/* Sector being written */
+	uint32_t sector_seq;		/* Its sequence number, increased on every new sector */
+	uint32_t offset;			/* Write offset in the sector */
+	uint8_t channels_num;
+	sample_store_buffer_t buffers[SAMPLE_STORE_MAX_CHANNELS];
+	SemaphoreHandle_t mutex;
+	StaticSemaphore_t mutex_buffer;
+
+	/* Statistics */
+	uint32_t samples;			/* Samples written to flash */
+	uint32_t bytes;				/* Flash bytes they take, headers included */
+} sample_store_t;
+
+/* Position of a block in the store, zero for the oldest one */
+typedef struct {
+	uint32_t sector_seq;
+	uint32_t offset;
+} sample_store_cursor_t;
+
+/* Position of an iteration over the samples of a channel */
+typedef struct {
+	sample_store_t *store;
+	uint8_t channel;
+	uint32_t from;				/* Time range in ms, inclusive */
+	uint32_t to;
+	uint32_t sectors_left;		/* Sectors not iterated yet, including the current one */
+	uint32_t sector;
+	uint32_t sector_seq;		/* Sequence number of the last sector iterated, 0 if none */
+	uint32_t offset;			/* Offset of the next block in the sector, 0 before its header */
+	uint16_t left;				/* Samples left in the current block */
+	sample_store_block_t header;
+	uint8_t data[SAMPLE_STORE_BLOCK_SIZE];
+	sample_store_codec_t codec;
+} sample_store_iter_t;
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions prototypes ---------------------------------------------*/
+/**
+  * @brief Function to mount the sample store on its partition
+  *
+  * @note The write position is recovered from the sector headers, a sector
+  *       with a torn block is closed
+  *
+  * @param me           : Pointer to a sample_store_t structure
+  * @param resolutions  : Value quantization step of each channel, values are
+  *                       stored as multiples of it
+  * @param channels_num : Number of channels, SAMPLE_STORE_MAX_CHANNELS at most
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_INVALID_ARG if there are too many channels or a resolution
+  * 	  isn't positive
+  * 	- ESP_ERR_NOT_FOUND if there is no CONFIG_SAMPLE_STORE_PARTITION_LABEL
+  * 	  partition
+  * 	- ESP_ERR_INVALID_SIZE if the partition has less than 2 sectors
+  * 	- Others from esp_partition_read() and esp_partition_erase_range()
+  */
+esp_err_t sample_store_init(sample_store_t * const me, const float *resolutions, uint8_t channels_num);
+
+/**
+  * @brief Function to mount the sample store keeping the samples in the
+  *        block buffers
+  *
+  * @note For an instance in RTC memory after a deep sleep wake up, the
+  *       buffers that don't match their channel are reset
+  *
+  * @param me           : Pointer to a sample_store_t structure
+  * @param resolutions  : Value quantization step of each channel
+  * @param channels_num : Number of channels, SAMPLE_STORE_MAX_CHANNELS at most
+  *
+  * @retval Same as sample_store_init()
+  */
+esp_err_t sample_store_resume(sample_store_t * const me, const float *resolutions, uint8_t channels_num);
+
+/**
+  * @brief Function to append samples to a channel
+  *
+  * @note The samples are encoded in the channel block buffer, which is
+  *       written to flash when full
+  *
+  * @param me      : Pointer to a sample_store_t structure
+  * @param channel : Channel number
+  * @param samples : Samples to append, in time order
+  * @param count   : Number of samples
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_INVALID_ARG if the channel doesn't exist
+  * 	- Others from esp_partition_write() and esp_partition_erase_range()
+  */
+esp_err_t sample_store_append(sample_store_t * const me, uint8_t channel, const sample_t *samples, size_t count);
+
+/**
+  * @brief Function to write the block buffers to flash, even if not full
+  *
+  * @note Every flushed block takes a header, flush before a reset or sleep
+  *       rather than periodically
+  *
+  * @param me : Pointer to a sample_store_t structure
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- Others from esp_partition_write() and esp_partition_erase_range()
+  */
+esp_err_t sample_store_flush(sample_store_t * const me);
+
+/**
+  * @brief Function to start an iteration over the samples of a channel, from
+  *        the oldest to the newest
+  *
+  * @note Only the samples in flash are visible, the ones still in the block
+  *       buffer need a sample_store_flush() first
+  *
+  * @param me      : Pointer to a sample_store_t structure
+  * @param iter    : Pointer to a sample_store_iter_t structure
+  * @param channel : Channel number
+  * @param from    : Start of the time range in ms, inclusive
+  * @param to      : End of the time range in ms, inclusive
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_INVALID_ARG if the channel doesn't exist
+  */
+esp_err_t sample_store_iter_init(sample_store_t * const me, sample_store_iter_t *iter, uint8_t channel, uint32_t from, uint32_t to);
+
+/**
+  * @brief Function to get the next sample of an iteration
+  *
+  * @note Sectors erased while iterating are skipped
+  *
+  * @param iter   : Pointer to a sample_store_iter_t structure
+  * @param sample : Pointer to store the sample, with the time in ms
+  *                 converted back to us and the quantized value
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_NOT_FOUND at the end of the iteration
+  * 	- Others from esp_partition_read()
+  */
+esp_err_t sample_store_iter_next(sample_store_iter_t *iter, sample_t *sample);
+
+/**
+  * @brief Function to copy the encoded blocks written after a position, of
+  *        every channel, to forward them as they are
+  *
+  * @note Each block is a sample_store_block_t header followed by its len
+  *       bytes, without padding. Blocks with a wrong CRC are skipped and a
+  *       position already overwritten continues from the oldest block
+  *
+  * @param me   : Pointer to a sample_store_t structure
+  * @param from : Position of the first block
+  * @param next : Pointer to store the position after the last block copied
+  * @param buf  : Pointer to store the blocks
+  * @param size : Size of buf, the blocks that don't fit are left for the
+  *               next call
+  * @param len  : Pointer to store the number of bytes copied, 0 if there are
+  *               no more blocks
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_INVALID_SIZE if buf can't hold a full block
+  * 	- Others from esp_partition_read()
+  */
+esp_err_t sample_store_read_blocks(sample_store_t * const me, const sample_store_cursor_t *from, sample_store_cursor_t *next,
+		uint8_t *buf, size_t size, size_t *len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SAMPLE_STORE_H_ */
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,766 @@
+/**
+  ******************************************************************************
+  * @file           : sample_store.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Compressed circular store of samples in flash
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <inttypes.h>
+#include <math.h>
+
+#include "sample_store.h"
+#include "esp_log.h"
+#include "esp_rom_crc.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define SECTOR_SIZE			4096
+#define SECTOR_MAGIC		0x52545353		/* "SSTR" */
+#define BLOCK_MAGIC			0x4253			/* "SB" */
+#define ALIGN4(x)			(((x) + 3) & ~3UL)
+
+/* Longest sample encoding: 36 bits of time, 36 bits of value and 25 of id */
+#define SAMPLE_MAX_BITS		97
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+	uint32_t magic;
+	uint32_t seq;
+} sector_header_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const char *TAG = "sample_store";
+
+/* Payload widths of the variable length codes, after a prefix of 1 to 3 ones
+ * and a zero, 4 ones are followed by 32 bits and a single zero means 0 */
+static const uint8_t timestamp_widths[] = {4, 8, 12};
+static const uint8_t value_widths[] = {6, 12, 20};
+
+_Static_assert(offsetof(sample_store_buffer_t, data) == sizeof(sample_store_block_t), "Block header and data must be contiguous");
+_Static_assert(offsetof(sample_store_iter_t, data) - offsetof(sample_store_iter_t, header) == sizeof(sample_store_block_t), "Block header and data must be contiguous");
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t zigzag(int32_t value);
+static int32_t unzigzag(uint32_t value);
+static bool put_bits(sample_store_buffer_t *buf, uint32_t value, uint8_t n);
+static bool put_code(sample_store_buffer_t *buf, uint32_t value, const uint8_t *widths);
+static uint32_t get_bits(const uint8_t *data, uint32_t len, uint32_t *bits, uint8_t n);
+static uint32_t get_code(const uint8_t *data, uint32_t len, uint32_t *bits, const uint8_t *widths);
+static bool sample_encode(sample_store_buffer_t *buf, const sample_t *sample);
+static void sample_decode(sample_store_iter_t *iter, sample_t *sample);
+static void buffer_reset(sample_store_buffer_t *buf);
+static uint32_t block_crc(const sample_store_block_t *header, const uint8_t *data);
+static esp_err_t block_check(sample_store_t * const me, uint32_t addr, const sample_store_block_t *header, bool *valid);
+static esp_err_t block_write(sample_store_t * const me, sample_store_buffer_t *buf);
+static esp_err_t sector_open_next(sample_store_t * const me);
+static esp_err_t sector_find_end(sample_store_t * const me);
+static esp_err_t store_mount(sample_store_t * const me, const float *resolutions, uint8_t channels_num, bool keep);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief Function to mount the sample store on its partition
+  */
+esp_err_t sample_store_init(sample_store_t * const me, const float *resolutions, uint8_t channels_num) {
+	ESP_LOGI(TAG, "Initializing sample store instance...");
+
+	return store_mount(me, resolutions, channels_num, false);
+}
+
+/**
+  * @brief Function to mount the sample store keeping the samples in the
+  *        block buffers
+  */
+esp_err_t sample_store_resume(sample_store_t * const me, const float *resolutions, uint8_t channels_num) {
+	ESP_LOGI(TAG, "Resuming sample store instance...");
+
+	return store_mount(me, resolutions, channels_num, true);
+}
+
+/**
+  * @brief Function to append samples to a channel
+  */
+esp_err_t sample_store_append(sample_store_t * const me, uint8_t channel, const sample_t *samples, size_t count) {
+	if (channel >= me->channels_num) {
+		return ESP_ERR_INVALID_ARG;
+	}
+
+	sample_store_buffer_t *buf = &me->buffers[channel];
+	esp_err_t ret = ESP_OK;
+
+	xSemaphoreTake(me->mutex, portMAX_DELAY);
+
+	for (size_t i = 0; i < count; i++) {
+		if (sample_encode(buf, &samples[i])) {
+			continue;
+		}
+
+		/* Full, an empty block always fits a sample */
+		ret = block_write(me, buf);
+
+		if (ret != ESP_OK) {
+			break;
+		}
+
+		sample_encode(buf, &samples[i]);
+	}
+
+	xSemaphoreGive(me->mutex);
+
+	return ret;
+}
+
+/**
+  * @brief Function to write the block buffers to flash, even if not full
+  */
+esp_err_t sample_store_flush(sample_store_t * const me) {
+	esp_err_t ret = ESP_OK;
+
+	xSemaphoreTake(me->mutex, portMAX_DELAY);
+
+	for (uint8_t i = 0; i < me->channels_num && ret == ESP_OK; i++) {
+		ret = block_write(me, &me->buffers[i]);
+	}
+
+	xSemaphoreGive(me->mutex);
+
+	return ret;
+}
+
+/**
+  * @brief Function to start an iteration over the samples of a channel, from
+  *        the oldest to the newest
+  */
+esp_err_t sample_store_iter_init(sample_store_t * const me, sample_store_iter_t *iter, uint8_t channel, uint32_t from, uint32_t to) {
+	if (channel >= me->channels_num) {
+		return ESP_ERR_INVALID_ARG;
+	}
+
+	iter->store = me;
+	iter->channel = channel;
+	iter->from = from;
+	iter->to = to;
+	iter->left = 0;
+	iter->offset = 0;
+	iter->sector_seq = 0;
+
+	/* The oldest sector follows the one being written */
+	xSemaphoreTake(me->mutex, portMAX_DELAY);
+	iter->sector = (me->sector + 1) % me->sectors;
+	iter->sectors_left = me->sectors;
+	xSemaphoreGive(me->mutex);
+
+	return ESP_OK;
+}
+
+/**
+  * @brief Function to get the next sample of an iteration
+  */
+esp_err_t sample_store_iter_next(sample_store_iter_t *iter, sample_t *sample) {
+	sample_store_t *me = iter->store;
+	esp_err_t ret = ESP_OK;
+
+	xSemaphoreTake(me->mutex, portMAX_DELAY);
+
+	for (;;) {
+		/* Samples of the current block */
+		if (iter->left) {
+			sample_decode(iter, sample);
+			iter->left--;
+
+			uint32_t timestamp = iter->codec.timestamp;
+
+			if (timestamp >= iter->from && timestamp <= iter->to) {
+				break;
+			}
+
+			continue;
+		}
+
+		if (iter->sectors_left == 0) {
+			ret = ESP_ERR_NOT_FOUND;
+			break;
+		}
+
+		/* Check the sector wasn't erased since the last block */
+		sector_header_t sector;
+		ret = esp_partition_read(me->partition, iter->sector * SECTOR_SIZE, &sector, sizeof(sector));
+
+		if (ret != ESP_OK) {
+			break;
+		}
+
+		bool valid = sector.magic == SECTOR_MAGIC;
+
+		if (iter->offset == 0) {
+			valid = valid && (iter->sector_seq == 0 || (int32_t)(sector.seq - iter->sector_seq) > 0);
+			iter->offset = sizeof(sector_header_t);
+		}
+		else {
+			valid = valid && sector.seq == iter->sector_seq;
+		}
+
+		sample_store_block_t *header = &iter->header;
+
+		if (valid && iter->offset + sizeof(*header) <= SECTOR_SIZE) {
+			iter->sector_seq = sector.seq;
+			ret = esp_partition_read(me->partition, iter->sector * SECTOR_SIZE + iter->offset, header, sizeof(*header));
+
+			if (ret != ESP_OK) {
+				break;
+			}
+
+			uint32_t size = sizeof(*header) + header->len;
+			valid = header->magic == BLOCK_MAGIC && header->len <= SAMPLE_STORE_BLOCK_SIZE &&
+					iter->offset + size <= SECTOR_SIZE;
+		}
+		else {
+			valid = false;
+		}
+
+		/* End of the sector, erased space or a torn block */
+		if (!valid) {
+			iter->sector = (iter->sector + 1) % me->sectors;
+			iter->sectors_left--;
+			iter->offset = 0;
+			continue;
+		}
+
+		uint32_t addr = iter->sector * SECTOR_SIZE + iter->offset + sizeof(*header);
+		iter->offset += ALIGN4(sizeof(*header) + header->len);
+
+		if (header->channel != iter->channel || header->timestamp_last < iter->from || header->timestamp_first > iter->to) {
+			continue;
+		}
+
+		ret = esp_partition_read(me->partition, addr, iter->data, header->len);
+
+		if (ret != ESP_OK) {
+			break;
+		}
+
+		if (block_crc(header, iter->data) != header->crc) {
+			ESP_LOGW(TAG, "Block CRC mismatch in sector %" PRIu32, iter->sector);
+			continue;
+		}
+
+		memset(&iter->codec, 0, sizeof(iter->codec));
+		iter->codec.timestamp = header->timestamp_first;
+		iter->left = header->count;
+	}
+
+	xSemaphoreGive(me->mutex);
+
+	return ret;
+}
+
+/**
+  * @brief Function to copy the encoded blocks written after a position, of
+  *        every channel, to forward them as they are
+  */
+esp_err_t sample_store_read_blocks(sample_store_t * const me, const sample_store_cursor_t *from, sample_store_cursor_t *next,
+		uint8_t *buf, size_t size, size_t *len) {
+	if (size < sizeof(sample_store_block_t) + SAMPLE_STORE_BLOCK_SIZE) {
+		return ESP_ERR_INVALID_SIZE;
+	}
+
+	esp_err_t ret = ESP_OK;
+
+	*len = 0;
+
+	xSemaphoreTake(me->mutex, portMAX_DELAY);
+
+	/* Sectors have consecutive sequence numbers, the oldest one can be found
+	 * from the sector being written */
+	uint32_t seq = from->sector_seq;
+	uint32_t offset = from->offset;
+	uint32_t oldest = me->sector_seq - (me->sectors - 1);
+
+	if (offset < sizeof(sector_header_t) || (int32_t)(seq - oldest) < 0 || (int32_t)(seq - me->sector_seq) > 1) {
+		seq = oldest;
+		offset = sizeof(sector_header_t);
+	}
+
+	for (; (int32_t)(me->sector_seq - seq) >= 0; seq++, offset = sizeof(sector_header_t)) {
+		uint32_t sector = (me->sector + me->sectors - (me->sector_seq - seq)) % me->sectors;
+		uint32_t addr = sector * SECTOR_SIZE;
+		sector_header_t header;
+
+		ret = esp_partition_read(me->partition, addr, &header, sizeof(header));
+
+		if (ret != ESP_OK) {
+			goto end;
+		}
+
+		/* Not written since the store was mounted */
+		if (header.magic != SECTOR_MAGIC || header.seq != seq) {
+			continue;
+		}
+
+		while (offset + sizeof(sample_store_block_t) <= SECTOR_SIZE) {
+			if (seq == me->sector_seq && offset >= me->offset) {
+				goto end;
+			}
+
+			sample_store_block_t block;
+
+			if (*len + sizeof(block) + SAMPLE_STORE_BLOCK_SIZE > size) {
+				goto end;
+			}
+
+			ret = esp_partition_read(me->partition, addr + offset, &block, sizeof(block));
+
+			if (ret != ESP_OK) {
+				goto end;
+			}
+
+			uint32_t block_size = sizeof(block) + block.len;
+
+			if (block.magic != BLOCK_MAGIC || block.len > SAMPLE_STORE_BLOCK_SIZE || offset + block_size > SECTOR_SIZE) {
+				break;
+			}
+
+			/* The blocks aren't aligned in buf, the header is copied */
+			uint8_t *data = &buf[*len + sizeof(block)];
+			ret = esp_partition_read(me->partition, addr + offset + sizeof(block), data, block.len);
+
+			if (ret != ESP_OK) {
+				goto end;
+			}
+
+			offset += ALIGN4(block_size);
+
+			if (block_crc(&block, data) == block.crc) {
+				memcpy(&buf[*len], &block, sizeof(block));
+				*len += block_size;
+			}
+		}
+	}
+
+end:
+	next->sector_seq = seq;
+	next->offset = offset;
+
+	xSemaphoreGive(me->mutex);
+
+	return ret;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static esp_err_t store_mount(sample_store_t * const me, const float *resolutions, uint8_t channels_num, bool keep) {
+	if (channels_num > SAMPLE_STORE_MAX_CHANNELS) {
+		ESP_LOGE(TAG, "Too many channels");
+		return ESP_ERR_INVALID_ARG;
+	}
+
+	for (uint8_t i = 0; i < channels_num; i++) {
+		sample_store_buffer_t *buf = &me->buffers[i];
+
+		if (!(resolutions[i] > 0.0f)) {
+			ESP_LOGE(TAG, "Invalid resolution of channel %d", i);
+			return ESP_ERR_INVALID_ARG;
+		}
+
+		/* A buffer kept in RTC memory goes on, unless it doesn't match the
+		 * channel */
+		if (!keep || buf->header.channel != i || buf->header.resolution != resolutions[i] ||
+				buf->codec.bits > SAMPLE_STORE_BLOCK_SIZE * 8 || buf->header.count > buf->codec.bits) {
+			buffer_reset(buf);
+			buf->header.channel = i;
+			buf->header.resolution = resolutions[i];
+		}
+
+		buf->scale = 1.0f / resolutions[i];
+	}
+
+	me->channels_num = channels_num;
+	me->samples = 0;
+	me->bytes = 0;
+
+	me->partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+			CONFIG_SAMPLE_STORE_PARTITION_LABEL);
+
+	if (me->partition == NULL) {
+		ESP_LOGE(TAG, "Partition %s not found", CONFIG_SAMPLE_STORE_PARTITION_LABEL);
+		return ESP_ERR_NOT_FOUND;
+	}
+
+	me->sectors = me->partition->size / SECTOR_SIZE;
+
+	if (me->sectors < 2) {
+		ESP_LOGE(TAG, "Partition too small");
+		return ESP_ERR_INVALID_SIZE;
+	}
+
+	/* The sector written last has the highest sequence number */
+	bool found = false;
+
+	for (uint32_t i = 0; i < me->sectors; i++) {
+		sector_header_t header;
+		esp_err_t ret = esp_partition_read(me->partition, i * SECTOR_SIZE, &header, sizeof(header));
+
+		if (ret != ESP_OK) {
+			return ret;
+		}
+
+		if (header.magic == SECTOR_MAGIC && (!found || (int32_t)(header.seq - me->sector_seq) > 0)) {
+			me->sector = i;
+			me->sector_seq = header.seq;
+			found = true;
+		}
+	}
+
+	esp_err_t ret;
+
+	if (found) {
+		ret = sector_find_end(me);
+	}
+	else {
+		ESP_LOGW(TAG, "Empty partition");
+		me->sector = me->sectors - 1;
+		me->sector_seq = 0;
+		ret = sector_open_next(me);
+	}
+
+	if (ret != ESP_OK) {
+		return ret;
+	}
+
+	me->mutex = xSemaphoreCreateMutexStatic(&me->mutex_buffer);
+
+	ESP_LOGI(TAG, "Writing sector %" PRIu32 " of %" PRIu32 " at offset %" PRIu32, me->sector, me->sectors, me->offset);
+
+	return ESP_OK;
+}
+
+static uint32_t zigzag(int32_t value) {
+	return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t unzigzag(uint32_t value) {
+	return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+static bool put_bits(sample_store_buffer_t *buf, uint32_t value, uint8_t n) {
+	uint32_t bits = buf->codec.bits;
+
+	if (bits + n > SAMPLE_STORE_BLOCK_SIZE * 8) {
+		return false;
+	}
+
+	/* Most significant bit first, up to a byte at a time */
+	while (n) {
+		uint8_t free = 8 - (bits & 7);
+		uint8_t take = n < free ? n : free;
+		uint8_t chunk = (value >> (n - take)) & ((1U << take) - 1);
+
+		buf->data[bits >> 3] |= chunk << (free - take);
+		bits += take;
+		n -= take;
+	}
+
+	buf->codec.bits = bits;
+
+	return true;
+}
+
+static bool put_code(sample_store_buffer_t *buf, uint32_t value, const uint8_t *widths) {
+	if (value == 0) {
+		return put_bits(buf, 0, 1);
+	}
+
+	for (uint8_t i = 0; i < 3; i++) {
+		if (value < (1UL << widths[i])) {
+			return put_bits(buf, ((1U << (i + 1)) - 1) << 1, i + 2) && put_bits(buf, value, widths[i]);
+		}
+	}
+
+	return put_bits(buf, 0x0F, 4) && put_bits(buf, value, 32);
+}
+
+static uint32_t get_bits(const uint8_t *data, uint32_t len, uint32_t *bits, uint8_t n) {
+	uint32_t value = 0;
+
+	while (n) {
+		/* Past the end reads zeros, only a corrupted block gets there */
+		uint8_t byte = (*bits >> 3) < len ? data[*bits >> 3] : 0;
+		uint8_t free = 8 - (*bits & 7);
+		uint8_t take = n < free ? n : free;
+
+		value = (value << take) | ((byte >> (free - take)) & ((1U << take) - 1));
+		*bits += take;
+		n -= take;
+	}
+
+	return value;
+}
+
+static uint32_t get_code(const uint8_t *data, uint32_t len, uint32_t *bits, const uint8_t *widths) {
+	if (!get_bits(data, len, bits, 1)) {
+		return 0;
+	}
+
+	for (uint8_t i = 0; i < 3; i++) {
+		if (!get_bits(data, len, bits, 1)) {
+			return get_bits(data, len, bits, widths[i]);
+		}
+	}
+
+	return get_bits(data, len, bits, 32);
+}
+
+static bool sample_encode(sample_store_buffer_t *buf, const sample_t *sample) {
+	sample_store_codec_t *codec = &buf->codec;
+	uint32_t timestamp = (uint32_t)(sample->timestamp / 1000);
+
+	/* Quantize the value, saturated */
+	float scaled = sample->value * buf->scale;
+	int32_t value;
+
+	if (isnan(scaled)) {
+		value = 0;
+	}
+	else if (scaled >= 2147483520.0f) {
+		value = INT32_MAX;
+	}
+	else if (scaled <= -2147483648.0f) {
+		value = INT32_MIN;
+	}
+	else {
+		value = (int32_t)lrintf(scaled);
+	}
+
+	if (buf->header.count == 0) {
+		codec->timestamp = timestamp;
+		buf->header.timestamp_first = timestamp;
+	}
+
+	uint32_t start = codec->bits;
+	int32_t delta = (int32_t)(timestamp - codec->timestamp);
+	bool tag = sample->id != codec->id || sample->accuracy != codec->accuracy;
+
+	bool fits = put_code(buf, zigzag(delta - codec->delta), timestamp_widths) &&
+			put_code(buf, zigzag((int32_t)((uint32_t)value - (uint32_t)codec->value)), value_widths) &&
+			put_bits(buf, tag, 1) &&
+			(!tag || (put_bits(buf, sample->id, 16) && put_bits(buf, sample->accuracy, 8)));
+
+	if (!fits) {
+		/* Clear the partial encoding, the block stays as it was */
+		uint32_t end = (codec->bits + 7) >> 3;
+
+		buf->data[start >> 3] &= (uint8_t)(0xFF00 >> (start & 7));
+		memset(&buf->data[(start >> 3) + 1], 0, end > (start >> 3) + 1 ? end - (start >> 3) - 1 : 0);
+		codec->bits = start;
+
+		return false;
+	}
+
+	codec->timestamp = timestamp;
+	codec->delta = delta;
+	codec->value = value;
+	codec->id = sample->id;
+	codec->accuracy = sample->accuracy;
+
+	buf->header.timestamp_last = timestamp;
+	buf->header.count++;
+
+	return true;
+}
+
+static void sample_decode(sample_store_iter_t *iter, sample_t *sample) {
+	sample_store_codec_t *codec = &iter->codec;
+	uint32_t len = iter->header.len;
+
+	codec->delta += unzigzag(get_code(iter->data, len, &codec->bits, timestamp_widths));
+	codec->timestamp += codec->delta;
+	codec->value = (int32_t)((uint32_t)codec->value + (uint32_t)unzigzag(get_code(iter->data, len, &codec->bits, value_widths)));
+
+	if (get_bits(iter->data, len, &codec->bits, 1)) {
+		codec->id = get_bits(iter->data, len, &codec->bits, 16);
+		codec->accuracy = get_bits(iter->data, len, &codec->bits, 8);
+	}
+
+	sample->timestamp = (int64_t)codec->timestamp * 1000;
+	sample->value = (float)codec->value * iter->header.resolution;
+	sample->id = codec->id;
+	sample->accuracy = codec->accuracy;
+}
+
+static void buffer_reset(sample_store_buffer_t *buf) {
+	memset(buf->data, 0, sizeof(buf->data));
+	memset(&buf->codec, 0, sizeof(buf->codec));
+	buf->header.count = 0;
+}
+
+static uint32_t block_crc(const sample_store_block_t *header, const uint8_t *data) {
+	uint32_t crc = esp_rom_crc32_le(0, (const uint8_t *)header, offsetof(sample_store_block_t, crc));
+
+	return esp_rom_crc32_le(crc, data, header->len);
+}
+
+static esp_err_t block_check(sample_store_t * const me, uint32_t addr, const sample_store_block_t *header, bool *valid) {
+	/* In chunks, the block buffers may hold samples kept across deep sleep */
+	uint8_t chunk[64];
+	uint32_t crc = esp_rom_crc32_le(0, (const uint8_t *)header, offsetof(sample_store_block_t, crc));
+
+	for (uint32_t i = 0; i < header->len; i += sizeof(chunk)) {
+		uint32_t len = header->len - i < sizeof(chunk) ? header->len - i : sizeof(chunk);
+		esp_err_t ret = esp_partition_read(me->partition, addr + sizeof(*header) + i, chunk, len);
+
+		if (ret != ESP_OK) {
+			return ret;
+		}
+
+		crc = esp_rom_crc32_le(crc, chunk, len);
+	}
+
+	*valid = crc == header->crc;
+
+	return ESP_OK;
+}
+
+static esp_err_t block_write(sample_store_t * const me, sample_store_buffer_t *buf) {
+	sample_store_block_t *header = &buf->header;
+
+	if (header->count == 0) {
+		return ESP_OK;
+	}
+
+	header->magic = BLOCK_MAGIC;
+	header->reserved = 0xFF;
+	header->len = (buf->codec.bits + 7) >> 3;
+	header->crc = block_crc(header, buf->data);
+
+	uint32_t size = sizeof(*header) + header->len;
+
+	if (me->offset + size > SECTOR_SIZE) {
+		esp_err_t ret = sector_open_next(me);
+
+		if (ret != ESP_OK) {
+			return ret;
+		}
+	}
+
+	/* Header and data in a single write, a torn one fails the CRC */
+	esp_err_t ret = esp_partition_write(me->partition, me->sector * SECTOR_SIZE + me->offset, header, size);
+
+	if (ret != ESP_OK) {
+		/* The space may be partly programmed, the block is kept to retry in
+		 * a new sector */
+		sector_open_next(me);
+		return ret;
+	}
+
+	me->offset += ALIGN4(size);
+	me->samples += header->count;
+	me->bytes += ALIGN4(size);
+
+	buffer_reset(buf);
+
+	return ESP_OK;
+}
+
+static esp_err_t sector_open_next(sample_store_t * const me) {
+	uint32_t sector = (me->sector + 1) % me->sectors;
+
+	/* Drops the oldest samples once the partition is full */
+	esp_err_t ret = esp_partition_erase_range(me->partition, sector * SECTOR_SIZE, SECTOR_SIZE);
+
+	if (ret != ESP_OK) {
+		return ret;
+	}
+
+	sector_header_t header = {
+			.magic = SECTOR_MAGIC,
+			.seq = me->sector_seq + 1,
+	};
+
+	ret = esp_partition_write(me->partition, sector * SECTOR_SIZE, &header, sizeof(header));
+
+	if (ret != ESP_OK) {
+		return ret;
+	}
+
+	me->sector = sector;
+	me->sector_seq = header.seq;
+	me->offset = sizeof(header);
+
+	return ESP_OK;
+}
+
+static esp_err_t sector_find_end(sample_store_t * const me) {
+	sample_store_block_t header;
+	bool valid;
+	esp_err_t ret;
+
+	me->offset = sizeof(sector_header_t);
+
+	while (me->offset + sizeof(header) <= SECTOR_SIZE) {
+		uint32_t addr = me->sector * SECTOR_SIZE + me->offset;
+		ret = esp_partition_read(me->partition, addr, &header, sizeof(header));
+
+		if (ret != ESP_OK) {
+			return ret;
+		}
+
+		if (header.magic == 0xFFFF) {
+			return ESP_OK;
+		}
+
+		uint32_t size = sizeof(header) + header.len;
+
+		if (header.magic != BLOCK_MAGIC || header.len > SAMPLE_STORE_BLOCK_SIZE || me->offset + size > SECTOR_SIZE) {
+			break;
+		}
+
+		ret = block_check(me, addr, &header, &valid);
+
+		if (ret != ESP_OK) {
+			return ret;
+		}
+
+		if (!valid) {
+			break;
+		}
+
+		me->offset += ALIGN4(size);
+	}
+
+	/* Full, or a torn block whose length can't be trusted to write after it */
+	if (me->offset + sizeof(header) <= SECTOR_SIZE) {
+		ESP_LOGW(TAG, "Torn block in sector %" PRIu32 ", closing it", me->sector);
+	}
+
+	return sector_open_next(me);
+}
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,559 @@
+/**
+  ******************************************************************************
+  * @file           : test_sample_store.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Host test of the sample store on a file-backed flash emulator
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+#include "host_test.h"
+#include "esp_rom_crc.h"
+#include "sample_store.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define SECTOR_SIZE				4096
+#define PARTITION_SECTORS		16
+#define PARTITION_PATH			"test_sample_store.bin"
+#define CHANNELS_NUM			8
+#define SAMPLES_NUM				3000
+#define BATCH_SIZE				10
+#define START_US				12345678LL	/* Time of the first sample */
+#define PERIOD_US				1000000LL
+#define COMPRESSION_MIN			5			/* Against the sample_t taken */
+#define THROUGHPUT_PER_S		100000		/* Samples per CPU second */
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static const float resolutions[CHANNELS_NUM] = {0.01f, 0.01f, 1.0f, 0.01f, 1.0f, 1.0f, 0.001f, 0.01f};
+static const esp_partition_t *partition;
+static sample_store_t store;
+
+/* Samples appended to every channel, in order */
+static sample_t truth[CHANNELS_NUM][SAMPLES_NUM];
+static uint32_t truth_num;
+
+/* Private function prototypes -----------------------------------------------*/
+static float signal_value(uint8_t channel, uint32_t n);
+static void samples_append(sample_store_t *me, uint32_t n);
+static uint32_t samples_check(sample_store_t *me, uint8_t channel, uint32_t from, uint32_t to, const sample_t *expected);
+static void setup(uint8_t fill);
+static void test_blank(void);
+static void test_round_trip(void);
+static void test_range(void);
+static void test_remount(void);
+static void test_torn_write(void);
+static void test_wraparound(void);
+static void test_read_blocks(void);
+static void test_resume(void);
+static void test_invalid(void);
+static void test_throughput(void);
+
+/* Main ----------------------------------------------------------------------*/
+int main(void) {
+	partition = host_partition_add(CONFIG_SAMPLE_STORE_PARTITION_LABEL, PARTITION_SECTORS * SECTOR_SIZE, PARTITION_PATH);
+	TEST_ASSERT(partition != NULL);
+
+	RUN_TEST(test_blank);
+	RUN_TEST(test_round_trip);
+	RUN_TEST(test_range);
+	RUN_TEST(test_remount);
+	RUN_TEST(test_torn_write);
+	RUN_TEST(test_wraparound);
+	RUN_TEST(test_read_blocks);
+	RUN_TEST(test_resume);
+	RUN_TEST(test_invalid);
+	RUN_TEST(test_throughput);
+
+	return 0;
+}
+
+/* Private functions ---------------------------------------------------------*/
+/* Slow signals with noise, as the sensors give */
+static float signal_value(uint8_t channel, uint32_t n) {
+	float noise = (float)rand() / RAND_MAX - 0.5f;
+
+	switch (channel) {
+		case 0:
+			return 23.5f + 2.0f * sinf(n / 3600.0f) + 0.02f * noise;
+		case 1:
+			return 45.0f + 5.0f * sinf(n / 5000.0f) + 0.1f * noise;
+		case 2:
+			return 101325.0f + 50.0f * sinf(n / 7200.0f) + 3.0f * noise;
+		case 4:
+			return 500.0f + 100.0f * sinf(n / 1800.0f) + 2.0f * noise;
+		default:
+			return channel * 1.3f * (1.0f + 0.3f * sinf(n / 600.0f)) * (1.0f + 0.01f * noise);
+	}
+}
+
+/* Appends n samples to every channel, 1 s apart with some jitter, in batches */
+static void samples_append(sample_store_t *me, uint32_t n) {
+	TEST_ASSERT(truth_num + n <= SAMPLES_NUM);
+
+	for (uint32_t i = 0; i < n; i += BATCH_SIZE) {
+		for (uint8_t channel = 0; channel < CHANNELS_NUM; channel++) {
+			sample_t *batch = &truth[channel][truth_num + i];
+
+			for (uint32_t j = 0; j < BATCH_SIZE; j++) {
+				uint32_t k = truth_num + i + j;
+
+				batch[j] = (sample_t) {
+						.timestamp = START_US + k * PERIOD_US + (rand() % 20) * 1000,
+						.value = signal_value(channel, k),
+						.id = channel,
+						.accuracy = channel < 4 ? 0 : (k < 1000 ? 1 : 3),
+				};
+			}
+
+			TEST_ASSERT_EQUAL(ESP_OK, sample_store_append(me, channel, batch, BATCH_SIZE));
+		}
+	}
+
+	truth_num += n;
+}
+
+/* Iterates a channel checking the samples against the expected ones, if any,
+ * and returns how many there are */
+static uint32_t samples_check(sample_store_t *me, uint8_t channel, uint32_t from, uint32_t to, const sample_t *expected) {
+	sample_store_iter_t iter;
+	sample_t sample;
+	uint32_t n = 0;
+	int64_t previous = -1;
+	esp_err_t ret;
+
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_iter_init(me, &iter, channel, from, to));
+
+	while ((ret = sample_store_iter_next(&iter, &sample)) == ESP_OK) {
+		TEST_ASSERT(sample.timestamp > previous);
+		TEST_ASSERT(sample.timestamp >= (int64_t)from * 1000 && sample.timestamp <= (int64_t)to * 1000);
+		previous = sample.timestamp;
+
+		if (expected != NULL) {
+			const sample_t *e = &expected[n];
+
+			/* Times in ms, values quantized to the resolution */
+			TEST_ASSERT_EQUAL(e->timestamp / 1000 * 1000, sample.timestamp);
+			TEST_ASSERT(fabsf(sample.value - e->value) <= resolutions[channel] * 0.51f + fabsf(e->value) * 1e-6f);
+			TEST_ASSERT_EQUAL(e->id, sample.id);
+			TEST_ASSERT_EQUAL(e->accuracy, sample.accuracy);
+		}
+
+		n++;
+	}
+
+	TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, ret);
+
+	return n;
+}
+
+static void setup(uint8_t fill) {
+	host_partition_fill(partition, fill);
+	memset(&store, 0, sizeof(store));
+	truth_num = 0;
+	srand(1);
+
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_init(&store, resolutions, CHANNELS_NUM));
+}
+
+/* Erased and never written flash, the store starts on the first sector */
+static void test_blank(void) {
+	static const uint8_t fills[] = {0xFF, 0x00};
+
+	for (uint32_t i = 0; i < sizeof(fills); i++) {
+		setup(fills[i]);
+
+		TEST_ASSERT_EQUAL(0, store.sector);
+		TEST_ASSERT_EQUAL(8, store.offset);
+		TEST_ASSERT_EQUAL(1, host_partition_erases(partition));
+
+		for (uint8_t channel = 0; channel < CHANNELS_NUM; channel++) {
+			TEST_ASSERT_EQUAL(0, samples_check(&store, channel, 0, UINT32_MAX, NULL));
+		}
+
+		sample_store_cursor_t cursor = {0};
+		uint8_t buf[1024];
+		size_t len;
+
+		TEST_ASSERT_EQUAL(ESP_OK, sample_store_read_blocks(&store, &cursor, &cursor, buf, sizeof(buf), &len));
+		TEST_ASSERT_EQUAL(0, len);
+
+		/* Nothing to write without samples */
+		TEST_ASSERT_EQUAL(ESP_OK, sample_store_flush(&store));
+		TEST_ASSERT_EQUAL(8, store.offset);
+	}
+}
+
+static void test_round_trip(void) {
+	setup(0xFF);
+	samples_append(&store, SAMPLES_NUM);
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_flush(&store));
+
+	for (uint8_t channel = 0; channel < CHANNELS_NUM; channel++) {
+		TEST_ASSERT_EQUAL(SAMPLES_NUM, samples_check(&store, channel, 0, UINT32_MAX, truth[channel]));
+	}
+
+	TEST_ASSERT_EQUAL(SAMPLES_NUM * CHANNELS_NUM, store.samples);
+	TEST_ASSERT_EQUAL(0, host_partition_overwrites(partition));
+
+	/* Headers included */
+	float bits = store.bytes * 8.0f / store.samples;
+	float ratio = (float)store.samples * sizeof(sample_t) / store.bytes;
+
+	printf("%.1f bits per sample, %.1fx smaller than the %zu B sample_t\n", bits, ratio, sizeof(sample_t));
+	TEST_ASSERT(store.bytes * COMPRESSION_MIN <= store.samples * sizeof(sample_t));
+}
+
+static void test_range(void) {
+	setup(0xFF);
+	samples_append(&store, SAMPLES_NUM);
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_flush(&store));
+
+	/* The second thousand, the jitter stays within each second */
+	uint32_t from = (START_US + 1000 * PERIOD_US) / 1000;
+	uint32_t to = (START_US + 2000 * PERIOD_US) / 1000 - 1;
+
+	for (uint8_t channel = 0; channel < CHANNELS_NUM; channel++) {
+		TEST_ASSERT_EQUAL(1000, samples_check(&store, channel, from, to, &truth[channel][1000]));
+	}
+
+	/* Before and after every sample */
+	TEST_ASSERT_EQUAL(0, samples_check(&store, 0, 0, START_US / 1000 - 1, NULL));
+	TEST_ASSERT_EQUAL(0, samples_check(&store, 0, (START_US + SAMPLES_NUM * PERIOD_US) / 1000, UINT32_MAX, NULL));
+}
+
+/* A reboot finds the write position and appends after the blocks there */
+static void test_remount(void) {
+	static sample_store_t remounted;
+
+	setup(0xFF);
+	samples_append(&store, SAMPLES_NUM / 2);
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_flush(&store));
+
+	memset(&remounted, 0, sizeof(remounted));
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_init(&remounted, resolutions, CHANNELS_NUM));
+	TEST_ASSERT_EQUAL(store.sector, remounted.sector);
+	TEST_ASSERT_EQUAL(store.sector_seq, remounted.sector_seq);
+	TEST_ASSERT_EQUAL(store.offset, remounted.offset);
+
+	samples_append(&remounted, SAMPLES_NUM / 2);
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_flush(&remounted));
+
+	for (uint8_t channel = 0; channel < CHANNELS_NUM; channel++) {
+		TEST_ASSERT_EQUAL(SAMPLES_NUM, samples_check(&remounted, channel, 0, UINT32_MAX, truth[channel]));
+	}
+
+	TEST_ASSERT_EQUAL(0, host_partition_overwrites(partition));
+}
+
+/* Power lost while writing a block, at several points of it */
+static void test_torn_write(void) {
+	static const size_t cuts[] = {0, 1, 2, 12, 23, 24, 40};
+	static sample_store_t remounted;
+
+	for (uint32_t i = 0; i < sizeof(cuts) / sizeof(cuts[0]); i++) {
+		setup(0xFF);
+		samples_append(&store, 500);
+		TEST_ASSERT_EQUAL(ESP_OK, sample_store_flush(&store));
+
+		/* A block of channel 0 that is only in RAM */
+		for (uint32_t j = 0; j < 50; j++) {
+			sample_t sample = {
+					.timestamp = START_US + (500 + j) * PERIOD_US,
+					.value = 1.0f,
+			};
+
+			TEST_ASSERT_EQUAL(ESP_OK, sample_store_append(&store, 0, &sample, 1));
+		}
+
+		uint32_t sector = store.sector;
+
+		host_partition_power_cut(cuts[i]);
+		TEST_ASSERT(sample_store_flush(&store) != ESP_OK);
+		host_partition_power_on();
+
+		memset(&remounted, 0, sizeof(remounted));
+		TEST_ASSERT_EQUAL(ESP_OK, sample_store_init(&remounted, resolutions, CHANNELS_NUM));
+
+		/* A torn block closes its sector, its length can't be trusted */
+		if (cuts[i]) {
+			TEST_ASSERT(remounted.sector != sector);
+		}
+		else {
+			TEST_ASSERT_EQUAL(sector, remounted.sector);
+		}
+
+		/* The blocks written before are intact and the torn one is skipped */
+		for (uint8_t channel = 0; channel < CHANNELS_NUM; channel++) {
+			TEST_ASSERT_EQUAL(500, samples_check(&remounted, channel, 0, UINT32_MAX, truth[channel]));
+		}
+
+		samples_append(&remounted, 100);
+		TEST_ASSERT_EQUAL(ESP_OK, sample_store_flush(&remounted));
+
+		for (uint8_t channel = 0; channel < CHANNELS_NUM; channel++) {
+			TEST_ASSERT_EQUAL(600, samples_check(&remounted, channel, 0, UINT32_MAX, truth[channel]));
+		}
+
+		TEST_ASSERT_EQUAL(0, host_partition_overwrites(partition));
+	}
+}
+
+/* Once full, the oldest sector is dropped and the newest samples are kept in
+ * order */
+static void test_wraparound(void) {
+	setup(0xFF);
+
+	int64_t timestamp = START_US;
+	uint32_t n = 0;
+
+	while (host_partition_erases(partition) < 3 * PARTITION_SECTORS) {
+		sample_t batch[100];
+
+		for (uint32_t i = 0; i < 100; i++, n++) {
+			batch[i] = (sample_t) {
+					.timestamp = timestamp,
+					.value = signal_value(0, n),
+			};
+
+			timestamp += PERIOD_US;
+		}
+
+		TEST_ASSERT_EQUAL(ESP_OK, sample_store_append(&store, 0, batch, 100));
+	}
+
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_flush(&store));
+	TEST_ASSERT(store.sector_seq > 2 * PARTITION_SECTORS);
+
+	sample_store_iter_t iter;
+	sample_t sample;
+	int64_t first = -1;
+	int64_t last = -1;
+	uint32_t kept = 0;
+
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_iter_init(&store, &iter, 0, 0, UINT32_MAX));
+
+	while (sample_store_iter_next(&iter, &sample) == ESP_OK) {
+		/* Without gaps, the dropped samples are the oldest ones */
+		if (first < 0) {
+			first = sample.timestamp;
+		}
+		else {
+			TEST_ASSERT_EQUAL(last + PERIOD_US, sample.timestamp);
+		}
+
+		last = sample.timestamp;
+		kept++;
+	}
+
+	TEST_ASSERT(first > START_US);
+	TEST_ASSERT_EQUAL((timestamp - PERIOD_US) / 1000 * 1000, last);
+
+	/* All the sectors but the one being written are full */
+	TEST_ASSERT(kept > (uint64_t)(PARTITION_SECTORS - 2) * SECTOR_SIZE * 8 / 24);
+	printf("%" PRIu32 " of %" PRIu32 " samples kept\n", kept, n);
+
+	/* The blocks copied start from the oldest one too */
+	sample_store_cursor_t cursor = {0};
+	uint8_t buf[1024];
+	size_t len;
+
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_read_blocks(&store, &cursor, &cursor, buf, sizeof(buf), &len));
+	TEST_ASSERT(len > sizeof(sample_store_block_t));
+	TEST_ASSERT_EQUAL(first / 1000, ((sample_store_block_t *)buf)->timestamp_first);
+	TEST_ASSERT_EQUAL(0, host_partition_overwrites(partition));
+}
+
+/* Copied by a reader that keeps its cursor, as the uplink does */
+static void test_read_blocks(void) {
+	setup(0xFF);
+	samples_append(&store, 1000);
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_flush(&store));
+
+	sample_store_cursor_t cursor = {0};
+	uint8_t buf[sizeof(sample_store_block_t) + SAMPLE_STORE_BLOCK_SIZE + 100];
+	uint32_t counts[CHANNELS_NUM] = {0};
+	uint32_t calls = 0;
+	size_t len;
+
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, sample_store_read_blocks(&store, &cursor, &cursor, buf, SAMPLE_STORE_BLOCK_SIZE, &len));
+
+	for (;;) {
+		TEST_ASSERT_EQUAL(ESP_OK, sample_store_read_blocks(&store, &cursor, &cursor, buf, sizeof(buf), &len));
+
+		if (len == 0) {
+			break;
+		}
+
+		calls++;
+
+		/* Headers and data back to back, without padding */
+		for (size_t offset = 0; offset < len;) {
+			sample_store_block_t block;
+
+			memcpy(&block, &buf[offset], sizeof(block));
+			TEST_ASSERT_EQUAL(0x4253, block.magic);
+			TEST_ASSERT(block.channel < CHANNELS_NUM);
+			TEST_ASSERT(offset + sizeof(block) + block.len <= len);
+
+			uint32_t crc = esp_rom_crc32_le(0, (const uint8_t *)&block, offsetof(sample_store_block_t, crc));
+			crc = esp_rom_crc32_le(crc, &buf[offset + sizeof(block)], block.len);
+			TEST_ASSERT_EQUAL(block.crc, crc);
+
+			counts[block.channel] += block.count;
+			offset += sizeof(block) + block.len;
+		}
+	}
+
+	TEST_ASSERT(calls > 1);
+
+	for (uint8_t channel = 0; channel < CHANNELS_NUM; channel++) {
+		TEST_ASSERT_EQUAL(1000, counts[channel]);
+	}
+
+	/* Only the block written since */
+	sample_t sample = {.timestamp = START_US + 1000 * PERIOD_US, .value = 1.0f};
+
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_append(&store, 1, &sample, 1));
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_flush(&store));
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_read_blocks(&store, &cursor, &cursor, buf, sizeof(buf), &len));
+	TEST_ASSERT_EQUAL(sizeof(sample_store_block_t) + ((sample_store_block_t *)buf)->len, len);
+	TEST_ASSERT_EQUAL(1, ((sample_store_block_t *)buf)->channel);
+	TEST_ASSERT_EQUAL(1, ((sample_store_block_t *)buf)->count);
+
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_read_blocks(&store, &cursor, &cursor, buf, sizeof(buf), &len));
+	TEST_ASSERT_EQUAL(0, len);
+}
+
+/* The block buffers kept in RTC memory across a deep sleep */
+static void test_resume(void) {
+	float changed[CHANNELS_NUM];
+
+	setup(0xFF);
+	samples_append(&store, 10);
+
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_resume(&store, resolutions, CHANNELS_NUM));
+	samples_append(&store, 10);
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_flush(&store));
+
+	for (uint8_t channel = 0; channel < CHANNELS_NUM; channel++) {
+		TEST_ASSERT_EQUAL(20, samples_check(&store, channel, 0, UINT32_MAX, truth[channel]));
+	}
+
+	/* A buffer with another resolution is dropped, the others go on */
+	memcpy(changed, resolutions, sizeof(changed));
+	changed[0] = 0.1f;
+
+	samples_append(&store, 10);
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_resume(&store, changed, CHANNELS_NUM));
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_flush(&store));
+	TEST_ASSERT_EQUAL(20, samples_check(&store, 0, 0, UINT32_MAX, truth[0]));
+
+	for (uint8_t channel = 1; channel < CHANNELS_NUM; channel++) {
+		TEST_ASSERT_EQUAL(30, samples_check(&store, channel, 0, UINT32_MAX, truth[channel]));
+	}
+
+	/* A plain init drops them all */
+	samples_append(&store, 10);
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_init(&store, changed, CHANNELS_NUM));
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_flush(&store));
+	TEST_ASSERT_EQUAL(30, samples_check(&store, 1, 0, UINT32_MAX, truth[1]));
+}
+
+static void test_invalid(void) {
+	float invalid[CHANNELS_NUM];
+	sample_store_iter_t iter;
+	sample_t sample = {0};
+
+	setup(0xFF);
+
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, sample_store_init(&store, resolutions, SAMPLE_STORE_MAX_CHANNELS + 1));
+
+	memcpy(invalid, resolutions, sizeof(invalid));
+	invalid[3] = 0.0f;
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, sample_store_init(&store, invalid, CHANNELS_NUM));
+	invalid[3] = NAN;
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, sample_store_init(&store, invalid, CHANNELS_NUM));
+
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_init(&store, resolutions, CHANNELS_NUM));
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, sample_store_append(&store, CHANNELS_NUM, &sample, 1));
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, sample_store_iter_init(&store, &iter, CHANNELS_NUM, 0, UINT32_MAX));
+}
+
+/* Samples encoded and decoded per second of CPU time, the signals are
+ * generated before the time is taken. The CPU time of the process doesn't
+ * depend on the load of the host */
+static void test_throughput(void) {
+	setup(0xFF);
+	samples_append(&store, SAMPLES_NUM);
+
+	host_partition_fill(partition, 0xFF);
+	memset(&store, 0, sizeof(store));
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_init(&store, resolutions, CHANNELS_NUM));
+
+	clock_t start = clock();
+
+	for (uint32_t i = 0; i < SAMPLES_NUM; i += BATCH_SIZE) {
+		for (uint8_t channel = 0; channel < CHANNELS_NUM; channel++) {
+			TEST_ASSERT_EQUAL(ESP_OK, sample_store_append(&store, channel, &truth[channel][i], BATCH_SIZE));
+		}
+	}
+
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_flush(&store));
+
+	clock_t appended = clock();
+	uint32_t read = 0;
+
+	for (uint8_t channel = 0; channel < CHANNELS_NUM; channel++) {
+		read += samples_check(&store, channel, 0, UINT32_MAX, NULL);
+	}
+
+	clock_t end = clock();
+	uint32_t samples = SAMPLES_NUM * CHANNELS_NUM;
+	int64_t append_us = (int64_t)(appended - start) * 1000000 / CLOCKS_PER_SEC;
+	int64_t read_us = (int64_t)(end - appended) * 1000000 / CLOCKS_PER_SEC;
+	uint64_t append_per_s = (uint64_t)samples * 1000000 / (append_us ? append_us : 1);
+	uint64_t read_per_s = (uint64_t)samples * 1000000 / (read_us ? read_us : 1);
+
+	printf("%" PRIu32 " samples, %" PRIu64 " appended and %" PRIu64 " read per CPU second\n",
+			samples, append_per_s, read_per_s);
+
+	TEST_ASSERT_EQUAL(samples, read);
+	TEST_ASSERT(append_per_s > THROUGHPUT_PER_S);
+	TEST_ASSERT(read_per_s > THROUGHPUT_PER_S);
+}
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+# Decode the sample_store blocks to CSV
+#
+# Usage:
+#   sample_store_decode.py [-p] [-n NAMES] [INPUT ...]
+#
+# Each INPUT holds blocks back to back, as read by sample_store_read_blocks()
+# and sent by the uplink, stdin if omitted. With -p the inputs are dumps of
+# the whole partition, e.g. from parttool.py read_partition, and the sectors
+# are decoded from the oldest to the newest. Blocks with a wrong CRC are
+# skipped, a summary is written to stderr at the end.
+
+import argparse
+import csv
+import struct
+import sys
+import zlib
+
+SECTOR_SIZE = 4096
+SECTOR_MAGIC = 0x52545353
+BLOCK_MAGIC = 0x4253
+BLOCK_HEADER = struct.Struct('<HBBHHIIfI')
+
+# Payload widths of the variable length codes, as in sample_store.c
+TIMESTAMP_WIDTHS = (4, 8, 12)
+VALUE_WIDTHS = (6, 12, 20)
+
+
+class BitReader:
+    def __init__(self, data):
+        self.value = int.from_bytes(data, 'big')
+        self.left = len(data) * 8
+
+    def bits(self, n):
+        # Past the end reads zeros, as on the device
+        if n > self.left:
+            value = (self.value << (n - self.left)) & ((1 << n) - 1) if self.left > 0 else 0
+            self.left = 0
+            self.value = 0
+            return value
+
+        self.left -= n
+        value = self.value >> self.left
+        self.value &= (1 << self.left) - 1
+
+        return value
+
+    def code(self, widths):
+        if not self.bits(1):
+            return 0
+
+        for width in widths:
+            if not self.bits(1):
+                return self.bits(width)
+
+        return self.bits(32)
+
+
+def unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def to_int32(value):
+    value &= 0xFFFFFFFF
+
+    return value - (1 << 32) if value & 0x80000000 else value
+
+
+def decode_block(header, data):
+    _, channel, _, count, length, first, _, resolution, _ = header
+    reader = BitReader(data[:length])
+    timestamp = first
+    delta = 0
+    value = 0
+    sample_id = 0
+    accuracy = 0
+
+    for _ in range(count):
+        delta = to_int32(delta + unzigzag(reader.code(TIMESTAMP_WIDTHS)))
+        timestamp = (timestamp + delta) & 0xFFFFFFFF
+        value = to_int32(value + unzigzag(reader.code(VALUE_WIDTHS)))
+
+        if reader.bits(1):
+            sample_id = reader.bits(16)
+            accuracy = reader.bits(8)
+
+        yield timestamp, channel, value * resolution, sample_id, accuracy
+
+
+def parse_blocks(data, aligned):
+    """Yield (header, payload) of the valid blocks, None for the bad ones"""
+    offset = 0
+
+    while offset + BLOCK_HEADER.size <= len(data):
+        header = BLOCK_HEADER.unpack_from(data, offset)
+        magic, length, crc = header[0], header[4], header[8]
+
+        if magic != BLOCK_MAGIC or offset + BLOCK_HEADER.size + length > len(data):
+            if not aligned or magic != 0xFFFF:
+                yield None
+            return
+
+        start = offset + BLOCK_HEADER.size
+        payload = data[start:start + length]
+        offset = start + length
+
+        if aligned:
+            offset = (offset + 3) & ~3
+
+        if zlib.crc32(payload, zlib.crc32(data[start - BLOCK_HEADER.size:start - 4])) != crc:
+            yield None
+        else:
+            yield header, payload
+
+
+def partition_sectors(data):
+    sectors = []
+
+    for offset in range(0, len(data) - SECTOR_SIZE + 1, SECTOR_SIZE):
+        magic, seq = struct.unpack_from('<II', data, offset)
+
+        if magic == SECTOR_MAGIC:
+            sectors.append((seq, data[offset + 8:offset + SECTOR_SIZE]))
+
+    # The sequence numbers only wrap after 2^32 sectors
+    return [sector for _, sector in sorted(sectors, key=lambda s: s[0])]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode sample_store blocks to CSV")
+    parser.add_argument('inputs', nargs='*', help='block payload files, or partition dumps with -p')
+    parser.add_argument('-p', '--partition', action='store_true', help='inputs are partition dumps')
+    parser.add_argument('-n', '--names', help='comma separated channel names, in channel order')
+    args = parser.parse_args()
+
+    names = args.names.split(',') if args.names else []
+    writer = csv.writer(sys.stdout)
+    writer.writerow(['timestamp_ms', 'channel', 'value', 'id', 'accuracy'])
+
+    inputs = [open(path, 'rb').read() for path in args.inputs] or [sys.stdin.buffer.read()]
+    samples = 0
+    blocks = 0
+    dropped = 0
+
+    for data in inputs:
+        chunks = partition_sectors(data) if args.partition else [data]
+
+        for chunk in chunks:
+            for block in parse_blocks(chunk, args.partition):
+                if block is None:
+                    dropped += 1
+                    continue
+
+                blocks += 1
+
+                for timestamp, channel, value, sample_id, accuracy in decode_block(*block):
+                    name = names[channel] if channel < len(names) else channel
+                    writer.writerow([timestamp, name, f'{value:.6g}', sample_id, accuracy])
+                    samples += 1
+
+    print(f'{samples} samples in {blocks} blocks decoded, {dropped} blocks dropped', file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
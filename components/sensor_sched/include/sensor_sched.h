@@ -0,0 +1,129 @@
+/**
+  ******************************************************************************
+  * @file           : sensor_sched.h
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Deadline driven scheduler of sensor sampling jobs
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef SENSOR_SCHED_H_
+#define SENSOR_SCHED_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+/* Exported macro ------------------------------------------------------------*/
+#define SENSOR_SCHED_MAX_JOBS	CONFIG_SENSOR_SCHED_MAX_JOBS
+
+/* Exported typedef ----------------------------------------------------------*/
+/* Sampling callback, returns the esp_timer time in us it is due again, or 0
+ * to be called again one period after the previous due time */
+typedef int64_t (*sensor_sched_cb_t)(void *arg);
+
+typedef struct {
+	int64_t due;			/* esp_timer time in us the job is due */
+	uint32_t period;		/* Period in ms */
+	sensor_sched_cb_t cb;
+	void *arg;
+	const char *name;
+} sensor_sched_job_t;
+
+typedef struct {
+	sensor_sched_job_t jobs[SENSOR_SCHED_MAX_JOBS];	/* Min-heap ordered by due time */
+	uint8_t jobs_num;
+	bool running;			/* A job is out of the heap while it runs, its slot is kept */
+	SemaphoreHandle_t mutex;
+	StaticSemaphore_t mutex_buffer;
+	TaskHandle_t task_handle;
+	uint32_t wakeups;		/* Times the scheduler task woke up */
+} sensor_sched_t;
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions prototypes ---------------------------------------------*/
+/**
+  * @brief Function to initialize a scheduler and create its task
+  *
+  * @param me       : Pointer to a sensor_sched_t structure
+  * @param priority : Priority of the task running the jobs
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_NO_MEM if the task can't be created
+  */
+esp_err_t sensor_sched_init(sensor_sched_t * const me, UBaseType_t priority);
+
+/**
+  * @brief Function to add a sampling job, it is first due right away
+  *
+  * @note The jobs run one after the other in the scheduler task, so a job
+  *       blocking delays the others
+  *
+  * @param me     : Pointer to a sensor_sched_t structure
+  * @param name   : Job name, not copied
+  * @param cb     : Sampling callback
+  * @param arg    : Argument passed to the callback
+  * @param period : Period in ms, used when the callback returns 0
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_INVALID_ARG if the callback is NULL or the period is 0
+  * 	- ESP_ERR_NO_MEM if there is no room for another job
+  */
+esp_err_t sensor_sched_add(sensor_sched_t * const me, const char *name, sensor_sched_cb_t cb, void *arg, uint32_t period);
+
+/**
+  * @brief Function to get the number of times the scheduler task woke up
+  *
+  * @param me : Pointer to a sensor_sched_t structure
+  *
+  * @retval Number of wakeups since the scheduler was initialized
+  */
+uint32_t sensor_sched_get_wakeups(sensor_sched_t * const me);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SENSOR_SCHED_H_ */
+
+/***************************** END OF FILE ************************************/
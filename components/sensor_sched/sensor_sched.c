@@ -0,0 +1,240 @@
+/**
+  ******************************************************************************
+  * @file           : sensor_sched.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Deadline driven scheduler of sensor sampling jobs
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <assert.h>
+
+#include "sensor_sched.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+/* Private macro -------------------------------------------------------------*/
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static const char *TAG = "sensor_sched";
+
+/* Private function prototypes -----------------------------------------------*/
+static void sched_task(void *arg);
+static void heap_push(sensor_sched_t * const me, const sensor_sched_job_t *job);
+static void heap_pop(sensor_sched_t * const me, sensor_sched_job_t *job);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief Function to initialize a scheduler and create its task
+  */
+esp_err_t sensor_sched_init(sensor_sched_t * const me, UBaseType_t priority) {
+	ESP_LOGI(TAG, "Initializing sensor scheduler...");
+
+	me->jobs_num = 0;
+	me->running = false;
+	me->wakeups = 0;
+
+	/* Serialize the job additions with the scheduler task */
+	me->mutex = xSemaphoreCreateMutexStatic(&me->mutex_buffer);
+
+	if (me->mutex == NULL) {
+		ESP_LOGE(TAG, "Failed to create the scheduler mutex");
+		return ESP_FAIL;
+	}
+
+	if (xTaskCreate(sched_task,
+			"sensor sched task",
+			CONFIG_SENSOR_SCHED_TASK_STACK_SIZE,
+			(void *)me,
+			priority,
+			&me->task_handle) != pdPASS) {
+		ESP_LOGE(TAG, "Failed to create the scheduler task");
+		return ESP_ERR_NO_MEM;
+	}
+
+	return ESP_OK;
+}
+
+/**
+  * @brief Function to add a sampling job, it is first due right away
+  */
+esp_err_t sensor_sched_add(sensor_sched_t * const me, const char *name, sensor_sched_cb_t cb, void *arg, uint32_t period) {
+	if (cb == NULL || period == 0) {
+		return ESP_ERR_INVALID_ARG;
+	}
+
+	sensor_sched_job_t job = {
+			.due = esp_timer_get_time(),
+			.period = period,
+			.cb = cb,
+			.arg = arg,
+			.name = name,
+	};
+
+	xSemaphoreTake(me->mutex, portMAX_DELAY);
+
+	/* The job being run goes back to the heap afterwards */
+	if (me->jobs_num + me->running >= SENSOR_SCHED_MAX_JOBS) {
+		xSemaphoreGive(me->mutex);
+		ESP_LOGE(TAG, "No room for job %s", name);
+		return ESP_ERR_NO_MEM;
+	}
+
+	heap_push(me, &job);
+
+	xSemaphoreGive(me->mutex);
+
+	/* The new job may be due before the one the task is waiting for */
+	xTaskNotifyGive(me->task_handle);
+
+	return ESP_OK;
+}
+
+/**
+  * @brief Function to get the number of times the scheduler task woke up
+  */
+uint32_t sensor_sched_get_wakeups(sensor_sched_t * const me) {
+	return me->wakeups;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static void sched_task(void *arg) {
+	sensor_sched_t *sched = (sensor_sched_t *)arg;
+	sensor_sched_job_t job;
+
+	for (;;) {
+		xSemaphoreTake(sched->mutex, portMAX_DELAY);
+
+		int64_t now = esp_timer_get_time();
+
+		if (sched->jobs_num == 0 || sched->jobs[0].due > now) {
+			TickType_t ticks = portMAX_DELAY;
+
+			/* Sleep until the earliest job is due, rounding up so the task
+			 * doesn't wake up just before it */
+			if (sched->jobs_num) {
+				int64_t wait_ms = (sched->jobs[0].due - now + 999) / 1000;
+				int64_t wait_ticks = (wait_ms + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS;
+
+				/* A job due later than the longest timeout is waited for in
+				 * several sleeps, the truncated count could be a few ticks */
+				ticks = wait_ticks < portMAX_DELAY ? (TickType_t)wait_ticks : portMAX_DELAY - 1;
+			}
+
+			xSemaphoreGive(sched->mutex);
+
+			ulTaskNotifyTake(pdTRUE, ticks);
+			sched->wakeups++;
+
+			continue;
+		}
+
+		heap_pop(sched, &job);
+		sched->running = true;
+
+		xSemaphoreGive(sched->mutex);
+
+		/* Run the job without holding the mutex, it may take a while */
+		int64_t next = job.cb(job.arg);
+
+		if (next > 0) {
+			job.due = next;
+		}
+		else {
+			/* Keep the period from the due time, skipping the periods
+			 * missed if the job ran late */
+			job.due += (int64_t)job.period * 1000;
+			now = esp_timer_get_time();
+
+			if (job.due <= now) {
+				job.due = now + (int64_t)job.period * 1000;
+			}
+		}
+
+		xSemaphoreTake(sched->mutex, portMAX_DELAY);
+		sched->running = false;
+		heap_push(sched, &job);
+		xSemaphoreGive(sched->mutex);
+	}
+}
+
+static void heap_push(sensor_sched_t * const me, const sensor_sched_job_t *job) {
+	assert(me->jobs_num < SENSOR_SCHED_MAX_JOBS);
+
+	uint8_t i = me->jobs_num++;
+
+	/* Sift up */
+	while (i > 0) {
+		uint8_t parent = (i - 1) / 2;
+
+		if (me->jobs[parent].due <= job->due) {
+			break;
+		}
+
+		me->jobs[i] = me->jobs[parent];
+		i = parent;
+	}
+
+	me->jobs[i] = *job;
+}
+
+static void heap_pop(sensor_sched_t * const me, sensor_sched_job_t *job) {
+	*job = me->jobs[0];
+
+	sensor_sched_job_t last = me->jobs[--me->jobs_num];
+	uint8_t i = 0;
+
+	/* Sift the last job down from the root */
+	for (;;) {
+		uint8_t child = 2 * i + 1;
+
+		if (child >= me->jobs_num) {
+			break;
+		}
+
+		if (child + 1 < me->jobs_num && me->jobs[child + 1].due < me->jobs[child].due) {
+			child++;
+		}
+
+		if (last.due <= me->jobs[child].due) {
+			break;
+		}
+
+		me->jobs[i] = me->jobs[child];
+		i = child;
+	}
+
+	me->jobs[i] = last;
+}
+
+/***************************** END OF FILE ************************************/
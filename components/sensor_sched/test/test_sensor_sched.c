@@ -0,0 +1,318 @@
+/**
+  ******************************************************************************
+  * @file           : test_sensor_sched.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Host test of the sensor scheduler heap, wakeups and waits
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdatomic.h>
+
+#include "host_test.h"
+#include "sensor_sched.h"
+#include "esp_timer.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define DONE_TIMEOUT_MS			2000
+#define PARK_US					(3600LL * 1000000)	/* Due time of the jobs a test is done with */
+
+#define ORDER_BASE_MS			100
+#define ORDER_JOBS				7
+
+#define SLOT_PERIOD_MS			10
+
+/* The main.c jobs at MIX_SPEEDUP times their periods: the SHTC3, MiCS-6814
+ * and logger ones and BSEC, which triggers a measurement and polls it */
+#define MIX_SPEEDUP				10
+#define MIX_PERIOD_MS			1000
+#define MIX_JOBS				3
+#define MIX_BSEC_PERIOD_MS		3000
+#define MIX_BSEC_POLL_MS		20
+#define MIX_BSEC_POLLS			2
+#define MIX_RUN_MS				3000
+
+/* Before the scheduler the BSEC task woke every 20 ms and the SHTC3,
+ * MiCS-6814 and logger tasks every second, each on its own stack */
+#define OLD_WAKEUPS_PER_HOUR	(3600 * (1000 / MIX_BSEC_POLL_MS + MIX_JOBS))
+#define OLD_STACK_SIZE			(4 * configMINIMAL_STACK_SIZE * 4)
+
+#define FAR_SLEEP_MS			200
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+	uint32_t offset_ms;
+	uint32_t runs;
+} order_job_t;
+
+/* Private variables ---------------------------------------------------------*/
+static SemaphoreHandle_t done;
+
+static sensor_sched_t order_sched;
+static order_job_t order_jobs[ORDER_JOBS] = {
+		{70}, {10}, {50}, {30}, {60}, {20}, {40},
+};
+static int64_t order_base;
+static uint32_t order_runs[ORDER_JOBS];
+static uint32_t order_num;
+
+static sensor_sched_t slot_sched;
+static SemaphoreHandle_t slot_started;
+static SemaphoreHandle_t slot_release;
+static uint32_t slot_busy_runs;
+static uint32_t slot_runs[SENSOR_SCHED_MAX_JOBS];
+
+static sensor_sched_t mix_sched;
+static atomic_bool mix_stop;
+static atomic_uint mix_runs;
+static uint32_t mix_bsec_polls;
+
+static sensor_sched_t far_sched;
+static uint32_t far_runs;
+
+/* Private function prototypes -----------------------------------------------*/
+static int64_t order_job(void *arg);
+static int64_t slot_busy_job(void *arg);
+static int64_t slot_job(void *arg);
+static int64_t mix_job(void *arg);
+static int64_t mix_bsec_job(void *arg);
+static int64_t far_job(void *arg);
+static void done_wait(uint32_t count);
+static void test_add_invalid(void);
+static void test_order(void);
+static void test_running_slot(void);
+static void test_wakeups(void);
+static void test_far_due(void);
+
+/* Main ----------------------------------------------------------------------*/
+int main(void) {
+	done = xSemaphoreCreateCounting(SENSOR_SCHED_MAX_JOBS, 0);
+
+	RUN_TEST(test_add_invalid);
+	RUN_TEST(test_order);
+	RUN_TEST(test_running_slot);
+	RUN_TEST(test_wakeups);
+	RUN_TEST(test_far_due);
+
+	return 0;
+}
+
+/* Jobs ----------------------------------------------------------------------*/
+/* First due right away, then at its offset from the base, in shuffled order */
+static int64_t order_job(void *arg) {
+	order_job_t *job = arg;
+
+	if (job->runs++ == 0) {
+		return order_base + (int64_t)job->offset_ms * 1000;
+	}
+
+	order_runs[order_num++] = job->offset_ms;
+	xSemaphoreGive(done);
+
+	return esp_timer_get_time() + PARK_US;
+}
+
+/* Holds the scheduler on its first run, while the test adds the others */
+static int64_t slot_busy_job(void *arg) {
+	if (slot_busy_runs++ == 0) {
+		xSemaphoreGive(slot_started);
+		xSemaphoreTake(slot_release, portMAX_DELAY);
+
+		return 0;
+	}
+
+	xSemaphoreGive(done);
+
+	return esp_timer_get_time() + PARK_US;
+}
+
+static int64_t slot_job(void *arg) {
+	slot_runs[(uintptr_t)arg]++;
+	xSemaphoreGive(done);
+
+	return esp_timer_get_time() + PARK_US;
+}
+
+static int64_t mix_job(void *arg) {
+	if (atomic_load(&mix_stop)) {
+		return esp_timer_get_time() + PARK_US;
+	}
+
+	atomic_fetch_add(&mix_runs, 1);
+
+	return 0;
+}
+
+static int64_t mix_bsec_job(void *arg) {
+	int64_t now = esp_timer_get_time();
+
+	if (atomic_load(&mix_stop)) {
+		return now + PARK_US;
+	}
+
+	atomic_fetch_add(&mix_runs, 1);
+
+	/* Polled while the measurement is in progress, then idle until the next
+	 * one */
+	if (++mix_bsec_polls <= MIX_BSEC_POLLS) {
+		return now + MIX_BSEC_POLL_MS * 1000;
+	}
+
+	mix_bsec_polls = 0;
+
+	return now + (MIX_BSEC_PERIOD_MS / MIX_SPEEDUP - MIX_BSEC_POLLS * MIX_BSEC_POLL_MS) * 1000;
+}
+
+/* Due so far that its wait in ticks doesn't fit a TickType_t, the truncated
+ * count is a tick and runs down from there */
+static int64_t far_job(void *arg) {
+	far_runs++;
+	xSemaphoreGive(done);
+
+	return esp_timer_get_time() + ((int64_t)UINT32_MAX + 2) * portTICK_PERIOD_MS * 1000;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static void done_wait(uint32_t count) {
+	for (uint32_t i = 0; i < count; i++) {
+		TEST_ASSERT(xSemaphoreTake(done, pdMS_TO_TICKS(DONE_TIMEOUT_MS)));
+	}
+}
+
+static void test_add_invalid(void) {
+	static sensor_sched_t sched;
+
+	TEST_ASSERT_EQUAL(ESP_OK, sensor_sched_init(&sched, 5));
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, sensor_sched_add(&sched, "null", NULL, NULL, 1000));
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, sensor_sched_add(&sched, "zero", mix_job, NULL, 0));
+	TEST_ASSERT_EQUAL(0, sched.jobs_num);
+}
+
+/* The heap hands the jobs out by due time, whatever their order in it */
+static void test_order(void) {
+	order_base = esp_timer_get_time() + ORDER_BASE_MS * 1000;
+
+	TEST_ASSERT_EQUAL(ESP_OK, sensor_sched_init(&order_sched, 5));
+
+	for (uint32_t i = 0; i < ORDER_JOBS; i++) {
+		TEST_ASSERT_EQUAL(ESP_OK, sensor_sched_add(&order_sched, "order", order_job, &order_jobs[i], 1000));
+	}
+
+	done_wait(ORDER_JOBS);
+
+	TEST_ASSERT_EQUAL(ORDER_JOBS, order_num);
+
+	for (uint32_t i = 1; i < ORDER_JOBS; i++) {
+		TEST_ASSERT(order_runs[i - 1] < order_runs[i]);
+	}
+}
+
+/* The job being run keeps its slot, the heap can't be filled while it runs
+ * and it finds room when it goes back */
+static void test_running_slot(void) {
+	slot_started = xSemaphoreCreateBinary();
+	slot_release = xSemaphoreCreateBinary();
+
+	TEST_ASSERT_EQUAL(ESP_OK, sensor_sched_init(&slot_sched, 5));
+	TEST_ASSERT_EQUAL(ESP_OK, sensor_sched_add(&slot_sched, "busy", slot_busy_job, NULL, SLOT_PERIOD_MS));
+	TEST_ASSERT(xSemaphoreTake(slot_started, pdMS_TO_TICKS(DONE_TIMEOUT_MS)));
+
+	for (uintptr_t i = 1; i < SENSOR_SCHED_MAX_JOBS; i++) {
+		TEST_ASSERT_EQUAL(ESP_OK, sensor_sched_add(&slot_sched, "slot", slot_job, (void *)i, SLOT_PERIOD_MS));
+	}
+
+	TEST_ASSERT_EQUAL(ESP_ERR_NO_MEM, sensor_sched_add(&slot_sched, "full", slot_job, (void *)0, SLOT_PERIOD_MS));
+	TEST_ASSERT_EQUAL(SENSOR_SCHED_MAX_JOBS - 1, slot_sched.jobs_num);
+
+	xSemaphoreGive(slot_release);
+	done_wait(SENSOR_SCHED_MAX_JOBS);
+
+	TEST_ASSERT_EQUAL(2, slot_busy_runs);
+	TEST_ASSERT_EQUAL(0, slot_runs[0]);
+
+	for (uint32_t i = 1; i < SENSOR_SCHED_MAX_JOBS; i++) {
+		TEST_ASSERT_EQUAL(1, slot_runs[i]);
+	}
+}
+
+/* The task wakes up only to run due jobs or to take a new one, and far less
+ * often than the task per sensor did */
+static void test_wakeups(void) {
+	TEST_ASSERT_EQUAL(ESP_OK, sensor_sched_init(&mix_sched, 5));
+
+	int64_t start = esp_timer_get_time();
+
+	TEST_ASSERT_EQUAL(ESP_OK, sensor_sched_add(&mix_sched, "bsec", mix_bsec_job, NULL, MIX_BSEC_POLL_MS));
+
+	for (uint32_t i = 0; i < MIX_JOBS; i++) {
+		TEST_ASSERT_EQUAL(ESP_OK, sensor_sched_add(&mix_sched, "sensor", mix_job, NULL, MIX_PERIOD_MS / MIX_SPEEDUP));
+	}
+
+	vTaskDelay(pdMS_TO_TICKS(MIX_RUN_MS));
+
+	uint32_t wakeups = sensor_sched_get_wakeups(&mix_sched);
+	uint32_t runs = atomic_load(&mix_runs);
+	int64_t elapsed = esp_timer_get_time() - start;
+
+	atomic_store(&mix_stop, true);
+
+	uint32_t per_hour = (uint32_t)((int64_t)wakeups * 3600 * 1000000 / (elapsed * MIX_SPEEDUP));
+
+	printf("wakeups: %" PRIu32 " for %" PRIu32 " job runs, %" PRIu32 "/h against %d/h with a task per sensor\n",
+			wakeups, runs, per_hour, OLD_WAKEUPS_PER_HOUR);
+	printf("stack: %d B in one task against %d B in four\n",
+			CONFIG_SENSOR_SCHED_TASK_STACK_SIZE, OLD_STACK_SIZE);
+
+	TEST_ASSERT(runs > 0);
+	TEST_ASSERT(wakeups <= runs + 1 + MIX_JOBS);
+	TEST_ASSERT(per_hour * 10 < OLD_WAKEUPS_PER_HOUR);
+	TEST_ASSERT(CONFIG_SENSOR_SCHED_TASK_STACK_SIZE < OLD_STACK_SIZE);
+}
+
+/* A job due later than the longest tick count doesn't wake the task up
+ * every few ticks */
+static void test_far_due(void) {
+	TEST_ASSERT_EQUAL(ESP_OK, sensor_sched_init(&far_sched, 5));
+	TEST_ASSERT_EQUAL(ESP_OK, sensor_sched_add(&far_sched, "far", far_job, NULL, 1000));
+
+	done_wait(1);
+	vTaskDelay(pdMS_TO_TICKS(FAR_SLEEP_MS));
+
+	/* Woken up once, by the addition */
+	TEST_ASSERT_EQUAL(1, sensor_sched_get_wakeups(&far_sched));
+	TEST_ASSERT_EQUAL(1, far_runs);
+}
+
+/***************************** END OF FILE ************************************/
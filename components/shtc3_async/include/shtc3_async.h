@@ -0,0 +1,145 @@
+/**
+  ******************************************************************************
+  * @file           : shtc3_async.h
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Split-phase SHTC3 measurement on i2c_bus_async
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef SHTC3_ASYNC_H_
+#define SHTC3_ASYNC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include "esp_err.h"
+#include "sdkconfig.h"
+#include "shtc3.h"
+#include "i2c_bus_async.h"
+
+/* Exported macro ------------------------------------------------------------*/
+#ifdef CONFIG_SHTC3_ASYNC_LOW_POWER
+#define SHTC3_ASYNC_DEFAULT_MODE	SHTC3_ASYNC_LOW_POWER_MODE
+#else
+#define SHTC3_ASYNC_DEFAULT_MODE	SHTC3_ASYNC_NORMAL_MODE
+#endif
+
+/* Exported typedef ----------------------------------------------------------*/
+typedef enum {
+	SHTC3_ASYNC_NORMAL_MODE = 0,
+	SHTC3_ASYNC_LOW_POWER_MODE
+} shtc3_async_mode_e;
+
+typedef enum {
+	SHTC3_ASYNC_WAKEUP_XFER = 0,
+	SHTC3_ASYNC_MEASURE_XFER,
+	SHTC3_ASYNC_READ_XFER,
+	SHTC3_ASYNC_SLEEP_XFER,
+	SHTC3_ASYNC_MAX_XFER
+} shtc3_async_xfer_e;
+
+typedef struct {
+	shtc3_t *shtc3;
+	i2c_bus_async_t *bus;
+	i2c_bus_async_xfer_t xfers[SHTC3_ASYNC_MAX_XFER];
+	uint8_t data[6];			/* Temperature and humidity words with their CRC */
+	atomic_bool busy;			/* Measurement chain submitted and not completed */
+	bool started;				/* Measurement started and not fetched */
+} shtc3_async_t;
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions prototypes ---------------------------------------------*/
+/**
+  * @brief Function to initialize a split-phase SHTC3 instance
+  *
+  * @param me    : Pointer to a shtc3_async_t structure
+  * @param shtc3 : Pointer to an initialized shtc3_t structure
+  * @param bus   : Pointer to an initialized i2c_bus_async_t structure
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_INVALID_ARG if an argument is NULL
+  */
+esp_err_t shtc3_async_init(shtc3_async_t * const me, shtc3_t *shtc3, i2c_bus_async_t *bus);
+
+/**
+  * @brief Function to start a measurement, the sensor is woken up before and
+  *        put to sleep after it
+  *
+  * @param me   : Pointer to a shtc3_async_t structure
+  * @param mode : Measurement mode
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_INVALID_STATE if a measurement is already in progress
+  * 	- ESP_ERR_TIMEOUT if the bus queue is full
+  */
+esp_err_t shtc3_start_measurement(shtc3_async_t * const me, shtc3_async_mode_e mode);
+
+/**
+  * @brief Function to fetch the result of the measurement started
+  *
+  * @param me   : Pointer to a shtc3_async_t structure
+  * @param temp : Pointer to store the temperature in °C
+  * @param hum  : Pointer to store the relative humidity in %
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_NOT_FINISHED if the measurement is still in progress
+  * 	- ESP_ERR_INVALID_STATE if no measurement was started
+  * 	- ESP_ERR_INVALID_CRC if a word doesn't match its CRC
+  * 	- ESP_FAIL if a transfer failed
+  */
+esp_err_t shtc3_fetch_result(shtc3_async_t * const me, float *temp, float *hum);
+
+/**
+  * @brief Function to get the time from the start of a measurement to its
+  *        result, without the bus latency
+  *
+  * @param mode : Measurement mode
+  *
+  * @retval Time in ms
+  */
+uint32_t shtc3_async_get_measurement_time(shtc3_async_mode_e mode);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHTC3_ASYNC_H_ */
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,203 @@
+/**
+  ******************************************************************************
+  * @file           : shtc3_async.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Split-phase SHTC3 measurement on i2c_bus_async
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include "shtc3_async.h"
+#include "esp_log.h"
+#include "dlog.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define WAKEUP_CMD				0x3517
+#define SLEEP_CMD				0xB098
+#define MEASURE_NORMAL_CMD		0x7866	/* Temperature first, no clock stretching */
+#define MEASURE_LOW_POWER_CMD	0x609C
+
+#define WAKEUP_TIME_MS			1		/* 240 us */
+#define NORMAL_TIME_MS			13		/* 12.1 ms */
+#define LOW_POWER_TIME_MS		1		/* 0.8 ms */
+
+#define CRC_POLYNOMIAL			0x31
+#define CRC_INIT				0xFF
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static const char *TAG = "shtc3_async";
+
+/* Private function prototypes -----------------------------------------------*/
+static void set_cmd(i2c_bus_async_xfer_t *xfer, uint16_t cmd);
+static void measurement_done(i2c_bus_async_xfer_t *xfer);
+static uint8_t calc_crc(const uint8_t *data);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief Function to initialize a split-phase SHTC3 instance
+  */
+esp_err_t shtc3_async_init(shtc3_async_t * const me, shtc3_t *shtc3, i2c_bus_async_t *bus) {
+	ESP_LOGI(TAG, "Initializing SHTC3 async instance...");
+
+	if (shtc3 == NULL || bus == NULL) {
+		return ESP_ERR_INVALID_ARG;
+	}
+
+	me->shtc3 = shtc3;
+	me->bus = bus;
+	me->started = false;
+	atomic_init(&me->busy, false);
+
+	/* The chain only changes in the measurement command and the conversion
+	 * wait, build it once */
+	i2c_bus_async_xfer_t *xfers = me->xfers;
+
+	for (uint8_t i = 0; i < SHTC3_ASYNC_MAX_XFER; i++) {
+		xfers[i] = (i2c_bus_async_xfer_t) {
+			.dev = shtc3->i2c_dev,
+			.op = I2C_BUS_ASYNC_WRITE,
+			.next = i + 1 < SHTC3_ASYNC_MAX_XFER ? &xfers[i + 1] : NULL,
+		};
+	}
+
+	set_cmd(&xfers[SHTC3_ASYNC_WAKEUP_XFER], WAKEUP_CMD);
+	set_cmd(&xfers[SHTC3_ASYNC_SLEEP_XFER], SLEEP_CMD);
+	xfers[SHTC3_ASYNC_MEASURE_XFER].delay = WAKEUP_TIME_MS;
+	xfers[SHTC3_ASYNC_READ_XFER].op = I2C_BUS_ASYNC_READ;
+	xfers[SHTC3_ASYNC_READ_XFER].data = me->data;
+	xfers[SHTC3_ASYNC_READ_XFER].data_len = sizeof(me->data);
+
+	xfers[SHTC3_ASYNC_WAKEUP_XFER].cb = measurement_done;
+	xfers[SHTC3_ASYNC_WAKEUP_XFER].arg = (void *)me;
+
+	return ESP_OK;
+}
+
+/**
+  * @brief Function to start a measurement, the sensor is woken up before and
+  *        put to sleep after it
+  */
+esp_err_t shtc3_start_measurement(shtc3_async_t * const me, shtc3_async_mode_e mode) {
+	if (atomic_load(&me->busy)) {
+		return ESP_ERR_INVALID_STATE;
+	}
+
+	bool low_power = mode == SHTC3_ASYNC_LOW_POWER_MODE;
+
+	set_cmd(&me->xfers[SHTC3_ASYNC_MEASURE_XFER], low_power ? MEASURE_LOW_POWER_CMD : MEASURE_NORMAL_CMD);
+	me->xfers[SHTC3_ASYNC_READ_XFER].delay = low_power ? LOW_POWER_TIME_MS : NORMAL_TIME_MS;
+
+	atomic_store(&me->busy, true);
+
+	esp_err_t ret = i2c_bus_async_submit(me->bus, &me->xfers[SHTC3_ASYNC_WAKEUP_XFER], 0);
+
+	if (ret != ESP_OK) {
+		atomic_store(&me->busy, false);
+		return ret;
+	}
+
+	me->started = true;
+
+	return ESP_OK;
+}
+
+/**
+  * @brief Function to fetch the result of the measurement started
+  */
+esp_err_t shtc3_fetch_result(shtc3_async_t * const me, float *temp, float *hum) {
+	if (!me->started) {
+		return ESP_ERR_INVALID_STATE;
+	}
+
+	if (atomic_load(&me->busy)) {
+		return ESP_ERR_NOT_FINISHED;
+	}
+
+	me->started = false;
+
+	if (me->xfers[SHTC3_ASYNC_WAKEUP_XFER].ret != ESP_OK) {
+		return me->xfers[SHTC3_ASYNC_WAKEUP_XFER].ret;
+	}
+
+	if (calc_crc(&me->data[0]) != me->data[2] || calc_crc(&me->data[3]) != me->data[5]) {
+		DLOGW(TAG, "CRC mismatch");
+		return ESP_ERR_INVALID_CRC;
+	}
+
+	uint16_t raw_temp = (me->data[0] << 8) | me->data[1];
+	uint16_t raw_hum = (me->data[3] << 8) | me->data[4];
+
+	*temp = 175.0f * (float)raw_temp / 65536.0f - 45.0f;
+	*hum = 100.0f * (float)raw_hum / 65536.0f;
+
+	return ESP_OK;
+}
+
+/**
+  * @brief Function to get the time from the start of a measurement to its
+  *        result, without the bus latency
+  */
+uint32_t shtc3_async_get_measurement_time(shtc3_async_mode_e mode) {
+	return WAKEUP_TIME_MS + (mode == SHTC3_ASYNC_LOW_POWER_MODE ? LOW_POWER_TIME_MS : NORMAL_TIME_MS);
+}
+
+/* Private functions ---------------------------------------------------------*/
+static void set_cmd(i2c_bus_async_xfer_t *xfer, uint16_t cmd) {
+	/* The commands are sent as a 2 bytes register address with no data */
+	xfer->reg_addr[0] = cmd >> 8;
+	xfer->reg_addr[1] = cmd & 0xFF;
+	xfer->reg_addr_len = 2;
+}
+
+static void measurement_done(i2c_bus_async_xfer_t *xfer) {
+	shtc3_async_t *shtc3 = (shtc3_async_t *)xfer->arg;
+
+	atomic_store(&shtc3->busy, false);
+}
+
+static uint8_t calc_crc(const uint8_t *data) {
+	uint8_t crc = CRC_INIT;
+
+	for (uint8_t i = 0; i < 2; i++) {
+		crc ^= data[i];
+
+		for (uint8_t bit = 0; bit < 8; bit++) {
+			crc = crc & 0x80 ? (crc << 1) ^ CRC_POLYNOMIAL : crc << 1;
+		}
+	}
+
+	return crc;
+}
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,353 @@
+/**
+  ******************************************************************************
+  * @file           : test_shtc3_async.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Host test of the split-phase SHTC3 measurement
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+#include "host_test.h"
+#include "i2c_fake.h"
+#include "shtc3_async.h"
+
+#include "esp_timer.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define WORKER_PRIORITY			5
+#define POLL_MS					1
+#define POLL_TIMEOUT_MS			1000
+
+#define WAKEUP_CMD				0x3517
+#define SLEEP_CMD				0xB098
+#define MEASURE_NORMAL_CMD		0x7866
+#define MEASURE_LOW_POWER_CMD	0x609C
+
+/* Datasheet timings, the maximums */
+#define WAKEUP_TIME_US			240
+#define NORMAL_TIME_US			12100
+#define LOW_POWER_TIME_US		800
+
+/* 25 °C and 50 % */
+#define RAW_TEMP				0x6666
+#define RAW_HUM					0x8000
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+/* SHTC3 as seen on the bus: it NACKs everything but the wakeup command while
+ * asleep, and the read until the conversion is done */
+typedef struct {
+	bool awake;
+	int64_t wakeup_time;
+	int64_t measure_time;
+	uint32_t conversion_us;
+	bool measured;
+	bool bad_crc;
+	uint32_t nacks;
+	uint32_t measurements;
+	i2c_bus_async_xfer_t *on_measure;	/* Submitted from the measurement command */
+} shtc3_model_t;
+
+/* Private variables ---------------------------------------------------------*/
+static i2c_bus_async_t bus;
+static i2c_fake_t sensor_dev;
+static i2c_fake_t other_dev;
+static shtc3_model_t model;
+static shtc3_t shtc3;
+static shtc3_async_t shtc3_async;
+
+/* Private function prototypes -----------------------------------------------*/
+static uint8_t model_crc(const uint8_t *data);
+static int8_t shtc3_model(i2c_fake_t *fake, const i2c_fake_xfer_t *xfer, uint8_t *data);
+static esp_err_t fetch_wait(float *temp, float *hum);
+static void setup(void);
+static void test_crc(void);
+static void test_normal(void);
+static void test_low_power(void);
+static void test_states(void);
+static void test_bad_crc(void);
+static void test_nack(void);
+static void test_shared_bus(void);
+
+/* Main ----------------------------------------------------------------------*/
+int main(void) {
+	TEST_ASSERT_EQUAL(ESP_OK, i2c_bus_async_init(&bus, WORKER_PRIORITY));
+
+	RUN_TEST(test_crc);
+	RUN_TEST(test_normal);
+	RUN_TEST(test_low_power);
+	RUN_TEST(test_states);
+	RUN_TEST(test_bad_crc);
+	RUN_TEST(test_nack);
+	RUN_TEST(test_shared_bus);
+
+	return 0;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static uint8_t model_crc(const uint8_t *data) {
+	uint8_t crc = 0xFF;
+
+	for (uint8_t i = 0; i < 2; i++) {
+		crc ^= data[i];
+
+		for (uint8_t bit = 0; bit < 8; bit++) {
+			crc = crc & 0x80 ? (crc << 1) ^ 0x31 : crc << 1;
+		}
+	}
+
+	return crc;
+}
+
+static int8_t shtc3_model(i2c_fake_t *fake, const i2c_fake_xfer_t *xfer, uint8_t *data) {
+	shtc3_model_t *me = fake->model_arg;
+
+	if (xfer->op == I2C_FAKE_READ) {
+		if (!me->awake || !me->measured || xfer->time < me->measure_time + me->conversion_us || xfer->data_len != 6) {
+			me->nacks++;
+			return -1;
+		}
+
+		uint16_t words[2] = {RAW_TEMP, RAW_HUM};
+
+		for (uint8_t i = 0; i < 2; i++) {
+			data[3 * i] = words[i] >> 8;
+			data[3 * i + 1] = words[i] & 0xFF;
+			data[3 * i + 2] = model_crc(&data[3 * i]);
+		}
+
+		if (me->bad_crc) {
+			data[5] ^= 0x01;
+		}
+
+		me->measured = false;
+		me->measurements++;
+
+		return 0;
+	}
+
+	/* The commands are 2 bytes with no data */
+	if (xfer->reg_addr_len != 2 || xfer->data_len != 0) {
+		me->nacks++;
+		return -1;
+	}
+
+	uint16_t cmd = (xfer->reg_addr[0] << 8) | xfer->reg_addr[1];
+
+	if (cmd == WAKEUP_CMD) {
+		me->awake = true;
+		me->wakeup_time = xfer->time;
+
+		return 0;
+	}
+
+	if (!me->awake) {
+		me->nacks++;
+		return -1;
+	}
+
+	switch (cmd) {
+		case SLEEP_CMD:
+			me->awake = false;
+			me->measured = false;
+			return 0;
+
+		case MEASURE_NORMAL_CMD:
+		case MEASURE_LOW_POWER_CMD:
+			if (xfer->time < me->wakeup_time + WAKEUP_TIME_US) {
+				me->nacks++;
+				return -1;
+			}
+
+			me->measured = true;
+			me->measure_time = xfer->time;
+			me->conversion_us = cmd == MEASURE_NORMAL_CMD ? NORMAL_TIME_US : LOW_POWER_TIME_US;
+
+			if (me->on_measure != NULL) {
+				i2c_bus_async_submit(&bus, me->on_measure, 0);
+			}
+
+			return 0;
+
+		default:
+			me->nacks++;
+			return -1;
+	}
+}
+
+static esp_err_t fetch_wait(float *temp, float *hum) {
+	esp_err_t ret = ESP_ERR_NOT_FINISHED;
+
+	for (uint32_t i = 0; i < POLL_TIMEOUT_MS / POLL_MS && ret == ESP_ERR_NOT_FINISHED; i++) {
+		vTaskDelay(pdMS_TO_TICKS(POLL_MS) + 1);
+		ret = shtc3_fetch_result(&shtc3_async, temp, hum);
+	}
+
+	return ret;
+}
+
+static void setup(void) {
+	memset(&model, 0, sizeof(model));
+	i2c_fake_init(&sensor_dev, "shtc3", SHTC3_I2C_ADDR);
+	sensor_dev.model = shtc3_model;
+	sensor_dev.model_arg = &model;
+	i2c_fake_init(&other_dev, "other", 0x50);
+
+	shtc3.i2c_dev = &sensor_dev.dev;
+	TEST_ASSERT_EQUAL(ESP_OK, shtc3_async_init(&shtc3_async, &shtc3, &bus));
+}
+
+/* The model checks the driver with the CRC of the datasheet example */
+static void test_crc(void) {
+	uint8_t data[2] = {0xBE, 0xEF};
+
+	TEST_ASSERT_EQUAL(0x92, model_crc(data));
+}
+
+/* Wakeup, measurement, read after the conversion and sleep, in one chain */
+static void test_normal(void) {
+	float temp = 0;
+	float hum = 0;
+
+	setup();
+
+	TEST_ASSERT_EQUAL(ESP_OK, shtc3_start_measurement(&shtc3_async, SHTC3_ASYNC_NORMAL_MODE));
+	TEST_ASSERT_EQUAL(ESP_OK, fetch_wait(&temp, &hum));
+
+	TEST_ASSERT(temp > 24.99f && temp < 25.01f);
+	TEST_ASSERT(hum > 49.99f && hum < 50.01f);
+	TEST_ASSERT_EQUAL(0, model.nacks);
+	TEST_ASSERT_EQUAL(1, model.measurements);
+	TEST_ASSERT(!model.awake);
+
+	TEST_ASSERT_EQUAL(4, sensor_dev.xfers_num);
+	TEST_ASSERT_EQUAL(I2C_FAKE_WRITE, sensor_dev.xfers[0].op);
+	TEST_ASSERT_EQUAL(MEASURE_NORMAL_CMD >> 8, sensor_dev.xfers[1].reg_addr[0]);
+	TEST_ASSERT_EQUAL(I2C_FAKE_READ, sensor_dev.xfers[2].op);
+	TEST_ASSERT_EQUAL(SLEEP_CMD >> 8, sensor_dev.xfers[3].reg_addr[0]);
+
+	/* The measurement time covers the chain */
+	int64_t chain_us = sensor_dev.xfers[2].time - sensor_dev.xfers[0].time;
+
+	TEST_ASSERT(chain_us >= WAKEUP_TIME_US + NORMAL_TIME_US);
+	TEST_ASSERT(chain_us <= shtc3_async_get_measurement_time(SHTC3_ASYNC_NORMAL_MODE) * 1000 + 50000);
+}
+
+static void test_low_power(void) {
+	float temp = 0;
+	float hum = 0;
+
+	setup();
+
+	TEST_ASSERT_EQUAL(ESP_OK, shtc3_start_measurement(&shtc3_async, SHTC3_ASYNC_LOW_POWER_MODE));
+	TEST_ASSERT_EQUAL(ESP_OK, fetch_wait(&temp, &hum));
+
+	TEST_ASSERT_EQUAL(0, model.nacks);
+	TEST_ASSERT_EQUAL(MEASURE_LOW_POWER_CMD >> 8, sensor_dev.xfers[1].reg_addr[0]);
+	TEST_ASSERT_EQUAL(MEASURE_LOW_POWER_CMD & 0xFF, sensor_dev.xfers[1].reg_addr[1]);
+	TEST_ASSERT(sensor_dev.xfers[2].time - sensor_dev.xfers[1].time >= LOW_POWER_TIME_US);
+	TEST_ASSERT(shtc3_async_get_measurement_time(SHTC3_ASYNC_LOW_POWER_MODE) < shtc3_async_get_measurement_time(SHTC3_ASYNC_NORMAL_MODE));
+}
+
+/* One measurement at a time, fetched once */
+static void test_states(void) {
+	float temp = 0;
+	float hum = 0;
+
+	setup();
+
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, shtc3_fetch_result(&shtc3_async, &temp, &hum));
+	TEST_ASSERT_EQUAL(ESP_OK, shtc3_start_measurement(&shtc3_async, SHTC3_ASYNC_NORMAL_MODE));
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, shtc3_start_measurement(&shtc3_async, SHTC3_ASYNC_NORMAL_MODE));
+	TEST_ASSERT_EQUAL(ESP_ERR_NOT_FINISHED, shtc3_fetch_result(&shtc3_async, &temp, &hum));
+	TEST_ASSERT_EQUAL(ESP_OK, fetch_wait(&temp, &hum));
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, shtc3_fetch_result(&shtc3_async, &temp, &hum));
+	TEST_ASSERT_EQUAL(1, model.measurements);
+}
+
+static void test_bad_crc(void) {
+	float temp = 0;
+	float hum = 0;
+
+	setup();
+	model.bad_crc = true;
+
+	TEST_ASSERT_EQUAL(ESP_OK, shtc3_start_measurement(&shtc3_async, SHTC3_ASYNC_NORMAL_MODE));
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_CRC, fetch_wait(&temp, &hum));
+}
+
+/* A NACK ends the chain, and the next measurement wakes the sensor again */
+static void test_nack(void) {
+	float temp = 0;
+	float hum = 0;
+
+	setup();
+	sensor_dev.fail_at = 2;
+
+	TEST_ASSERT_EQUAL(ESP_OK, shtc3_start_measurement(&shtc3_async, SHTC3_ASYNC_NORMAL_MODE));
+	TEST_ASSERT_EQUAL(ESP_FAIL, fetch_wait(&temp, &hum));
+	TEST_ASSERT_EQUAL(2, sensor_dev.xfers_num);
+
+	TEST_ASSERT_EQUAL(ESP_OK, shtc3_start_measurement(&shtc3_async, SHTC3_ASYNC_NORMAL_MODE));
+	TEST_ASSERT_EQUAL(ESP_OK, fetch_wait(&temp, &hum));
+	TEST_ASSERT_EQUAL(1, model.measurements);
+	TEST_ASSERT(!model.awake);
+}
+
+/* Other devices use the bus during the conversion */
+static void test_shared_bus(void) {
+	float temp = 0;
+	float hum = 0;
+	uint8_t buf[4] = {0};
+	i2c_bus_async_xfer_t xfer = {
+			.dev = &other_dev.dev,
+			.op = I2C_BUS_ASYNC_READ,
+			.reg_addr_len = 1,
+			.data = buf,
+			.data_len = sizeof(buf),
+	};
+
+	setup();
+	model.on_measure = &xfer;
+
+	TEST_ASSERT_EQUAL(ESP_OK, shtc3_start_measurement(&shtc3_async, SHTC3_ASYNC_NORMAL_MODE));
+	TEST_ASSERT_EQUAL(ESP_OK, fetch_wait(&temp, &hum));
+
+	TEST_ASSERT_EQUAL(1, other_dev.xfers_num);
+	TEST_ASSERT_EQUAL(ESP_OK, xfer.ret);
+	TEST_ASSERT(other_dev.xfers[0].time > sensor_dev.xfers[1].time);
+	TEST_ASSERT(other_dev.xfers[0].time < sensor_dev.xfers[2].time);
+}
+
+/***************************** END OF FILE ************************************/
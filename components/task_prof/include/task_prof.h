@@ -0,0 +1,184 @@
+/**
+  ******************************************************************************
+  * @file           : task_prof.h
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Per task CPU and stack profiler and callback histograms
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TASK_PROF_H_
+#define TASK_PROF_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+#include "esp_err.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+/* Exported macro ------------------------------------------------------------*/
+#define TASK_PROF_HIST_BUCKETS	16		/* Bucket i counts the times below 2^i us, the last one is open */
+#define TASK_PROF_NAME_SIZE		16
+#define TASK_PROF_DUMP_VERSION	1
+
+#ifdef CONFIG_TASK_PROF_ENABLE
+/* Execution time of a callback, the histogram is defined once at file scope
+ * and listed in the report the first time a time is added */
+#define TASK_PROF_HIST_DEFINE(hist, name_str)	static task_prof_hist_t hist = {.name = (name_str)}
+#define TASK_PROF_START(start)					const int64_t start = esp_timer_get_time()
+#define TASK_PROF_END(hist, start)				task_prof_hist_add(&(hist), (uint32_t)(esp_timer_get_time() - (start)))
+#else
+#define TASK_PROF_HIST_DEFINE(hist, name_str)
+#define TASK_PROF_START(start)
+#define TASK_PROF_END(hist, start)
+#endif /* CONFIG_TASK_PROF_ENABLE */
+
+/* Exported typedef ----------------------------------------------------------*/
+typedef struct task_prof_hist {
+	const char *name;
+	uint32_t counts[TASK_PROF_HIST_BUCKETS];
+	uint32_t max_us;
+	uint64_t total_us;
+	struct task_prof_hist *next;	/* Next histogram of the report */
+	bool listed;
+} task_prof_hist_t;
+
+typedef struct {
+	char name[TASK_PROF_NAME_SIZE];
+	UBaseType_t number;				/* FreeRTOS task number, matches the samples */
+	UBaseType_t priority;
+	uint32_t run_time;				/* Run time counter at the sample */
+	uint16_t cpu;					/* Share of the window in permille */
+	uint32_t stack_free;			/* Stack high water mark in bytes */
+} task_prof_task_t;
+
+typedef struct {
+	SemaphoreHandle_t mutex;
+#ifdef CONFIG_TASK_PROF_ENABLE
+	TaskStatus_t status[CONFIG_TASK_PROF_MAX_TASKS];
+	task_prof_task_t tasks[CONFIG_TASK_PROF_MAX_TASKS];
+#endif
+	uint8_t tasks_num;
+	uint32_t total;					/* Total run time counter at the sample */
+	uint32_t window;				/* Run time between the last two samples */
+} task_prof_t;
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions prototypes ---------------------------------------------*/
+/**
+  * @brief Function to initialize a task profiler instance
+  *
+  * @param me : Pointer to a task_prof_t structure
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_NOT_SUPPORTED if CONFIG_TASK_PROF_ENABLE is not set
+  * 	- ESP_ERR_NO_MEM if the mutex can't be created
+  */
+esp_err_t task_prof_init(task_prof_t * const me);
+
+/**
+  * @brief Function to sample the run time and the stack high water mark of
+  *        every task, the CPU shares are over the time since the previous
+  *        sample, or since boot the first time
+  *
+  * @note It suspends the scheduler while the task list is read, call it every
+  *       few seconds at most. The run time counter is in us and wraps after
+  *       71 minutes, sample more often than that
+  *
+  * @param me : Pointer to a task_prof_t structure
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_NOT_SUPPORTED if CONFIG_TASK_PROF_ENABLE is not set
+  * 	- ESP_ERR_INVALID_SIZE if more than CONFIG_TASK_PROF_MAX_TASKS tasks
+  * 	  are running
+  */
+esp_err_t task_prof_sample(task_prof_t * const me);
+
+/**
+  * @brief Function to print the last sample and the callback histograms as
+  *        a table
+  *
+  * @param me : Pointer to a task_prof_t structure
+  */
+void task_prof_print(task_prof_t * const me);
+
+/**
+  * @brief Function to write the last sample and the callback histograms as a
+  *        binary blob, little endian:
+  *        - Header: version, tasks number, histograms number, 0 (1 byte each)
+  *          and window in us (4 bytes)
+  *        - Per task: name (16 bytes, zero padded), priority (1 byte), 0,
+  *          CPU share in permille (2 bytes) and stack free in bytes (4 bytes)
+  *        - Per histogram: name (16 bytes, zero padded), maximum in us
+  *          (4 bytes), total in us (8 bytes) and the bucket counts (4 bytes
+  *          each)
+  *
+  * @param me   : Pointer to a task_prof_t structure
+  * @param buf  : Buffer to write the blob to
+  * @param size : Size of the buffer
+  * @param len  : Pointer to store the length of the blob
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_NOT_SUPPORTED if CONFIG_TASK_PROF_ENABLE is not set
+  * 	- ESP_ERR_INVALID_SIZE if the blob doesn't fit in the buffer
+  */
+esp_err_t task_prof_dump(task_prof_t * const me, uint8_t *buf, size_t size, size_t *len);
+
+/**
+  * @brief Function to add an execution time to a histogram, used by the
+  *        TASK_PROF_END macro
+  *
+  * @note It doesn't block, it can be called from an ISR
+  *
+  * @param hist : Pointer to a task_prof_hist_t structure
+  * @param us   : Execution time in us
+  */
+void task_prof_hist_add(task_prof_hist_t *hist, uint32_t us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TASK_PROF_H_ */
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,345 @@
+/**
+  ******************************************************************************
+  * @file           : task_prof.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Per task CPU and stack profiler and callback histograms
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "task_prof.h"
+#include "esp_log.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define DUMP_HEADER_SIZE	8
+#define DUMP_TASK_SIZE		(TASK_PROF_NAME_SIZE + 8)
+#define DUMP_HIST_SIZE		(TASK_PROF_NAME_SIZE + 12 + TASK_PROF_HIST_BUCKETS * 4)
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static const char *TAG = "task_prof";
+
+/* Histograms in the order they were first added to */
+static task_prof_hist_t *hists;
+static portMUX_TYPE hists_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/* Private function prototypes -----------------------------------------------*/
+#ifdef CONFIG_TASK_PROF_ENABLE
+static void hist_copy(const task_prof_hist_t *hist, task_prof_hist_t *copy);
+static uint32_t hist_percentile(const task_prof_hist_t *hist, uint32_t count, uint8_t percent);
+static uint8_t *put_name(uint8_t *p, const char *name);
+static uint8_t *put_u32(uint8_t *p, uint32_t value);
+#endif
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief Function to initialize a task profiler instance
+  */
+esp_err_t task_prof_init(task_prof_t * const me) {
+	ESP_LOGI(TAG, "Initializing task profiler instance...");
+
+#ifdef CONFIG_TASK_PROF_ENABLE
+	me->tasks_num = 0;
+	me->total = 0;
+	me->window = 0;
+	me->mutex = xSemaphoreCreateMutex();
+
+	if (me->mutex == NULL) {
+		ESP_LOGE(TAG, "Failed to create the mutex");
+		return ESP_ERR_NO_MEM;
+	}
+
+	ESP_LOGI(TAG, "Initialization success");
+
+	return ESP_OK;
+#else
+	ESP_LOGW(TAG, "CONFIG_TASK_PROF_ENABLE is not set");
+
+	return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+/**
+  * @brief Function to sample the run time and the stack high water mark of
+  *        every task
+  */
+esp_err_t task_prof_sample(task_prof_t * const me) {
+#ifdef CONFIG_TASK_PROF_ENABLE
+	uint32_t total;
+
+	xSemaphoreTake(me->mutex, portMAX_DELAY);
+
+	UBaseType_t num = uxTaskGetSystemState(me->status, CONFIG_TASK_PROF_MAX_TASKS, &total);
+
+	if (num == 0) {
+		xSemaphoreGive(me->mutex);
+		return ESP_ERR_INVALID_SIZE;
+	}
+
+	uint32_t window = total - me->total;
+	uint16_t cpu[CONFIG_TASK_PROF_MAX_TASKS];
+
+	/* Shares first, the previous sample is overwritten next */
+	for (UBaseType_t i = 0; i < num; i++) {
+		uint32_t previous = 0;
+
+		/* The tasks created since the previous sample start from 0 */
+		for (uint8_t j = 0; j < me->tasks_num; j++) {
+			if (me->tasks[j].number == me->status[i].xTaskNumber) {
+				previous = me->tasks[j].run_time;
+				break;
+			}
+		}
+
+		cpu[i] = window ? (uint16_t)((uint64_t)(uint32_t)(me->status[i].ulRunTimeCounter - previous) * 1000 / window) : 0;
+	}
+
+	for (UBaseType_t i = 0; i < num; i++) {
+		const TaskStatus_t *status = &me->status[i];
+		UBaseType_t j = i;
+
+		/* Sorted by CPU share, the busiest first */
+		while (j > 0 && me->tasks[j - 1].cpu < cpu[i]) {
+			me->tasks[j] = me->tasks[j - 1];
+			j--;
+		}
+
+		task_prof_task_t *task = &me->tasks[j];
+
+		strlcpy(task->name, status->pcTaskName, sizeof(task->name));
+		task->number = status->xTaskNumber;
+		task->priority = status->uxCurrentPriority;
+		task->run_time = status->ulRunTimeCounter;
+		task->cpu = cpu[i];
+		task->stack_free = status->usStackHighWaterMark;
+	}
+
+	me->tasks_num = num;
+	me->total = total;
+	me->window = window;
+
+	xSemaphoreGive(me->mutex);
+
+	return ESP_OK;
+#else
+	return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+/**
+  * @brief Function to print the last sample and the callback histograms as
+  *        a table
+  */
+void task_prof_print(task_prof_t * const me) {
+#ifdef CONFIG_TASK_PROF_ENABLE
+	xSemaphoreTake(me->mutex, portMAX_DELAY);
+
+	printf("Task             Prio   CPU %%  Stack free  (%" PRIu32 " ms)\r\n", me->window / 1000);
+
+	for (uint8_t i = 0; i < me->tasks_num; i++) {
+		const task_prof_task_t *task = &me->tasks[i];
+
+		printf("%-16s %4u %3u.%u %%  %10" PRIu32 "\r\n", task->name, (unsigned)task->priority,
+				task->cpu / 10, task->cpu % 10, task->stack_free);
+	}
+
+	xSemaphoreGive(me->mutex);
+
+	/* The percentiles are the upper bounds of their buckets */
+	printf("Callback             Count  Mean us  P50 us  P99 us  Max us\r\n");
+
+	for (task_prof_hist_t *hist = hists; hist != NULL; hist = hist->next) {
+		task_prof_hist_t copy;
+		uint32_t count = 0;
+
+		hist_copy(hist, &copy);
+
+		for (uint8_t i = 0; i < TASK_PROF_HIST_BUCKETS; i++) {
+			count += copy.counts[i];
+		}
+
+		printf("%-16s %9" PRIu32 " %8" PRIu32 " %7" PRIu32 " %7" PRIu32 " %7" PRIu32 "\r\n", copy.name, count,
+				count ? (uint32_t)(copy.total_us / count) : 0,
+				hist_percentile(&copy, count, 50), hist_percentile(&copy, count, 99), copy.max_us);
+	}
+#endif
+}
+
+/**
+  * @brief Function to write the last sample and the callback histograms as a
+  *        binary blob
+  */
+esp_err_t task_prof_dump(task_prof_t * const me, uint8_t *buf, size_t size, size_t *len) {
+#ifdef CONFIG_TASK_PROF_ENABLE
+	uint8_t hists_num = 0;
+
+	for (task_prof_hist_t *hist = hists; hist != NULL; hist = hist->next) {
+		hists_num++;
+	}
+
+	xSemaphoreTake(me->mutex, portMAX_DELAY);
+
+	size_t needed = DUMP_HEADER_SIZE + me->tasks_num * DUMP_TASK_SIZE + hists_num * DUMP_HIST_SIZE;
+
+	if (needed > size) {
+		xSemaphoreGive(me->mutex);
+		return ESP_ERR_INVALID_SIZE;
+	}
+
+	uint8_t *p = buf;
+
+	*p++ = TASK_PROF_DUMP_VERSION;
+	*p++ = me->tasks_num;
+	*p++ = hists_num;
+	*p++ = 0;
+	p = put_u32(p, me->window);
+
+	for (uint8_t i = 0; i < me->tasks_num; i++) {
+		const task_prof_task_t *task = &me->tasks[i];
+
+		p = put_name(p, task->name);
+		*p++ = (uint8_t)task->priority;
+		*p++ = 0;
+		*p++ = (uint8_t)task->cpu;
+		*p++ = (uint8_t)(task->cpu >> 8);
+		p = put_u32(p, task->stack_free);
+	}
+
+	xSemaphoreGive(me->mutex);
+
+	/* Only the histograms counted above, another one may have been listed
+	 * since */
+	task_prof_hist_t *hist = hists;
+
+	for (uint8_t i = 0; i < hists_num; i++, hist = hist->next) {
+		task_prof_hist_t copy;
+
+		hist_copy(hist, &copy);
+
+		p = put_name(p, copy.name);
+		p = put_u32(p, copy.max_us);
+		p = put_u32(p, (uint32_t)copy.total_us);
+		p = put_u32(p, (uint32_t)(copy.total_us >> 32));
+
+		for (uint8_t j = 0; j < TASK_PROF_HIST_BUCKETS; j++) {
+			p = put_u32(p, copy.counts[j]);
+		}
+	}
+
+	*len = p - buf;
+
+	return ESP_OK;
+#else
+	return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+/**
+  * @brief Function to add an execution time to a histogram
+  */
+void task_prof_hist_add(task_prof_hist_t *hist, uint32_t us) {
+	/* 0 us in the first bucket, [2^(i - 1), 2^i) us in the bucket i */
+	uint8_t bucket = us ? 32 - __builtin_clz(us) : 0;
+
+	if (bucket >= TASK_PROF_HIST_BUCKETS) {
+		bucket = TASK_PROF_HIST_BUCKETS - 1;
+	}
+
+	portENTER_CRITICAL_SAFE(&hists_lock);
+
+	if (!hist->listed) {
+		task_prof_hist_t **last = &hists;
+
+		while (*last != NULL) {
+			last = &(*last)->next;
+		}
+
+		hist->next = NULL;
+		*last = hist;
+		hist->listed = true;
+	}
+
+	hist->counts[bucket]++;
+	hist->total_us += us;
+
+	if (us > hist->max_us) {
+		hist->max_us = us;
+	}
+
+	portEXIT_CRITICAL_SAFE(&hists_lock);
+}
+
+/* Private functions ---------------------------------------------------------*/
+#ifdef CONFIG_TASK_PROF_ENABLE
+static void hist_copy(const task_prof_hist_t *hist, task_prof_hist_t *copy) {
+	/* The total doesn't fit in a word, copy it whole */
+	portENTER_CRITICAL(&hists_lock);
+	*copy = *hist;
+	portEXIT_CRITICAL(&hists_lock);
+}
+
+static uint32_t hist_percentile(const task_prof_hist_t *hist, uint32_t count, uint8_t percent) {
+	uint32_t target = ((uint64_t)count * percent + 99) / 100;
+	uint32_t sum = 0;
+
+	for (uint8_t i = 0; i < TASK_PROF_HIST_BUCKETS - 1; i++) {
+		sum += hist->counts[i];
+
+		if (sum >= target) {
+			return count ? 1UL << i : 0;
+		}
+	}
+
+	/* In the open bucket, only the maximum is known */
+	return hist->max_us;
+}
+
+static uint8_t *put_name(uint8_t *p, const char *name) {
+	strncpy((char *)p, name, TASK_PROF_NAME_SIZE);
+
+	return p + TASK_PROF_NAME_SIZE;
+}
+
+static uint8_t *put_u32(uint8_t *p, uint32_t value) {
+	for (uint8_t i = 0; i < 4; i++) {
+		*p++ = (uint8_t)(value >> (i * 8));
+	}
+
+	return p;
+}
+#endif
+
+/***************************** END OF FILE ************************************/
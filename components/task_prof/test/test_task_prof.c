@@ -0,0 +1,428 @@
+/**
+  ******************************************************************************
+  * @file           : test_task_prof.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Host test of the task profiler shares and histograms
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "host_test.h"
+#include "task_prof.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define TASKS_NUM				(CONFIG_TASK_PROF_MAX_TASKS + 1)
+#define STRESS_TASKS_NUM		4
+#define STRESS_ADDS				10000
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+	const char *name;
+	UBaseType_t number;
+	UBaseType_t priority;
+	uint32_t run_time;
+	uint32_t stack_free;
+	bool running;
+} fake_task_t;
+
+/* Private variables ---------------------------------------------------------*/
+static task_prof_t task_prof;
+
+/* Task list of the fake scheduler */
+static fake_task_t fake_tasks[TASKS_NUM];
+static uint32_t fake_total;
+
+TASK_PROF_HIST_DEFINE(hist_values, "values");
+TASK_PROF_HIST_DEFINE(hist_macros, "macros");
+TASK_PROF_HIST_DEFINE(hist_stress, "stress");
+
+static SemaphoreHandle_t stress_done;
+
+/* Private function prototypes -----------------------------------------------*/
+static fake_task_t *fake_task_add(const char *name, UBaseType_t priority, uint32_t stack_free);
+static void fake_run(fake_task_t *task, uint32_t run_time);
+static const task_prof_task_t *task_find(const char *name);
+static void stress_task(void *arg);
+static void hist_row(const char *out, const char *name, uint32_t *row);
+static void test_shares(void);
+static void test_task_list_changes(void);
+static void test_wrap(void);
+static void test_too_many(void);
+static void test_hist(void);
+static void test_hist_concurrent(void);
+static void test_dump(void);
+static void test_print(void);
+
+/* Main ----------------------------------------------------------------------*/
+int main(void) {
+	TEST_ASSERT_EQUAL(ESP_OK, task_prof_init(&task_prof));
+
+	RUN_TEST(test_shares);
+	RUN_TEST(test_task_list_changes);
+	RUN_TEST(test_wrap);
+	RUN_TEST(test_too_many);
+	RUN_TEST(test_hist);
+	RUN_TEST(test_hist_concurrent);
+	RUN_TEST(test_dump);
+	RUN_TEST(test_print);
+
+	return 0;
+}
+
+/* Fake scheduler ------------------------------------------------------------*/
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *status_array, UBaseType_t array_size, uint32_t *total_run_time) {
+	UBaseType_t num = 0;
+
+	for (uint32_t i = 0; i < TASKS_NUM; i++) {
+		num += fake_tasks[i].running;
+	}
+
+	/* As the kernel, nothing unless every task fits */
+	if (num > array_size) {
+		return 0;
+	}
+
+	num = 0;
+
+	for (uint32_t i = 0; i < TASKS_NUM; i++) {
+		const fake_task_t *task = &fake_tasks[i];
+
+		if (!task->running) {
+			continue;
+		}
+
+		status_array[num++] = (TaskStatus_t) {
+				.pcTaskName = task->name,
+				.xTaskNumber = task->number,
+				.eCurrentState = eReady,
+				.uxCurrentPriority = task->priority,
+				.uxBasePriority = task->priority,
+				.ulRunTimeCounter = task->run_time,
+				.usStackHighWaterMark = task->stack_free,
+		};
+	}
+
+	*total_run_time = fake_total;
+
+	return num;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static fake_task_t *fake_task_add(const char *name, UBaseType_t priority, uint32_t stack_free) {
+	static UBaseType_t numbers;
+
+	for (uint32_t i = 0; i < TASKS_NUM; i++) {
+		fake_task_t *task = &fake_tasks[i];
+
+		if (!task->running) {
+			*task = (fake_task_t) {
+					.name = name,
+					.number = ++numbers,
+					.priority = priority,
+					.stack_free = stack_free,
+					.running = true,
+			};
+
+			return task;
+		}
+	}
+
+	TEST_ASSERT(false);
+
+	return NULL;
+}
+
+static void fake_run(fake_task_t *task, uint32_t run_time) {
+	task->run_time += run_time;
+	fake_total += run_time;
+}
+
+static const task_prof_task_t *task_find(const char *name) {
+	for (uint8_t i = 0; i < task_prof.tasks_num; i++) {
+		if (strcmp(task_prof.tasks[i].name, name) == 0) {
+			return &task_prof.tasks[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void stress_task(void *arg) {
+	for (uint32_t i = 0; i < STRESS_ADDS; i++) {
+		task_prof_hist_add(&hist_stress, i % 100);
+	}
+
+	xSemaphoreGive(stress_done);
+	vTaskDelete(NULL);
+}
+
+/* Count, mean, P50, P99 and maximum of a printed histogram */
+static void hist_row(const char *out, const char *name, uint32_t *row) {
+	const char *line = strstr(out, name);
+
+	TEST_ASSERT(line != NULL);
+	TEST_ASSERT_EQUAL(5, sscanf(line + TASK_PROF_NAME_SIZE, "%" SCNu32 " %" SCNu32 " %" SCNu32 " %" SCNu32 " %" SCNu32,
+			&row[0], &row[1], &row[2], &row[3], &row[4]));
+}
+
+/* Shares of the window between samples, the busiest task first */
+static void test_shares(void) {
+	fake_task_t *idle = fake_task_add("IDLE", 0, 800);
+	fake_task_t *sensors = fake_task_add("sensors task", 5, 1200);
+	fake_task_t *log = fake_task_add("log task", 2, 400);
+
+	/* The first window starts at boot */
+	fake_run(sensors, 300000);
+	fake_run(log, 100000);
+	fake_run(idle, 600000);
+
+	TEST_ASSERT_EQUAL(ESP_OK, task_prof_sample(&task_prof));
+	TEST_ASSERT_EQUAL(1000000, task_prof.window);
+	TEST_ASSERT_EQUAL(3, task_prof.tasks_num);
+	TEST_ASSERT_EQUAL(0, strcmp(task_prof.tasks[0].name, "IDLE"));
+	TEST_ASSERT_EQUAL(600, task_prof.tasks[0].cpu);
+	TEST_ASSERT_EQUAL(0, strcmp(task_prof.tasks[1].name, "sensors task"));
+	TEST_ASSERT_EQUAL(300, task_prof.tasks[1].cpu);
+	TEST_ASSERT_EQUAL(5, task_prof.tasks[1].priority);
+	TEST_ASSERT_EQUAL(1200, task_prof.tasks[1].stack_free);
+	TEST_ASSERT_EQUAL(100, task_prof.tasks[2].cpu);
+
+	/* Only the time since the previous sample counts */
+	fake_run(sensors, 700000);
+	fake_run(idle, 300000);
+
+	TEST_ASSERT_EQUAL(ESP_OK, task_prof_sample(&task_prof));
+	TEST_ASSERT_EQUAL(1000000, task_prof.window);
+	TEST_ASSERT_EQUAL(0, strcmp(task_prof.tasks[0].name, "sensors task"));
+	TEST_ASSERT_EQUAL(700, task_prof.tasks[0].cpu);
+	TEST_ASSERT_EQUAL(300, task_prof.tasks[1].cpu);
+	TEST_ASSERT_EQUAL(0, strcmp(task_prof.tasks[2].name, "log task"));
+	TEST_ASSERT_EQUAL(0, task_prof.tasks[2].cpu);
+}
+
+/* A task created between samples starts from 0, a deleted one is dropped */
+static void test_task_list_changes(void) {
+	fake_task_t *uplink = fake_task_add("uplink task", 2, 2000);
+
+	fake_run(uplink, 50000);
+	fake_run(&fake_tasks[0], 450000);
+
+	TEST_ASSERT_EQUAL(ESP_OK, task_prof_sample(&task_prof));
+	TEST_ASSERT_EQUAL(500000, task_prof.window);
+	TEST_ASSERT_EQUAL(4, task_prof.tasks_num);
+	TEST_ASSERT_EQUAL(100, task_find("uplink task")->cpu);
+	TEST_ASSERT_EQUAL(900, task_find("IDLE")->cpu);
+
+	uplink->running = false;
+	fake_run(&fake_tasks[0], 100000);
+
+	TEST_ASSERT_EQUAL(ESP_OK, task_prof_sample(&task_prof));
+	TEST_ASSERT_EQUAL(3, task_prof.tasks_num);
+	TEST_ASSERT(task_find("uplink task") == NULL);
+	TEST_ASSERT_EQUAL(1000, task_find("IDLE")->cpu);
+}
+
+/* The run time counters are in us and wrap after 71 minutes */
+static void test_wrap(void) {
+	fake_task_t *idle = &fake_tasks[0];
+	fake_task_t *sensors = &fake_tasks[1];
+
+	fake_run(idle, UINT32_MAX - idle->run_time - 1000);
+	TEST_ASSERT_EQUAL(ESP_OK, task_prof_sample(&task_prof));
+
+	fake_run(idle, 1500);
+	fake_run(sensors, 500);
+	TEST_ASSERT(idle->run_time < 1000);
+
+	TEST_ASSERT_EQUAL(ESP_OK, task_prof_sample(&task_prof));
+	TEST_ASSERT_EQUAL(2000, task_prof.window);
+	TEST_ASSERT_EQUAL(750, task_find("IDLE")->cpu);
+	TEST_ASSERT_EQUAL(250, task_find("sensors task")->cpu);
+}
+
+/* The previous sample is kept when the task list doesn't fit */
+static void test_too_many(void) {
+	fake_task_t *extra[TASKS_NUM];
+	uint32_t extra_num = 0;
+	uint8_t tasks_num = task_prof.tasks_num;
+
+	while (extra_num + tasks_num < TASKS_NUM) {
+		extra[extra_num++] = fake_task_add("extra", 1, 100);
+	}
+
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, task_prof_sample(&task_prof));
+	TEST_ASSERT_EQUAL(tasks_num, task_prof.tasks_num);
+
+	extra[0]->running = false;
+
+	TEST_ASSERT_EQUAL(ESP_OK, task_prof_sample(&task_prof));
+	TEST_ASSERT_EQUAL(CONFIG_TASK_PROF_MAX_TASKS, task_prof.tasks_num);
+
+	for (uint32_t i = 1; i < extra_num; i++) {
+		extra[i]->running = false;
+	}
+
+	TEST_ASSERT_EQUAL(ESP_OK, task_prof_sample(&task_prof));
+	TEST_ASSERT_EQUAL(tasks_num, task_prof.tasks_num);
+}
+
+static void test_hist(void) {
+	static const uint32_t values[] = {0, 1, 2, 3, 1000, 100000};
+
+	for (uint32_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+		task_prof_hist_add(&hist_values, values[i]);
+	}
+
+	/* 0 us, then [2^(i - 1), 2^i) us, the last bucket is open */
+	TEST_ASSERT_EQUAL(1, hist_values.counts[0]);
+	TEST_ASSERT_EQUAL(1, hist_values.counts[1]);
+	TEST_ASSERT_EQUAL(2, hist_values.counts[2]);
+	TEST_ASSERT_EQUAL(1, hist_values.counts[10]);
+	TEST_ASSERT_EQUAL(1, hist_values.counts[TASK_PROF_HIST_BUCKETS - 1]);
+	TEST_ASSERT_EQUAL(100000, hist_values.max_us);
+	TEST_ASSERT_EQUAL(101006, hist_values.total_us);
+
+	/* The macros time with esp_timer */
+	TASK_PROF_START(start);
+	host_time_advance(1500);
+	TASK_PROF_END(hist_macros, start);
+
+	TEST_ASSERT(hist_macros.max_us >= 1500);
+	TEST_ASSERT_EQUAL(hist_macros.max_us, hist_macros.total_us);
+
+	/* Listed in the order they were first added to */
+	TEST_ASSERT(hist_values.listed && hist_macros.listed);
+	TEST_ASSERT(hist_values.next == &hist_macros);
+	TEST_ASSERT(!hist_stress.listed);
+}
+
+/* Added from several tasks at once, no count is lost */
+static void test_hist_concurrent(void) {
+	stress_done = xSemaphoreCreateCounting(STRESS_TASKS_NUM, 0);
+
+	for (uint32_t i = 0; i < STRESS_TASKS_NUM; i++) {
+		TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(stress_task, "stress", 2048, NULL, 5, NULL));
+	}
+
+	for (uint32_t i = 0; i < STRESS_TASKS_NUM; i++) {
+		TEST_ASSERT(xSemaphoreTake(stress_done, pdMS_TO_TICKS(10000)));
+	}
+
+	uint32_t count = 0;
+
+	for (uint8_t i = 0; i < TASK_PROF_HIST_BUCKETS; i++) {
+		count += hist_stress.counts[i];
+	}
+
+	TEST_ASSERT_EQUAL(STRESS_TASKS_NUM * STRESS_ADDS, count);
+	TEST_ASSERT_EQUAL(STRESS_TASKS_NUM * (STRESS_ADDS / 100) * 4950ULL, hist_stress.total_us);
+	TEST_ASSERT_EQUAL(99, hist_stress.max_us);
+	TEST_ASSERT(hist_macros.next == &hist_stress);
+	TEST_ASSERT(hist_stress.next == NULL);
+}
+
+static void test_dump(void) {
+	uint8_t buf[1024];
+	size_t len;
+
+	TEST_ASSERT_EQUAL(ESP_OK, task_prof_dump(&task_prof, buf, sizeof(buf), &len));
+
+	/* Header, 3 tasks and 3 histograms */
+	size_t task_size = TASK_PROF_NAME_SIZE + 8;
+	size_t hist_size = TASK_PROF_NAME_SIZE + 12 + TASK_PROF_HIST_BUCKETS * 4;
+
+	TEST_ASSERT_EQUAL(8 + 3 * task_size + 3 * hist_size, len);
+	TEST_ASSERT_EQUAL(TASK_PROF_DUMP_VERSION, buf[0]);
+	TEST_ASSERT_EQUAL(3, buf[1]);
+	TEST_ASSERT_EQUAL(3, buf[2]);
+	TEST_ASSERT_EQUAL(task_prof.window, buf[4] | buf[5] << 8 | buf[6] << 16 | (uint32_t)buf[7] << 24);
+
+	for (uint8_t i = 0; i < 3; i++) {
+		const uint8_t *p = &buf[8 + i * task_size];
+		const task_prof_task_t *task = &task_prof.tasks[i];
+
+		TEST_ASSERT_EQUAL(0, strncmp((const char *)p, task->name, TASK_PROF_NAME_SIZE));
+		TEST_ASSERT_EQUAL(task->priority, p[16]);
+		TEST_ASSERT_EQUAL(task->cpu, p[18] | p[19] << 8);
+		TEST_ASSERT_EQUAL(task->stack_free, p[20] | p[21] << 8 | p[22] << 16 | (uint32_t)p[23] << 24);
+	}
+
+	const uint8_t *p = &buf[8 + 3 * task_size];
+
+	TEST_ASSERT_EQUAL(0, strcmp((const char *)p, "values"));
+	TEST_ASSERT_EQUAL(100000, p[16] | p[17] << 8 | p[18] << 16 | (uint32_t)p[19] << 24);
+	TEST_ASSERT_EQUAL(101006, p[20] | p[21] << 8 | p[22] << 16 | (uint32_t)p[23] << 24);
+	TEST_ASSERT_EQUAL(0, p[24] | p[25] | p[26] | p[27]);
+	TEST_ASSERT_EQUAL(2, p[28 + 2 * 4]);
+
+	TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, task_prof_dump(&task_prof, buf, len - 1, &len));
+}
+
+/* The table, the percentiles are the upper bounds of their buckets */
+static void test_print(void) {
+	char out[2048] = {0};
+	FILE *file = tmpfile();
+	int saved = dup(STDOUT_FILENO);
+
+	fflush(stdout);
+	dup2(fileno(file), STDOUT_FILENO);
+	task_prof_print(&task_prof);
+	fflush(stdout);
+	dup2(saved, STDOUT_FILENO);
+	close(saved);
+
+	rewind(file);
+	fread(out, 1, sizeof(out) - 1, file);
+	fclose(file);
+
+	char *tasks = strstr(out, "Task ");
+	char *busiest = strstr(out, task_prof.tasks[0].name);
+	char *callbacks = strstr(out, "Callback ");
+
+	TEST_ASSERT(tasks != NULL && busiest > tasks && callbacks > busiest);
+
+	/* 6 values, 16 us on average, P50 in [2, 4) and P99 in the open bucket */
+	uint32_t row[5];
+
+	hist_row(callbacks, "values", row);
+	TEST_ASSERT(row[0] == 6 && row[1] == 16834 && row[2] == 4 && row[3] == 100000 && row[4] == 100000);
+
+	/* 0 to 99 us, 64 % of them below 64 us */
+	hist_row(callbacks, "stress", row);
+	TEST_ASSERT(row[0] == 40000 && row[1] == 49 && row[2] == 64 && row[3] == 128 && row[4] == 99);
+}
+
+/***************************** END OF FILE ************************************/
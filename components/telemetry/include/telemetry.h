@@ -0,0 +1,111 @@
+/**
+  ******************************************************************************
+  * @file           : telemetry.h
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Binary COBS framed telemetry of sample_bus samples
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+#include "esp_err.h"
+#include "sample_bus.h"
+
+/* Exported macro ------------------------------------------------------------*/
+#define TELEMETRY_RECORD_SIZE	11
+#define TELEMETRY_FRAME_SIZE	(TELEMETRY_RECORD_SIZE + 2)	/* COBS code byte and delimiter */
+
+/* Exported typedef ----------------------------------------------------------*/
+/* Output callback, returns 0 on success */
+typedef int (*telemetry_write_t)(const uint8_t *data, size_t len, void *arg);
+
+typedef struct {
+	telemetry_write_t write;
+	void *arg;
+	uint8_t frame[TELEMETRY_FRAME_SIZE];
+	uint32_t frames;			/* Frames sent */
+	uint32_t errors;			/* Frames the callback failed to send */
+} telemetry_t;
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions prototypes ---------------------------------------------*/
+/**
+  * @brief Function to initialize a telemetry instance
+  *
+  * @param me    : Pointer to a telemetry_t structure
+  * @param write : Output callback, NULL to write to stdout
+  * @param arg   : Argument passed to the callback
+  *
+  * @retval ESP_OK
+  */
+esp_err_t telemetry_init(telemetry_t * const me, telemetry_write_t write, void *arg);
+
+/**
+  * @brief Function to encode a sample into a COBS frame
+  *
+  * @param channel : Sample bus channel of the sample
+  * @param sample  : Pointer to the sample
+  * @param frame   : Buffer of TELEMETRY_FRAME_SIZE bytes to store the frame
+  *
+  * @retval Frame length, delimiter included
+  */
+size_t telemetry_encode(uint8_t channel, const sample_t *sample, uint8_t *frame);
+
+/**
+  * @brief Function to encode a sample and send its frame
+  *
+  * @param me      : Pointer to a telemetry_t structure
+  * @param channel : Sample bus channel of the sample
+  * @param sample  : Pointer to the sample
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_FAIL if the callback failed
+  */
+esp_err_t telemetry_send(telemetry_t * const me, uint8_t channel, const sample_t *sample);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TELEMETRY_H_ */
+
+/***************************** END OF FILE ************************************/
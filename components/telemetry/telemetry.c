@@ -0,0 +1,175 @@
+/**
+  ******************************************************************************
+  * @file           : telemetry.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Binary COBS framed telemetry of sample_bus samples
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+
+#include "telemetry.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define VALUE_SCALE		1000.0f
+#define CRC_POLYNOMIAL	0x07
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+static int stdout_write(const uint8_t *data, size_t len, void *arg);
+static void put_le32(uint8_t *buf, uint32_t value);
+static int32_t to_fixed(float value);
+static uint8_t calc_crc(const uint8_t *data, size_t len);
+static size_t cobs_encode(const uint8_t *src, size_t len, uint8_t *dst);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief Function to initialize a telemetry instance
+  */
+esp_err_t telemetry_init(telemetry_t * const me, telemetry_write_t write, void *arg) {
+	me->write = write != NULL ? write : stdout_write;
+	me->arg = arg;
+	me->frames = 0;
+	me->errors = 0;
+
+	return ESP_OK;
+}
+
+/**
+  * @brief Function to encode a sample into a COBS frame
+  */
+size_t telemetry_encode(uint8_t channel, const sample_t *sample, uint8_t *frame) {
+	uint8_t record[TELEMETRY_RECORD_SIZE];
+
+	record[0] = channel;
+	put_le32(&record[1], (uint32_t)(sample->timestamp / 1000));
+	put_le32(&record[5], (uint32_t)to_fixed(sample->value));
+	record[9] = sample->accuracy;
+	record[10] = calc_crc(record, TELEMETRY_RECORD_SIZE - 1);
+
+	size_t len = cobs_encode(record, TELEMETRY_RECORD_SIZE, frame);
+	frame[len++] = 0x00;
+
+	return len;
+}
+
+/**
+  * @brief Function to encode a sample and send its frame
+  */
+esp_err_t telemetry_send(telemetry_t * const me, uint8_t channel, const sample_t *sample) {
+	size_t len = telemetry_encode(channel, sample, me->frame);
+
+	if (me->write(me->frame, len, me->arg) != 0) {
+		me->errors++;
+		return ESP_FAIL;
+	}
+
+	me->frames++;
+
+	return ESP_OK;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static int stdout_write(const uint8_t *data, size_t len, void *arg) {
+	return fwrite(data, 1, len, stdout) == len ? 0 : -1;
+}
+
+static void put_le32(uint8_t *buf, uint32_t value) {
+	buf[0] = value;
+	buf[1] = value >> 8;
+	buf[2] = value >> 16;
+	buf[3] = value >> 24;
+}
+
+static int32_t to_fixed(float value) {
+	float scaled = value * VALUE_SCALE;
+
+	/* Saturate instead of wrapping, NaN ends up as 0 */
+	if (scaled >= (float)INT32_MAX) {
+		return INT32_MAX;
+	}
+
+	if (scaled <= (float)INT32_MIN) {
+		return INT32_MIN;
+	}
+
+	if (scaled != scaled) {
+		return 0;
+	}
+
+	return (int32_t)(scaled < 0.0f ? scaled - 0.5f : scaled + 0.5f);
+}
+
+static uint8_t calc_crc(const uint8_t *data, size_t len) {
+	uint8_t crc = 0x00;
+
+	for (size_t i = 0; i < len; i++) {
+		crc ^= data[i];
+
+		for (uint8_t bit = 0; bit < 8; bit++) {
+			crc = crc & 0x80 ? (crc << 1) ^ CRC_POLYNOMIAL : crc << 1;
+		}
+	}
+
+	return crc;
+}
+
+static size_t cobs_encode(const uint8_t *src, size_t len, uint8_t *dst) {
+	/* Each code byte holds the distance to the next zero, the zeros are
+	 * dropped so the only one in the frame is the delimiter. Records are
+	 * shorter than 254 bytes, a single code block never overflows */
+	size_t code_pos = 0;
+	size_t out = 1;
+	uint8_t code = 1;
+
+	for (size_t i = 0; i < len; i++) {
+		if (src[i] == 0x00) {
+			dst[code_pos] = code;
+			code_pos = out++;
+			code = 1;
+		}
+		else {
+			dst[out++] = src[i];
+			code++;
+		}
+	}
+
+	dst[code_pos] = code;
+
+	return out;
+}
+
+/***************************** END OF FILE ************************************/
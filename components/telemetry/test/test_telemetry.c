@@ -0,0 +1,264 @@
+/**
+  ******************************************************************************
+  * @file           : test_telemetry.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Host test of the COBS telemetry frames
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "telemetry.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define SINK_SIZE				256
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+/* Fields of a decoded record */
+typedef struct {
+	uint8_t channel;
+	uint32_t timestamp;			/* In ms */
+	int32_t value;				/* In thousandths */
+	uint8_t accuracy;
+} record_t;
+
+/* Serial port the frames are written to */
+typedef struct {
+	uint8_t data[SINK_SIZE];
+	size_t len;
+	bool fail;
+} sink_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+static uint8_t crc8(const uint8_t *data, size_t len);
+static bool frame_decode(const uint8_t *frame, size_t len, record_t *record);
+static int sink_write(const uint8_t *data, size_t len, void *arg);
+static void test_crc(void);
+static void test_encode(void);
+static void test_zeros(void);
+static void test_fixed_point(void);
+static void test_send(void);
+
+/* Main ----------------------------------------------------------------------*/
+int main(void) {
+	RUN_TEST(test_crc);
+	RUN_TEST(test_encode);
+	RUN_TEST(test_zeros);
+	RUN_TEST(test_fixed_point);
+	RUN_TEST(test_send);
+
+	return 0;
+}
+
+/* Private functions ---------------------------------------------------------*/
+/* CRC-8 of the decoder, polynomial 0x07 from 0 */
+static uint8_t crc8(const uint8_t *data, size_t len) {
+	uint8_t crc = 0x00;
+
+	for (size_t i = 0; i < len; i++) {
+		crc ^= data[i];
+
+		for (uint8_t bit = 0; bit < 8; bit++) {
+			crc = crc & 0x80 ? (crc << 1) ^ 0x07 : crc << 1;
+		}
+	}
+
+	return crc;
+}
+
+/* Decodes a frame as tools/telemetry_decode.py does, the delimiter included */
+static bool frame_decode(const uint8_t *frame, size_t len, record_t *record) {
+	uint8_t out[TELEMETRY_RECORD_SIZE];
+	size_t out_len = 0;
+
+	if (len < 2 || frame[len - 1] != 0x00 || memchr(frame, 0x00, len - 1) != NULL) {
+		return false;
+	}
+
+	len--;
+
+	for (size_t i = 0; i < len;) {
+		uint8_t code = frame[i];
+
+		if (i + code > len || out_len + code - 1 > sizeof(out)) {
+			return false;
+		}
+
+		memcpy(&out[out_len], &frame[i + 1], code - 1);
+		out_len += code - 1;
+		i += code;
+
+		if (code < 0xFF && i < len) {
+			if (out_len == sizeof(out)) {
+				return false;
+			}
+
+			out[out_len++] = 0x00;
+		}
+	}
+
+	if (out_len != TELEMETRY_RECORD_SIZE || crc8(out, out_len - 1) != out[out_len - 1]) {
+		return false;
+	}
+
+	record->channel = out[0];
+	record->timestamp = out[1] | out[2] << 8 | out[3] << 16 | (uint32_t)out[4] << 24;
+	record->value = (int32_t)(out[5] | out[6] << 8 | out[7] << 16 | (uint32_t)out[8] << 24);
+	record->accuracy = out[9];
+
+	return true;
+}
+
+static int sink_write(const uint8_t *data, size_t len, void *arg) {
+	sink_t *sink = arg;
+
+	if (sink->fail || sink->len + len > sizeof(sink->data)) {
+		return -1;
+	}
+
+	memcpy(&sink->data[sink->len], data, len);
+	sink->len += len;
+
+	return 0;
+}
+
+static void test_crc(void) {
+	TEST_ASSERT_EQUAL(0xF4, crc8((const uint8_t *)"123456789", 9));
+}
+
+/* A frame is the COBS encoded record and the only zero, its delimiter */
+static void test_encode(void) {
+	uint8_t frame[TELEMETRY_FRAME_SIZE];
+	record_t record;
+	sample_t sample = {
+			.timestamp = 1234567890,
+			.value = 23.456f,
+			.accuracy = 3,
+	};
+
+	size_t len = telemetry_encode(7, &sample, frame);
+
+	TEST_ASSERT_EQUAL(TELEMETRY_FRAME_SIZE, len);
+	TEST_ASSERT(frame_decode(frame, len, &record));
+	TEST_ASSERT_EQUAL(7, record.channel);
+	TEST_ASSERT_EQUAL(1234567, record.timestamp);
+	TEST_ASSERT_EQUAL(23456, record.value);
+	TEST_ASSERT_EQUAL(3, record.accuracy);
+
+	/* A corrupted byte is caught by the CRC */
+	frame[3] ^= 0x10;
+	TEST_ASSERT(!frame_decode(frame, len, &record));
+}
+
+/* A record of zeros still has no zero before the delimiter */
+static void test_zeros(void) {
+	uint8_t frame[TELEMETRY_FRAME_SIZE];
+	record_t record;
+	sample_t sample = {0};
+
+	size_t len = telemetry_encode(0, &sample, frame);
+
+	TEST_ASSERT_EQUAL(TELEMETRY_FRAME_SIZE, len);
+	TEST_ASSERT(frame_decode(frame, len, &record));
+	TEST_ASSERT_EQUAL(0, record.channel);
+	TEST_ASSERT_EQUAL(0, record.timestamp);
+	TEST_ASSERT_EQUAL(0, record.value);
+	TEST_ASSERT_EQUAL(0, record.accuracy);
+}
+
+/* Values are rounded to thousandths and saturate, NaN is sent as 0 */
+static void test_fixed_point(void) {
+	const struct {
+		float value;
+		int32_t expected;
+	} cases[] = {
+			{-45.0f, -45000},
+			{101325.0f, 101325000},
+			{0.0004f, 0},
+			{0.0006f, 1},
+			{-0.0006f, -1},
+			{1e12f, INT32_MAX},
+			{-1e12f, INT32_MIN},
+			{NAN, 0},
+	};
+	uint8_t frame[TELEMETRY_FRAME_SIZE];
+	record_t record;
+
+	for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+		sample_t sample = {.value = cases[i].value};
+
+		TEST_ASSERT(frame_decode(frame, telemetry_encode(1, &sample, frame), &record));
+		TEST_ASSERT_EQUAL(cases[i].expected, record.value);
+	}
+}
+
+/* The frames are written back to back and the failures counted */
+static void test_send(void) {
+	telemetry_t telemetry;
+	sink_t sink = {0};
+	record_t record;
+
+	TEST_ASSERT_EQUAL(ESP_OK, telemetry_init(&telemetry, sink_write, &sink));
+
+	for (uint8_t i = 0; i < 3; i++) {
+		sample_t sample = {
+				.timestamp = i * 1000000,
+				.value = i,
+				.accuracy = i,
+		};
+
+		TEST_ASSERT_EQUAL(ESP_OK, telemetry_send(&telemetry, i, &sample));
+	}
+
+	TEST_ASSERT_EQUAL(3, telemetry.frames);
+	TEST_ASSERT_EQUAL(3 * TELEMETRY_FRAME_SIZE, sink.len);
+
+	for (uint8_t i = 0; i < 3; i++) {
+		TEST_ASSERT(frame_decode(&sink.data[i * TELEMETRY_FRAME_SIZE], TELEMETRY_FRAME_SIZE, &record));
+		TEST_ASSERT_EQUAL(i, record.channel);
+		TEST_ASSERT_EQUAL(i * 1000, record.timestamp);
+		TEST_ASSERT_EQUAL(i * 1000, record.value);
+	}
+
+	sink.fail = true;
+	sample_t sample = {0};
+
+	TEST_ASSERT_EQUAL(ESP_FAIL, telemetry_send(&telemetry, 0, &sample));
+	TEST_ASSERT_EQUAL(3, telemetry.frames);
+	TEST_ASSERT_EQUAL(1, telemetry.errors);
+}
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+# Decode the COBS framed telemetry records of the telemetry component to CSV
+#
+# Usage:
+#   telemetry_decode.py [-n NAMES] [INPUT]
+#
+# INPUT is a capture file or a serial port, stdin if omitted. Bytes outside
+# of valid frames (console text, corrupted frames) are skipped, a summary of
+# the frames decoded and dropped is written to stderr at the end.
+
+import argparse
+import csv
+import struct
+import sys
+
+RECORD_SIZE = 11
+FRAME_SIZE = RECORD_SIZE + 1    # COBS code byte, delimiter excluded
+CRC_POLYNOMIAL = 0x07
+
+
+def crc8(data):
+    crc = 0x00
+
+    for byte in data:
+        crc ^= byte
+
+        for _ in range(8):
+            crc = ((crc << 1) ^ CRC_POLYNOMIAL) if crc & 0x80 else crc << 1
+            crc &= 0xFF
+
+    return crc
+
+
+def cobs_decode(frame):
+    out = bytearray()
+    i = 0
+
+    while i < len(frame):
+        code = frame[i]
+
+        if code == 0 or i + code > len(frame) + 1:
+            return None
+
+        out += frame[i + 1:i + code]
+        i += code
+
+        if code < 0xFF and i < len(frame):
+            out.append(0)
+
+    return bytes(out)
+
+
+def decode_record(frame):
+    record = cobs_decode(frame)
+
+    if record is None or len(record) != RECORD_SIZE or crc8(record[:-1]) != record[-1]:
+        return None
+
+    channel, timestamp, value, accuracy = struct.unpack('<BIiB', record[:-1])
+
+    return channel, timestamp, value / 1000.0, accuracy
+
+
+def open_input(path):
+    if path is None:
+        return sys.stdin.buffer
+
+    try:
+        import serial
+        return serial.Serial(path, 115200)
+    except (ImportError, ValueError, OSError):
+        return open(path, 'rb')
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode telemetry frames to CSV")
+    parser.add_argument('input', nargs='?', help='capture file or serial port')
+    parser.add_argument('-n', '--names', help='comma separated channel names, in channel order')
+    args = parser.parse_args()
+
+    names = args.names.split(',') if args.names else []
+    writer = csv.writer(sys.stdout)
+    writer.writerow(['timestamp_ms', 'channel', 'value', 'accuracy'])
+
+    stream = open_input(args.input)
+    frame = bytearray()
+    decoded = 0
+    dropped = 0
+
+    try:
+        while True:
+            byte = stream.read(1)
+
+            if not byte:
+                break
+
+            if byte != b'\x00':
+                frame += byte
+                continue
+
+            # A delimiter closes the frame, the frames have a fixed size so
+            # console text received before one is cut off
+            if frame:
+                sample = decode_record(frame[-FRAME_SIZE:])
+
+                if sample is None:
+                    dropped += 1
+                else:
+                    channel, timestamp, value, accuracy = sample
+                    name = names[channel] if channel < len(names) else channel
+                    writer.writerow([timestamp, name, value, accuracy])
+                    decoded += 1
+
+            frame.clear()
+    except KeyboardInterrupt:
+        pass
+
+    print(f'{decoded} frames decoded, {dropped} dropped', file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
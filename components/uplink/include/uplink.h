@@ -0,0 +1,133 @@
+/**
+  ******************************************************************************
+  * @file           : uplink.h
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Batched store and forward uplink over MQTT
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef UPLINK_H_
+#define UPLINK_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include "esp_err.h"
+#include "esp_netif.h"
+#include "mqtt_client.h"
+#include "nvs.h"
+#include "sdkconfig.h"
+#include "sample_store.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+
+/* Exported macro ------------------------------------------------------------*/
+
+/* Exported typedef ----------------------------------------------------------*/
+typedef struct {
+	sample_store_t *store;
+	sample_store_cursor_t cursor;	/* First block not acknowledged */
+	esp_netif_t *netif;
+	esp_mqtt_client_handle_t client;
+	nvs_handle_t nvs;
+	TaskHandle_t task_handle;
+	EventGroupHandle_t events;
+	StaticEventGroup_t events_buffer;
+	atomic_uint pending;			/* Samples stored since the last batch */
+	atomic_int acked;				/* Message id of the last PUBACK */
+	uint8_t payload[CONFIG_UPLINK_PAYLOAD_SIZE];
+
+	/* Statistics */
+	uint32_t batches;				/* Batches sent completely */
+	uint32_t messages;				/* Messages acknowledged */
+	uint32_t bytes;					/* Payload bytes acknowledged */
+	uint32_t failures;				/* Batches left for the next period */
+	esp_err_t status;				/* Result of the last batch */
+} uplink_t;
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions prototypes ---------------------------------------------*/
+/**
+  * @brief Function to initialize the uplink and create its task
+  *
+  * @note NVS must be initialized, Wi-Fi is configured but only started for
+  *       each batch
+  *
+  * @param me       : Pointer to a uplink_t structure
+  * @param store    : Pointer to the initialized sample store to forward
+  * @param ssid     : Wi-Fi network name
+  * @param password : Wi-Fi password
+  * @param priority : Priority of the uplink task
+  *
+  * @retval
+  * 	- ESP_OK on success
+  * 	- ESP_ERR_NO_MEM if the task can't be created
+  * 	- Others from the Wi-Fi, netif, event loop, MQTT and NVS init
+  */
+esp_err_t uplink_init(uplink_t * const me, sample_store_t *store, const char *ssid, const char *password, UBaseType_t priority);
+
+/**
+  * @brief Function to count the samples appended to the store, a batch is
+  *        started once CONFIG_UPLINK_BATCH_SAMPLES are pending
+  *
+  * @param me      : Pointer to a uplink_t structure
+  * @param samples : Number of samples appended
+  */
+void uplink_add(uplink_t * const me, uint32_t samples);
+
+/**
+  * @brief Function to send the stored samples now, without waiting for the
+  *        batch size or period, and wait for the batch to end
+  *
+  * @param me      : Pointer to a uplink_t structure
+  * @param timeout : Ticks to wait for the batch
+  *
+  * @retval
+  * 	- ESP_OK if the samples were sent, or there were none
+  * 	- ESP_ERR_TIMEOUT if the batch didn't end in time
+  * 	- Others from the batch, the samples are left for the next one
+  */
+esp_err_t uplink_flush(uplink_t * const me, TickType_t timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UPLINK_H_ */
+
+/***************************** END OF FILE ************************************/
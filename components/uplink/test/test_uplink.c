@@ -0,0 +1,613 @@
+/**
+  ******************************************************************************
+  * @file           : test_uplink.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Host test of the uplink batches against a fake broker
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdatomic.h>
+#include <string.h>
+#include <time.h>
+
+#include "host_test.h"
+#include "esp_rom_crc.h"
+#include "esp_timer.h"
+#include "esp_wifi.h"
+#include "uplink.h"
+
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define SECTOR_SIZE				4096
+#define PARTITION_SECTORS		16
+#define PARTITION_PATH			"test_uplink.bin"
+#define CHANNELS_NUM			8
+#define BOOTS_NUM				16
+#define HANDLERS_NUM			4
+#define RECEIVED_SIZE			(64 * 1024)
+#define FLUSH_TIMEOUT			pdMS_TO_TICKS(5000)
+#define ASSOCIATION_MS			100		/* Time of a failed association */
+#define THROUGHPUT_SAMPLES		2000	/* Per channel */
+#define THROUGHPUT_MSGS_PER_S	1000	/* Per CPU second */
+#define SSID					"test_ssid"
+#define PASSWORD				"test_password"
+
+/* External variables --------------------------------------------------------*/
+ESP_EVENT_DEFINE_BASE(WIFI_EVENT);
+ESP_EVENT_DEFINE_BASE(IP_EVENT);
+
+/* Private typedef -----------------------------------------------------------*/
+struct esp_netif_obj {
+	int unused;
+};
+
+struct esp_mqtt_client {
+	esp_event_handler_t handler;
+	void *arg;
+};
+
+typedef struct {
+	esp_event_base_t base;
+	int32_t id;
+	esp_mqtt_event_t mqtt;		/* Data of the MQTT events */
+	uint32_t delay_ms;			/* Before the event is dispatched */
+} event_t;
+
+typedef struct {
+	esp_event_base_t base;
+	int32_t id;
+	esp_event_handler_t handler;
+	void *arg;
+} handler_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const float resolutions[CHANNELS_NUM] = {0.01f, 0.01f, 1.0f, 0.01f, 1.0f, 1.0f, 0.001f, 0.01f};
+static const char *MQTT_EVENTS = "MQTT_EVENTS";
+static const esp_partition_t *partition;
+static sample_store_t store;
+static uint32_t appended;			/* Samples of every channel in the store */
+
+/* A reboot leaves the task of the previous instance behind, blocked */
+static uplink_t uplinks[BOOTS_NUM];
+static uplink_t *uplink;
+static uint32_t boots_num;
+
+/* Event loop */
+static QueueHandle_t events;
+static SemaphoreHandle_t handlers_mutex;
+static handler_t handlers[HANDLERS_NUM];
+static uint32_t handlers_num;
+
+/* Access point and broker */
+static struct esp_netif_obj netif;
+static struct esp_mqtt_client clients[BOOTS_NUM];
+static uint32_t clients_num;
+static wifi_config_t wifi_config;
+static atomic_bool ap_up;
+static atomic_bool broker_up;
+static atomic_bool wifi_started;
+static atomic_bool wifi_connected;
+static atomic_bool mqtt_connected;
+static atomic_bool ack_inline;		/* PUBACK before the publish call returns */
+static atomic_int acks_left;		/* Before the acks are lost, -1 for no limit */
+static atomic_uint wifi_starts;
+static atomic_uint published;
+static atomic_int msg_ids;
+
+/* Payload of the messages acknowledged, the lost ones are resent */
+static uint8_t received[RECEIVED_SIZE];
+static size_t received_len;
+
+/* Private function prototypes -----------------------------------------------*/
+static void event_post(esp_event_base_t base, int32_t id, const esp_mqtt_event_t *mqtt, uint32_t delay_ms);
+static void event_task(void *arg);
+static void network_reset(void);
+static void store_fill(uint32_t n);
+static void received_check(uint32_t expected);
+static void boot(void);
+static void setup(void);
+static void test_empty(void);
+static void test_batch(void);
+static void test_threshold(void);
+static void test_no_wifi(void);
+static void test_no_broker(void);
+static void test_lost_ack(void);
+static void test_ack_inline(void);
+static void test_reboot(void);
+static void test_throughput(void);
+
+/* Main ----------------------------------------------------------------------*/
+int main(void) {
+	partition = host_partition_add(CONFIG_SAMPLE_STORE_PARTITION_LABEL, PARTITION_SECTORS * SECTOR_SIZE, PARTITION_PATH);
+	TEST_ASSERT(partition != NULL);
+
+	RUN_TEST(test_empty);
+	RUN_TEST(test_batch);
+	RUN_TEST(test_threshold);
+	RUN_TEST(test_no_wifi);
+	RUN_TEST(test_no_broker);
+	RUN_TEST(test_lost_ack);
+	RUN_TEST(test_ack_inline);
+	RUN_TEST(test_reboot);
+	RUN_TEST(test_throughput);
+
+	return 0;
+}
+
+/* Fake event loop -----------------------------------------------------------*/
+esp_err_t esp_event_loop_create_default(void) {
+	if (events != NULL) {
+		return ESP_ERR_INVALID_STATE;
+	}
+
+	events = xQueueCreate(16, sizeof(event_t));
+	handlers_mutex = xSemaphoreCreateMutex();
+	xTaskCreate(event_task, "sys_evt", 4096, NULL, 20, NULL);
+
+	return ESP_OK;
+}
+
+esp_err_t esp_event_handler_register(esp_event_base_t event_base, int32_t event_id, esp_event_handler_t event_handler, void *event_handler_arg) {
+	esp_err_t ret = ESP_ERR_NO_MEM;
+
+	xSemaphoreTake(handlers_mutex, portMAX_DELAY);
+
+	if (handlers_num < HANDLERS_NUM) {
+		handlers[handlers_num++] = (handler_t) {event_base, event_id, event_handler, event_handler_arg};
+		ret = ESP_OK;
+	}
+
+	xSemaphoreGive(handlers_mutex);
+
+	return ret;
+}
+
+/* Fake Wi-Fi ----------------------------------------------------------------*/
+esp_err_t esp_netif_init(void) {
+	return ESP_OK;
+}
+
+esp_netif_t *esp_netif_create_default_wifi_sta(void) {
+	return &netif;
+}
+
+esp_err_t esp_wifi_init(const wifi_init_config_t *config) {
+	return config->magic == WIFI_INIT_CONFIG_MAGIC ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t esp_wifi_set_storage(wifi_storage_t storage) {
+	return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_mode(wifi_mode_t mode) {
+	return mode == WIFI_MODE_STA ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t esp_wifi_set_config(wifi_interface_t interface, wifi_config_t *conf) {
+	wifi_config = *conf;
+
+	return ESP_OK;
+}
+
+esp_err_t esp_wifi_start(void) {
+	atomic_store(&wifi_started, true);
+	atomic_fetch_add(&wifi_starts, 1);
+	event_post(WIFI_EVENT, WIFI_EVENT_STA_START, NULL, 0);
+
+	return ESP_OK;
+}
+
+esp_err_t esp_wifi_stop(void) {
+	atomic_store(&wifi_started, false);
+	atomic_store(&wifi_connected, false);
+
+	return ESP_OK;
+}
+
+esp_err_t esp_wifi_connect(void) {
+	if (!atomic_load(&wifi_started)) {
+		return ESP_FAIL;
+	}
+
+	if (atomic_load(&ap_up)) {
+		atomic_store(&wifi_connected, true);
+		event_post(IP_EVENT, IP_EVENT_STA_GOT_IP, NULL, 0);
+	}
+	else {
+		event_post(WIFI_EVENT, WIFI_EVENT_STA_DISCONNECTED, NULL, ASSOCIATION_MS);
+	}
+
+	return ESP_OK;
+}
+
+/* Fake broker ---------------------------------------------------------------*/
+esp_mqtt_client_handle_t esp_mqtt_client_init(const esp_mqtt_client_config_t *config) {
+	TEST_ASSERT_EQUAL(0, strcmp(config->broker.address.uri, CONFIG_UPLINK_BROKER_URI));
+
+	return clients_num < BOOTS_NUM ? &clients[clients_num++] : NULL;
+}
+
+esp_err_t esp_mqtt_client_register_event(esp_mqtt_client_handle_t client, esp_mqtt_event_id_t event, esp_event_handler_t event_handler, void *event_handler_arg) {
+	client->handler = event_handler;
+	client->arg = event_handler_arg;
+
+	return ESP_OK;
+}
+
+esp_err_t esp_mqtt_client_start(esp_mqtt_client_handle_t client) {
+	/* Without the broker the client keeps trying, silently */
+	if (atomic_load(&wifi_connected) && atomic_load(&broker_up)) {
+		esp_mqtt_event_t event = {.event_id = MQTT_EVENT_CONNECTED, .client = client};
+
+		atomic_store(&mqtt_connected, true);
+		event_post(MQTT_EVENTS, MQTT_EVENT_CONNECTED, &event, 0);
+	}
+
+	return ESP_OK;
+}
+
+esp_err_t esp_mqtt_client_stop(esp_mqtt_client_handle_t client) {
+	atomic_store(&mqtt_connected, false);
+
+	return ESP_OK;
+}
+
+int esp_mqtt_client_publish(esp_mqtt_client_handle_t client, const char *topic, const char *data, int len, int qos, int retain) {
+	if (!atomic_load(&mqtt_connected)) {
+		return -1;
+	}
+
+	TEST_ASSERT_EQUAL(0, strcmp(topic, CONFIG_UPLINK_TOPIC));
+	TEST_ASSERT_EQUAL(1, qos);
+	TEST_ASSERT(len <= CONFIG_UPLINK_PAYLOAD_SIZE);
+
+	int msg_id = atomic_fetch_add(&msg_ids, 1) + 1;
+
+	atomic_fetch_add(&published, 1);
+
+	/* A lost message or PUBACK, the same to the client */
+	if (atomic_load(&acks_left) == 0) {
+		return msg_id;
+	}
+
+	if (atomic_load(&acks_left) > 0) {
+		atomic_fetch_sub(&acks_left, 1);
+	}
+
+	TEST_ASSERT(received_len + len <= sizeof(received));
+	memcpy(&received[received_len], data, len);
+	received_len += len;
+
+	esp_mqtt_event_t event = {.event_id = MQTT_EVENT_PUBLISHED, .client = client, .msg_id = msg_id};
+
+	if (atomic_load(&ack_inline)) {
+		client->handler(client->arg, MQTT_EVENTS, MQTT_EVENT_PUBLISHED, &event);
+	}
+	else {
+		event_post(MQTT_EVENTS, MQTT_EVENT_PUBLISHED, &event, 0);
+	}
+
+	return msg_id;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static void event_post(esp_event_base_t base, int32_t id, const esp_mqtt_event_t *mqtt, uint32_t delay_ms) {
+	event_t event = {
+			.base = base,
+			.id = id,
+			.delay_ms = delay_ms,
+	};
+
+	if (mqtt != NULL) {
+		event.mqtt = *mqtt;
+	}
+
+	xQueueSend(events, &event, portMAX_DELAY);
+}
+
+/* Dispatches the events one at a time, as the default event loop task */
+static void event_task(void *arg) {
+	event_t event;
+
+	for (;;) {
+		xQueueReceive(events, &event, portMAX_DELAY);
+		vTaskDelay(pdMS_TO_TICKS(event.delay_ms));
+
+		if (event.base == MQTT_EVENTS) {
+			esp_mqtt_client_handle_t client = event.mqtt.client;
+
+			client->handler(client->arg, MQTT_EVENTS, event.id, &event.mqtt);
+			continue;
+		}
+
+		xSemaphoreTake(handlers_mutex, portMAX_DELAY);
+
+		for (uint32_t i = 0; i < handlers_num; i++) {
+			handler_t *handler = &handlers[i];
+
+			if (handler->base == event.base && (handler->id == ESP_EVENT_ANY_ID || handler->id == event.id)) {
+				handler->handler(handler->arg, event.base, event.id, NULL);
+			}
+		}
+
+		xSemaphoreGive(handlers_mutex);
+	}
+}
+
+static void network_reset(void) {
+	atomic_store(&ap_up, true);
+	atomic_store(&broker_up, true);
+	atomic_store(&ack_inline, false);
+	atomic_store(&acks_left, -1);
+	atomic_store(&wifi_starts, 0);
+	atomic_store(&published, 0);
+	received_len = 0;
+}
+
+/* Appends n samples to every channel of the store */
+static void store_fill(uint32_t n) {
+	for (uint8_t channel = 0; channel < CHANNELS_NUM; channel++) {
+		for (uint32_t i = 0; i < n; i++) {
+			uint32_t k = appended + i;
+			sample_t sample = {
+					.timestamp = (int64_t)k * 1000000,
+					.value = channel * 10.0f + (float)(rand() % 100) * resolutions[channel],
+					.id = channel,
+			};
+
+			TEST_ASSERT_EQUAL(ESP_OK, sample_store_append(&store, channel, &sample, 1));
+		}
+	}
+
+	appended += n;
+}
+
+/* Every sample acknowledged once, in blocks with a valid CRC */
+static void received_check(uint32_t expected) {
+	uint32_t counts[CHANNELS_NUM] = {0};
+
+	for (size_t offset = 0; offset < received_len;) {
+		sample_store_block_t block;
+
+		memcpy(&block, &received[offset], sizeof(block));
+		TEST_ASSERT(block.channel < CHANNELS_NUM);
+		TEST_ASSERT(offset + sizeof(block) + block.len <= received_len);
+
+		uint32_t crc = esp_rom_crc32_le(0, (const uint8_t *)&block, offsetof(sample_store_block_t, crc));
+		crc = esp_rom_crc32_le(crc, &received[offset + sizeof(block)], block.len);
+		TEST_ASSERT_EQUAL(block.crc, crc);
+
+		counts[block.channel] += block.count;
+		offset += sizeof(block) + block.len;
+	}
+
+	for (uint8_t channel = 0; channel < CHANNELS_NUM; channel++) {
+		TEST_ASSERT_EQUAL(expected, counts[channel]);
+	}
+}
+
+/* Mounts the store and starts a new uplink, as a reset does */
+static void boot(void) {
+	TEST_ASSERT(boots_num < BOOTS_NUM);
+
+	if (handlers_mutex != NULL) {
+		xSemaphoreTake(handlers_mutex, portMAX_DELAY);
+		handlers_num = 0;
+		xSemaphoreGive(handlers_mutex);
+	}
+
+	memset(&store, 0, sizeof(store));
+	TEST_ASSERT_EQUAL(ESP_OK, sample_store_init(&store, resolutions, CHANNELS_NUM));
+
+	uplink = &uplinks[boots_num++];
+	TEST_ASSERT_EQUAL(ESP_OK, uplink_init(uplink, &store, SSID, PASSWORD, 5));
+}
+
+/* A new device, blank flash and NVS */
+static void setup(void) {
+	host_partition_fill(partition, 0xFF);
+	host_nvs_erase();
+	network_reset();
+	appended = 0;
+	srand(1);
+
+	boot();
+}
+
+/* Nothing to send, the radio stays off */
+static void test_empty(void) {
+	setup();
+
+	TEST_ASSERT_EQUAL(0, strcmp((const char *)wifi_config.sta.ssid, SSID));
+	TEST_ASSERT_EQUAL(0, strcmp((const char *)wifi_config.sta.password, PASSWORD));
+
+	TEST_ASSERT_EQUAL(ESP_OK, uplink_flush(uplink, FLUSH_TIMEOUT));
+	TEST_ASSERT_EQUAL(0, atomic_load(&wifi_starts));
+	TEST_ASSERT_EQUAL(0, host_nvs_writes());
+}
+
+/* The samples take several messages, the radio is on for the batch only */
+static void test_batch(void) {
+	setup();
+	store_fill(500);
+
+	TEST_ASSERT_EQUAL(ESP_OK, uplink_flush(uplink, FLUSH_TIMEOUT));
+	received_check(500);
+	TEST_ASSERT(atomic_load(&published) > 1);
+	TEST_ASSERT_EQUAL(atomic_load(&published), uplink->messages);
+	TEST_ASSERT_EQUAL(received_len, uplink->bytes);
+	TEST_ASSERT_EQUAL(1, uplink->batches);
+	TEST_ASSERT_EQUAL(1, atomic_load(&wifi_starts));
+	TEST_ASSERT(!atomic_load(&wifi_started));
+	TEST_ASSERT(!atomic_load(&mqtt_connected));
+
+	/* The cursor is saved once per batch */
+	TEST_ASSERT_EQUAL(1, host_nvs_writes());
+
+	/* Already sent */
+	TEST_ASSERT_EQUAL(ESP_OK, uplink_flush(uplink, FLUSH_TIMEOUT));
+	TEST_ASSERT_EQUAL(1, atomic_load(&wifi_starts));
+	TEST_ASSERT_EQUAL(1, host_nvs_writes());
+}
+
+/* A batch starts by itself once enough samples are pending */
+static void test_threshold(void) {
+	setup();
+	store_fill(CONFIG_UPLINK_BATCH_SAMPLES / CHANNELS_NUM);
+
+	uplink_add(uplink, CONFIG_UPLINK_BATCH_SAMPLES - 1);
+	vTaskDelay(pdMS_TO_TICKS(200));
+	TEST_ASSERT_EQUAL(0, atomic_load(&wifi_starts));
+
+	uplink_add(uplink, 1);
+
+	for (uint32_t i = 0; i < 500 && uplink->batches == 0; i++) {
+		vTaskDelay(pdMS_TO_TICKS(10));
+	}
+
+	TEST_ASSERT_EQUAL(1, uplink->batches);
+	received_check(CONFIG_UPLINK_BATCH_SAMPLES / CHANNELS_NUM);
+
+	/* The count starts again after the batch */
+	uplink_add(uplink, CONFIG_UPLINK_BATCH_SAMPLES - 1);
+	vTaskDelay(pdMS_TO_TICKS(200));
+	TEST_ASSERT_EQUAL(1, atomic_load(&wifi_starts));
+}
+
+/* Without the access point the batch is left for the next period */
+static void test_no_wifi(void) {
+	setup();
+	store_fill(100);
+	atomic_store(&ap_up, false);
+
+	TEST_ASSERT_EQUAL(ESP_ERR_TIMEOUT, uplink_flush(uplink, FLUSH_TIMEOUT));
+	TEST_ASSERT_EQUAL(1, uplink->failures);
+	TEST_ASSERT_EQUAL(0, atomic_load(&published));
+	TEST_ASSERT(!atomic_load(&wifi_started));
+	TEST_ASSERT_EQUAL(0, host_nvs_writes());
+
+	atomic_store(&ap_up, true);
+
+	TEST_ASSERT_EQUAL(ESP_OK, uplink_flush(uplink, FLUSH_TIMEOUT));
+	received_check(100);
+}
+
+static void test_no_broker(void) {
+	setup();
+	store_fill(100);
+	atomic_store(&broker_up, false);
+
+	TEST_ASSERT_EQUAL(ESP_ERR_TIMEOUT, uplink_flush(uplink, FLUSH_TIMEOUT));
+	TEST_ASSERT_EQUAL(1, uplink->failures);
+	TEST_ASSERT_EQUAL(0, atomic_load(&published));
+	TEST_ASSERT(!atomic_load(&wifi_started));
+
+	atomic_store(&broker_up, true);
+
+	TEST_ASSERT_EQUAL(ESP_OK, uplink_flush(uplink, FLUSH_TIMEOUT));
+	received_check(100);
+}
+
+/* The messages acknowledged are kept, the rest are sent again */
+static void test_lost_ack(void) {
+	setup();
+	store_fill(500);
+	atomic_store(&acks_left, 2);
+
+	TEST_ASSERT_EQUAL(ESP_ERR_TIMEOUT, uplink_flush(uplink, FLUSH_TIMEOUT));
+	TEST_ASSERT_EQUAL(2, uplink->messages);
+	TEST_ASSERT_EQUAL(3, atomic_load(&published));
+	TEST_ASSERT_EQUAL(1, host_nvs_writes());
+	TEST_ASSERT(!atomic_load(&wifi_started));
+
+	atomic_store(&acks_left, -1);
+
+	TEST_ASSERT_EQUAL(ESP_OK, uplink_flush(uplink, FLUSH_TIMEOUT));
+	received_check(500);
+}
+
+/* The PUBACK handled before the publish call returns its message id */
+static void test_ack_inline(void) {
+	setup();
+	store_fill(500);
+	atomic_store(&ack_inline, true);
+
+	TEST_ASSERT_EQUAL(ESP_OK, uplink_flush(uplink, FLUSH_TIMEOUT));
+	received_check(500);
+	TEST_ASSERT_EQUAL(atomic_load(&published), uplink->messages);
+}
+
+/* The blocks acknowledged before a reset aren't sent again */
+static void test_reboot(void) {
+	setup();
+	store_fill(300);
+	TEST_ASSERT_EQUAL(ESP_OK, uplink_flush(uplink, FLUSH_TIMEOUT));
+
+	boot();
+	TEST_ASSERT_EQUAL(ESP_OK, uplink_flush(uplink, FLUSH_TIMEOUT));
+	TEST_ASSERT_EQUAL(1, atomic_load(&wifi_starts));
+
+	store_fill(200);
+	TEST_ASSERT_EQUAL(ESP_OK, uplink_flush(uplink, FLUSH_TIMEOUT));
+	TEST_ASSERT_EQUAL(2, atomic_load(&wifi_starts));
+	received_check(500);
+}
+
+/* A batch goes out as the stored blocks, well under the size of the samples
+ * taken, and the uplink isn't what limits the messages per second. The CPU
+ * time of the process doesn't depend on the load of the host */
+static void test_throughput(void) {
+	setup();
+	store_fill(THROUGHPUT_SAMPLES);
+
+	int64_t start = esp_timer_get_time();
+	clock_t cpu_start = clock();
+
+	TEST_ASSERT_EQUAL(ESP_OK, uplink_flush(uplink, FLUSH_TIMEOUT));
+
+	int64_t elapsed = esp_timer_get_time() - start;
+	int64_t cpu_us = (int64_t)(clock() - cpu_start) * 1000000 / CLOCKS_PER_SEC;
+	uint32_t samples = THROUGHPUT_SAMPLES * CHANNELS_NUM;
+	float per_sample = (float)uplink->bytes / samples;
+	uint64_t per_s = (uint64_t)uplink->messages * 1000000 / (elapsed ? elapsed : 1);
+	uint64_t per_cpu_s = (uint64_t)uplink->messages * 1000000 / (cpu_us ? cpu_us : 1);
+
+	printf("%" PRIu32 " samples in %" PRIu32 " messages of %" PRIu32 " B, %.2f B/sample against %zu B taken\n",
+			samples, uplink->messages, uplink->bytes, per_sample, sizeof(sample_t));
+	printf("%" PRId64 " us, %" PRIu64 " messages/s, %" PRIu64 " per CPU second\n", elapsed, per_s, per_cpu_s);
+
+	received_check(THROUGHPUT_SAMPLES);
+	TEST_ASSERT(per_sample * 4 < sizeof(sample_t));
+	TEST_ASSERT(per_cpu_s > THROUGHPUT_MSGS_PER_S);
+}
+
+/***************************** END OF FILE ************************************/
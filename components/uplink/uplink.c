@@ -0,0 +1,389 @@
+/**
+  ******************************************************************************
+  * @file           : uplink.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Batched store and forward uplink over MQTT
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <inttypes.h>
+
+#include "uplink.h"
+#include "esp_log.h"
+#include "esp_wifi.h"
+#include "esp_event.h"
+#include "esp_timer.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define NVS_NAMESPACE		"uplink"
+#define NVS_CURSOR_KEY		"cursor"
+
+/* Event bits */
+#define WIFI_CONNECTED_BIT	BIT0
+#define MQTT_CONNECTED_BIT	BIT1
+#define PUBLISHED_BIT		BIT2
+#define SESSION_BIT			BIT3		/* The link is wanted, reconnect on loss */
+#define BATCH_DONE_BIT		BIT4
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static const char *TAG = "uplink";
+
+/* Private function prototypes -----------------------------------------------*/
+static void uplink_task(void *arg);
+static esp_err_t link_up(uplink_t * const me);
+static void link_down(uplink_t * const me);
+static esp_err_t batch_send(uplink_t * const me);
+static void wifi_event_handler(void *arg, esp_event_base_t base, int32_t id, void *data);
+static void mqtt_event_handler(void *arg, esp_event_base_t base, int32_t id, void *data);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief Function to initialize the uplink and create its task
+  */
+esp_err_t uplink_init(uplink_t * const me, sample_store_t *store, const char *ssid, const char *password, UBaseType_t priority) {
+	ESP_LOGI(TAG, "Initializing uplink instance...");
+
+	me->store = store;
+	me->batches = 0;
+	me->messages = 0;
+	me->bytes = 0;
+	me->failures = 0;
+	me->status = ESP_OK;
+	atomic_init(&me->pending, 0);
+	atomic_init(&me->acked, -1);
+
+	me->events = xEventGroupCreateStatic(&me->events_buffer);
+
+	/* Blocks acknowledged before the last reset aren't sent again */
+	esp_err_t ret = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &me->nvs);
+
+	if (ret != ESP_OK) {
+		ESP_LOGE(TAG, "Failed to open NVS namespace");
+		return ret;
+	}
+
+	size_t len = sizeof(me->cursor);
+
+	if (nvs_get_blob(me->nvs, NVS_CURSOR_KEY, &me->cursor, &len) != ESP_OK || len != sizeof(me->cursor)) {
+		memset(&me->cursor, 0, sizeof(me->cursor));
+	}
+
+	/* Wi-Fi station, configured once and started for each batch */
+	ret = esp_netif_init();
+
+	if (ret == ESP_OK) {
+		ret = esp_event_loop_create_default();
+	}
+
+	if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
+		ESP_LOGE(TAG, "Failed to initialize the network interface");
+		return ret;
+	}
+
+	me->netif = esp_netif_create_default_wifi_sta();
+
+	wifi_init_config_t init_config = WIFI_INIT_CONFIG_DEFAULT();
+	wifi_config_t wifi_config = {
+			.sta = {
+					.threshold.authmode = WIFI_AUTH_WPA2_PSK,
+			},
+	};
+
+	strlcpy((char *)wifi_config.sta.ssid, ssid, sizeof(wifi_config.sta.ssid));
+	strlcpy((char *)wifi_config.sta.password, password, sizeof(wifi_config.sta.password));
+
+	ret = esp_wifi_init(&init_config);
+
+	if (ret == ESP_OK) {
+		ret = esp_wifi_set_storage(WIFI_STORAGE_RAM);
+	}
+
+	if (ret == ESP_OK) {
+		ret = esp_wifi_set_mode(WIFI_MODE_STA);
+	}
+
+	if (ret == ESP_OK) {
+		ret = esp_wifi_set_config(WIFI_IF_STA, &wifi_config);
+	}
+
+	if (ret == ESP_OK) {
+		ret = esp_event_handler_register(WIFI_EVENT, ESP_EVENT_ANY_ID, wifi_event_handler, me);
+	}
+
+	if (ret == ESP_OK) {
+		ret = esp_event_handler_register(IP_EVENT, IP_EVENT_STA_GOT_IP, wifi_event_handler, me);
+	}
+
+	if (ret != ESP_OK) {
+		ESP_LOGE(TAG, "Failed to initialize Wi-Fi");
+		return ret;
+	}
+
+	esp_mqtt_client_config_t mqtt_config = {
+			.broker.address.uri = CONFIG_UPLINK_BROKER_URI,
+	};
+
+	me->client = esp_mqtt_client_init(&mqtt_config);
+
+	if (me->client == NULL) {
+		ESP_LOGE(TAG, "Failed to create the MQTT client");
+		return ESP_FAIL;
+	}
+
+	ret = esp_mqtt_client_register_event(me->client, ESP_EVENT_ANY_ID, mqtt_event_handler, me);
+
+	if (ret != ESP_OK) {
+		return ret;
+	}
+
+	if (xTaskCreate(uplink_task,
+			"uplink task",
+			CONFIG_UPLINK_TASK_STACK_SIZE,
+			me,
+			priority,
+			&me->task_handle) != pdPASS) {
+		ESP_LOGE(TAG, "Failed to create the uplink task");
+		return ESP_ERR_NO_MEM;
+	}
+
+	return ESP_OK;
+}
+
+/**
+  * @brief Function to count the samples appended to the store, a batch is
+  *        started once CONFIG_UPLINK_BATCH_SAMPLES are pending
+  */
+void uplink_add(uplink_t * const me, uint32_t samples) {
+	uint32_t pending = atomic_fetch_add_explicit(&me->pending, samples, memory_order_relaxed) + samples;
+
+	/* Only the crossing notifies, the task resets the count */
+	if (pending >= CONFIG_UPLINK_BATCH_SAMPLES && pending - samples < CONFIG_UPLINK_BATCH_SAMPLES) {
+		xTaskNotifyGive(me->task_handle);
+	}
+}
+
+/**
+  * @brief Function to send the stored samples now and wait for the batch
+  */
+esp_err_t uplink_flush(uplink_t * const me, TickType_t timeout) {
+	xEventGroupClearBits(me->events, BATCH_DONE_BIT);
+	xTaskNotifyGive(me->task_handle);
+
+	if (!(xEventGroupWaitBits(me->events, BATCH_DONE_BIT, pdTRUE, pdTRUE, timeout) & BATCH_DONE_BIT)) {
+		return ESP_ERR_TIMEOUT;
+	}
+
+	return me->status;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static void uplink_task(void *arg) {
+	uplink_t *me = (uplink_t *)arg;
+
+	for (;;) {
+		/* Every N samples or T seconds, whatever comes first */
+		ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CONFIG_UPLINK_BATCH_PERIOD_S * 1000));
+		atomic_store_explicit(&me->pending, 0, memory_order_relaxed);
+
+		/* Partial blocks are sent too, the samples can't wait for them to
+		 * fill */
+		if (sample_store_flush(me->store) != ESP_OK) {
+			ESP_LOGW(TAG, "Failed to flush the sample store");
+		}
+
+		me->status = batch_send(me);
+
+		if (me->status == ESP_OK) {
+			me->batches++;
+		}
+		else {
+			me->failures++;
+		}
+
+		xEventGroupSetBits(me->events, BATCH_DONE_BIT);
+	}
+}
+
+static esp_err_t batch_send(uplink_t * const me) {
+	sample_store_cursor_t next;
+	size_t len;
+
+	esp_err_t ret = sample_store_read_blocks(me->store, &me->cursor, &next, me->payload, sizeof(me->payload), &len);
+
+	/* Nothing new, the radio stays off */
+	if (ret != ESP_OK || len == 0) {
+		return ret;
+	}
+
+	int64_t start = esp_timer_get_time();
+	uint32_t messages = 0;
+
+	ret = link_up(me);
+
+	while (ret == ESP_OK && len) {
+		int msg_id = esp_mqtt_client_publish(me->client, CONFIG_UPLINK_TOPIC, (const char *)me->payload, len, 1, 0);
+
+		if (msg_id < 0) {
+			ret = ESP_FAIL;
+			break;
+		}
+
+		/* The PUBACK can arrive before the publish call returns */
+		TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(CONFIG_UPLINK_ACK_TIMEOUT_S * 1000);
+
+		while (atomic_load(&me->acked) != msg_id) {
+			TickType_t now = xTaskGetTickCount();
+
+			if ((int32_t)(deadline - now) <= 0 ||
+					!(xEventGroupWaitBits(me->events, PUBLISHED_BIT, pdTRUE, pdFALSE, deadline - now) & PUBLISHED_BIT)) {
+				break;
+			}
+		}
+
+		if (atomic_load(&me->acked) != msg_id) {
+			ESP_LOGW(TAG, "Message %d not acknowledged", msg_id);
+			ret = ESP_ERR_TIMEOUT;
+			break;
+		}
+
+		me->cursor = next;
+		me->messages++;
+		me->bytes += len;
+		messages++;
+
+		ret = sample_store_read_blocks(me->store, &me->cursor, &next, me->payload, sizeof(me->payload), &len);
+	}
+
+	link_down(me);
+
+	/* Once per batch, the NVS sectors don't wear on every message */
+	if (messages) {
+		if (nvs_set_blob(me->nvs, NVS_CURSOR_KEY, &me->cursor, sizeof(me->cursor)) != ESP_OK ||
+				nvs_commit(me->nvs) != ESP_OK) {
+			ESP_LOGW(TAG, "Failed to save the cursor");
+		}
+
+		ESP_LOGI(TAG, "%" PRIu32 " messages sent in %" PRId64 " ms", messages, (esp_timer_get_time() - start) / 1000);
+	}
+
+	if (ret != ESP_OK) {
+		ESP_LOGW(TAG, "Batch left for the next period: %s", esp_err_to_name(ret));
+	}
+
+	return ret;
+}
+
+static esp_err_t link_up(uplink_t * const me) {
+	xEventGroupClearBits(me->events, WIFI_CONNECTED_BIT | MQTT_CONNECTED_BIT | PUBLISHED_BIT);
+	xEventGroupSetBits(me->events, SESSION_BIT);
+
+	esp_err_t ret = esp_wifi_start();
+
+	if (ret != ESP_OK) {
+		return ret;
+	}
+
+	EventBits_t bits = xEventGroupWaitBits(me->events, WIFI_CONNECTED_BIT, pdFALSE, pdTRUE,
+			pdMS_TO_TICKS(CONFIG_UPLINK_CONNECT_TIMEOUT_S * 1000));
+
+	if (!(bits & WIFI_CONNECTED_BIT)) {
+		ESP_LOGW(TAG, "No Wi-Fi connection");
+		return ESP_ERR_TIMEOUT;
+	}
+
+	ret = esp_mqtt_client_start(me->client);
+
+	if (ret != ESP_OK) {
+		return ret;
+	}
+
+	bits = xEventGroupWaitBits(me->events, MQTT_CONNECTED_BIT, pdFALSE, pdTRUE,
+			pdMS_TO_TICKS(CONFIG_UPLINK_CONNECT_TIMEOUT_S * 1000));
+
+	if (!(bits & MQTT_CONNECTED_BIT)) {
+		ESP_LOGW(TAG, "No broker connection");
+		return ESP_ERR_TIMEOUT;
+	}
+
+	return ESP_OK;
+}
+
+static void link_down(uplink_t * const me) {
+	xEventGroupClearBits(me->events, SESSION_BIT);
+
+	/* Turns the radio off until the next batch */
+	esp_mqtt_client_stop(me->client);
+	esp_wifi_stop();
+}
+
+static void wifi_event_handler(void *arg, esp_event_base_t base, int32_t id, void *data) {
+	uplink_t *me = (uplink_t *)arg;
+
+	if (base == WIFI_EVENT && id == WIFI_EVENT_STA_START) {
+		esp_wifi_connect();
+	}
+	else if (base == WIFI_EVENT && id == WIFI_EVENT_STA_DISCONNECTED) {
+		xEventGroupClearBits(me->events, WIFI_CONNECTED_BIT);
+
+		if (xEventGroupGetBits(me->events) & SESSION_BIT) {
+			esp_wifi_connect();
+		}
+	}
+	else if (base == IP_EVENT && id == IP_EVENT_STA_GOT_IP) {
+		xEventGroupSetBits(me->events, WIFI_CONNECTED_BIT);
+	}
+}
+
+static void mqtt_event_handler(void *arg, esp_event_base_t base, int32_t id, void *data) {
+	uplink_t *me = (uplink_t *)arg;
+	esp_mqtt_event_handle_t event = (esp_mqtt_event_handle_t)data;
+
+	switch ((esp_mqtt_event_id_t)id) {
+		case MQTT_EVENT_CONNECTED:
+			xEventGroupSetBits(me->events, MQTT_CONNECTED_BIT);
+			break;
+		case MQTT_EVENT_DISCONNECTED:
+			xEventGroupClearBits(me->events, MQTT_CONNECTED_BIT);
+			break;
+		case MQTT_EVENT_PUBLISHED:
+			atomic_store(&me->acked, event->msg_id);
+			xEventGroupSetBits(me->events, PUBLISHED_BIT);
+			break;
+		default:
+			break;
+	}
+}
+
+/***************************** END OF FILE ************************************/
@@ -1,87 +1,215 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include <unistd.h>
+#include <inttypes.h>
 
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_cpu.h"
+#include "esp_sleep.h"
+#include "nvs_flash.h"
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/event_groups.h"
 
 #include "i2c_bus.h"
+#include "i2c_bus_async.h"
 #include "adpd188.h"
 #include "at24cs0x.h"
 #include "bsec2.h"
+#include "bsec2_state.h"
 #include "button.h"
 #include "shtc3.h"
+#include "shtc3_async.h"
 #include "tpl5010.h"
-#include "mics6814.h"
+#include "mics6814_cont.h"
 #include "esp_buzzer.h"
 #include "esp_rgb_led.h"
+#include "sample_bus.h"
+#include "sample_store.h"
+#include "uplink.h"
+#include "sensor_sched.h"
+#include "telemetry.h"
+#include "dlog.h"
+#include "duty_cycle.h"
+#include "power_mgmt.h"
+#include "task_prof.h"
+#include "cycle_trace.h"
+
+/* Interval to poll BSEC while a measurement is in progress */
+#define BSEC_POLL_PERIOD_MS	20
+#define SHTC3_PERIOD_MS		1000
+#define SHTC3_RETRY_MS		10
+
+/* Logger runs between reports of the output cost */
+#define OUTPUT_STATS_RUNS	60
+
+/* Samples appended to the store at once */
+#define STORE_BATCH_SIZE	8
+
+/* Sampling round of a duty cycle */
+#define SHTC3_DONE_BIT		BIT0
+#define MICS6814_DONE_BIT	BIT1
+#define ROUND_DONE_BITS		(SHTC3_DONE_BIT | MICS6814_DONE_BIT)
+#define UPLINK_TIMEOUT_MS	((2 * CONFIG_UPLINK_CONNECT_TIMEOUT_S + CONFIG_UPLINK_ACK_TIMEOUT_S) * 1000)
+
+/* Sample bus channels, one per signal and single producer each */
+typedef enum {
+	SHTC3_TEMP_CHANNEL = 0,
+	SHTC3_HUM_CHANNEL,
+	BSEC_TEMP_CHANNEL,
+	BSEC_HUM_CHANNEL,
+	BSEC_PRES_CHANNEL,
+	BSEC_IAQ_CHANNEL,
+	BSEC_VOC_CHANNEL,
+	BSEC_CO2_CHANNEL,
+	GAS_CHANNEL,
+	MAX_CHANNEL = GAS_CHANNEL + MICS6814_CONT_GAS_NUM,
+} channel_e;
 
 static i2c_bus_t i2c_bus;
+static i2c_bus_async_t i2c_bus_async;
 static at24cs0x_t at24cs01;
 static bsec2_t bsec2;
+static bsec2_state_t bsec2_state;
+static uint8_t iaq_accuracy;
 static button_t button;
 static tpl5010_t tpl5010;
 static shtc3_t shtc3;
-static mics6814_t mics6814;
+static shtc3_async_t shtc3_async;
+static mics6814_cont_t mics6814;
 static esp_buzzer_t buzzer;
 static esp_rgb_led_t led;
 
-static float temp = 0.0f, hum = 0.0f;
+static sensor_sched_t sensor_sched;
+static sample_bus_channel_t channels[MAX_CHANNEL];
+static sample_bus_reader_t readers[MAX_CHANNEL];
+static telemetry_t telemetry;
+static uplink_t uplink;
+static power_mgmt_t power_mgmt;
+static task_prof_t task_prof;
+
+#ifdef CONFIG_OPERATING_MODE_DUTY_CYCLE
+static duty_cycle_t duty_cycle;
+static EventGroupHandle_t round_events;
+static StaticEventGroup_t round_events_buffer;
+
+/* The block buffers go on filling across deep sleep */
+RTC_NOINIT_ATTR static sample_store_t sample_store;
+#else
+static sample_store_t sample_store;
+#endif
+
+/* The sample time base, esp_timer starts over on every deep sleep wake up */
+static int64_t time_offset;
+
+static const char *channel_names[MAX_CHANNEL] = {
+		[SHTC3_TEMP_CHANNEL] = "temp",
+		[SHTC3_HUM_CHANNEL] = "hum",
+		[BSEC_TEMP_CHANNEL] = "bsec temp",
+		[BSEC_HUM_CHANNEL] = "bsec hum",
+		[BSEC_PRES_CHANNEL] = "bsec pres",
+		[BSEC_IAQ_CHANNEL] = "bsec iaq",
+		[BSEC_VOC_CHANNEL] = "bsec voc",
+		[BSEC_CO2_CHANNEL] = "bsec co2",
+		[GAS_CHANNEL + CO_GAS] = "gas co",
+		[GAS_CHANNEL + NO2_GAS] = "gas no2",
+		[GAS_CHANNEL + NH3_GAS] = "gas nh3",
+		[GAS_CHANNEL + C3H8_GAS] = "gas c3h8",
+		[GAS_CHANNEL + C4H10_GAS] = "gas c4h10",
+		[GAS_CHANNEL + CH4_GAS] = "gas ch4",
+		[GAS_CHANNEL + H2_GAS] = "gas h2",
+		[GAS_CHANNEL + C2H5OH_GAS] = "gas c2h5oh",
+};
+
+/* Stored value steps, in the units of each signal */
+static const float store_resolutions[MAX_CHANNEL] = {
+		[SHTC3_TEMP_CHANNEL] = 0.01f,	/* deg C */
+		[SHTC3_HUM_CHANNEL] = 0.01f,	/* %RH */
+		[BSEC_TEMP_CHANNEL] = 0.01f,	/* deg C */
+		[BSEC_HUM_CHANNEL] = 0.01f,		/* %RH */
+		[BSEC_PRES_CHANNEL] = 1.0f,		/* Pa */
+		[BSEC_IAQ_CHANNEL] = 0.1f,
+		[BSEC_VOC_CHANNEL] = 0.01f,		/* ppm */
+		[BSEC_CO2_CHANNEL] = 1.0f,		/* ppm */
+		[GAS_CHANNEL + CO_GAS] = 0.01f,	/* ppm */
+		[GAS_CHANNEL + NO2_GAS] = 0.01f,
+		[GAS_CHANNEL + NH3_GAS] = 0.01f,
+		[GAS_CHANNEL + C3H8_GAS] = 0.01f,
+		[GAS_CHANNEL + C4H10_GAS] = 0.01f,
+		[GAS_CHANNEL + CH4_GAS] = 0.01f,
+		[GAS_CHANNEL + H2_GAS] = 0.01f,
+		[GAS_CHANNEL + C2H5OH_GAS] = 0.01f,
+};
 
 static const char *TAG = "test";
 
+TASK_PROF_HIST_DEFINE(bsec_hist, "bsec_callback");
+
 static void bsec_check_status(bsec2_t * const bsec) {
 	if (bsec->status < BSEC_OK) {
-		ESP_LOGE(TAG, "BSEC error code: %d", bsec->status);
+		DLOGE(TAG, "BSEC error code: %d", bsec->status);
 	}
 	else if (bsec->status > BSEC_OK) {
-		ESP_LOGW(TAG, "BSEC warning code: %d", bsec->status);
+		DLOGW(TAG, "BSEC warning code: %d", bsec->status);
 	}
 	else if (bsec->sensor.status < BME68X_OK) {
-		ESP_LOGE(TAG, "BME68x error code: %d", bsec->sensor.status);
+		DLOGE(TAG, "BME68x error code: %d", bsec->sensor.status);
 	}
 	else if (bsec->sensor.status > BME68X_OK) {
-		ESP_LOGW(TAG, "BME68x warning code: %d", bsec->sensor.status);
+		DLOGW(TAG, "BME68x warning code: %d", bsec->sensor.status);
 	}
 }
 
-static void bsec_callback(const bme68x_data_t bme68x_data, const bsec_outputs_t outputs, bsec2_t bsec) {
-	if (!outputs.n_outputs) {
-		return;
-	}
+static void publish(channel_e channel, uint16_t id, float value, uint8_t accuracy, int64_t timestamp) {
+	sample_t sample = {
+			.timestamp = timestamp + time_offset,
+			.value = value,
+			.id = id,
+			.accuracy = accuracy,
+	};
 
-	printf("FSM_BSEC_DATA_EVENT\r\n");
+	sample_bus_publish(&channels[channel], &sample);
+}
+
+static void bsec_callback(const bme68x_data_t bme68x_data, const bsec_outputs_t outputs, bsec2_t bsec) {
+	TASK_PROF_START(start);
 
+	/* Called from bsec2_run(), only hand the outputs over */
 	for (uint8_t i = 0; i < outputs.n_outputs; i++) {
 		const bsec_data_t output = outputs.output[i];
+		channel_e channel;
 
 		switch (output.sensor_id) {
 			case BSEC_OUTPUT_RAW_TEMPERATURE:
-				printf("\ttemp: %f", output.signal);
+				channel = BSEC_TEMP_CHANNEL;
 				break;
 			case BSEC_OUTPUT_RAW_HUMIDITY:
-				printf("\thum: %f", output.signal);
+				channel = BSEC_HUM_CHANNEL;
 				break;
 			case BSEC_OUTPUT_RAW_PRESSURE:
-				printf("\tpres: %f", output.signal);
+				channel = BSEC_PRES_CHANNEL;
 				break;
 			case BSEC_OUTPUT_IAQ:
-				printf("\tiaq: %d", (int)output.signal);
+				channel = BSEC_IAQ_CHANNEL;
+				iaq_accuracy = output.accuracy;
 				break;
 			case BSEC_OUTPUT_BREATH_VOC_EQUIVALENT:
-				printf("\tvoc: %f", output.signal);
+				channel = BSEC_VOC_CHANNEL;
 				break;
 			case BSEC_OUTPUT_CO2_EQUIVALENT:
-				printf("\tco2: %f", output.signal);
+				channel = BSEC_CO2_CHANNEL;
 				break;
 			default:
-				break;
+				continue;
 		}
-		printf("\n");
+
+		/* BSEC time stamps are in ns */
+		publish(channel, output.sensor_id, output.signal, output.accuracy, output.time_stamp / 1000);
 	}
-	printf("\r\n");
+
+	TASK_PROF_END(bsec_hist, start);
 }
 
 static esp_err_t bsec_lib_init(void) {
@@ -103,6 +231,11 @@ static esp_err_t bsec_lib_init(void) {
 		bsec_check_status(&bsec2);
 	}
 
+	/* Start from the last calibration instead of from scratch */
+	if (bsec2_state_restore(&bsec2_state, &bsec2) != ESP_OK) {
+		ESP_LOGW(TAG, "No BSEC state restored");
+	}
+
 	if (!bsec2_update_subscription(&bsec2, sensor_list, ARRAY_LEN(sensor_list), BSEC_SAMPLE_RATE_LP)) {
 		bsec_check_status(&bsec2);
 	}
@@ -114,72 +247,337 @@ static esp_err_t bsec_lib_init(void) {
 	return ret;
 }
 
-void bsec_task(void *arg) {
-	for (;;) {
-		if (!bsec2_run(&bsec2)) {
-			bsec_check_status(&bsec2);
-		}
-		vTaskDelay(pdMS_TO_TICKS(20));
+static int64_t bsec_sample(void *arg) {
+	CYCLE_TRACE_BEGIN("bsec2_run");
+	bool ok = bsec2_run(&bsec2);
+	CYCLE_TRACE_END("bsec2_run");
+
+	if (!ok) {
+		bsec_check_status(&bsec2);
+	}
+
+	/* Collect the data of the measurement in progress */
+	if (bsec2.op_mode != BME68X_SLEEP_MODE) {
+		return esp_timer_get_time() + BSEC_POLL_PERIOD_MS * 1000;
+	}
+
+	/* Save the calibration when it's due, between measurements */
+	bsec2_state_update(&bsec2_state, &bsec2, iaq_accuracy);
+
+	/* Sleep until BSEC wants the next measurement, its time base
+	 * is in ns */
+	int64_t delay_ms = bsec2.bme_conf.next_call / 1000000 - bsec2_get_time_ms(&bsec2);
+
+	if (delay_ms < BSEC_POLL_PERIOD_MS) {
+		delay_ms = BSEC_POLL_PERIOD_MS;
 	}
+
+	return esp_timer_get_time() + delay_ms * 1000;
 }
 
-void shtc3_task(void *arg) {
-	for (;;) {
-		shtc3_get_temp_and_hum(&shtc3, &temp, &hum);
-		printf("temp: %f, hum: %f\r\n", temp, hum);
+static int64_t shtc3_sample(void *arg) {
+	static int64_t started;
+	float temp, hum;
+
+	/* Start the measurement and come back when it should be done, the bus
+	 * serves the other devices during the conversion */
+	if (!shtc3_async.started) {
+		started = esp_timer_get_time();
+
+		CYCLE_TRACE_BEGIN("shtc3_start");
+		esp_err_t ret = shtc3_start_measurement(&shtc3_async, SHTC3_ASYNC_DEFAULT_MODE);
+		CYCLE_TRACE_END("shtc3_start");
+
+		if (ret != ESP_OK) {
+			return 0;
+		}
 
-		vTaskDelay(pdMS_TO_TICKS(1000));
+		return started + shtc3_async_get_measurement_time(SHTC3_ASYNC_DEFAULT_MODE) * 1000;
 	}
+
+	CYCLE_TRACE_BEGIN("shtc3_fetch");
+	esp_err_t ret = shtc3_fetch_result(&shtc3_async, &temp, &hum);
+	CYCLE_TRACE_END("shtc3_fetch");
+
+	if (ret == ESP_ERR_NOT_FINISHED) {
+		return esp_timer_get_time() + SHTC3_RETRY_MS * 1000;
+	}
+
+	if (ret == ESP_OK) {
+		int64_t now = esp_timer_get_time();
+		publish(SHTC3_TEMP_CHANNEL, SHTC3_TEMP_CHANNEL, temp, 0, now);
+		publish(SHTC3_HUM_CHANNEL, SHTC3_HUM_CHANNEL, hum, 0, now);
+
+#ifdef CONFIG_OPERATING_MODE_DUTY_CYCLE
+		xEventGroupSetBits(round_events, SHTC3_DONE_BIT);
+#endif
+	}
+
+	return started + SHTC3_PERIOD_MS * 1000;
 }
 
-void at24cs0x_task(void *arg) {
-	for (;;) {
-		at24cs0x_read_serial_number(&at24cs01);
-		printf("serial number: ");
-		for (uint8_t i = 0; i < AT24CS0X_SN_SIZE; i++) {
-			printf("%02X", at24cs01.serial_number[i]);
+static int64_t mics6814_sample(void *arg) {
+	mics6814_gases_t gases;
+
+	/* The three channels are sampled once for all the gases */
+	CYCLE_TRACE_BEGIN("mics6814_get_all_gases");
+	esp_err_t ret = mics6814_get_all_gases(&mics6814, &gases);
+	CYCLE_TRACE_END("mics6814_get_all_gases");
+
+	if (ret == ESP_OK) {
+		int64_t now = esp_timer_get_time();
+
+		for (uint8_t i = CO_GAS; i < MICS6814_CONT_GAS_NUM; i++) {
+			publish(GAS_CHANNEL + i, i, gases.gas[i], 0, now);
 		}
-		printf("\r\n");
 
-		vTaskDelay(pdMS_TO_TICKS(1000));
+#ifdef CONFIG_OPERATING_MODE_DUTY_CYCLE
+		xEventGroupSetBits(round_events, MICS6814_DONE_BIT);
+#endif
+	}
+
+	return 0;
+}
+
+static void output_sample(channel_e channel, const sample_t *sample) {
+#ifdef CONFIG_SAMPLE_OUTPUT_BINARY
+	telemetry_send(&telemetry, channel, sample);
+#else
+	printf("%" PRId64 " %s: %f (%u)\r\n", sample->timestamp, channels[channel].name, sample->value, sample->accuracy);
+#endif
+}
+
+static void store_samples(channel_e channel, const sample_t *samples, size_t count) {
+	sample_store_append(&sample_store, channel, samples, count);
+
+	/* In the duty cycle mode the uplink is only started for its batches */
+#ifndef CONFIG_OPERATING_MODE_DUTY_CYCLE
+	uplink_add(&uplink, count);
+#endif
+}
+
+static void power_report(void) {
+	power_mgmt_stats_t stats;
+	int64_t total = 0;
+
+	if (power_mgmt_get_stats(&power_mgmt, &stats) != ESP_OK) {
+		return;
+	}
+
+	for (uint8_t i = 0; i < POWER_MGMT_MAX_MODE; i++) {
+		total += stats.time_us[i];
+	}
+
+	if (total <= 0) {
+		return;
 	}
+
+	/* Share of the time since the previous report */
+	DLOGI(TAG, "Power: sleep %" PRIu32 "%%, APB min %" PRIu32 "%%, APB max %" PRIu32 "%%, CPU max %" PRIu32 "%%",
+			(uint32_t)(stats.time_us[POWER_MGMT_LIGHT_SLEEP_MODE] * 100 / total),
+			(uint32_t)(stats.time_us[POWER_MGMT_APB_MIN_MODE] * 100 / total),
+			(uint32_t)(stats.time_us[POWER_MGMT_APB_MAX_MODE] * 100 / total),
+			(uint32_t)(stats.time_us[POWER_MGMT_CPU_MAX_MODE] * 100 / total));
 }
 
-void mics6814_task(void *arg) {
-	for (;;) {
-		for (uint8_t i = CO_GAS; i < C2H5OH_GAS; i++) {
-			printf("gas %d: %f\r\n", i, mics6814_get_gas(&mics6814, i));
+static int64_t logger_sample(void *arg) {
+	static uint32_t runs, samples, cycles;
+	sample_t batch[STORE_BATCH_SIZE];
+
+	/* Drain every channel, the producers never wait for this job */
+	for (uint8_t i = 0; i < MAX_CHANNEL; i++) {
+		size_t count = 0;
+
+		while (sample_bus_read_next(&channels[i], &readers[i], &batch[count]) == ESP_OK) {
+			uint32_t start = esp_cpu_get_cycle_count();
+			output_sample(i, &batch[count]);
+			cycles += esp_cpu_get_cycle_count() - start;
+			samples++;
+
+			if (++count == STORE_BATCH_SIZE) {
+				store_samples(i, batch, count);
+				count = 0;
+			}
+		}
+
+		if (count) {
+			store_samples(i, batch, count);
 		}
-		printf("\r\n");
 
-		vTaskDelay(pdMS_TO_TICKS(1000));
+		if (readers[i].lost) {
+			DLOGW(TAG, "%s: %" PRIu32 " samples lost", channels[i].name, readers[i].lost);
+			readers[i].lost = 0;
+		}
 	}
+
+	/* Report the CPU cost of the output format and where the time went */
+	if (++runs >= OUTPUT_STATS_RUNS && samples) {
+		DLOGI(TAG, "Output: %" PRIu32 " cycles/sample", cycles / samples);
+		power_report();
+		task_prof_sample(&task_prof);
+		runs = 0;
+		samples = 0;
+		cycles = 0;
+	}
+
+	return 0;
+}
+
+static void at24cs0x_print_serial_number(void) {
+	char serial_number[AT24CS0X_SN_SIZE * 2 + 1];
+
+	/* Read it once, at24cs01 keeps it afterwards */
+	at24cs0x_read_serial_number(&at24cs01);
+
+	for (uint8_t i = 0; i < AT24CS0X_SN_SIZE; i++) {
+		sprintf(&serial_number[i * 2], "%02X", at24cs01.serial_number[i]);
+	}
+
+	printf("serial number: %s\r\n", serial_number);
 }
 
 void button_task(void *arg) {
 	printf("%s\r\n", (char*)arg);
 }
 
+static void button_prof_task(void *arg) {
+	/* CPU shares of the last logger report, stacks and callbacks since boot */
+	task_prof_print(&task_prof);
+}
+
+static void button_trace_task(void *arg) {
+	/* Converted on the host by components/cycle_trace/tools/cycle_trace_json.py */
+	cycle_trace_dump();
+}
+
+static esp_err_t nvs_init(void) {
+	esp_err_t ret = nvs_flash_init();
+
+	/* The partition is erased if it is full or was written by a newer NVS
+	 * version */
+	if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+		ESP_ERROR_CHECK(nvs_flash_erase());
+		ret = nvs_flash_init();
+	}
+
+	return ret;
+}
+
+#ifdef CONFIG_OPERATING_MODE_DUTY_CYCLE
+static void duty_cycle_round(void) {
+	/* Wait for a sample of every sensor, no longer than the budget */
+	xEventGroupWaitBits(round_events, ROUND_DONE_BITS, pdFALSE, pdTRUE,
+			pdMS_TO_TICKS(duty_cycle_get_remaining_ms(&duty_cycle)));
+
+	logger_sample(NULL);
+
+	/* The samples stay in the RTC block buffers until they fill, only the
+	 * uplink cycles flush them */
+	if (duty_cycle.rtc->cycles % CONFIG_DUTY_CYCLE_UPLINK_CYCLES == 0) {
+		esp_err_t ret = uplink_init(&uplink, &sample_store, CONFIG_ESP_WIFI_SSID, CONFIG_ESP_WIFI_PASSWORD, tskIDLE_PRIORITY + 2);
+
+		if (ret == ESP_OK) {
+			ret = uplink_flush(&uplink, pdMS_TO_TICKS(UPLINK_TIMEOUT_MS));
+		}
+
+		if (ret != ESP_OK) {
+			ESP_LOGW(TAG, "Uplink failed: %s", esp_err_to_name(ret));
+		}
+	}
+
+	/* Let the deferred logs out before the RAM is lost */
+	dlog_flush(pdMS_TO_TICKS(100));
+
+	duty_cycle_sleep(&duty_cycle);
+}
+#endif
+
 void app_main(void) {
-	ESP_ERROR_CHECK(mics6814_init(&mics6814,
+#ifdef CONFIG_OPERATING_MODE_DUTY_CYCLE
+	/* First, the budget of the cycle counts from here */
+	ESP_ERROR_CHECK(duty_cycle_init(&duty_cycle, GPIO_NUM_38));
+	time_offset = duty_cycle_get_time() - esp_timer_get_time();
+	round_events = xEventGroupCreateStatic(&round_events_buffer);
+#endif
+
+	ESP_ERROR_CHECK(dlog_init(tskIDLE_PRIORITY + 1));
+	ESP_ERROR_CHECK(nvs_init());
+
+	/* The CPU slows down or sleeps whenever no driver holds a lock */
+	if (power_mgmt_init(&power_mgmt) != ESP_OK) {
+		ESP_LOGW(TAG, "Running without power management");
+	}
+
+	if (task_prof_init(&task_prof) != ESP_OK) {
+		ESP_LOGW(TAG, "Running without task profiling");
+	}
+
+	for (uint8_t i = 0; i < MAX_CHANNEL; i++) {
+		sample_bus_channel_init(&channels[i], channel_names[i]);
+		sample_bus_reader_init(&channels[i], &readers[i]);
+	}
+
+	ESP_ERROR_CHECK(telemetry_init(&telemetry, NULL, NULL));
+
+#ifdef CONFIG_OPERATING_MODE_DUTY_CYCLE
+	if (duty_cycle.resumed) {
+		ESP_ERROR_CHECK(sample_store_resume(&sample_store, store_resolutions, MAX_CHANNEL));
+	}
+	else {
+		ESP_ERROR_CHECK(sample_store_init(&sample_store, store_resolutions, MAX_CHANNEL));
+	}
+#else
+	ESP_ERROR_CHECK(sample_store_init(&sample_store, store_resolutions, MAX_CHANNEL));
+	ESP_ERROR_CHECK(uplink_init(&uplink, &sample_store, CONFIG_ESP_WIFI_SSID, CONFIG_ESP_WIFI_PASSWORD, tskIDLE_PRIORITY + 2));
+#endif
+
+	ESP_ERROR_CHECK(mics6814_cont_init(&mics6814,
 			ADC_CHANNEL_3, /* NH3 */
 			ADC_CHANNEL_4, /* CO */
 			ADC_CHANNEL_5)); /* NO2 */
+#ifndef CONFIG_OPERATING_MODE_DUTY_CYCLE
+	/* In the duty cycle mode duty_cycle drives DONE, WAKE isn't an RTC GPIO */
 	ESP_ERROR_CHECK(tpl5010_init(&tpl5010, GPIO_NUM_37, GPIO_NUM_38));
+#endif
 	ESP_ERROR_CHECK(i2c_bus_init(&i2c_bus, I2C_NUM_0, GPIO_NUM_33, GPIO_NUM_34, true, true, 400000));
 	ESP_ERROR_CHECK(at24cs0x_init(&at24cs01, &i2c_bus, AT24CS0X_I2C_ADDRESS, NULL, NULL));
+	ESP_ERROR_CHECK(i2c_bus_async_init(&i2c_bus_async, tskIDLE_PRIORITY + 6));
 	ESP_ERROR_CHECK(shtc3_init(&shtc3, &i2c_bus, SHTC3_I2C_ADDR, NULL, NULL));
+	ESP_ERROR_CHECK(shtc3_async_init(&shtc3_async, &shtc3, &i2c_bus_async));
+
+#ifdef CONFIG_OPERATING_MODE_DUTY_CYCLE
+	ESP_ERROR_CHECK(sensor_sched_init(&sensor_sched, tskIDLE_PRIORITY + 5));
+	ESP_ERROR_CHECK(sensor_sched_add(&sensor_sched, "shtc3", shtc3_sample, NULL, SHTC3_PERIOD_MS));
+	ESP_ERROR_CHECK(sensor_sched_add(&sensor_sched, "mics6814", mics6814_sample, NULL, 1000));
+
+	duty_cycle_round();
+#else
+	ESP_ERROR_CHECK(bsec2_state_init(&bsec2_state));
 	ESP_ERROR_CHECK(bsec_lib_init());
 	ESP_ERROR_CHECK(esp_rgb_led_init(&led, GPIO_NUM_9, 1));
-	ESP_ERROR_CHECK(esp_buzzer_init(&buzzer, GPIO_NUM_21));
+	ESP_ERROR_CHECK(esp_buzzer_init(&buzzer, GPIO_NUM_21, ESP_BUZZER_GPIO_BACKEND));
 	ESP_ERROR_CHECK(button_init(&button, GPIO_NUM_0, tskIDLE_PRIORITY + 6, configMINIMAL_STACK_SIZE * 4));
 	button_register_cb(&button, SHORT_TIME, button_task, "Hello World!");
+	button_register_cb(&button, MEDIUM_TIME, button_prof_task, NULL);
+	button_register_cb(&button, LONG_TIME, button_trace_task, NULL);
+
+	/* A press must wake the chip up from light sleep, the button is active
+	 * low */
+	ESP_ERROR_CHECK(gpio_wakeup_enable(GPIO_NUM_0, GPIO_INTR_LOW_LEVEL));
+	ESP_ERROR_CHECK(esp_sleep_enable_gpio_wakeup());
 
 	esp_rgb_led_blink_start(&led, 200, 120, 63, 32);
 	esp_buzzer_start(&buzzer, 100, 300, 0);
 
-	xTaskCreate(shtc3_task, "shtc3 task", configMINIMAL_STACK_SIZE * 4, NULL, tskIDLE_PRIORITY + 3, NULL);
-	xTaskCreate(bsec_task, "bsec task", configMINIMAL_STACK_SIZE * 4, NULL, tskIDLE_PRIORITY + 5, NULL);
-	xTaskCreate(at24cs0x_task, "at24cs0x task", configMINIMAL_STACK_SIZE * 4, NULL, tskIDLE_PRIORITY + 2, NULL);
-	xTaskCreate(mics6814_task, "mics6814 task", configMINIMAL_STACK_SIZE * 4, NULL, tskIDLE_PRIORITY + 1, NULL);
+	/* The serial number doesn't change, read it once */
+	at24cs0x_print_serial_number();
+
+	/* Every sensor is sampled from a single task, woken up only when a job
+	 * is due */
+	ESP_ERROR_CHECK(sensor_sched_init(&sensor_sched, tskIDLE_PRIORITY + 5));
+	ESP_ERROR_CHECK(sensor_sched_add(&sensor_sched, "bsec", bsec_sample, NULL, BSEC_POLL_PERIOD_MS));
+	ESP_ERROR_CHECK(sensor_sched_add(&sensor_sched, "shtc3", shtc3_sample, NULL, SHTC3_PERIOD_MS));
+	ESP_ERROR_CHECK(sensor_sched_add(&sensor_sched, "mics6814", mics6814_sample, NULL, 1000));
+	ESP_ERROR_CHECK(sensor_sched_add(&sensor_sched, "logger", logger_sample, NULL, 1000));
+#endif
 }
@@ -0,0 +1,12 @@
+/* Host stand-in of the at24cs0x driver API */
+#pragma once
+
+#include "i2c_bus.h"
+
+#define AT24CS0X_I2C_ADDRESS	0x50
+#define AT24CS0X_SN_SIZE		16
+
+typedef struct {
+	i2c_bus_dev_t *i2c_dev;
+	uint8_t serial_number[AT24CS0X_SN_SIZE];
+} at24cs0x_t;
@@ -0,0 +1,15 @@
+/* Host stand-in of the bsec2 driver API, the tests that use the BSEC state
+ * define these functions */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define BSEC_MAX_STATE_BLOB_SIZE	221
+
+typedef struct {
+	void *bsec_instance;
+} bsec2_t;
+
+bool bsec2_get_state(bsec2_t *me, uint8_t *state);
+bool bsec2_set_state(bsec2_t *me, uint8_t *state);
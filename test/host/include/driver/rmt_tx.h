@@ -0,0 +1,40 @@
+/* Host stand-in of driver/rmt_tx.h, the frames take their time on the wire
+ * of esp_timer and are recorded for host_rmt_last_tx() */
+#pragma once
+
+#include "driver/rmt_types.h"
+#include "driver/rmt_encoder.h"
+
+typedef struct {
+	int gpio_num;
+	rmt_clock_source_t clk_src;
+	uint32_t resolution_hz;
+	size_t mem_block_symbols;
+	size_t trans_queue_depth;
+	int intr_priority;
+	struct {
+		uint32_t invert_out : 1;
+		uint32_t with_dma : 1;
+		uint32_t io_loop_back : 1;
+		uint32_t io_od_mode : 1;
+	} flags;
+} rmt_tx_channel_config_t;
+
+typedef struct {
+	int loop_count;			/* -1 loops until the channel is disabled */
+	struct {
+		uint32_t eot_level : 1;
+	} flags;
+} rmt_transmit_config_t;
+
+typedef struct {
+	rmt_tx_done_callback_t on_trans_done;
+} rmt_tx_event_callbacks_t;
+
+esp_err_t rmt_new_tx_channel(const rmt_tx_channel_config_t *config, rmt_channel_handle_t *ret_chan);
+esp_err_t rmt_del_channel(rmt_channel_handle_t channel);
+esp_err_t rmt_enable(rmt_channel_handle_t channel);
+esp_err_t rmt_disable(rmt_channel_handle_t channel);
+esp_err_t rmt_transmit(rmt_channel_handle_t tx_channel, rmt_encoder_handle_t encoder, const void *payload, size_t payload_bytes, const rmt_transmit_config_t *config);
+esp_err_t rmt_tx_wait_all_done(rmt_channel_handle_t tx_channel, int timeout_ms);
+esp_err_t rmt_tx_register_event_callbacks(rmt_channel_handle_t tx_channel, const rmt_tx_event_callbacks_t *cbs, void *user_data);
@@ -0,0 +1,59 @@
+/* Host stand-in of driver/spi_master.h, the transmitted frames are recorded
+ * for host_spi_last_tx() */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "esp_heap_caps.h"
+
+#define SPI_CLK_SRC_DEFAULT		0
+
+typedef enum {
+	SPI1_HOST = 0,
+	SPI2_HOST = 1,
+	SPI3_HOST = 2,
+	SPI_HOST_MAX,
+} spi_host_device_t;
+
+typedef enum {
+	SPI_DMA_DISABLED = 0,
+	SPI_DMA_CH_AUTO = 3,
+} spi_dma_chan_t;
+
+typedef int spi_clock_source_t;
+typedef struct spi_device_t *spi_device_handle_t;
+
+typedef struct {
+	int mosi_io_num;
+	int miso_io_num;
+	int sclk_io_num;
+	int quadwp_io_num;
+	int quadhd_io_num;
+	int max_transfer_sz;
+} spi_bus_config_t;
+
+typedef struct {
+	uint8_t command_bits;
+	uint8_t address_bits;
+	uint8_t dummy_bits;
+	uint8_t mode;
+	spi_clock_source_t clock_source;
+	int clock_speed_hz;
+	int spics_io_num;
+	int queue_size;
+} spi_device_interface_config_t;
+
+typedef struct {
+	size_t length;				/* In bits */
+	const void *tx_buffer;
+	void *rx_buffer;
+} spi_transaction_t;
+
+esp_err_t spi_bus_initialize(spi_host_device_t host_id, const spi_bus_config_t *bus_config, spi_dma_chan_t dma_chan);
+esp_err_t spi_bus_free(spi_host_device_t host_id);
+esp_err_t spi_bus_add_device(spi_host_device_t host_id, const spi_device_interface_config_t *dev_config, spi_device_handle_t *handle);
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle);
+esp_err_t spi_device_get_actual_freq(spi_device_handle_t handle, int *freq_khz);
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc);
@@ -0,0 +1,7 @@
+/* Host stand-in of esp_attr.h, the placement attributes are dropped */
+#pragma once
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
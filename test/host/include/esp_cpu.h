@@ -0,0 +1,16 @@
+/* Host stand-in of esp_cpu.h, a single core whose cycle counter runs with
+ * esp_timer at the default CPU frequency */
+#pragma once
+
+#include <stdint.h>
+
+#include "sdkconfig.h"
+#include "esp_timer.h"
+
+static inline uint32_t esp_cpu_get_cycle_count(void) {
+	return (uint32_t)(esp_timer_get_time() * CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ);
+}
+
+static inline int esp_cpu_get_core_id(void) {
+	return 0;
+}
@@ -0,0 +1,12 @@
+/* Host stand-in of esp_heap_caps.h, the capabilities are ignored */
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#define MALLOC_CAP_DMA			(1 << 3)
+#define MALLOC_CAP_INTERNAL		(1 << 11)
+#define MALLOC_CAP_DEFAULT		(1 << 12)
+
+#define heap_caps_malloc(size, caps)		malloc(size)
+#define heap_caps_calloc(n, size, caps)		calloc(n, size)
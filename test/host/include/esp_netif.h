@@ -0,0 +1,18 @@
+/* Host stand-in of the network interface API, the tests that bring up a
+ * link define these functions */
+#pragma once
+
+#include "esp_err.h"
+#include "esp_event.h"
+
+typedef struct esp_netif_obj esp_netif_t;
+
+typedef enum {
+	IP_EVENT_STA_GOT_IP,
+	IP_EVENT_STA_LOST_IP,
+} ip_event_t;
+
+ESP_EVENT_DECLARE_BASE(IP_EVENT);
+
+esp_err_t esp_netif_init(void);
+esp_netif_t *esp_netif_create_default_wifi_sta(void);
@@ -0,0 +1,7 @@
+/* Host stand-in of esp_rom_gpio.h */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+void esp_rom_gpio_connect_out_signal(uint32_t gpio_num, uint32_t signal_idx, bool out_inv, bool oen_inv);
@@ -0,0 +1,7 @@
+/* Host stand-in of esp_rom_sys.h, the tests that time pulses define these
+ * functions */
+#pragma once
+
+#include <stdint.h>
+
+void esp_rom_delay_us(uint32_t us);
@@ -0,0 +1,10 @@
+/* Host stand-in of esp_sleep.h, the tests that sleep define these
+ * functions */
+#pragma once
+
+#include <stdint.h>
+
+#include "esp_err.h"
+
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t time_in_us);
+void esp_deep_sleep_start(void) __attribute__((noreturn));
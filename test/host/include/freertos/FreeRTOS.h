@@ -0,0 +1,63 @@
+/* Host stand-in of FreeRTOS.h, the kernel objects are built on pthreads and
+ * one tick lasts portTICK_PERIOD_MS of real time */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sdkconfig.h"
+#include "esp_bit_defs.h"
+#include "esp_err.h"
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint8_t StackType_t;
+
+#define pdTRUE					1
+#define pdFALSE					0
+#define pdPASS					pdTRUE
+#define pdFAIL					pdFALSE
+
+#define configTICK_RATE_HZ		CONFIG_FREERTOS_HZ
+#define configMAX_PRIORITIES	25
+#define configMAX_TASK_NAME_LEN	16
+#define configMINIMAL_STACK_SIZE	768
+#define configASSERT(x)			do { if (!(x)) abort(); } while (0)
+#define tskIDLE_PRIORITY		0
+#define tskNO_AFFINITY			0x7FFFFFFF
+
+#define portMAX_DELAY			((TickType_t)0xFFFFFFFF)
+#define portTICK_PERIOD_MS		(1000 / configTICK_RATE_HZ)
+#define portNUM_PROCESSORS		1
+#define pdMS_TO_TICKS(ms)		((TickType_t)((uint64_t)(ms) * configTICK_RATE_HZ / 1000))
+#define pdTICKS_TO_MS(ticks)	((uint32_t)((uint64_t)(ticks) * 1000 / configTICK_RATE_HZ))
+
+/* The buffers of the static objects are not used, the objects are allocated */
+typedef struct { uint8_t dummy[80]; } StaticQueue_t;
+typedef StaticQueue_t StaticSemaphore_t;
+typedef struct { uint8_t dummy[32]; } StaticEventGroup_t;
+typedef struct { uint8_t dummy[120]; } StaticTask_t;
+typedef struct { uint8_t dummy[40]; } StaticTimer_t;
+
+/* Every critical section takes the same recursive lock */
+typedef struct {
+	int unused;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED	{0}
+
+void host_critical_enter(void);
+void host_critical_exit(void);
+
+#define portENTER_CRITICAL(mux)			((void)(mux), host_critical_enter())
+#define portEXIT_CRITICAL(mux)			((void)(mux), host_critical_exit())
+#define portENTER_CRITICAL_ISR(mux)		((void)(mux), host_critical_enter())
+#define portEXIT_CRITICAL_ISR(mux)		((void)(mux), host_critical_exit())
+#define portENTER_CRITICAL_SAFE(mux)	((void)(mux), host_critical_enter())
+#define portEXIT_CRITICAL_SAFE(mux)		((void)(mux), host_critical_exit())
+#define taskENTER_CRITICAL(mux)			((void)(mux), host_critical_enter())
+#define taskEXIT_CRITICAL(mux)			((void)(mux), host_critical_exit())
+#define portYIELD_FROM_ISR(x)			(void)(x)
+
+BaseType_t xPortInIsrContext(void);
@@ -0,0 +1,55 @@
+/* Host stand-in of task.h, every task is a thread */
+#pragma once
+
+#include <sched.h>
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct host_task *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *arg);
+
+typedef enum {
+	eRunning,
+	eReady,
+	eBlocked,
+	eSuspended,
+	eDeleted,
+	eInvalid,
+} eTaskState;
+
+typedef struct {
+	TaskHandle_t xHandle;
+	const char *pcTaskName;
+	UBaseType_t xTaskNumber;
+	eTaskState eCurrentState;
+	UBaseType_t uxCurrentPriority;
+	UBaseType_t uxBasePriority;
+	uint32_t ulRunTimeCounter;
+	StackType_t *pxStackBase;
+	uint32_t usStackHighWaterMark;
+	BaseType_t xCoreID;
+} TaskStatus_t;
+
+#define taskYIELD()				sched_yield()
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *arg, UBaseType_t prio, TaskHandle_t *handle);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *arg, UBaseType_t prio, TaskHandle_t *handle, BaseType_t core_id);
+TaskHandle_t xTaskCreateStatic(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *arg, UBaseType_t prio, StackType_t *stack, StaticTask_t *task_buffer);
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t *previous_wake_time, TickType_t increment);
+BaseType_t xTaskDelayUntil(TickType_t *previous_wake_time, TickType_t increment);
+TickType_t xTaskGetTickCount(void);
+TickType_t xTaskGetTickCountFromISR(void);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+const char *pcTaskGetName(TaskHandle_t task);
+UBaseType_t uxTaskGetNumberOfTasks(void);
+void vTaskSuspendAll(void);
+BaseType_t xTaskResumeAll(void);
+
+/* Weak and empty on the host, the tests that fake the task list define it */
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *status_array, UBaseType_t array_size, uint32_t *total_run_time);
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higher_priority_task_woken);
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait);
@@ -0,0 +1,63 @@
+/* Host stand-in of hal/adc_types.h with the ESP32-S2 output format */
+#pragma once
+
+#include <stdint.h>
+
+#include "soc/soc_caps.h"
+
+typedef enum {
+	ADC_UNIT_1 = 0,
+	ADC_UNIT_2,
+} adc_unit_t;
+
+typedef enum {
+	ADC_CHANNEL_0 = 0,
+	ADC_CHANNEL_1,
+	ADC_CHANNEL_2,
+	ADC_CHANNEL_3,
+	ADC_CHANNEL_4,
+	ADC_CHANNEL_5,
+	ADC_CHANNEL_6,
+	ADC_CHANNEL_7,
+	ADC_CHANNEL_8,
+	ADC_CHANNEL_9,
+} adc_channel_t;
+
+typedef enum {
+	ADC_ATTEN_DB_0 = 0,
+	ADC_ATTEN_DB_2_5,
+	ADC_ATTEN_DB_6,
+	ADC_ATTEN_DB_11,
+} adc_atten_t;
+
+typedef enum {
+	ADC_CONV_SINGLE_UNIT_1 = 1,
+	ADC_CONV_SINGLE_UNIT_2 = 2,
+} adc_digi_convert_mode_t;
+
+typedef enum {
+	ADC_DIGI_OUTPUT_FORMAT_TYPE1 = 0,
+	ADC_DIGI_OUTPUT_FORMAT_TYPE2,
+} adc_digi_output_format_t;
+
+typedef struct {
+	uint8_t atten;
+	uint8_t channel;
+	uint8_t unit;
+	uint8_t bit_width;
+} adc_digi_pattern_config_t;
+
+typedef struct {
+	union {
+		struct {
+			uint16_t data: 12;
+			uint16_t channel: 4;
+		} type1;
+		struct {
+			uint16_t data: 11;
+			uint16_t channel: 4;
+			uint16_t unit: 1;
+		} type2;
+		uint16_t val;
+	};
+} adc_digi_output_data_t;
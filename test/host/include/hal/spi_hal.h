@@ -0,0 +1,14 @@
+/* Host stand-in of hal/spi_hal.h, the registers are plain memory */
+#pragma once
+
+#include <stdint.h>
+
+typedef struct {
+	struct {
+		uint32_t d_pol;
+	} ctrl;
+} spi_dev_t;
+
+extern spi_dev_t host_spi_hw[];
+
+#define SPI_LL_GET_HW(host_id)	(&host_spi_hw[(host_id)])
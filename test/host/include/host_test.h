@@ -0,0 +1,264 @@
+/**
+  ******************************************************************************
+  * @file           : host_test.h
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Assertions and clock control of the host tests
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef HOST_TEST_H_
+#define HOST_TEST_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_partition.h"
+#include "esp_pm.h"
+#include "driver/rmt_types.h"
+
+/* Exported macro ------------------------------------------------------------*/
+#define TEST_ASSERT(cond) do {												\
+		if (!(cond)) {														\
+			fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #cond);		\
+			exit(EXIT_FAILURE);												\
+		}																	\
+	} while (0)
+
+#define TEST_ASSERT_EQUAL(expected, actual) do {							\
+		int64_t e_ = (int64_t)(expected);									\
+		int64_t a_ = (int64_t)(actual);										\
+		if (e_ != a_) {														\
+			fprintf(stderr, "%s:%d: %s is %" PRId64 ", expected %" PRId64 "\n",	\
+					__FILE__, __LINE__, #actual, a_, e_);					\
+			exit(EXIT_FAILURE);												\
+		}																	\
+	} while (0)
+
+#define RUN_TEST(fn) do {													\
+		printf("%s\n", #fn);												\
+		fn();																\
+	} while (0)
+
+/* Exported typedef ----------------------------------------------------------*/
+/* Receives the formatted log lines instead of stderr */
+typedef void (*host_log_hook_t)(esp_log_level_t level, const char *tag, const char *line);
+
+/* Exported functions prototypes ---------------------------------------------*/
+/**
+  * @brief Function to move the clock of esp_timer_get_time() and of the tick
+  *        count forward without waiting
+  *
+  * @param us : Time to skip in us
+  */
+void host_time_advance(int64_t us);
+
+/**
+  * @brief Function to sleep as a deep sleep does, the RTC time goes on and
+  *        esp_timer_get_time() starts again from 0, as on the boot after it
+  *
+  * @note The tick count goes back too, no task may wait across it
+  *
+  * @param us : Time asleep in us
+  */
+void host_deep_sleep(int64_t us);
+
+/**
+  * @brief Function to get the number of holders of a power management lock
+  *
+  * @param handle : Lock handle
+  *
+  * @retval Times the lock is acquired and not released
+  */
+int host_pm_lock_count(esp_pm_lock_handle_t handle);
+
+/**
+  * @brief Function to set the report printed by esp_pm_dump_locks()
+  *
+  * @param text : Report, not copied, NULL to print nothing
+  */
+void host_pm_set_dump(const char *text);
+
+/**
+  * @brief Function to get the last frame sent by spi_device_transmit()
+  *
+  * @param len   : Pointer to store the frame length in bytes
+  * @param count : Pointer to store the number of frames sent
+  *
+  * @retval Frame data, valid until the next transmission
+  */
+const uint8_t *host_spi_last_tx(size_t *len, uint32_t *count);
+
+/**
+  * @brief Function to get the RMT TX channel driving a GPIO
+  *
+  * @param gpio_num : GPIO of the channel
+  *
+  * @retval Channel, NULL if none drives it
+  */
+rmt_channel_handle_t host_rmt_channel(int gpio_num);
+
+/**
+  * @brief Function to get the symbols of the last transaction started on an
+  *        RMT channel, the end marker isn't included
+  *
+  * @param channel     : Channel
+  * @param num_symbols : Pointer to store the number of symbols
+  * @param count       : Pointer to store the number of transactions started
+  *
+  * @retval Symbols, valid until the next transmission
+  */
+const rmt_symbol_word_t *host_rmt_last_tx(rmt_channel_handle_t channel, size_t *num_symbols, uint32_t *count);
+
+/**
+  * @brief Function to get the number of transactions of an RMT channel not
+  *        done yet, a transaction is done once its symbols took their time
+  *        on the wire of esp_timer_get_time()
+  *
+  * @param channel : Channel
+  *
+  * @retval Transactions on the wire or queued
+  */
+uint32_t host_rmt_in_flight(rmt_channel_handle_t channel);
+
+/**
+  * @brief Function to know if an RMT channel is enabled, it holds a light
+  *        sleep lock while it is
+  *
+  * @param channel : Channel
+  *
+  * @retval True if enabled
+  */
+bool host_rmt_enabled(rmt_channel_handle_t channel);
+
+/**
+  * @brief Function to make the creation of the RMT encoders fail
+  *
+  * @param err : Error code returned, ESP_OK to make them succeed again
+  */
+void host_rmt_encoder_error(esp_err_t err);
+
+/**
+  * @brief Function to erase every NVS namespace, as a blank flash
+  */
+void host_nvs_erase(void);
+
+/**
+  * @brief Function to get the number of NVS values written since the erase
+  *
+  * @retval Successful nvs_set_*() calls
+  */
+uint32_t host_nvs_writes(void);
+
+/**
+  * @brief Function to make the NVS writes and commits fail
+  *
+  * @param err : Error code returned, ESP_OK to make them succeed again
+  */
+void host_nvs_write_error(esp_err_t err);
+
+/**
+  * @brief Function to send the log lines to a hook instead of stderr
+  *
+  * @param hook : Function called with every line printed, NULL for stderr
+  */
+void host_log_set_hook(host_log_hook_t hook);
+
+/**
+  * @brief Function to add a flash partition backed by a file, erased
+  *
+  * @note The partitions can't be removed, the file is left to inspect it
+  *
+  * @param label : Partition label, the partition has the data type
+  * @param size  : Partition size in bytes, a multiple of the 4 KB sector
+  * @param path  : Path of the file, created or truncated
+  *
+  * @retval Partition, NULL if it can't be added
+  */
+const esp_partition_t *host_partition_add(const char *label, size_t size, const char *path);
+
+/**
+  * @brief Function to fill a partition with a value, as an erased (0xFF) or
+  *        a never written flash, and clear its counters
+  *
+  * @param partition : Partition to fill
+  * @param value     : Value of every byte
+  */
+void host_partition_fill(const esp_partition_t *partition, uint8_t value);
+
+/**
+  * @brief Function to cut the power after programming some more bytes
+  *
+  * @note The write reaching the cut programs only the bytes before it, it and
+  *       every write or erase after it fail until host_partition_power_on()
+  *
+  * @param bytes : Bytes programmed before the cut
+  */
+void host_partition_power_cut(size_t bytes);
+
+/**
+  * @brief Function to restore the power of the flash
+  */
+void host_partition_power_on(void);
+
+/**
+  * @brief Function to get the number of sectors erased in a partition
+  *
+  * @param partition : Partition
+  *
+  * @retval Sectors erased since it was filled
+  */
+uint32_t host_partition_erases(const esp_partition_t *partition);
+
+/**
+  * @brief Function to get the number of bytes programmed twice in a
+  *        partition, without an erase between the writes
+  *
+  * @param partition : Partition
+  *
+  * @retval Bytes programmed again since it was filled
+  */
+uint32_t host_partition_overwrites(const esp_partition_t *partition);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_TEST_H_ */
+
+/***************************** END OF FILE ************************************/
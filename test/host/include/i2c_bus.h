@@ -0,0 +1,23 @@
+/* Host stand-in of the i2c_bus driver API, the devices are fakes that set
+ * their own read and write functions */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+typedef int8_t (*i2c_bus_read_t)(uint8_t *reg_addr, uint8_t addr_len, uint8_t *reg_data, uint32_t data_len, void *intf);
+typedef int8_t (*i2c_bus_write_t)(uint8_t *reg_addr, uint8_t addr_len, const uint8_t *reg_data, uint32_t data_len, void *intf);
+
+typedef struct {
+	int *i2c_num;
+	SemaphoreHandle_t *mutex;
+	uint8_t dev_num;
+	uint8_t addr;
+	char name[32];
+	i2c_bus_write_t write;
+	i2c_bus_read_t read;
+} i2c_bus_dev_t;
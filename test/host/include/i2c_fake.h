@@ -0,0 +1,106 @@
+/**
+  ******************************************************************************
+  * @file           : i2c_fake.h
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Loopback fake of an I2C bus device for the host tests
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef I2C_FAKE_H_
+#define I2C_FAKE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "i2c_bus.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+/* Exported macro ------------------------------------------------------------*/
+#define I2C_FAKE_MEM_SIZE		256
+#define I2C_FAKE_LOG_SIZE		64
+
+/* Exported typedef ----------------------------------------------------------*/
+typedef enum {
+	I2C_FAKE_WRITE = 0,
+	I2C_FAKE_READ
+} i2c_fake_op_e;
+
+typedef struct {
+	i2c_fake_op_e op;
+	uint8_t reg_addr[2];
+	uint8_t reg_addr_len;
+	uint32_t data_len;
+	int64_t time;				/* esp_timer_get_time() when it ran */
+	TaskHandle_t task;			/* Task that ran it */
+	int8_t rslt;
+} i2c_fake_xfer_t;
+
+typedef struct i2c_fake i2c_fake_t;
+
+/* Device model, returns the transaction result and reads into or writes from
+ * data. Without a model the device loops the data back through mem */
+typedef int8_t (*i2c_fake_model_t)(i2c_fake_t *fake, const i2c_fake_xfer_t *xfer, uint8_t *data);
+
+struct i2c_fake {
+	i2c_bus_dev_t dev;			/* First, the drivers pass it as intf */
+	uint8_t mem[I2C_FAKE_MEM_SIZE];	/* Register space, the last register
+								   address byte indexes it */
+	i2c_fake_model_t model;
+	void *model_arg;
+	uint32_t fail_at;			/* Transaction NACKed, counting from 1, 0 for none */
+	uint32_t xfers_num;			/* Transactions run */
+	i2c_fake_xfer_t xfers[I2C_FAKE_LOG_SIZE];	/* First transactions */
+};
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions prototypes ---------------------------------------------*/
+/**
+  * @brief Function to initialize a fake I2C device
+  *
+  * @param me   : Pointer to a i2c_fake_t structure
+  * @param name : Device name
+  * @param addr : 7 bits address
+  */
+void i2c_fake_init(i2c_fake_t * const me, const char *name, uint8_t addr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* I2C_FAKE_H_ */
+
+/***************************** END OF FILE ************************************/
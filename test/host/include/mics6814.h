@@ -0,0 +1,29 @@
+/* Host stand-in of the mics6814 driver types */
+#pragma once
+
+#include <stdint.h>
+
+#include "hal/adc_types.h"
+
+typedef enum {
+	CO_GAS = 0,
+	NO2_GAS,
+	NH3_GAS,
+	C3H8_GAS,
+	C4H10_GAS,
+	CH4_GAS,
+	H2_GAS,
+	C2H5OH_GAS,
+} gas_e;
+
+typedef enum {
+	CO_CHANNEL = 0,
+	NO2_CHANNEL,
+	NH3_CHANNEL,
+} mics6814_channel_e;
+
+typedef struct {
+	uint16_t nh3;
+	uint16_t co;
+	uint16_t no2;
+} calibration_values_t;
@@ -0,0 +1,90 @@
+/* Host stand-in of the generated sdkconfig.h, the Kconfig defaults of the
+ * project components on an ESP32-S2 with power management */
+#pragma once
+
+#define CONFIG_IDF_TARGET_ESP32S2 1
+#define CONFIG_FREERTOS_HZ 100
+#define CONFIG_FREERTOS_UNICORE 1
+#define CONFIG_FREERTOS_USE_TRACE_FACILITY 1
+#define CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS 1
+#define CONFIG_FREERTOS_USE_TICKLESS_IDLE 1
+#define CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ 160
+#define CONFIG_PM_ENABLE 1
+#define CONFIG_PM_PROFILING 1
+#define CONFIG_ESP_WIFI_SSID "myssid"
+#define CONFIG_ESP_WIFI_PASSWORD "mypassword"
+#define CONFIG_SAMPLE_OUTPUT_BINARY 1
+#define CONFIG_OPERATING_MODE_CONTINUOUS 1
+
+/* at24cs0x_cache */
+#define CONFIG_AT24CS0X_CACHE_PAGES 4
+/* Longer than the default of 10, a loaded host can preempt the ack polling
+ * for longer than the write cycle of the fake EEPROM */
+#define CONFIG_AT24CS0X_CACHE_WRITE_TIMEOUT_MS 100
+
+/* dlog */
+#define CONFIG_DLOG_ENABLE 1
+#define CONFIG_DLOG_RING_SIZE 64
+#define CONFIG_DLOG_LINE_SIZE 160
+#define CONFIG_DLOG_TASK_STACK_SIZE 3072
+
+/* i2c_bus_async */
+#define CONFIG_I2C_BUS_ASYNC_QUEUE_LENGTH 8
+#define CONFIG_I2C_BUS_ASYNC_TASK_STACK_SIZE 3072
+
+/* esp_rgb_led */
+#define CONFIG_ESP_RGB_LED_RMT_MEM_BLOCK_SYMBOLS 128
+#define CONFIG_ESP_RGB_LED_ANIM_FPS 50
+#define CONFIG_ESP_RGB_LED_ANIM_TASK_PRIORITY 5
+#define CONFIG_ESP_RGB_LED_ANIM_TASK_STACK_SIZE 2048
+
+/* esp_buzzer */
+#define CONFIG_ESP_BUZZER_QUEUE_LENGTH 4
+#define CONFIG_ESP_BUZZER_LEDC_TONE 2700
+#define CONFIG_ESP_BUZZER_LEDC_TIMER 0
+#define CONFIG_ESP_BUZZER_LEDC_CHANNEL 0
+
+/* sample_bus */
+#define CONFIG_SAMPLE_BUS_RING_SIZE 8
+
+/* sample_store */
+#define CONFIG_SAMPLE_STORE_PARTITION_LABEL "samples"
+#define CONFIG_SAMPLE_STORE_BLOCK_SIZE 256
+#define CONFIG_SAMPLE_STORE_MAX_CHANNELS 16
+
+/* uplink */
+#define CONFIG_UPLINK_BROKER_URI "mqtt://192.168.1.100"
+#define CONFIG_UPLINK_TOPIC "wit_test/samples"
+#define CONFIG_UPLINK_BATCH_SAMPLES 1024
+#define CONFIG_UPLINK_BATCH_PERIOD_S 300
+/* The smallest messages and timeouts, a batch takes several messages and a
+ * failed one doesn't hold the test for long */
+#define CONFIG_UPLINK_PAYLOAD_SIZE 1024
+#define CONFIG_UPLINK_CONNECT_TIMEOUT_S 1
+#define CONFIG_UPLINK_ACK_TIMEOUT_S 1
+#define CONFIG_UPLINK_TASK_STACK_SIZE 4096
+
+/* duty_cycle */
+#define CONFIG_DUTY_CYCLE_PERIOD_S 60
+#define CONFIG_DUTY_CYCLE_AWAKE_BUDGET_MS 500
+
+/* task_prof */
+#define CONFIG_TASK_PROF_ENABLE 1
+#define CONFIG_TASK_PROF_MAX_TASKS 24
+
+/* mics6814_cont */
+#define CONFIG_MICS6814_CONT_OVERSAMPLING 64
+#define CONFIG_MICS6814_CONT_SAMPLE_FREQ_HZ 20000
+
+/* power_mgmt */
+#define CONFIG_POWER_MGMT_MAX_CPU_FREQ_MHZ 160
+#define CONFIG_POWER_MGMT_MIN_CPU_FREQ_MHZ 40
+#define CONFIG_POWER_MGMT_LIGHT_SLEEP 1
+
+/* sensor_sched */
+#define CONFIG_SENSOR_SCHED_MAX_JOBS 8
+#define CONFIG_SENSOR_SCHED_TASK_STACK_SIZE 4096
+
+/* bsec2_state */
+#define CONFIG_BSEC2_STATE_SAVE_PERIOD_MIN 240
+#define CONFIG_BSEC2_STATE_MIN_ACCURACY 3
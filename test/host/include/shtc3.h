@@ -0,0 +1,10 @@
+/* Host stand-in of the shtc3 driver API */
+#pragma once
+
+#include "i2c_bus.h"
+
+#define SHTC3_I2C_ADDR			0x70
+
+typedef struct {
+	i2c_bus_dev_t *i2c_dev;
+} shtc3_t;
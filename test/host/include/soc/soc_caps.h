@@ -0,0 +1,7 @@
+/* Host stand-in of soc/soc_caps.h, the ADC capabilities of the ESP32-S2 */
+#pragma once
+
+#define SOC_ADC_DIGI_RESULT_BYTES		2
+#define SOC_ADC_DIGI_MAX_BITWIDTH		12
+#define SOC_ADC_SAMPLE_FREQ_THRES_LOW	611
+#define SOC_ADC_SAMPLE_FREQ_THRES_HIGH	83333
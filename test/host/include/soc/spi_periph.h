@@ -0,0 +1,10 @@
+/* Host stand-in of soc/spi_periph.h */
+#pragma once
+
+#include <stdint.h>
+
+typedef struct {
+	uint32_t spid_out;
+} spi_signal_conn_t;
+
+extern const spi_signal_conn_t spi_periph_signal[];
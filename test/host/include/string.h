@@ -0,0 +1,11 @@
+/* Host stand-in of the newlib string.h, the C library one with the BSD
+ * functions that glibc lacks before 2.38, in src/string.c */
+#pragma once
+
+#include_next <string.h>
+
+#if defined(__GLIBC__) && __GLIBC__ == 2 && __GLIBC_MINOR__ < 38
+#define HOST_STRLCPY 1
+
+size_t strlcpy(char *dst, const char *src, size_t size);
+#endif
@@ -0,0 +1,301 @@
+/**
+  ******************************************************************************
+  * @file           : esp_partition.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : File-backed flash stand-in of the partition API
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "esp_partition.h"
+#include "host_test.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define PARTITIONS_NUM			4
+#define SECTOR_SIZE				4096
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+	esp_partition_t partition;
+	FILE *file;
+	uint32_t erases;			/* Sectors erased */
+	uint32_t overwrites;		/* Bytes programmed again without an erase */
+} flash_t;
+
+/* Private variables ---------------------------------------------------------*/
+/* The partitions outlive the mounts of the components, as the flash across
+ * reboots */
+static pthread_mutex_t flash_lock = PTHREAD_MUTEX_INITIALIZER;
+static flash_t flashes[PARTITIONS_NUM];
+static uint32_t partitions_num;
+
+/* Bytes left to program before the power cut, -1 for none */
+static int64_t power_left = -1;
+
+/* Private function prototypes -----------------------------------------------*/
+static flash_t *flash_get(const esp_partition_t *partition, size_t offset, size_t size);
+
+/* Exported functions --------------------------------------------------------*/
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype, const char *label) {
+	const esp_partition_t *ret = NULL;
+
+	pthread_mutex_lock(&flash_lock);
+
+	for (uint32_t i = 0; i < partitions_num; i++) {
+		esp_partition_t *partition = &flashes[i].partition;
+
+		if ((type == ESP_PARTITION_TYPE_ANY || type == partition->type) &&
+				(subtype == ESP_PARTITION_SUBTYPE_ANY || subtype == partition->subtype) &&
+				(label == NULL || strcmp(label, partition->label) == 0)) {
+			ret = partition;
+			break;
+		}
+	}
+
+	pthread_mutex_unlock(&flash_lock);
+
+	return ret;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t *partition, size_t src_offset, void *dst, size_t size) {
+	if (dst == NULL) {
+		return ESP_ERR_INVALID_ARG;
+	}
+
+	pthread_mutex_lock(&flash_lock);
+
+	flash_t *flash = flash_get(partition, src_offset, size);
+	esp_err_t ret = ESP_ERR_INVALID_ARG;
+
+	if (flash != NULL) {
+		fseek(flash->file, src_offset, SEEK_SET);
+		ret = fread(dst, 1, size, flash->file) == size ? ESP_OK : ESP_FAIL;
+	}
+
+	pthread_mutex_unlock(&flash_lock);
+
+	return ret;
+}
+
+/* As a NOR flash, programming only clears bits, the bytes must be erased
+ * first to get the data written */
+esp_err_t esp_partition_write(const esp_partition_t *partition, size_t dst_offset, const void *src, size_t size) {
+	if (src == NULL) {
+		return ESP_ERR_INVALID_ARG;
+	}
+
+	pthread_mutex_lock(&flash_lock);
+
+	flash_t *flash = flash_get(partition, dst_offset, size);
+	esp_err_t ret = ESP_OK;
+
+	if (flash == NULL) {
+		ret = ESP_ERR_INVALID_ARG;
+		goto end;
+	}
+
+	/* Without power only the bytes programmed before the cut get there */
+	size_t programmed = size;
+
+	if (power_left >= 0 && (int64_t)size > power_left) {
+		programmed = power_left;
+		ret = ESP_FAIL;
+	}
+
+	if (power_left >= 0) {
+		power_left -= programmed;
+	}
+
+	const uint8_t *data = src;
+
+	for (size_t i = 0, len; i < programmed; i += len) {
+		uint8_t chunk[256];
+
+		len = programmed - i < sizeof(chunk) ? programmed - i : sizeof(chunk);
+		fseek(flash->file, dst_offset + i, SEEK_SET);
+
+		if (fread(chunk, 1, len, flash->file) != len) {
+			ret = ESP_FAIL;
+			break;
+		}
+
+		for (size_t j = 0; j < len; j++) {
+			flash->overwrites += chunk[j] != 0xFF;
+			chunk[j] &= data[i + j];
+		}
+
+		fseek(flash->file, dst_offset + i, SEEK_SET);
+		fwrite(chunk, 1, len, flash->file);
+	}
+
+	fflush(flash->file);
+
+end:
+	pthread_mutex_unlock(&flash_lock);
+
+	return ret;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t *partition, size_t offset, size_t size) {
+	pthread_mutex_lock(&flash_lock);
+
+	flash_t *flash = flash_get(partition, offset, size);
+	esp_err_t ret = ESP_OK;
+
+	if (flash == NULL || offset % SECTOR_SIZE || size % SECTOR_SIZE) {
+		ret = ESP_ERR_INVALID_ARG;
+	}
+	else if (power_left == 0) {
+		ret = ESP_FAIL;
+	}
+	else {
+		uint8_t erased[SECTOR_SIZE];
+
+		memset(erased, 0xFF, sizeof(erased));
+		fseek(flash->file, offset, SEEK_SET);
+
+		for (size_t i = 0; i < size; i += SECTOR_SIZE) {
+			fwrite(erased, 1, SECTOR_SIZE, flash->file);
+			flash->erases++;
+		}
+
+		fflush(flash->file);
+	}
+
+	pthread_mutex_unlock(&flash_lock);
+
+	return ret;
+}
+
+const esp_partition_t *host_partition_add(const char *label, size_t size, const char *path) {
+	if (size % SECTOR_SIZE || strlen(label) >= sizeof(flashes[0].partition.label)) {
+		return NULL;
+	}
+
+	pthread_mutex_lock(&flash_lock);
+
+	flash_t *flash = NULL;
+	FILE *file = partitions_num < PARTITIONS_NUM ? fopen(path, "w+b") : NULL;
+
+	if (file != NULL) {
+		uint32_t address = 0x110000;
+
+		for (uint32_t i = 0; i < partitions_num; i++) {
+			address += flashes[i].partition.size;
+		}
+
+		flash = &flashes[partitions_num++];
+		flash->file = file;
+		flash->partition = (esp_partition_t) {
+				.type = ESP_PARTITION_TYPE_DATA,
+				.subtype = 0x99,
+				.address = address,
+				.size = size,
+				.erase_size = SECTOR_SIZE,
+		};
+		strcpy(flash->partition.label, label);
+	}
+
+	pthread_mutex_unlock(&flash_lock);
+
+	if (flash == NULL) {
+		return NULL;
+	}
+
+	host_partition_fill(&flash->partition, 0xFF);
+
+	return &flash->partition;
+}
+
+void host_partition_fill(const esp_partition_t *partition, uint8_t value) {
+	pthread_mutex_lock(&flash_lock);
+
+	flash_t *flash = flash_get(partition, 0, partition->size);
+	uint8_t sector[SECTOR_SIZE];
+
+	memset(sector, value, sizeof(sector));
+	fseek(flash->file, 0, SEEK_SET);
+
+	for (size_t i = 0; i < partition->size; i += SECTOR_SIZE) {
+		fwrite(sector, 1, SECTOR_SIZE, flash->file);
+	}
+
+	fflush(flash->file);
+	flash->erases = 0;
+	flash->overwrites = 0;
+
+	pthread_mutex_unlock(&flash_lock);
+}
+
+void host_partition_power_cut(size_t bytes) {
+	pthread_mutex_lock(&flash_lock);
+	power_left = bytes;
+	pthread_mutex_unlock(&flash_lock);
+}
+
+void host_partition_power_on(void) {
+	pthread_mutex_lock(&flash_lock);
+	power_left = -1;
+	pthread_mutex_unlock(&flash_lock);
+}
+
+uint32_t host_partition_erases(const esp_partition_t *partition) {
+	pthread_mutex_lock(&flash_lock);
+	uint32_t erases = flash_get(partition, 0, 0)->erases;
+	pthread_mutex_unlock(&flash_lock);
+
+	return erases;
+}
+
+uint32_t host_partition_overwrites(const esp_partition_t *partition) {
+	pthread_mutex_lock(&flash_lock);
+	uint32_t overwrites = flash_get(partition, 0, 0)->overwrites;
+	pthread_mutex_unlock(&flash_lock);
+
+	return overwrites;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static flash_t *flash_get(const esp_partition_t *partition, size_t offset, size_t size) {
+	for (uint32_t i = 0; i < partitions_num; i++) {
+		if (partition == &flashes[i].partition) {
+			return offset + size <= partition->size ? &flashes[i] : NULL;
+		}
+	}
+
+	return NULL;
+}
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,122 @@
+/**
+  ******************************************************************************
+  * @file           : esp_pm.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Power management lock stand-ins for the host tests
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include "esp_pm.h"
+#include "host_test.h"
+
+/* Private macro -------------------------------------------------------------*/
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+struct esp_pm_lock {
+	esp_pm_lock_type_t type;
+	const char *name;
+	atomic_int count;
+};
+
+/* Private variables ---------------------------------------------------------*/
+static const char *dump;
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+esp_err_t esp_pm_configure(const void *config) {
+	return config == NULL ? ESP_ERR_INVALID_ARG : ESP_OK;
+}
+
+esp_err_t esp_pm_lock_create(esp_pm_lock_type_t lock_type, int arg, const char *name, esp_pm_lock_handle_t *out_handle) {
+	struct esp_pm_lock *lock = calloc(1, sizeof(*lock));
+
+	if (lock == NULL) {
+		return ESP_ERR_NO_MEM;
+	}
+
+	lock->type = lock_type;
+	lock->name = name;
+	*out_handle = lock;
+
+	return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_acquire(esp_pm_lock_handle_t handle) {
+	atomic_fetch_add(&handle->count, 1);
+
+	return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_release(esp_pm_lock_handle_t handle) {
+	/* Releasing a lock not held is an error, as with the IDF */
+	if (atomic_fetch_sub(&handle->count, 1) <= 0) {
+		atomic_fetch_add(&handle->count, 1);
+
+		return ESP_ERR_INVALID_STATE;
+	}
+
+	return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_delete(esp_pm_lock_handle_t handle) {
+	if (atomic_load(&handle->count)) {
+		return ESP_ERR_INVALID_STATE;
+	}
+
+	free(handle);
+
+	return ESP_OK;
+}
+
+esp_err_t esp_pm_dump_locks(FILE *stream) {
+	if (dump != NULL) {
+		fputs(dump, stream);
+	}
+
+	return ESP_OK;
+}
+
+void host_pm_set_dump(const char *text) {
+	dump = text;
+}
+
+int host_pm_lock_count(esp_pm_lock_handle_t handle) {
+	return atomic_load(&handle->count);
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,121 @@
+/**
+  ******************************************************************************
+  * @file           : esp_system.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Log and error name stand-ins for the host tests
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdio.h>
+
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "host_test.h"
+
+/* Private macro -------------------------------------------------------------*/
+/* The debug and verbose messages are dropped */
+#define LOG_LEVEL				ESP_LOG_INFO
+#define LOG_LINE_SIZE			256
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+	esp_err_t code;
+	const char *name;
+} err_name_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const err_name_t err_names[] = {
+		{ESP_OK, "ESP_OK"},
+		{ESP_FAIL, "ESP_FAIL"},
+		{ESP_ERR_NO_MEM, "ESP_ERR_NO_MEM"},
+		{ESP_ERR_INVALID_ARG, "ESP_ERR_INVALID_ARG"},
+		{ESP_ERR_INVALID_STATE, "ESP_ERR_INVALID_STATE"},
+		{ESP_ERR_INVALID_SIZE, "ESP_ERR_INVALID_SIZE"},
+		{ESP_ERR_NOT_FOUND, "ESP_ERR_NOT_FOUND"},
+		{ESP_ERR_NOT_SUPPORTED, "ESP_ERR_NOT_SUPPORTED"},
+		{ESP_ERR_TIMEOUT, "ESP_ERR_TIMEOUT"},
+		{ESP_ERR_INVALID_RESPONSE, "ESP_ERR_INVALID_RESPONSE"},
+		{ESP_ERR_INVALID_CRC, "ESP_ERR_INVALID_CRC"},
+		{ESP_ERR_NOT_FINISHED, "ESP_ERR_NOT_FINISHED"},
+};
+
+static _Atomic(host_log_hook_t) log_hook;
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+const char *esp_err_to_name(esp_err_t code) {
+	for (size_t i = 0; i < sizeof(err_names) / sizeof(err_names[0]); i++) {
+		if (err_names[i].code == code) {
+			return err_names[i].name;
+		}
+	}
+
+	return "UNKNOWN ERROR";
+}
+
+uint32_t esp_log_timestamp(void) {
+	return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+void esp_log_write(esp_log_level_t level, const char *tag, const char *format, ...) {
+	if (level > LOG_LEVEL) {
+		return;
+	}
+
+	char line[LOG_LINE_SIZE];
+	va_list args;
+
+	va_start(args, format);
+	vsnprintf(line, sizeof(line), format, args);
+	va_end(args);
+
+	host_log_hook_t hook = atomic_load(&log_hook);
+
+	if (hook != NULL) {
+		hook(level, tag, line);
+	}
+	else {
+		fputs(line, stderr);
+	}
+}
+
+void host_log_set_hook(host_log_hook_t hook) {
+	atomic_store(&log_hook, hook);
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,281 @@
+/**
+  ******************************************************************************
+  * @file           : esp_timer.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : esp_timer and RTC stand-ins with a skippable clock
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "host_internal.h"
+#include "host_test.h"
+
+/* Private macro -------------------------------------------------------------*/
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+struct esp_timer {
+	esp_timer_create_args_t args;
+	int64_t alarm;				/* In esp_timer_get_time() time */
+	uint64_t period;			/* 0 for a one-shot timer */
+	bool armed;
+	struct esp_timer *next;
+};
+
+/* Private variables ---------------------------------------------------------*/
+static _Atomic int64_t time_offset;
+static int64_t time_start;
+static pthread_once_t time_once = PTHREAD_ONCE_INIT;
+static _Atomic int64_t rtc_offset;	/* RTC time in us at esp_timer time 0 */
+
+/* The callbacks run one at a time on the dispatch task, as on the target */
+static pthread_mutex_t timers_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t timers_cond;
+static pthread_once_t timers_once = PTHREAD_ONCE_INIT;
+static struct esp_timer *timers;
+
+/* Private function prototypes -----------------------------------------------*/
+static void time_init(void);
+static void timers_init(void);
+static void timers_task(void *arg);
+
+/* Exported functions --------------------------------------------------------*/
+int64_t esp_timer_get_time(void) {
+	pthread_once(&time_once, time_init);
+
+	return host_real_time() - time_start + atomic_load(&time_offset);
+}
+
+void host_time_advance(int64_t us) {
+	atomic_fetch_add(&time_offset, us);
+
+	/* The alarms that the skip made due fire now */
+	pthread_once(&timers_once, timers_init);
+	pthread_mutex_lock(&timers_lock);
+	pthread_cond_broadcast(&timers_cond);
+	pthread_mutex_unlock(&timers_lock);
+}
+
+/* The RTC runs with esp_timer, as on the target, and is set by the tests
+ * without touching the system clock */
+/* The RTC goes on and esp_timer starts again, the tick count with it */
+void host_deep_sleep(int64_t us) {
+	int64_t now = esp_timer_get_time();
+
+	atomic_fetch_add(&rtc_offset, now + us);
+	atomic_fetch_sub(&time_offset, now);
+}
+
+int gettimeofday(struct timeval *tv, void *tz) {
+	int64_t us = atomic_load(&rtc_offset) + esp_timer_get_time();
+
+	tv->tv_sec = us / 1000000;
+	tv->tv_usec = us % 1000000;
+
+	return 0;
+}
+
+int settimeofday(const struct timeval *tv, const struct timezone *tz) {
+	atomic_store(&rtc_offset, (int64_t)tv->tv_sec * 1000000 + tv->tv_usec - esp_timer_get_time());
+
+	return 0;
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *create_args, esp_timer_handle_t *out_handle) {
+	if (create_args == NULL || create_args->callback == NULL || out_handle == NULL) {
+		return ESP_ERR_INVALID_ARG;
+	}
+
+	pthread_once(&timers_once, timers_init);
+
+	struct esp_timer *timer = calloc(1, sizeof(*timer));
+
+	timer->args = *create_args;
+
+	pthread_mutex_lock(&timers_lock);
+	timer->next = timers;
+	timers = timer;
+	pthread_mutex_unlock(&timers_lock);
+
+	*out_handle = timer;
+
+	return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us) {
+	esp_err_t ret = ESP_ERR_INVALID_STATE;
+
+	pthread_mutex_lock(&timers_lock);
+
+	if (!timer->armed) {
+		timer->alarm = esp_timer_get_time() + timeout_us;
+		timer->period = 0;
+		timer->armed = true;
+		pthread_cond_broadcast(&timers_cond);
+		ret = ESP_OK;
+	}
+
+	pthread_mutex_unlock(&timers_lock);
+
+	return ret;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period) {
+	esp_err_t ret = ESP_ERR_INVALID_STATE;
+
+	pthread_mutex_lock(&timers_lock);
+
+	if (!timer->armed) {
+		timer->alarm = esp_timer_get_time() + period;
+		timer->period = period;
+		timer->armed = true;
+		pthread_cond_broadcast(&timers_cond);
+		ret = ESP_OK;
+	}
+
+	pthread_mutex_unlock(&timers_lock);
+
+	return ret;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+	esp_err_t ret = ESP_ERR_INVALID_STATE;
+
+	pthread_mutex_lock(&timers_lock);
+
+	if (timer->armed) {
+		timer->armed = false;
+		ret = ESP_OK;
+	}
+
+	pthread_mutex_unlock(&timers_lock);
+
+	return ret;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer) {
+	pthread_mutex_lock(&timers_lock);
+
+	if (timer->armed) {
+		pthread_mutex_unlock(&timers_lock);
+
+		return ESP_ERR_INVALID_STATE;
+	}
+
+	for (struct esp_timer **t = &timers; *t != NULL; t = &(*t)->next) {
+		if (*t == timer) {
+			*t = timer->next;
+			break;
+		}
+	}
+
+	pthread_mutex_unlock(&timers_lock);
+	free(timer);
+
+	return ESP_OK;
+}
+
+bool esp_timer_is_active(esp_timer_handle_t timer) {
+	pthread_mutex_lock(&timers_lock);
+	bool armed = timer->armed;
+	pthread_mutex_unlock(&timers_lock);
+
+	return armed;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static void time_init(void) {
+	time_start = host_real_time();
+}
+
+static void timers_init(void) {
+	pthread_condattr_t attr;
+
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&timers_cond, &attr);
+	pthread_condattr_destroy(&attr);
+
+	xTaskCreate(timers_task, "esp_timer", 4096, NULL, 22, NULL);
+}
+
+static void timers_task(void *arg) {
+	pthread_mutex_lock(&timers_lock);
+
+	for (;;) {
+		struct esp_timer *next = NULL;
+
+		for (struct esp_timer *t = timers; t != NULL; t = t->next) {
+			if (t->armed && (next == NULL || t->alarm < next->alarm)) {
+				next = t;
+			}
+		}
+
+		if (next == NULL) {
+			pthread_cond_wait(&timers_cond, &timers_lock);
+			continue;
+		}
+
+		int64_t now = esp_timer_get_time();
+
+		if (next->alarm > now) {
+			struct timespec deadline;
+
+			host_deadline(host_real_time() + next->alarm - now, &deadline);
+			pthread_cond_timedwait(&timers_cond, &timers_lock, &deadline);
+			continue;
+		}
+
+		if (next->period) {
+			next->alarm += next->period;
+		}
+		else {
+			next->armed = false;
+		}
+
+		esp_timer_create_args_t args = next->args;
+
+		pthread_mutex_unlock(&timers_lock);
+		host_isr_context(args.dispatch_method == ESP_TIMER_ISR);
+		args.callback(args.arg);
+		host_isr_context(false);
+		pthread_mutex_lock(&timers_lock);
+	}
+}
+
+/***************************** END OF FILE ************************************/
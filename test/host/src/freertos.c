@@ -0,0 +1,615 @@
+/**
+  ******************************************************************************
+  * @file           : freertos.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : FreeRTOS kernel objects on pthreads for the host tests
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+#include "freertos/event_groups.h"
+#include "esp_timer.h"
+#include "host_internal.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define TICK_US					(portTICK_PERIOD_MS * 1000)
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+struct host_task {
+	pthread_t thread;
+	char name[configMAX_TASK_NAME_LEN];
+	TaskFunction_t fn;
+	void *arg;
+	UBaseType_t prio;
+	UBaseType_t number;
+	uint32_t stack_depth;
+	uint32_t notify;
+	pthread_cond_t cond;
+	struct host_task *next;
+};
+
+struct host_sem {
+	pthread_cond_t cond;
+	UBaseType_t count;
+	UBaseType_t max;
+};
+
+struct host_queue {
+	pthread_cond_t cond;
+	uint8_t *items;
+	UBaseType_t length;
+	UBaseType_t item_size;
+	UBaseType_t head;
+	UBaseType_t count;
+};
+
+struct host_event_group {
+	pthread_cond_t cond;
+	EventBits_t bits;
+};
+
+/* Private variables ---------------------------------------------------------*/
+/* One lock guards the state of every kernel object, each object waits on its
+ * own condition */
+static pthread_mutex_t kernel_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t critical_lock;
+static pthread_once_t critical_once = PTHREAD_ONCE_INIT;
+static struct host_task *tasks;
+static UBaseType_t tasks_created;
+static __thread struct host_task *current;
+static __thread bool in_isr;
+
+/* Private function prototypes -----------------------------------------------*/
+static void cond_init(pthread_cond_t *cond);
+static bool cond_wait(pthread_cond_t *cond, TickType_t ticks, int64_t start);
+static struct host_task *task_new(const char *name, TaskFunction_t fn, void *arg, UBaseType_t prio, uint32_t stack_depth);
+static void *task_main(void *arg);
+static struct host_task *task_current(void);
+static void critical_init(void);
+static SemaphoreHandle_t sem_new(UBaseType_t max, UBaseType_t count);
+
+/* Exported functions --------------------------------------------------------*/
+int64_t host_real_time(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+void host_deadline(int64_t us, struct timespec *ts) {
+	ts->tv_sec = us / 1000000;
+	ts->tv_nsec = (us % 1000000) * 1000;
+}
+
+void host_isr_context(bool isr) {
+	in_isr = isr;
+}
+
+BaseType_t xPortInIsrContext(void) {
+	return in_isr;
+}
+
+void host_critical_enter(void) {
+	pthread_once(&critical_once, critical_init);
+	pthread_mutex_lock(&critical_lock);
+}
+
+void host_critical_exit(void) {
+	pthread_mutex_unlock(&critical_lock);
+}
+
+/* Tasks ---------------------------------------------------------------------*/
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *arg, UBaseType_t prio, TaskHandle_t *handle) {
+	struct host_task *task = task_new(name, fn, arg, prio, stack_depth);
+
+	/* The handle is set before the task runs, as with the kernel */
+	if (handle != NULL) {
+		*handle = task;
+	}
+
+	if (pthread_create(&task->thread, NULL, task_main, task) != 0) {
+		return pdFAIL;
+	}
+
+	pthread_detach(task->thread);
+
+	return pdPASS;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *arg, UBaseType_t prio, TaskHandle_t *handle, BaseType_t core_id) {
+	return xTaskCreate(fn, name, stack_depth, arg, prio, handle);
+}
+
+TaskHandle_t xTaskCreateStatic(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *arg, UBaseType_t prio, StackType_t *stack, StaticTask_t *task_buffer) {
+	TaskHandle_t handle = NULL;
+
+	xTaskCreate(fn, name, stack_depth, arg, prio, &handle);
+
+	return handle;
+}
+
+void vTaskDelete(TaskHandle_t task) {
+	/* The task object is kept, the handle may still be notified */
+	if (task == NULL || task == current) {
+		pthread_exit(NULL);
+	}
+
+	pthread_cancel(task->thread);
+}
+
+void vTaskDelay(TickType_t ticks) {
+	usleep((useconds_t)ticks * TICK_US);
+}
+
+BaseType_t xTaskDelayUntil(TickType_t *previous_wake_time, TickType_t increment) {
+	TickType_t wake_time = *previous_wake_time + increment;
+	TickType_t now = xTaskGetTickCount();
+
+	*previous_wake_time = wake_time;
+
+	if ((int32_t)(wake_time - now) <= 0) {
+		return pdFALSE;
+	}
+
+	vTaskDelay(wake_time - now);
+
+	return pdTRUE;
+}
+
+void vTaskDelayUntil(TickType_t *previous_wake_time, TickType_t increment) {
+	xTaskDelayUntil(previous_wake_time, increment);
+}
+
+TickType_t xTaskGetTickCount(void) {
+	return (TickType_t)(esp_timer_get_time() / TICK_US);
+}
+
+TickType_t xTaskGetTickCountFromISR(void) {
+	return xTaskGetTickCount();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+	return task_current();
+}
+
+const char *pcTaskGetName(TaskHandle_t task) {
+	return task == NULL ? task_current()->name : task->name;
+}
+
+/* The deleted tasks are counted, their objects are kept */
+UBaseType_t uxTaskGetNumberOfTasks(void) {
+	UBaseType_t num = 0;
+
+	pthread_mutex_lock(&kernel_lock);
+
+	for (struct host_task *task = tasks; task != NULL; task = task->next) {
+		num++;
+	}
+
+	pthread_mutex_unlock(&kernel_lock);
+
+	return num;
+}
+
+/* No run time stats on the host, the tests that fake the task list override
+ * it */
+__attribute__((weak)) UBaseType_t uxTaskGetSystemState(TaskStatus_t *status_array, UBaseType_t array_size, uint32_t *total_run_time) {
+	*total_run_time = 0;
+
+	return 0;
+}
+
+void vTaskSuspendAll(void) {
+	host_critical_enter();
+}
+
+BaseType_t xTaskResumeAll(void) {
+	host_critical_exit();
+
+	return pdFALSE;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+	pthread_mutex_lock(&kernel_lock);
+	task->notify++;
+	pthread_cond_broadcast(&task->cond);
+	pthread_mutex_unlock(&kernel_lock);
+
+	return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higher_priority_task_woken) {
+	xTaskNotifyGive(task);
+
+	if (higher_priority_task_woken != NULL) {
+		*higher_priority_task_woken = pdTRUE;
+	}
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait) {
+	struct host_task *task = task_current();
+	int64_t start = host_real_time();
+
+	pthread_mutex_lock(&kernel_lock);
+
+	while (task->notify == 0 && cond_wait(&task->cond, ticks_to_wait, start));
+
+	uint32_t value = task->notify;
+
+	if (value) {
+		task->notify = clear_on_exit ? 0 : value - 1;
+	}
+
+	pthread_mutex_unlock(&kernel_lock);
+
+	return value;
+}
+
+/* Semaphores ----------------------------------------------------------------*/
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+	return sem_new(1, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t *buffer) {
+	return sem_new(1, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void) {
+	return sem_new(1, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *buffer) {
+	return sem_new(1, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max_count, UBaseType_t initial_count) {
+	return sem_new(max_count, initial_count);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks_to_wait) {
+	int64_t start = host_real_time();
+	BaseType_t ret = pdFALSE;
+
+	pthread_mutex_lock(&kernel_lock);
+
+	while (sem->count == 0 && cond_wait(&sem->cond, ticks_to_wait, start));
+
+	if (sem->count) {
+		sem->count--;
+		ret = pdTRUE;
+	}
+
+	pthread_mutex_unlock(&kernel_lock);
+
+	return ret;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+	BaseType_t ret = pdFALSE;
+
+	pthread_mutex_lock(&kernel_lock);
+
+	if (sem->count < sem->max) {
+		sem->count++;
+		pthread_cond_broadcast(&sem->cond);
+		ret = pdTRUE;
+	}
+
+	pthread_mutex_unlock(&kernel_lock);
+
+	return ret;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t *higher_priority_task_woken) {
+	if (higher_priority_task_woken != NULL) {
+		*higher_priority_task_woken = pdFALSE;
+	}
+
+	return xSemaphoreGive(sem);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t sem) {
+	pthread_cond_destroy(&sem->cond);
+	free(sem);
+}
+
+/* Queues --------------------------------------------------------------------*/
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) {
+	struct host_queue *queue = calloc(1, sizeof(*queue));
+
+	queue->items = calloc(length, item_size);
+	queue->length = length;
+	queue->item_size = item_size;
+	cond_init(&queue->cond);
+
+	return queue;
+}
+
+QueueHandle_t xQueueCreateStatic(UBaseType_t length, UBaseType_t item_size, uint8_t *storage, StaticQueue_t *buffer) {
+	return xQueueCreate(length, item_size);
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks_to_wait) {
+	int64_t start = host_real_time();
+	BaseType_t ret = pdFALSE;
+
+	pthread_mutex_lock(&kernel_lock);
+
+	while (queue->count == queue->length && cond_wait(&queue->cond, ticks_to_wait, start));
+
+	if (queue->count < queue->length) {
+		UBaseType_t tail = (queue->head + queue->count) % queue->length;
+
+		memcpy(&queue->items[tail * queue->item_size], item, queue->item_size);
+		queue->count++;
+		pthread_cond_broadcast(&queue->cond);
+		ret = pdTRUE;
+	}
+
+	pthread_mutex_unlock(&kernel_lock);
+
+	return ret;
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void *item, TickType_t ticks_to_wait) {
+	return xQueueSend(queue, item, ticks_to_wait);
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void *item, BaseType_t *higher_priority_task_woken) {
+	if (higher_priority_task_woken != NULL) {
+		*higher_priority_task_woken = pdFALSE;
+	}
+
+	return xQueueSend(queue, item, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks_to_wait) {
+	int64_t start = host_real_time();
+	BaseType_t ret = pdFALSE;
+
+	pthread_mutex_lock(&kernel_lock);
+
+	while (queue->count == 0 && cond_wait(&queue->cond, ticks_to_wait, start));
+
+	if (queue->count) {
+		memcpy(item, &queue->items[queue->head * queue->item_size], queue->item_size);
+		queue->head = (queue->head + 1) % queue->length;
+		queue->count--;
+		pthread_cond_broadcast(&queue->cond);
+		ret = pdTRUE;
+	}
+
+	pthread_mutex_unlock(&kernel_lock);
+
+	return ret;
+}
+
+BaseType_t xQueuePeek(QueueHandle_t queue, void *item, TickType_t ticks_to_wait) {
+	int64_t start = host_real_time();
+	BaseType_t ret = pdFALSE;
+
+	pthread_mutex_lock(&kernel_lock);
+
+	while (queue->count == 0 && cond_wait(&queue->cond, ticks_to_wait, start));
+
+	if (queue->count) {
+		memcpy(item, &queue->items[queue->head * queue->item_size], queue->item_size);
+		ret = pdTRUE;
+	}
+
+	pthread_mutex_unlock(&kernel_lock);
+
+	return ret;
+}
+
+BaseType_t xQueueReset(QueueHandle_t queue) {
+	pthread_mutex_lock(&kernel_lock);
+	queue->head = 0;
+	queue->count = 0;
+	pthread_cond_broadcast(&queue->cond);
+	pthread_mutex_unlock(&kernel_lock);
+
+	return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+	pthread_mutex_lock(&kernel_lock);
+	UBaseType_t count = queue->count;
+	pthread_mutex_unlock(&kernel_lock);
+
+	return count;
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+	pthread_cond_destroy(&queue->cond);
+	free(queue->items);
+	free(queue);
+}
+
+/* Event groups --------------------------------------------------------------*/
+EventGroupHandle_t xEventGroupCreate(void) {
+	struct host_event_group *group = calloc(1, sizeof(*group));
+
+	cond_init(&group->cond);
+
+	return group;
+}
+
+EventGroupHandle_t xEventGroupCreateStatic(StaticEventGroup_t *buffer) {
+	return xEventGroupCreate();
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, const EventBits_t bits) {
+	pthread_mutex_lock(&kernel_lock);
+	group->bits |= bits;
+	EventBits_t value = group->bits;
+	pthread_cond_broadcast(&group->cond);
+	pthread_mutex_unlock(&kernel_lock);
+
+	return value;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t group, const EventBits_t bits) {
+	pthread_mutex_lock(&kernel_lock);
+	EventBits_t value = group->bits;
+	group->bits &= ~bits;
+	pthread_mutex_unlock(&kernel_lock);
+
+	/* The bits before the clear, as the kernel */
+	return value;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t group) {
+	pthread_mutex_lock(&kernel_lock);
+	EventBits_t value = group->bits;
+	pthread_mutex_unlock(&kernel_lock);
+
+	return value;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t group, const EventBits_t bits, const BaseType_t clear_on_exit,
+		const BaseType_t wait_for_all, TickType_t ticks_to_wait) {
+	int64_t start = host_real_time();
+
+	pthread_mutex_lock(&kernel_lock);
+
+	while (!(wait_for_all ? (group->bits & bits) == bits : (group->bits & bits) != 0) &&
+			cond_wait(&group->cond, ticks_to_wait, start));
+
+	/* The bits when the wait ended, met or not */
+	EventBits_t value = group->bits;
+
+	if (clear_on_exit && (wait_for_all ? (value & bits) == bits : (value & bits) != 0)) {
+		group->bits &= ~bits;
+	}
+
+	pthread_mutex_unlock(&kernel_lock);
+
+	return value;
+}
+
+void vEventGroupDelete(EventGroupHandle_t group) {
+	pthread_cond_destroy(&group->cond);
+	free(group);
+}
+
+/* Private functions ---------------------------------------------------------*/
+static void cond_init(pthread_cond_t *cond) {
+	pthread_condattr_t attr;
+
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(cond, &attr);
+	pthread_condattr_destroy(&attr);
+}
+
+/* Waits with the kernel lock held, false once the ticks since start elapsed */
+static bool cond_wait(pthread_cond_t *cond, TickType_t ticks, int64_t start) {
+	if (ticks == portMAX_DELAY) {
+		pthread_cond_wait(cond, &kernel_lock);
+
+		return true;
+	}
+
+	struct timespec deadline;
+
+	host_deadline(start + (int64_t)ticks * TICK_US, &deadline);
+
+	return pthread_cond_timedwait(cond, &kernel_lock, &deadline) != ETIMEDOUT;
+}
+
+static struct host_task *task_new(const char *name, TaskFunction_t fn, void *arg, UBaseType_t prio, uint32_t stack_depth) {
+	struct host_task *task = calloc(1, sizeof(*task));
+
+	strncpy(task->name, name, sizeof(task->name) - 1);
+	task->fn = fn;
+	task->arg = arg;
+	task->prio = prio;
+	task->stack_depth = stack_depth;
+	cond_init(&task->cond);
+
+	pthread_mutex_lock(&kernel_lock);
+	task->number = ++tasks_created;
+	task->next = tasks;
+	tasks = task;
+	pthread_mutex_unlock(&kernel_lock);
+
+	return task;
+}
+
+static void *task_main(void *arg) {
+	current = arg;
+	current->fn(current->arg);
+
+	return NULL;
+}
+
+/* Threads not created as tasks, such as main(), get a handle on first use */
+static struct host_task *task_current(void) {
+	if (current == NULL) {
+		current = task_new("main", NULL, NULL, 1, 0);
+		current->thread = pthread_self();
+	}
+
+	return current;
+}
+
+static void critical_init(void) {
+	pthread_mutexattr_t attr;
+
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&critical_lock, &attr);
+	pthread_mutexattr_destroy(&attr);
+}
+
+static SemaphoreHandle_t sem_new(UBaseType_t max, UBaseType_t count) {
+	struct host_sem *sem = calloc(1, sizeof(*sem));
+
+	sem->max = max;
+	sem->count = count;
+	cond_init(&sem->cond);
+
+	return sem;
+}
+
+/***************************** END OF FILE ************************************/
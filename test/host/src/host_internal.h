@@ -0,0 +1,78 @@
+/**
+  ******************************************************************************
+  * @file           : host_internal.h
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Shared helpers of the host stand-ins
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef HOST_INTERNAL_H_
+#define HOST_INTERNAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+/* Exported functions prototypes ---------------------------------------------*/
+/**
+  * @brief Function to get the real monotonic time, the clock of every timed
+  *        wait of the stand-ins
+  *
+  * @retval Time in us
+  */
+int64_t host_real_time(void);
+
+/**
+  * @brief Function to convert a real monotonic time to a timed wait deadline
+  *
+  * @param us : Real monotonic time in us
+  * @param ts : Pointer to store the deadline
+  */
+void host_deadline(int64_t us, struct timespec *ts);
+
+/**
+  * @brief Function to mark the calling thread as running an interrupt handler
+  *
+  * @param isr : True on entry of the handler, false on exit
+  */
+void host_isr_context(bool isr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_INTERNAL_H_ */
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,116 @@
+/**
+  ******************************************************************************
+  * @file           : i2c_fake.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : Loopback fake of an I2C bus device for the host tests
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+
+#include "i2c_fake.h"
+#include "esp_timer.h"
+
+/* Private macro -------------------------------------------------------------*/
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+static int8_t fake_read(uint8_t *reg_addr, uint8_t addr_len, uint8_t *reg_data, uint32_t data_len, void *intf);
+static int8_t fake_write(uint8_t *reg_addr, uint8_t addr_len, const uint8_t *reg_data, uint32_t data_len, void *intf);
+static int8_t fake_xfer(i2c_fake_t *fake, i2c_fake_op_e op, uint8_t *reg_addr, uint8_t addr_len, uint8_t *data, uint32_t data_len);
+
+/* Exported functions --------------------------------------------------------*/
+void i2c_fake_init(i2c_fake_t * const me, const char *name, uint8_t addr) {
+	memset(me, 0, sizeof(*me));
+	snprintf(me->dev.name, sizeof(me->dev.name), "%s", name);
+	me->dev.addr = addr;
+	me->dev.read = fake_read;
+	me->dev.write = fake_write;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static int8_t fake_read(uint8_t *reg_addr, uint8_t addr_len, uint8_t *reg_data, uint32_t data_len, void *intf) {
+	return fake_xfer(intf, I2C_FAKE_READ, reg_addr, addr_len, reg_data, data_len);
+}
+
+static int8_t fake_write(uint8_t *reg_addr, uint8_t addr_len, const uint8_t *reg_data, uint32_t data_len, void *intf) {
+	/* The data is only read from on writes */
+	return fake_xfer(intf, I2C_FAKE_WRITE, reg_addr, addr_len, (uint8_t *)reg_data, data_len);
+}
+
+static int8_t fake_xfer(i2c_fake_t *fake, i2c_fake_op_e op, uint8_t *reg_addr, uint8_t addr_len, uint8_t *data, uint32_t data_len) {
+	i2c_fake_xfer_t xfer = {
+			.op = op,
+			.reg_addr_len = addr_len,
+			.data_len = data_len,
+			.task = xTaskGetCurrentTaskHandle(),
+	};
+
+	for (uint8_t i = 0; i < addr_len && i < sizeof(xfer.reg_addr); i++) {
+		xfer.reg_addr[i] = reg_addr[i];
+	}
+
+	xfer.time = esp_timer_get_time();
+
+	if (++fake->xfers_num == fake->fail_at) {
+		xfer.rslt = -1;
+	}
+	else if (fake->model != NULL) {
+		xfer.rslt = fake->model(fake, &xfer, data);
+	}
+	else {
+		uint8_t start = addr_len ? reg_addr[addr_len - 1] : 0;
+
+		for (uint32_t i = 0; i < data_len; i++) {
+			uint8_t *reg = &fake->mem[(start + i) % I2C_FAKE_MEM_SIZE];
+
+			if (op == I2C_FAKE_READ) {
+				data[i] = *reg;
+			}
+			else {
+				*reg = data[i];
+			}
+		}
+	}
+
+	if (fake->xfers_num <= I2C_FAKE_LOG_SIZE) {
+		fake->xfers[fake->xfers_num - 1] = xfer;
+	}
+
+	return xfer.rslt;
+}
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,212 @@
+/**
+  ******************************************************************************
+  * @file           : nvs.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : In-memory NVS stand-in for the host tests
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nvs.h"
+#include "host_test.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define NAMESPACES_NUM			8
+#define ENTRIES_NUM				32
+#define NAME_SIZE				16		/* With the terminator, as the IDF */
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+	nvs_handle_t handle;		/* Of the namespace, 0 for a free entry */
+	char key[NAME_SIZE];
+	void *value;
+	size_t len;
+} entry_t;
+
+/* Private variables ---------------------------------------------------------*/
+/* The store outlives the handles, as the flash partition across reboots */
+static pthread_mutex_t nvs_lock = PTHREAD_MUTEX_INITIALIZER;
+static char namespaces[NAMESPACES_NUM][NAME_SIZE];
+static entry_t entries[ENTRIES_NUM];
+static uint32_t writes;
+static esp_err_t write_error;
+
+/* Private function prototypes -----------------------------------------------*/
+static entry_t *entry_find(nvs_handle_t handle, const char *key);
+
+/* Exported functions --------------------------------------------------------*/
+esp_err_t nvs_open(const char *namespace_name, nvs_open_mode_t open_mode, nvs_handle_t *out_handle) {
+	if (namespace_name == NULL || strlen(namespace_name) >= NAME_SIZE || out_handle == NULL) {
+		return ESP_ERR_INVALID_ARG;
+	}
+
+	esp_err_t ret = ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+
+	pthread_mutex_lock(&nvs_lock);
+
+	for (nvs_handle_t i = 0; i < NAMESPACES_NUM; i++) {
+		if (namespaces[i][0] == '\0') {
+			strcpy(namespaces[i], namespace_name);
+		}
+
+		if (strcmp(namespaces[i], namespace_name) == 0) {
+			*out_handle = i + 1;
+			ret = ESP_OK;
+			break;
+		}
+	}
+
+	pthread_mutex_unlock(&nvs_lock);
+
+	return ret;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *out_value, size_t *length) {
+	esp_err_t ret = ESP_OK;
+
+	pthread_mutex_lock(&nvs_lock);
+
+	entry_t *entry = entry_find(handle, key);
+
+	if (entry == NULL) {
+		ret = ESP_ERR_NVS_NOT_FOUND;
+	}
+	/* Without a buffer only the length is returned */
+	else if (out_value == NULL) {
+		*length = entry->len;
+	}
+	else if (*length < entry->len) {
+		ret = ESP_ERR_NVS_INVALID_LENGTH;
+	}
+	else {
+		memcpy(out_value, entry->value, entry->len);
+		*length = entry->len;
+	}
+
+	pthread_mutex_unlock(&nvs_lock);
+
+	return ret;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length) {
+	if (key == NULL || strlen(key) >= NAME_SIZE || value == NULL) {
+		return ESP_ERR_INVALID_ARG;
+	}
+
+	esp_err_t ret = ESP_OK;
+
+	pthread_mutex_lock(&nvs_lock);
+
+	entry_t *entry = entry_find(handle, key);
+
+	for (uint32_t i = 0; i < ENTRIES_NUM && entry == NULL; i++) {
+		if (entries[i].handle == 0) {
+			entry = &entries[i];
+			entry->handle = handle;
+			strcpy(entry->key, key);
+		}
+	}
+
+	if (write_error != ESP_OK) {
+		ret = write_error;
+	}
+	else if (entry == NULL) {
+		ret = ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+	}
+	else {
+		free(entry->value);
+		entry->value = malloc(length);
+		memcpy(entry->value, value, length);
+		entry->len = length;
+		writes++;
+	}
+
+	pthread_mutex_unlock(&nvs_lock);
+
+	return ret;
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle) {
+	pthread_mutex_lock(&nvs_lock);
+	esp_err_t ret = write_error;
+	pthread_mutex_unlock(&nvs_lock);
+
+	return ret;
+}
+
+void nvs_close(nvs_handle_t handle) {
+}
+
+void host_nvs_erase(void) {
+	pthread_mutex_lock(&nvs_lock);
+
+	for (uint32_t i = 0; i < ENTRIES_NUM; i++) {
+		free(entries[i].value);
+	}
+
+	memset(entries, 0, sizeof(entries));
+	memset(namespaces, 0, sizeof(namespaces));
+	writes = 0;
+	write_error = ESP_OK;
+
+	pthread_mutex_unlock(&nvs_lock);
+}
+
+uint32_t host_nvs_writes(void) {
+	pthread_mutex_lock(&nvs_lock);
+	uint32_t ret = writes;
+	pthread_mutex_unlock(&nvs_lock);
+
+	return ret;
+}
+
+void host_nvs_write_error(esp_err_t err) {
+	pthread_mutex_lock(&nvs_lock);
+	write_error = err;
+	pthread_mutex_unlock(&nvs_lock);
+}
+
+/* Private functions ---------------------------------------------------------*/
+static entry_t *entry_find(nvs_handle_t handle, const char *key) {
+	for (uint32_t i = 0; i < ENTRIES_NUM; i++) {
+		if (entries[i].handle == handle && strcmp(entries[i].key, key) == 0) {
+			return &entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,627 @@
+/**
+  ******************************************************************************
+  * @file           : rmt.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : RMT TX stand-in that times and records the frames
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "driver/rmt_tx.h"
+#include "esp_pm.h"
+#include "esp_timer.h"
+#include "host_test.h"
+#include "host_internal.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define CHANNELS_NUM			4
+#define LOOP_END				INT64_MAX	/* Of a transaction looping until the channel is disabled */
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+	size_t num_symbols;
+	int64_t end;				/* esp_timer time the last symbol leaves the wire */
+} trans_t;
+
+struct rmt_channel_t {
+	rmt_tx_channel_config_t config;
+	esp_pm_lock_handle_t pm_lock;
+	esp_timer_handle_t done_timer;
+	rmt_tx_done_callback_t on_trans_done;
+	void *user_data;
+	bool enabled;
+
+	/* Transactions on the wire or waiting for it */
+	trans_t *queue;
+	size_t head;
+	size_t count;
+
+	/* Symbols of the transaction being encoded, the last one once sent */
+	rmt_symbol_word_t *symbols;
+	size_t num_symbols;
+	size_t size;
+	size_t mem_free;			/* Room left in the memory block for the encoders */
+	uint32_t tx_count;
+};
+
+typedef struct {
+	rmt_encoder_t base;
+	rmt_symbol_word_t bit0;
+	rmt_symbol_word_t bit1;
+	bool msb_first;
+	size_t byte_index;			/* Resumed after a full memory block, as the IDF */
+	uint8_t bit_index;
+} bytes_encoder_t;
+
+typedef struct {
+	rmt_encoder_t base;
+	size_t symbol_index;
+} copy_encoder_t;
+
+/* Private variables ---------------------------------------------------------*/
+static pthread_mutex_t rmt_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t done_lock = PTHREAD_MUTEX_INITIALIZER;	/* Held while the done callbacks run */
+static rmt_channel_handle_t channels[CHANNELS_NUM];
+static esp_err_t encoder_error;
+
+/* Private function prototypes -----------------------------------------------*/
+static bool channel_write(rmt_channel_handle_t channel, rmt_symbol_word_t symbol);
+static void channel_settle(rmt_channel_handle_t channel);
+static void channel_arm(rmt_channel_handle_t channel);
+static void channel_done(void *arg);
+static size_t bytes_encode(rmt_encoder_t *encoder, rmt_channel_handle_t channel, const void *primary_data, size_t data_size, rmt_encode_state_t *ret_state);
+static esp_err_t bytes_reset(rmt_encoder_t *encoder);
+static size_t copy_encode(rmt_encoder_t *encoder, rmt_channel_handle_t channel, const void *primary_data, size_t data_size, rmt_encode_state_t *ret_state);
+static esp_err_t copy_reset(rmt_encoder_t *encoder);
+static esp_err_t encoder_del(rmt_encoder_t *encoder);
+
+/* Exported functions --------------------------------------------------------*/
+esp_err_t rmt_new_tx_channel(const rmt_tx_channel_config_t *config, rmt_channel_handle_t *ret_chan) {
+	if (config == NULL || ret_chan == NULL || config->gpio_num < 0 || config->resolution_hz == 0 ||
+			config->mem_block_symbols == 0 || config->trans_queue_depth == 0) {
+		return ESP_ERR_INVALID_ARG;
+	}
+
+	struct rmt_channel_t *channel = calloc(1, sizeof(*channel));
+
+	if (channel == NULL) {
+		return ESP_ERR_NO_MEM;
+	}
+
+	channel->config = *config;
+	channel->queue = calloc(config->trans_queue_depth, sizeof(trans_t));
+
+	esp_timer_create_args_t args = {
+			.callback = channel_done,
+			.arg = channel,
+			.dispatch_method = ESP_TIMER_ISR,
+			.name = "rmt",
+	};
+
+	/* The driver holds a lock while the channel is enabled */
+	if (channel->queue == NULL || esp_timer_create(&args, &channel->done_timer) != ESP_OK ||
+			esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "rmt", &channel->pm_lock) != ESP_OK) {
+		free(channel->queue);
+		free(channel);
+		return ESP_ERR_NO_MEM;
+	}
+
+	pthread_mutex_lock(&rmt_lock);
+
+	for (uint32_t i = 0; i < CHANNELS_NUM; i++) {
+		if (channels[i] == NULL) {
+			channels[i] = channel;
+			*ret_chan = channel;
+			pthread_mutex_unlock(&rmt_lock);
+
+			return ESP_OK;
+		}
+	}
+
+	pthread_mutex_unlock(&rmt_lock);
+	esp_timer_delete(channel->done_timer);
+	esp_pm_lock_delete(channel->pm_lock);
+	free(channel->queue);
+	free(channel);
+
+	return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t rmt_del_channel(rmt_channel_handle_t channel) {
+	pthread_mutex_lock(&rmt_lock);
+
+	if (channel->enabled) {
+		pthread_mutex_unlock(&rmt_lock);
+
+		return ESP_ERR_INVALID_STATE;
+	}
+
+	for (uint32_t i = 0; i < CHANNELS_NUM; i++) {
+		if (channels[i] == channel) {
+			channels[i] = NULL;
+		}
+	}
+
+	pthread_mutex_unlock(&rmt_lock);
+
+	esp_timer_stop(channel->done_timer);
+	esp_timer_delete(channel->done_timer);
+	esp_pm_lock_delete(channel->pm_lock);
+	free(channel->symbols);
+	free(channel->queue);
+	free(channel);
+
+	return ESP_OK;
+}
+
+esp_err_t rmt_enable(rmt_channel_handle_t channel) {
+	esp_err_t ret = ESP_ERR_INVALID_STATE;
+
+	pthread_mutex_lock(&rmt_lock);
+
+	if (!channel->enabled) {
+		esp_pm_lock_acquire(channel->pm_lock);
+		channel->enabled = true;
+		ret = ESP_OK;
+	}
+
+	pthread_mutex_unlock(&rmt_lock);
+
+	return ret;
+}
+
+/* The transactions left are dropped without their callbacks, as the IDF */
+esp_err_t rmt_disable(rmt_channel_handle_t channel) {
+	esp_err_t ret = ESP_ERR_INVALID_STATE;
+
+	pthread_mutex_lock(&rmt_lock);
+
+	if (channel->enabled) {
+		channel->count = 0;
+		channel->enabled = false;
+		esp_timer_stop(channel->done_timer);
+		esp_pm_lock_release(channel->pm_lock);
+		ret = ESP_OK;
+	}
+
+	pthread_mutex_unlock(&rmt_lock);
+
+	return ret;
+}
+
+esp_err_t rmt_transmit(rmt_channel_handle_t tx_channel, rmt_encoder_handle_t encoder, const void *payload, size_t payload_bytes, const rmt_transmit_config_t *config) {
+	if (tx_channel == NULL || encoder == NULL || payload == NULL || payload_bytes == 0 || config == NULL) {
+		return ESP_ERR_INVALID_ARG;
+	}
+
+	channel_settle(tx_channel);
+	pthread_mutex_lock(&rmt_lock);
+
+	if (!tx_channel->enabled) {
+		pthread_mutex_unlock(&rmt_lock);
+
+		return ESP_ERR_INVALID_STATE;
+	}
+
+	/* The target blocks for a free slot, the caller waits as long */
+	while (tx_channel->count == tx_channel->config.trans_queue_depth) {
+		int64_t end = tx_channel->queue[tx_channel->head].end;
+
+		pthread_mutex_unlock(&rmt_lock);
+
+		if (end == LOOP_END) {
+			return ESP_ERR_INVALID_STATE;
+		}
+
+		int64_t wait = end - esp_timer_get_time();
+
+		if (wait > 0) {
+			host_time_advance(wait);
+		}
+
+		channel_settle(tx_channel);
+		pthread_mutex_lock(&rmt_lock);
+	}
+
+	rmt_encode_state_t state = RMT_ENCODING_RESET;
+	bool loop = config->loop_count != 0;
+
+	tx_channel->num_symbols = 0;
+	tx_channel->mem_free = tx_channel->config.mem_block_symbols;
+	encoder->reset(encoder);
+
+	do {
+		encoder->encode(encoder, tx_channel, payload, payload_bytes, &state);
+
+		if (!(state & (RMT_ENCODING_COMPLETE | RMT_ENCODING_MEM_FULL))) {
+			pthread_mutex_unlock(&rmt_lock);
+
+			return ESP_ERR_INVALID_STATE;
+		}
+
+		/* A loop plays the memory block over, it must hold the whole
+		 * transaction and the end marker */
+		if (loop && (state & RMT_ENCODING_MEM_FULL || tx_channel->num_symbols + 1 > tx_channel->config.mem_block_symbols)) {
+			encoder->reset(encoder);
+			pthread_mutex_unlock(&rmt_lock);
+
+			return ESP_ERR_INVALID_ARG;
+		}
+
+		/* The peripheral sent half of the block, the encoder refills it */
+		if (state & RMT_ENCODING_MEM_FULL) {
+			tx_channel->mem_free = tx_channel->config.mem_block_symbols / 2;
+		}
+	} while (!(state & RMT_ENCODING_COMPLETE));
+
+	uint64_t ticks = 0;
+
+	for (size_t i = 0; i < tx_channel->num_symbols; i++) {
+		ticks += tx_channel->symbols[i].duration0 + tx_channel->symbols[i].duration1;
+	}
+
+	int64_t start = esp_timer_get_time();
+
+	/* After the transactions ahead of it */
+	if (tx_channel->count) {
+		int64_t last = tx_channel->queue[(tx_channel->head + tx_channel->count - 1) % tx_channel->config.trans_queue_depth].end;
+
+		start = last > start ? last : start;
+	}
+
+	tx_channel->queue[(tx_channel->head + tx_channel->count) % tx_channel->config.trans_queue_depth] = (trans_t) {
+			.num_symbols = tx_channel->num_symbols,
+			.end = loop ? LOOP_END : start + (int64_t)(ticks * 1000000 / tx_channel->config.resolution_hz),
+	};
+	tx_channel->count++;
+	tx_channel->tx_count++;
+	channel_arm(tx_channel);
+
+	pthread_mutex_unlock(&rmt_lock);
+
+	return ESP_OK;
+}
+
+/* Moves the clock to the end of the last transaction, as long as the caller
+ * would be blocked on the target */
+esp_err_t rmt_tx_wait_all_done(rmt_channel_handle_t tx_channel, int timeout_ms) {
+	int64_t end = 0;
+
+	pthread_mutex_lock(&rmt_lock);
+
+	if (tx_channel->count) {
+		end = tx_channel->queue[(tx_channel->head + tx_channel->count - 1) % tx_channel->config.trans_queue_depth].end;
+	}
+
+	pthread_mutex_unlock(&rmt_lock);
+
+	int64_t wait = end - esp_timer_get_time();
+
+	if (wait > 0 && timeout_ms >= 0 && wait > (int64_t)timeout_ms * 1000) {
+		host_time_advance((int64_t)timeout_ms * 1000);
+		channel_settle(tx_channel);
+
+		return ESP_ERR_TIMEOUT;
+	}
+
+	/* A loop never ends */
+	if (end == LOOP_END) {
+		return ESP_ERR_TIMEOUT;
+	}
+
+	if (wait > 0) {
+		host_time_advance(wait);
+	}
+
+	channel_settle(tx_channel);
+
+	return ESP_OK;
+}
+
+esp_err_t rmt_tx_register_event_callbacks(rmt_channel_handle_t tx_channel, const rmt_tx_event_callbacks_t *cbs, void *user_data) {
+	esp_err_t ret = ESP_ERR_INVALID_STATE;
+
+	pthread_mutex_lock(&rmt_lock);
+
+	if (!tx_channel->enabled) {
+		tx_channel->on_trans_done = cbs->on_trans_done;
+		tx_channel->user_data = user_data;
+		ret = ESP_OK;
+	}
+
+	pthread_mutex_unlock(&rmt_lock);
+
+	return ret;
+}
+
+esp_err_t rmt_new_bytes_encoder(const rmt_bytes_encoder_config_t *config, rmt_encoder_handle_t *ret_encoder) {
+	if (encoder_error != ESP_OK) {
+		return encoder_error;
+	}
+
+	bytes_encoder_t *encoder = calloc(1, sizeof(*encoder));
+
+	if (encoder == NULL) {
+		return ESP_ERR_NO_MEM;
+	}
+
+	encoder->base.encode = bytes_encode;
+	encoder->base.reset = bytes_reset;
+	encoder->base.del = encoder_del;
+	encoder->bit0 = config->bit0;
+	encoder->bit1 = config->bit1;
+	encoder->msb_first = config->flags.msb_first;
+	*ret_encoder = &encoder->base;
+
+	return ESP_OK;
+}
+
+esp_err_t rmt_new_copy_encoder(const rmt_copy_encoder_config_t *config, rmt_encoder_handle_t *ret_encoder) {
+	if (encoder_error != ESP_OK) {
+		return encoder_error;
+	}
+
+	copy_encoder_t *encoder = calloc(1, sizeof(*encoder));
+
+	if (encoder == NULL) {
+		return ESP_ERR_NO_MEM;
+	}
+
+	encoder->base.encode = copy_encode;
+	encoder->base.reset = copy_reset;
+	encoder->base.del = encoder_del;
+	*ret_encoder = &encoder->base;
+
+	return ESP_OK;
+}
+
+esp_err_t rmt_del_encoder(rmt_encoder_handle_t encoder) {
+	return encoder->del(encoder);
+}
+
+esp_err_t rmt_encoder_reset(rmt_encoder_handle_t encoder) {
+	return encoder->reset(encoder);
+}
+
+rmt_channel_handle_t host_rmt_channel(int gpio_num) {
+	rmt_channel_handle_t channel = NULL;
+
+	pthread_mutex_lock(&rmt_lock);
+
+	for (uint32_t i = 0; i < CHANNELS_NUM; i++) {
+		if (channels[i] != NULL && channels[i]->config.gpio_num == gpio_num) {
+			channel = channels[i];
+		}
+	}
+
+	pthread_mutex_unlock(&rmt_lock);
+
+	return channel;
+}
+
+const rmt_symbol_word_t *host_rmt_last_tx(rmt_channel_handle_t channel, size_t *num_symbols, uint32_t *count) {
+	pthread_mutex_lock(&rmt_lock);
+	*num_symbols = channel->tx_count ? channel->num_symbols : 0;
+	*count = channel->tx_count;
+	pthread_mutex_unlock(&rmt_lock);
+
+	return channel->symbols;
+}
+
+uint32_t host_rmt_in_flight(rmt_channel_handle_t channel) {
+	channel_settle(channel);
+
+	pthread_mutex_lock(&rmt_lock);
+	uint32_t count = channel->count;
+	pthread_mutex_unlock(&rmt_lock);
+
+	return count;
+}
+
+bool host_rmt_enabled(rmt_channel_handle_t channel) {
+	pthread_mutex_lock(&rmt_lock);
+	bool enabled = channel->enabled;
+	pthread_mutex_unlock(&rmt_lock);
+
+	return enabled;
+}
+
+void host_rmt_encoder_error(esp_err_t err) {
+	pthread_mutex_lock(&rmt_lock);
+	encoder_error = err;
+	pthread_mutex_unlock(&rmt_lock);
+}
+
+/* Private functions ---------------------------------------------------------*/
+/* Called by the encoders with the lock taken */
+static bool channel_write(rmt_channel_handle_t channel, rmt_symbol_word_t symbol) {
+	if (channel->mem_free == 0) {
+		return false;
+	}
+
+	if (channel->num_symbols == channel->size) {
+		size_t size = channel->size ? channel->size * 2 : 256;
+		rmt_symbol_word_t *symbols = realloc(channel->symbols, size * sizeof(*symbols));
+
+		TEST_ASSERT(symbols != NULL);
+		channel->symbols = symbols;
+		channel->size = size;
+	}
+
+	channel->symbols[channel->num_symbols++] = symbol;
+	channel->mem_free--;
+
+	return true;
+}
+
+/* Ends the transactions whose time is over, their callbacks run in order as
+ * from the ISR */
+static void channel_settle(rmt_channel_handle_t channel) {
+	pthread_mutex_lock(&done_lock);
+
+	for (;;) {
+		pthread_mutex_lock(&rmt_lock);
+
+		if (channel->count == 0 || channel->queue[channel->head].end > esp_timer_get_time()) {
+			channel_arm(channel);
+			pthread_mutex_unlock(&rmt_lock);
+			break;
+		}
+
+		rmt_tx_done_event_data_t edata = {
+				.num_symbols = channel->queue[channel->head].num_symbols,
+		};
+		rmt_tx_done_callback_t on_trans_done = channel->on_trans_done;
+		void *user_data = channel->user_data;
+
+		pthread_mutex_unlock(&rmt_lock);
+
+		/* Still in flight for rmt_tx_wait_all_done() while it runs */
+		if (on_trans_done != NULL) {
+			host_isr_context(true);
+			on_trans_done(channel, &edata, user_data);
+			host_isr_context(false);
+		}
+
+		pthread_mutex_lock(&rmt_lock);
+		channel->head = (channel->head + 1) % channel->config.trans_queue_depth;
+		channel->count--;
+		pthread_mutex_unlock(&rmt_lock);
+	}
+
+	pthread_mutex_unlock(&done_lock);
+}
+
+/* Sets the alarm to the end of the next transaction, with the lock taken */
+static void channel_arm(rmt_channel_handle_t channel) {
+	esp_timer_stop(channel->done_timer);
+
+	if (channel->count && channel->queue[channel->head].end != LOOP_END) {
+		int64_t wait = channel->queue[channel->head].end - esp_timer_get_time();
+
+		esp_timer_start_once(channel->done_timer, wait > 0 ? wait : 0);
+	}
+}
+
+static void channel_done(void *arg) {
+	channel_settle(arg);
+}
+
+static size_t bytes_encode(rmt_encoder_t *encoder, rmt_channel_handle_t channel, const void *primary_data, size_t data_size, rmt_encode_state_t *ret_state) {
+	bytes_encoder_t *me = (bytes_encoder_t *)encoder;
+	const uint8_t *data = primary_data;
+	size_t encoded = 0;
+
+	*ret_state = RMT_ENCODING_RESET;
+
+	while (me->byte_index < data_size) {
+		uint8_t bit = me->msb_first ? 7 - me->bit_index : me->bit_index;
+
+		if (!channel_write(channel, data[me->byte_index] & (1 << bit) ? me->bit1 : me->bit0)) {
+			*ret_state |= RMT_ENCODING_MEM_FULL;
+			return encoded;
+		}
+
+		encoded++;
+
+		if (++me->bit_index == 8) {
+			me->bit_index = 0;
+			me->byte_index++;
+		}
+	}
+
+	me->byte_index = 0;
+	*ret_state |= RMT_ENCODING_COMPLETE;
+
+	/* The last symbol may fill the block too */
+	if (channel->mem_free == 0) {
+		*ret_state |= RMT_ENCODING_MEM_FULL;
+	}
+
+	return encoded;
+}
+
+static esp_err_t bytes_reset(rmt_encoder_t *encoder) {
+	bytes_encoder_t *me = (bytes_encoder_t *)encoder;
+
+	me->byte_index = 0;
+	me->bit_index = 0;
+
+	return ESP_OK;
+}
+
+static size_t copy_encode(rmt_encoder_t *encoder, rmt_channel_handle_t channel, const void *primary_data, size_t data_size, rmt_encode_state_t *ret_state) {
+	copy_encoder_t *me = (copy_encoder_t *)encoder;
+	const rmt_symbol_word_t *symbols = primary_data;
+	size_t num_symbols = data_size / sizeof(rmt_symbol_word_t);
+	size_t encoded = 0;
+
+	*ret_state = RMT_ENCODING_RESET;
+
+	while (me->symbol_index < num_symbols) {
+		if (!channel_write(channel, symbols[me->symbol_index])) {
+			*ret_state |= RMT_ENCODING_MEM_FULL;
+			return encoded;
+		}
+
+		encoded++;
+		me->symbol_index++;
+	}
+
+	me->symbol_index = 0;
+	*ret_state |= RMT_ENCODING_COMPLETE;
+
+	if (channel->mem_free == 0) {
+		*ret_state |= RMT_ENCODING_MEM_FULL;
+	}
+
+	return encoded;
+}
+
+static esp_err_t copy_reset(rmt_encoder_t *encoder) {
+	copy_encoder_t *me = (copy_encoder_t *)encoder;
+
+	me->symbol_index = 0;
+
+	return ESP_OK;
+}
+
+static esp_err_t encoder_del(rmt_encoder_t *encoder) {
+	free(encoder);
+
+	return ESP_OK;
+}
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,141 @@
+/**
+  ******************************************************************************
+  * @file           : spi_master.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : SPI master stand-in that records the transmitted frames
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+
+#include "driver/spi_master.h"
+#include "esp_rom_gpio.h"
+#include "hal/spi_hal.h"
+#include "soc/spi_periph.h"
+#include "host_test.h"
+
+/* Private macro -------------------------------------------------------------*/
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+struct spi_device_t {
+	spi_host_device_t host_id;
+	int clock_speed_hz;
+};
+
+/* Private variables ---------------------------------------------------------*/
+spi_dev_t host_spi_hw[SPI_HOST_MAX];
+const spi_signal_conn_t spi_periph_signal[SPI_HOST_MAX];
+
+static bool bus_used[SPI_HOST_MAX];
+static uint8_t *last_tx;
+static size_t last_tx_len;
+static uint32_t tx_count;
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+esp_err_t spi_bus_initialize(spi_host_device_t host_id, const spi_bus_config_t *bus_config, spi_dma_chan_t dma_chan) {
+	if (host_id >= SPI_HOST_MAX || bus_config == NULL) {
+		return ESP_ERR_INVALID_ARG;
+	}
+
+	if (bus_used[host_id]) {
+		return ESP_ERR_INVALID_STATE;
+	}
+
+	bus_used[host_id] = true;
+
+	return ESP_OK;
+}
+
+esp_err_t spi_bus_free(spi_host_device_t host_id) {
+	if (!bus_used[host_id]) {
+		return ESP_ERR_INVALID_STATE;
+	}
+
+	bus_used[host_id] = false;
+
+	return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host_id, const spi_device_interface_config_t *dev_config, spi_device_handle_t *handle) {
+	struct spi_device_t *dev = calloc(1, sizeof(*dev));
+
+	if (dev == NULL) {
+		return ESP_ERR_NO_MEM;
+	}
+
+	dev->host_id = host_id;
+	dev->clock_speed_hz = dev_config->clock_speed_hz;
+	*handle = dev;
+
+	return ESP_OK;
+}
+
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle) {
+	free(handle);
+
+	return ESP_OK;
+}
+
+esp_err_t spi_device_get_actual_freq(spi_device_handle_t handle, int *freq_khz) {
+	*freq_khz = handle->clock_speed_hz / 1000;
+
+	return ESP_OK;
+}
+
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc) {
+	size_t len = (trans_desc->length + 7) / 8;
+
+	free(last_tx);
+	last_tx = malloc(len);
+	memcpy(last_tx, trans_desc->tx_buffer, len);
+	last_tx_len = len;
+	tx_count++;
+
+	return ESP_OK;
+}
+
+void esp_rom_gpio_connect_out_signal(uint32_t gpio_num, uint32_t signal_idx, bool out_inv, bool oen_inv) {
+}
+
+const uint8_t *host_spi_last_tx(size_t *len, uint32_t *count) {
+	*len = last_tx_len;
+	*count = tx_count;
+
+	return last_tx;
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/***************************** END OF FILE ************************************/
@@ -0,0 +1,236 @@
+/**
+  ******************************************************************************
+  * @file           : timers.c
+  * @author         : Mauricio Barroso Benavides
+  * @date           : Oct 17, 2026
+  * @brief          : FreeRTOS software timer stand-in for the host tests
+  ******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Mauricio Barroso Benavides
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to
+  * deal in the Software without restriction, including without limitation the
+  * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+  * sell copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in
+  * all copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  * IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/timers.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define TICKS_TO_US(ticks)		((uint64_t)(ticks) * portTICK_PERIOD_MS * 1000)
+
+/* External variables --------------------------------------------------------*/
+
+/* Private typedef -----------------------------------------------------------*/
+struct host_timer {
+	esp_timer_handle_t timer;
+	TickType_t period;
+	bool auto_reload;
+	void *timer_id;
+	TimerCallbackFunction_t callback;
+};
+
+struct pended_call {
+	PendedFunction_t function;
+	void *arg1;
+	uint32_t arg2;
+	struct pended_call *next;
+};
+
+/* Private variables ---------------------------------------------------------*/
+/* The pended calls run in order on the esp_timer task, as the timer callbacks */
+static pthread_mutex_t pended_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t pended_once = PTHREAD_ONCE_INIT;
+static esp_timer_handle_t pended_timer;
+static struct pended_call *pended_head;
+static struct pended_call **pended_tail = &pended_head;
+
+/* Private function prototypes -----------------------------------------------*/
+static void timer_dispatch(void *arg);
+static void pended_init(void);
+static void pended_dispatch(void *arg);
+
+/* Exported functions --------------------------------------------------------*/
+TimerHandle_t xTimerCreate(const char *name, TickType_t period, UBaseType_t auto_reload, void *timer_id, TimerCallbackFunction_t callback) {
+	struct host_timer *timer = calloc(1, sizeof(*timer));
+
+	if (timer == NULL || period == 0) {
+		free(timer);
+		return NULL;
+	}
+
+	timer->period = period;
+	timer->auto_reload = auto_reload;
+	timer->timer_id = timer_id;
+	timer->callback = callback;
+
+	esp_timer_create_args_t args = {
+			.callback = timer_dispatch,
+			.arg = timer,
+			.dispatch_method = ESP_TIMER_TASK,
+			.name = name,
+	};
+
+	if (esp_timer_create(&args, &timer->timer) != ESP_OK) {
+		free(timer);
+		return NULL;
+	}
+
+	return timer;
+}
+
+TimerHandle_t xTimerCreateStatic(const char *name, TickType_t period, UBaseType_t auto_reload, void *timer_id, TimerCallbackFunction_t callback, StaticTimer_t *timer_buffer) {
+	return xTimerCreate(name, period, auto_reload, timer_id, callback);
+}
+
+/* Starting an active timer restarts its period, as on the target */
+BaseType_t xTimerStart(TimerHandle_t timer, TickType_t ticks_to_wait) {
+	esp_timer_stop(timer->timer);
+
+	if (timer->auto_reload) {
+		esp_timer_start_periodic(timer->timer, TICKS_TO_US(timer->period));
+	}
+	else {
+		esp_timer_start_once(timer->timer, TICKS_TO_US(timer->period));
+	}
+
+	return pdPASS;
+}
+
+BaseType_t xTimerReset(TimerHandle_t timer, TickType_t ticks_to_wait) {
+	return xTimerStart(timer, ticks_to_wait);
+}
+
+BaseType_t xTimerStop(TimerHandle_t timer, TickType_t ticks_to_wait) {
+	esp_timer_stop(timer->timer);
+
+	return pdPASS;
+}
+
+/* Changing the period of a dormant timer starts it */
+BaseType_t xTimerChangePeriod(TimerHandle_t timer, TickType_t period, TickType_t ticks_to_wait) {
+	if (period == 0) {
+		return pdFAIL;
+	}
+
+	timer->period = period;
+
+	return xTimerStart(timer, ticks_to_wait);
+}
+
+BaseType_t xTimerDelete(TimerHandle_t timer, TickType_t ticks_to_wait) {
+	esp_timer_stop(timer->timer);
+	esp_timer_delete(timer->timer);
+	free(timer);
+
+	return pdPASS;
+}
+
+BaseType_t xTimerIsTimerActive(TimerHandle_t timer) {
+	return esp_timer_is_active(timer->timer) ? pdTRUE : pdFALSE;
+}
+
+void *pvTimerGetTimerID(TimerHandle_t timer) {
+	return timer->timer_id;
+}
+
+BaseType_t xTimerPendFunctionCall(PendedFunction_t function, void *arg1, uint32_t arg2, TickType_t ticks_to_wait) {
+	struct pended_call *call = malloc(sizeof(*call));
+
+	if (call == NULL) {
+		return pdFAIL;
+	}
+
+	*call = (struct pended_call) {
+			.function = function,
+			.arg1 = arg1,
+			.arg2 = arg2,
+	};
+
+	pthread_once(&pended_once, pended_init);
+	pthread_mutex_lock(&pended_lock);
+	*pended_tail = call;
+	pended_tail = &call->next;
+	pthread_mutex_unlock(&pended_lock);
+
+	/* Already armed if a call is waiting, it runs them all */
+	esp_timer_start_once(pended_timer, 0);
+
+	return pdPASS;
+}
+
+BaseType_t xTimerPendFunctionCallFromISR(PendedFunction_t function, void *arg1, uint32_t arg2, BaseType_t *higher_priority_task_woken) {
+	if (higher_priority_task_woken != NULL) {
+		*higher_priority_task_woken = pdFALSE;
+	}
+
+	return xTimerPendFunctionCall(function, arg1, arg2, 0);
+}
+
+/* Private functions ---------------------------------------------------------*/
+static void timer_dispatch(void *arg) {
+	struct host_timer *timer = arg;
+
+	timer->callback(timer);
+}
+
+static void pended_init(void) {
+	esp_timer_create_args_t args = {
+			.callback = pended_dispatch,
+			.dispatch_method = ESP_TIMER_TASK,
+			.name = "pended",
+	};
+
+	esp_timer_create(&args, &pended_timer);
+}
+
+static void pended_dispatch(void *arg) {
+	for (;;) {
+		pthread_mutex_lock(&pended_lock);
+
+		struct pended_call *call = pended_head;
+
+		if (call != NULL) {
+			pended_head = call->next;
+
+			if (pended_head == NULL) {
+				pended_tail = &pended_head;
+			}
+		}
+
+		pthread_mutex_unlock(&pended_lock);
+
+		if (call == NULL) {
+			break;
+		}
+
+		call->function(call->arg1, call->arg2);
+		free(call);
+	}
+}
+
+/***************************** END OF FILE ************************************/